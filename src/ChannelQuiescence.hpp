@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cmath>
+
+// Sleep/wake state for the Proc and IntegralFlux channels, kept free of Rack types. A channel
+// sleeps (skips its DSP pipeline and holds its outputs) once it has stayed settled for
+// kSettleSamples in a row. While it sleeps, the module calls poll() every sample: edges, gate
+// levels and patch changes wake it at once, and timing knobs/CVs are checked every
+// kControlPollDivider samples. Waking starts the settle run over.
+namespace channel_quiescence {
+
+// A channel must hold still this long before sleeping, so brief pauses do not toggle sleep.
+static constexpr int kSettleSamples = 32;
+// Sleeping channels only poll timing knobs/CVs (which just feed the preview) at this divider.
+static constexpr int kControlPollDivider = 16;
+
+// Mirrors rack::dsp::SchmittTrigger::process() thresholds without consuming the edge.
+inline bool schmittWouldChange(bool high, float in) {
+	return high ? (in <= 0.f) : (in >= 1.f);
+}
+
+struct ChannelQuiescence {
+	bool quiescent = false;
+	// Whether the signal input was patched when the channel fell asleep.
+	bool signalPatched = false;
+	int settleSamplesLeft = 0;
+	int controlPollCounter = 0;
+
+	// After each processed sample. Any unsettled sample, or sleep being disabled, restarts the
+	// settle run; the channel sleeps once a full run has passed.
+	void update(bool settled, bool sleepEnabled, bool signalPatchedNow) {
+		if (!settled || !sleepEnabled) {
+			settleSamplesLeft = kSettleSamples;
+			return;
+		}
+		if (settleSamplesLeft > 0) {
+			settleSamplesLeft--;
+			return;
+		}
+		quiescent = true;
+		signalPatched = signalPatchedNow;
+		controlPollCounter = 0;
+	}
+
+	// Returns true while the channel may keep sleeping. `immediateWake` carries the module's
+	// per-sample checks (sleep disabled, latched cycle, pending edges or gates). A patch change,
+	// or a patched signal leaving the held output by more than `eps`, also wakes the channel.
+	// `controlsMoved` is only called every kControlPollDivider samples.
+	template <typename ControlsMoved>
+	bool poll(bool immediateWake, bool signalPatchedNow, float signalIn, float out, float eps,
+		ControlsMoved controlsMoved) {
+		bool wake = immediateWake
+			|| signalPatchedNow != signalPatched
+			|| (signalPatchedNow && std::fabs(signalIn - out) > eps);
+		if (!wake && ++controlPollCounter >= kControlPollDivider) {
+			controlPollCounter = 0;
+			wake = controlsMoved();
+		}
+		if (wake) {
+			quiescent = false;
+			settleSamplesLeft = kSettleSamples;
+		}
+		return !wake;
+	}
+};
+
+} // namespace channel_quiescence
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+// Control-rate reading of knobs and CVs shared by every Leviathan module. A clock decides
+// which samples read their controls, a bank latches each reading behind a hysteresis band
+// and raises a dirty flag only when it moves, and a ramp carries values that scale audio
+// directly back up to audio rate. Nothing here touches Rack, so modules feed it whatever
+// they read from their params and inputs.
+namespace control_acquisition {
+
+// Counts samples between control reads; a divider of 1 reads every sample.
+struct ControlClock {
+	int divider = 1;
+	int counter = 0;
+
+	void setDivider(int div) {
+		divider = div < 1 ? 1 : div;
+		counter = 0;
+	}
+
+	// True on the samples that should read their controls.
+	bool tick() {
+		if (divider <= 1) {
+			return true;
+		}
+		if (++counter >= divider) {
+			counter = 0;
+			return true;
+		}
+		return false;
+	}
+};
+
+// Latched control readings, one slot per knob or CV. A slot only moves once a reading leaves
+// the band of +/- threshold around its latched value, so jitter and slow drift below the
+// band never reach the DSP.
+template <int SLOTS>
+struct ControlBank {
+	static_assert(SLOTS > 0 && SLOTS <= 32, "dirty flags live in one 32-bit mask");
+
+	float latched[SLOTS] = {};
+	// A threshold of 0 flags any change at all.
+	float threshold[SLOTS] = {};
+	// Slots that moved since the last clearDirty().
+	uint32_t dirty = 0;
+	// Slots whose next reading latches unconditionally.
+	uint32_t stale = allSlots();
+
+	static uint32_t allSlots() {
+		return SLOTS == 32 ? 0xffffffffu : ((uint32_t(1) << SLOTS) - 1u);
+	}
+
+	void setThreshold(int slot, float band) {
+		threshold[slot] = band;
+	}
+
+	// Feeds one reading; returns true when the slot moved.
+	bool acquire(int slot, float raw) {
+		uint32_t bit = uint32_t(1) << slot;
+		if (!(stale & bit) && std::fabs(raw - latched[slot]) <= threshold[slot]) {
+			return false;
+		}
+		latched[slot] = raw;
+		stale &= ~bit;
+		dirty |= bit;
+		return true;
+	}
+
+	// Same test as acquire() without latching, for polling a sleeping channel.
+	bool wouldChange(int slot, float raw) const {
+		return (stale & (uint32_t(1) << slot)) || std::fabs(raw - latched[slot]) > threshold[slot];
+	}
+
+	float value(int slot) const {
+		return latched[slot];
+	}
+
+	bool isDirty(int slot) const {
+		return (dirty >> slot) & 1u;
+	}
+
+	bool anyDirty() const {
+		return dirty != 0;
+	}
+
+	void clearDirty() {
+		dirty = 0;
+	}
+
+	// Forces every slot to latch and flag on its next reading.
+	void invalidate() {
+		stale = allSlots();
+	}
+
+	bool awaitingReading() const {
+		return stale != 0;
+	}
+};
+
+// Linear glide toward a control-rate target, advanced once per audio sample. Lands exactly
+// on the target so comparisons against knob end stops keep working.
+struct ControlRamp {
+	float value = 0.f;
+	float target = 0.f;
+	float step = 0.f;
+	int samplesLeft = 0;
+
+	void jump(float to) {
+		value = to;
+		target = to;
+		step = 0.f;
+		samplesLeft = 0;
+	}
+
+	void glide(float to, int samples) {
+		if (samples <= 1) {
+			jump(to);
+			return;
+		}
+		target = to;
+		step = (to - value) / float(samples);
+		samplesLeft = samples;
+	}
+
+	float advance() {
+		if (samplesLeft > 0) {
+			value += step;
+			if (--samplesLeft == 0) {
+				value = target;
+			}
+		}
+		return value;
+	}
+
+	bool gliding() const {
+		return samplesLeft > 0;
+	}
+};
+
+} // namespace control_acquisition
@@ -1,5 +1,9 @@
 #include "plugin.hpp"
-#include <dsp/minblep.hpp>
+#include "WavePreviewWidget.hpp"
+#include "MinBlep.hpp"
+#include "SegmentOscillator.hpp"
+#include "ControlAcquisition.hpp"
+#include "ChannelQuiescence.hpp"
 #include <array>
 #include <cstdio>
 #include <atomic>
@@ -68,6 +72,14 @@ struct IntegralFlux : Module {
 		LIGHTS_LEN
 	};
 
+	enum BlepLane {
+		// CH1 and CH4 share one residue bank.
+		BLEP_CH1_GATE_LANE,
+		BLEP_CH1_SIGNAL_LANE,
+		BLEP_CH4_GATE_LANE,
+		BLEP_CH4_SIGNAL_LANE
+	};
+
 	enum OuterPhase {
 		// IDLE: no active function cycle unless cycle mode is engaged.
 		// RISE/FALL: function-generator mode integrates toward 10V then 0V.
@@ -76,14 +88,20 @@ struct IntegralFlux : Module {
 		OUTER_FALL
 	};
 
+	enum StageControlSlot {
+		STAGE_RISE_KNOB,
+		STAGE_FALL_KNOB,
+		STAGE_SHAPE_KNOB,
+		STAGE_RISE_CV,
+		STAGE_FALL_CV,
+		STAGE_BOTH_CV,
+		STAGE_CONTROL_SLOTS
+	};
+
 	struct OuterChannelState {
 		// Edge detectors for trigger input and momentary cycle button.
 		dsp::SchmittTrigger trigEdge;
 		dsp::SchmittTrigger cycleButtonEdge;
-		// Optional anti-alias compensation for hard output steps.
-		dsp::MinBlepGenerator<16, 16> gateBlep;
-		dsp::MinBlepGenerator<16, 16> signalBlep;
-
 		OuterPhase phase = OUTER_IDLE;
 		// phasePos is a normalized [0..1+] phase accumulator for the active segment.
 		float phasePos = 0.f;
@@ -95,28 +113,23 @@ struct IntegralFlux : Module {
 		float slewInvSpan = 0.f;
 		bool cycleLatched = false;
 		bool gateState = false;
-		// Cached warp compensation for the current shape setting.
-		bool warpScaleValid = false;
+		// Closed-form curve constants for the current shape setting.
+		bool warpCurveValid = false;
 		float cachedShapeSigned = 0.f;
-		float cachedWarpScale = 1.f;
-		// Stage-time cache avoids recomputing expensive mapping every sample when unchanged.
+		segment_curve::WarpCurve warpCurve;
+		// Audio-rate cycle core, running while audioRateCycle and cycle are both on.
+		segment_oscillator::SegmentOscillator osc;
+		bool oscRunning = false;
+		// Stage-time controls latched at the timing update rate; times are recomputed only when one moves.
 		bool stageTimeValid = false;
-		float cachedRiseKnob = 0.f;
-		float cachedFallKnob = 0.f;
-		float cachedShape = 0.f;
-		float cachedRiseCv = 0.f;
-		float cachedFallCv = 0.f;
-		float cachedBothCv = 0.f;
-		float cachedRiseTime = 0.01f;
-		float cachedFallTime = 0.01f;
-		// Active times may interpolate toward cached targets at reduced timing update rates.
-		float activeRiseTime = 0.01f;
-		float activeFallTime = 0.01f;
+		control_acquisition::ControlBank<STAGE_CONTROL_SLOTS> stageControls;
+		// Active times may glide toward recomputed targets at reduced timing update rates.
+		control_acquisition::ControlRamp riseTimeRamp;
+		control_acquisition::ControlRamp fallTimeRamp;
 		// Trigger acceptance rearm timer for explicit max trigger rate behavior.
 		float trigRearmSec = 0.f;
-		float riseTimeStep = 0.f;
-		float fallTimeStep = 0.f;
-		int timeInterpSamplesLeft = 0;
+		// Quiescent channels skip the DSP pipeline until an edge or control change wakes them.
+		channel_quiescence::ChannelQuiescence quiescence;
 	};
 
 	struct OuterChannelConfig {
@@ -134,10 +147,14 @@ struct IntegralFlux : Module {
 		float logShapeTimeScaleLog2;
 		float expShapeTimeScaleLog2;
 		OuterPhase gateHighPhase;
+		int gateBlepLane;
+		int signalBlepLane;
 	};
 
 	struct OuterChannelResult {
 		bool cycleOn = false;
+		// Output, gate and preview are at rest and will stay there until an input changes.
+		bool settled = false;
 	};
 
 	struct SlewStepResult {
@@ -147,6 +164,8 @@ struct IntegralFlux : Module {
 
 	OuterChannelState ch1;
 	OuterChannelState ch4;
+	// Optional anti-alias compensation for hard output steps.
+	min_blep::ResidualBank<4> blep;
 	struct PreviewSharedState {
 		// Lock-free handoff from engine thread -> UI thread.
 		// Atomics keep preview independent from DSP timing.
@@ -176,16 +195,15 @@ struct IntegralFlux : Module {
 	PreviewUpdateState previewUpdateCh4;
 	bool bandlimitedGateOutputs = false;
 	bool bandlimitedSignalOutputs = true;
-	int timingUpdateDiv = 1;
-	int timingUpdateCounter = 0;
+	control_acquisition::ControlClock timingClock;
 	bool timingInterpolate = true;
+	bool sleepWhenIdle = true;
+	bool audioRateCycle = false;
 	// UI light updates are rate-limited to reduce engine overhead.
 	float lightUpdateTimer = 0.f;
 	static constexpr float LINEAR_SHAPE = 0.33f;
 	static constexpr float OUTER_V_MIN = 0.f;
 	static constexpr float OUTER_V_MAX = 10.2f;
-	static constexpr float WARP_K_MAX = 40.f;
-	static constexpr int WARP_SCALE_SAMPLES = 16;
 	static constexpr float PARAM_CACHE_EPS = 1e-4f;
 	static constexpr float CV_CACHE_EPS = 1e-3f;
 	static constexpr float TARGET_EPS = 1e-4f;
@@ -214,6 +232,9 @@ struct IntegralFlux : Module {
 	// Hardware-like FG ceilings.
 	static constexpr float OUTER_MAX_CYCLE_HZ = 1000.f;
 	static constexpr float OUTER_MAX_TRIGGER_HZ = 2000.f;
+	// Audio-rate cycling renders analytically with band-limited corners, so it may run far faster.
+	static constexpr float OUTER_AUDIO_MAX_CYCLE_HZ = 20000.f;
+	static constexpr float OUTER_AUDIO_MIN_TIME = 0.00001f;
 	static constexpr float CV_OCT_CLAMP = 12.f;
 	static constexpr float STAGE_CV_OCT_PER_V = 0.5f;
 	static constexpr float PREVIEW_INTERACTIVE_INTERVAL = 1.f / 60.f;
@@ -269,38 +290,6 @@ struct IntegralFlux : Module {
 		return 0.f;
 	}
 
-	static float slopeWarp(float x, float s) {
-		// Differential warp used by both function-generator and slew modes.
-		// We shape local slope, then normalize total travel time with slopeWarpScale().
-		x = clamp(x, 0.f, 1.f);
-		float u = std::fabs(s);
-		if (u < 1e-6f) {
-			return 1.f;
-		}
-		float k = WARP_K_MAX * u;
-		float x2 = x * x;
-		if (s < 0.f) {
-			// LOG: fast near 0V, slow near top.
-			return 1.f / (1.f + k * x2);
-		}
-		// EXP: slow near 0V, fast near top.
-		return 1.f + k * x2;
-	}
-
-	static float slopeWarpScale(float s) {
-		// Numerically estimate scale so different curve settings keep similar segment duration.
-		// Integrates reciprocal slope over [0..1] with a small fixed sample count.
-		if (std::fabs(s) < 1e-6f) {
-			return 1.f;
-		}
-		float sum = 0.f;
-		for (int i = 0; i < WARP_SCALE_SAMPLES; ++i) {
-			float xi = (i + 0.5f) / float(WARP_SCALE_SAMPLES);
-			sum += 1.f / slopeWarp(xi, s);
-		}
-		return sum / float(WARP_SCALE_SAMPLES);
-	}
-
 	static float computeSegPhase(float out, float startOut, float invSpan) {
 		if (std::fabs(invSpan) < 1e-9f) {
 			return 1.f;
@@ -314,8 +303,7 @@ struct IntegralFlux : Module {
 		float in,
 		float riseTime,
 		float fallTime,
-		float shapeSigned,
-		float warpScale,
+		const segment_curve::WarpCurve& curve,
 		float dt
 	) {
 		// Shared "core limiter" path when the outer channel is acting as a slew on input signal.
@@ -355,16 +343,16 @@ struct IntegralFlux : Module {
 		stageTime = std::max(stageTime, 1e-6f);
 		float range = OUTER_V_MAX - OUTER_V_MIN;
 		float x = computeSegPhase(out, ch.slewStartOut, ch.slewInvSpan);
-		float dp = clamp(dt / stageTime, 0.f, 0.5f);
-		float step = dp * slopeWarp(x, shapeSigned) * warpScale * range;
+		// The curve is drawn over the full reference range, so a shorter span is covered sooner.
+		float dp = clamp(dt / stageTime, 0.f, 0.5f) * range * std::fabs(ch.slewInvSpan);
+		float travel = segment_curve::warpTravel(curve, x) + dp;
 
-		float prevOut = out;
-		out += (delta > 0.f) ? step : -step;
-		if ((in - prevOut) * (in - out) < 0.f) {
+		if (travel >= 1.f) {
 			out = in;
 			ch.slewDir = 0;
 		}
 		else {
+			out = ch.slewStartOut + segment_curve::warpLevel(curve, travel) * (ch.slewTargetOut - ch.slewStartOut);
 			ch.slewDir = dir;
 		}
 		result.out = out;
@@ -380,7 +368,7 @@ struct IntegralFlux : Module {
 		return clamp(1.f - ((phasePos - 1.f) / dp), 0.f, 1.f);
 	}
 
-	static void insertGateTransition(OuterChannelState& ch, bool newState, float fraction01) {
+	void insertGateTransition(OuterChannelState& ch, const OuterChannelConfig& cfg, bool newState, float fraction01) {
 		if (newState == ch.gateState) {
 			return;
 		}
@@ -388,7 +376,7 @@ struct IntegralFlux : Module {
 		// Rack MinBLEP expects discontinuity position in [-1, 0] samples from current sample.
 		float p = f - 1.f;
 		float step = newState ? 10.f : -10.f;
-		ch.gateBlep.insertDiscontinuity(p, step);
+		blep.insertDiscontinuity(cfg.gateBlepLane, p, step);
 		ch.gateState = newState;
 	}
 
@@ -396,23 +384,39 @@ struct IntegralFlux : Module {
 		ch.gateState = newState;
 	}
 
-	static void insertSignalTransition(OuterChannelState& ch, float step, float fraction01) {
+	void insertSignalTransition(const OuterChannelConfig& cfg, float step, float fraction01) {
 		if (std::fabs(step) < 1e-9f) {
 			return;
 		}
 		float f = clamp(fraction01, 1e-6f, 1.f);
 		float p = f - 1.f;
-		ch.signalBlep.insertDiscontinuity(p, step);
+		blep.insertDiscontinuity(cfg.signalBlepLane, p, step);
 	}
 
 	void setTimingUpdateDiv(int div) {
 		// Changing update rate invalidates cached timing so channels resync immediately.
-		timingUpdateDiv = std::max(1, div);
-		timingUpdateCounter = 0;
+		timingClock.setDivider(div);
+		ch1.stageTimeValid = false;
+		ch4.stageTimeValid = false;
+	}
+
+	void setAudioRateCycle(bool enabled) {
+		// The stage-time floor depends on the mode, so cached timing is rebuilt.
+		audioRateCycle = enabled;
 		ch1.stageTimeValid = false;
 		ch4.stageTimeValid = false;
 	}
 
+	void configureStageControls(OuterChannelState& ch) {
+		// Knob and CV hysteresis bands match the resolution each source can meaningfully resolve.
+		ch.stageControls.setThreshold(STAGE_RISE_KNOB, PARAM_CACHE_EPS);
+		ch.stageControls.setThreshold(STAGE_FALL_KNOB, PARAM_CACHE_EPS);
+		ch.stageControls.setThreshold(STAGE_SHAPE_KNOB, PARAM_CACHE_EPS);
+		ch.stageControls.setThreshold(STAGE_RISE_CV, CV_CACHE_EPS);
+		ch.stageControls.setThreshold(STAGE_FALL_CV, CV_CACHE_EPS);
+		ch.stageControls.setThreshold(STAGE_BOTH_CV, CV_CACHE_EPS);
+	}
+
 	void initKnobCurveLut() {
 		// Precompute knob taper to trade tiny memory for lower per-sample CPU.
 		for (int i = 0; i < KNOB_CURVE_LUT_SIZE; ++i) {
@@ -435,15 +439,8 @@ struct IntegralFlux : Module {
 
 	void updateActiveStageTimes(OuterChannelState& ch) {
 		// Optional de-zipper when timing is updated at control rate (/4, /8, ...).
-		if (ch.timeInterpSamplesLeft > 0) {
-			ch.activeRiseTime += ch.riseTimeStep;
-			ch.activeFallTime += ch.fallTimeStep;
-			ch.timeInterpSamplesLeft--;
-			if (ch.timeInterpSamplesLeft == 0) {
-				ch.activeRiseTime = ch.cachedRiseTime;
-				ch.activeFallTime = ch.cachedFallTime;
-			}
-		}
+		ch.riseTimeRamp.advance();
+		ch.fallTimeRamp.advance();
 	}
 
 	void publishPreviewState(PreviewSharedState& shared, float riseTime, float fallTime, float curveSigned, bool interactiveRecent) {
@@ -551,7 +548,7 @@ struct IntegralFlux : Module {
 		// - min dials at curve maximum ~1.0 kHz
 		const float minTime = OUTER_MIN_TIME;
 		// Absolute floor allows EXP/positive CV to run faster than the linear baseline.
-		const float absoluteMinTime = 0.0001f;
+		const float absoluteMinTime = audioRateCycle ? OUTER_AUDIO_MIN_TIME : 0.0001f;
 		const float maxTime = 1500.f;
 		// Use a curved knob law so noon timing tracks measured hardware behavior.
 		// With this exponent, knob=0.5 is ~23x slower than knob=0 (not ~1400x).
@@ -572,6 +569,40 @@ struct IntegralFlux : Module {
 		return clamp(t, absoluteMinTime, maxTime);
 	}
 
+	bool previewSettled(const PreviewUpdateState& state, float riseTime, float fallTime, float curveSigned) const {
+		return state.sentOnce && state.interactiveHold <= 0.f && !previewChangedMeaningfully(
+			riseTime, state.lastRiseSent,
+			fallTime, state.lastFallSent,
+			curveSigned, state.lastCurveSent
+		);
+	}
+
+	void updateQuiescence(OuterChannelState& ch, const OuterChannelConfig& cfg, bool settled) {
+		ch.quiescence.update(settled, sleepWhenIdle, inputs[cfg.signalInput].isConnected());
+	}
+
+	bool pollQuiescentChannel(OuterChannelState& ch, const OuterChannelConfig& cfg) {
+		// Returns true while the channel may keep sleeping. Edges and patch changes are
+		// checked every sample; anything that would move the output wakes it immediately.
+		bool immediateWake = !sleepWhenIdle
+			|| ch.cycleLatched
+			|| !ch.stageTimeValid
+			|| channel_quiescence::schmittWouldChange(ch.cycleButtonEdge.isHigh(), params[cfg.cycleParam].getValue())
+			|| channel_quiescence::schmittWouldChange(ch.trigEdge.isHigh(), inputs[cfg.trigInput].getVoltage())
+			|| inputs[cfg.cycleCvInput].getVoltage() >= 2.5f;
+		bool signalPatched = inputs[cfg.signalInput].isConnected();
+		float signalIn = signalPatched ? inputs[cfg.signalInput].getVoltage() : 0.f;
+		return ch.quiescence.poll(immediateWake, signalPatched, signalIn, ch.out, TARGET_EPS, [&]() {
+			const control_acquisition::ControlBank<STAGE_CONTROL_SLOTS>& controls = ch.stageControls;
+			return controls.wouldChange(STAGE_RISE_KNOB, params[cfg.riseParam].getValue())
+				|| controls.wouldChange(STAGE_FALL_KNOB, params[cfg.fallParam].getValue())
+				|| controls.wouldChange(STAGE_SHAPE_KNOB, params[cfg.shapeParam].getValue())
+				|| controls.wouldChange(STAGE_RISE_CV, inputs[cfg.riseCvInput].getVoltage())
+				|| controls.wouldChange(STAGE_FALL_CV, inputs[cfg.fallCvInput].getVoltage())
+				|| controls.wouldChange(STAGE_BOTH_CV, inputs[cfg.bothCvInput].getVoltage());
+		});
+	}
+
 	void triggerOuterFunction(OuterChannelState& ch) {
 		// Trigger always starts a fresh rise phase.
 		ch.phase = OUTER_RISE;
@@ -608,71 +639,56 @@ struct IntegralFlux : Module {
 			ch.trigRearmSec = 1.f / std::max(OUTER_MAX_TRIGGER_HZ, 1.f);
 		}
 
-		float riseKnob = params[cfg.riseParam].getValue();
-		float fallKnob = params[cfg.fallParam].getValue();
-		float shape = params[cfg.shapeParam].getValue();
-		float riseCv = inputs[cfg.riseCvInput].getVoltage();
-		float fallCv = inputs[cfg.fallCvInput].getVoltage();
-		float bothCv = inputs[cfg.bothCvInput].getVoltage();
+		control_acquisition::ControlBank<STAGE_CONTROL_SLOTS>& controls = ch.stageControls;
 		if (!ch.stageTimeValid || timingTick) {
-			// Recompute times only when a relevant source changed.
-			bool stageTimeDirty = !ch.stageTimeValid
-				|| std::fabs(riseKnob - ch.cachedRiseKnob) > PARAM_CACHE_EPS
-				|| std::fabs(fallKnob - ch.cachedFallKnob) > PARAM_CACHE_EPS
-				|| std::fabs(shape - ch.cachedShape) > PARAM_CACHE_EPS
-				|| std::fabs(riseCv - ch.cachedRiseCv) > CV_CACHE_EPS
-				|| std::fabs(fallCv - ch.cachedFallCv) > CV_CACHE_EPS
-				|| std::fabs(bothCv - ch.cachedBothCv) > CV_CACHE_EPS;
-			if (stageTimeDirty) {
-				float bothScale = bothTimeScaleFromCv(bothCv);
-				float shapeTimeScale = computeShapeTimeScale(shape, cfg.logShapeTimeScaleLog2, cfg.expShapeTimeScaleLog2);
-				ch.cachedRiseTime = computeStageTime(
-					riseKnob,
-					riseCv,
+			// Controls are only read on timing ticks, and times are recomputed only when one moved.
+			if (!ch.stageTimeValid) {
+				controls.invalidate();
+			}
+			controls.acquire(STAGE_RISE_KNOB, params[cfg.riseParam].getValue());
+			controls.acquire(STAGE_FALL_KNOB, params[cfg.fallParam].getValue());
+			controls.acquire(STAGE_SHAPE_KNOB, params[cfg.shapeParam].getValue());
+			controls.acquire(STAGE_RISE_CV, inputs[cfg.riseCvInput].getVoltage());
+			controls.acquire(STAGE_FALL_CV, inputs[cfg.fallCvInput].getVoltage());
+			controls.acquire(STAGE_BOTH_CV, inputs[cfg.bothCvInput].getVoltage());
+			if (controls.anyDirty()) {
+				controls.clearDirty();
+				float bothScale = bothTimeScaleFromCv(controls.value(STAGE_BOTH_CV));
+				float shapeTimeScale = computeShapeTimeScale(
+					controls.value(STAGE_SHAPE_KNOB), cfg.logShapeTimeScaleLog2, cfg.expShapeTimeScaleLog2);
+				float riseTarget = computeStageTime(
+					controls.value(STAGE_RISE_KNOB),
+					controls.value(STAGE_RISE_CV),
 					bothScale,
 					shapeTimeScale
 				);
-				ch.cachedFallTime = computeStageTime(
-					fallKnob,
-					fallCv,
+				float fallTarget = computeStageTime(
+					controls.value(STAGE_FALL_KNOB),
+					controls.value(STAGE_FALL_CV),
 					bothScale,
 					shapeTimeScale
 				);
-				ch.cachedRiseKnob = riseKnob;
-				ch.cachedFallKnob = fallKnob;
-				ch.cachedShape = shape;
-				ch.cachedRiseCv = riseCv;
-				ch.cachedFallCv = fallCv;
-				ch.cachedBothCv = bothCv;
-				if (!ch.stageTimeValid) {
-					// Cold start: avoid interpolation artifacts.
-					ch.activeRiseTime = ch.cachedRiseTime;
-					ch.activeFallTime = ch.cachedFallTime;
-					ch.riseTimeStep = 0.f;
-					ch.fallTimeStep = 0.f;
-					ch.timeInterpSamplesLeft = 0;
-				}
-				else if (timingInterpolate && timingUpdateDiv > 1) {
-					// Interpolate timing across N samples to avoid sample-and-hold zipper tone.
-					ch.riseTimeStep = (ch.cachedRiseTime - ch.activeRiseTime) / float(timingUpdateDiv);
-					ch.fallTimeStep = (ch.cachedFallTime - ch.activeFallTime) / float(timingUpdateDiv);
-					ch.timeInterpSamplesLeft = timingUpdateDiv;
-				}
-				else {
-					ch.activeRiseTime = ch.cachedRiseTime;
-					ch.activeFallTime = ch.cachedFallTime;
-					ch.riseTimeStep = 0.f;
-					ch.fallTimeStep = 0.f;
-					ch.timeInterpSamplesLeft = 0;
-				}
+				// Interpolate timing across N samples to avoid sample-and-hold zipper tone;
+				// a cold start jumps straight to the targets to avoid interpolation artifacts.
+				int glideSamples = (ch.stageTimeValid && timingInterpolate) ? timingClock.divider : 1;
+				ch.riseTimeRamp.glide(riseTarget, glideSamples);
+				ch.fallTimeRamp.glide(fallTarget, glideSamples);
 				ch.stageTimeValid = true;
 			}
 		}
+		float riseKnob = controls.value(STAGE_RISE_KNOB);
+		float fallKnob = controls.value(STAGE_FALL_KNOB);
+		float shape = controls.value(STAGE_SHAPE_KNOB);
 		updateActiveStageTimes(ch);
-		float riseTime = ch.activeRiseTime;
-		float fallTime = ch.activeFallTime;
+		float riseTime = ch.riseTimeRamp.value;
+		float fallTime = ch.fallTimeRamp.value;
 		bool fgActive = (ch.phase != OUTER_IDLE);
-		if (trigAccepted) {
+		bool audioCycle = audioRateCycle && cycleOn;
+		if (audioCycle) {
+			// Audio-rate cycling only answers to the Nyquist-side ceiling.
+			enforceOuterSpeedLimit(riseTime, fallTime, 1.f / OUTER_AUDIO_MAX_CYCLE_HZ);
+		}
+		else if (trigAccepted) {
 			// External trigger may run faster than self-cycle, but with an explicit ceiling.
 			enforceOuterSpeedLimit(riseTime, fallTime, 1.f / std::max(OUTER_MAX_TRIGGER_HZ, 1.f));
 		}
@@ -696,13 +712,13 @@ struct IntegralFlux : Module {
 			shapeSigned,
 			dt
 		);
-		if (!ch.warpScaleValid || std::fabs(shapeSigned - ch.cachedShapeSigned) > 1e-4f) {
-			// Curve normalization changes only when shape changes.
+		if (!ch.warpCurveValid || std::fabs(shapeSigned - ch.cachedShapeSigned) > 1e-4f) {
+			// Curve constants change only when shape changes.
 			ch.cachedShapeSigned = shapeSigned;
-			ch.cachedWarpScale = slopeWarpScale(shapeSigned);
-			ch.warpScaleValid = true;
+			ch.warpCurve = segment_curve::makeWarpCurve(shapeSigned);
+			ch.warpCurveValid = true;
 		}
-		float scale = ch.cachedWarpScale;
+		const segment_curve::WarpCurve& curve = ch.warpCurve;
 
 		bool signalPatched = inputs[cfg.signalInput].isConnected();
 		float signalIn = signalPatched ? inputs[cfg.signalInput].getVoltage() : 0.f;
@@ -710,12 +726,15 @@ struct IntegralFlux : Module {
 			// Cycle retriggers as soon as the channel reaches idle.
 			triggerOuterFunction(ch);
 		}
+		if (!audioCycle) {
+			ch.oscRunning = false;
+		}
 		if (ch.phase != OUTER_IDLE) {
 			bool gateIsHigh = (ch.phase == cfg.gateHighPhase);
 			if (gateIsHigh != gateWasHigh) {
 				// Transition occurred at start-of-sample due to trigger/cycle state.
 				if (bandlimitedGateOutputs) {
-					insertGateTransition(ch, gateIsHigh, 1e-6f);
+					insertGateTransition(ch, cfg, gateIsHigh, 1e-6f);
 				}
 				else {
 					setGateStateImmediate(ch, gateIsHigh);
@@ -724,16 +743,47 @@ struct IntegralFlux : Module {
 		}
 		else if (!signalPatched && gateWasHigh) {
 			if (bandlimitedGateOutputs) {
-				insertGateTransition(ch, false, 1e-6f);
+				insertGateTransition(ch, cfg, false, 1e-6f);
 			}
 			else {
 				setGateStateImmediate(ch, false);
 			}
 		}
 
-		if (ch.phase != OUTER_IDLE) {
+		if (audioCycle) {
+			// Audio-rate core: the cycle is rendered straight from phase, two samples late so the
+			// peak and trough corners can be band-limited. Signal IN does not perturb it here.
+			float range = OUTER_V_MAX - OUTER_V_MIN;
+			float period = riseTime + fallTime;
+			float riseShare = riseTime / period;
+			if (!ch.oscRunning) {
+				// Pick up from wherever the function generator was.
+				float startPhase = (ch.phase == OUTER_FALL)
+					? riseShare + ch.phasePos * (1.f - riseShare)
+					: ch.phasePos * riseShare;
+				ch.osc.reset(startPhase, clamp((ch.out - OUTER_V_MIN) / range, 0.f, 1.f));
+				ch.oscRunning = true;
+			}
+			segment_oscillator::Frame frame = ch.osc.process(curve, riseShare, dt / period);
+			ch.out = OUTER_V_MIN + frame.level * range;
+			ch.phase = frame.rising ? OUTER_RISE : OUTER_FALL;
+			ch.phasePos = frame.rising
+				? frame.phase / riseShare
+				: (frame.phase - riseShare) / std::max(1.f - riseShare, 1e-6f);
+			ch.phasePos = clamp(ch.phasePos, 0.f, 1.f);
+			bool gateIsHigh = (ch.phase == cfg.gateHighPhase);
+			if (gateIsHigh != ch.gateState) {
+				float f = std::max(std::max(frame.peakFraction, frame.troughFraction), 1e-6f);
+				if (bandlimitedGateOutputs) {
+					insertGateTransition(ch, cfg, gateIsHigh, f);
+				}
+				else {
+					setGateStateImmediate(ch, gateIsHigh);
+				}
+			}
+		}
+		else if (ch.phase != OUTER_IDLE) {
 			// Function-generator integration path.
-			float s = shapeSigned;
 			float range = OUTER_V_MAX - OUTER_V_MIN;
 			float xIn = 0.f;
 			float injectAlpha = 0.f;
@@ -745,31 +795,36 @@ struct IntegralFlux : Module {
 				injectAlpha = OUTER_INJECT_GAIN * clamp(a, 0.f, 1.f);
 			}
 
+			// Time left in this sample for the fall, shortened when the rise ends mid-sample.
+			float fallDt = dt;
 			if (ch.phase == OUTER_RISE) {
 				float dpPhase = dt / riseTime;
 				ch.phasePos += dpPhase;
 				float x = clamp((ch.out - OUTER_V_MIN) / range, 0.f, 1.f);
-				float dp = clamp(dt / riseTime, 0.f, 0.5f);
-				x += dp * slopeWarp(x, s) * scale;
+				// Step along the closed-form curve from wherever the level sits now, so any
+				// step size stays on the curve and the end of the segment is known exactly.
+				float travel = segment_curve::warpTravel(curve, x) + dpPhase;
+				x = segment_curve::warpLevel(curve, travel);
 				if (injectAlpha > 0.f) {
 					// Hardware-like perturbation: gently pull active FG state toward input.
 					x += injectAlpha * (xIn - x);
 				}
 				x = clamp(x, 0.f, 1.f);
 				ch.out = OUTER_V_MIN + x * range;
-				if (ch.phasePos >= 1.f || x >= 1.f) {
-					// Preserve fractional overshoot so rise->fall transition remains sample-rate robust.
-					float f = phaseCrossingFraction(ch.phasePos, dpPhase);
-					float overshoot = std::max(ch.phasePos - 1.f, 0.f);
-					ch.phasePos = overshoot * (riseTime / std::max(fallTime, 1e-6f));
+				if (ch.phasePos >= 1.f || travel >= 1.f || x >= 1.f) {
+					// Whichever of time or level reached the end first sets the crossing; the
+					// rest of the sample goes to the fall so the peak stays sample-rate robust.
+					float f = std::min(phaseCrossingFraction(ch.phasePos, dpPhase), phaseCrossingFraction(travel, dpPhase));
+					fallDt = (1.f - f) * dt;
+					ch.phasePos = 0.f;
 					ch.phase = OUTER_FALL;
 					float prevOut = ch.out;
 					ch.out = OUTER_V_MAX;
 					if (bandlimitedSignalOutputs) {
-						insertSignalTransition(ch, ch.out - prevOut, f);
+						insertSignalTransition(cfg, ch.out - prevOut, f);
 					}
 					if (bandlimitedGateOutputs) {
-						insertGateTransition(ch, ch.phase == cfg.gateHighPhase, f);
+						insertGateTransition(ch, cfg, ch.phase == cfg.gateHighPhase, f);
 					}
 					else {
 						setGateStateImmediate(ch, ch.phase == cfg.gateHighPhase);
@@ -778,27 +833,28 @@ struct IntegralFlux : Module {
 			}
 
 			if (ch.phase == OUTER_FALL) {
-				float dpPhase = dt / fallTime;
+				float dpPhase = fallDt / fallTime;
 				ch.phasePos += dpPhase;
 				float x = clamp((ch.out - OUTER_V_MIN) / range, 0.f, 1.f);
-				float dp = clamp(dt / fallTime, 0.f, 0.5f);
-				x -= dp * slopeWarp(x, s) * scale;
+				float travel = 1.f - segment_curve::warpTravel(curve, x) + dpPhase;
+				x = segment_curve::warpLevel(curve, 1.f - travel);
 				if (injectAlpha > 0.f) {
 					x += injectAlpha * (xIn - x);
 				}
 				x = clamp(x, 0.f, 1.f);
 				ch.out = OUTER_V_MIN + x * range;
-				if (ch.phasePos >= 1.f || x <= 0.f) {
-					float f = phaseCrossingFraction(ch.phasePos, dpPhase);
+				if (ch.phasePos >= 1.f || travel >= 1.f || x <= 0.f) {
+					float f = std::min(phaseCrossingFraction(ch.phasePos, dpPhase), phaseCrossingFraction(travel, dpPhase));
+					f = 1.f - (1.f - f) * fallDt / dt;
 					ch.phasePos = 0.f;
 					ch.phase = OUTER_IDLE;
 					float prevOut = ch.out;
 					ch.out = OUTER_V_MIN;
 					if (bandlimitedSignalOutputs) {
-						insertSignalTransition(ch, ch.out - prevOut, f);
+						insertSignalTransition(cfg, ch.out - prevOut, f);
 					}
 					if (bandlimitedGateOutputs) {
-						insertGateTransition(ch, ch.phase == cfg.gateHighPhase, f);
+						insertGateTransition(ch, cfg, ch.phase == cfg.gateHighPhase, f);
 					}
 					else {
 						setGateStateImmediate(ch, ch.phase == cfg.gateHighPhase);
@@ -813,15 +869,14 @@ struct IntegralFlux : Module {
 				signalIn,
 				riseTime,
 				fallTime,
-				shapeSigned,
-				scale,
+				ch.warpCurve,
 				dt
 			);
 			ch.out = slewStep.out;
 			bool gateIsHigh = (cfg.gateHighPhase == OUTER_RISE) ? (slewStep.direction > 0) : (slewStep.direction < 0);
 			if (gateIsHigh != gateWasHigh) {
 				if (bandlimitedGateOutputs) {
-					insertGateTransition(ch, gateIsHigh, 1e-6f);
+					insertGateTransition(ch, cfg, gateIsHigh, 1e-6f);
 				}
 				else {
 					setGateStateImmediate(ch, gateIsHigh);
@@ -848,11 +903,24 @@ struct IntegralFlux : Module {
 
 		OuterChannelResult result;
 		result.cycleOn = cycleOn;
+		result.settled = !cycleOn
+			&& ch.phase == OUTER_IDLE
+			&& ch.slewDir == 0
+			&& !ch.gateState
+			&& ch.trigRearmSec <= 0.f
+			&& !ch.riseTimeRamp.gliding()
+			&& !ch.fallTimeRamp.gliding()
+			&& !blep.isActive(cfg.gateBlepLane)
+			&& !blep.isActive(cfg.signalBlepLane)
+			&& (!signalPatched || std::fabs(signalIn - ch.out) <= TARGET_EPS)
+			&& previewSettled(previewUpdateState, riseTime, fallTime, shapeSigned);
 		return result;
 	}
 
 	IntegralFlux() {
 		initKnobCurveLut();
+		configureStageControls(ch1);
+		configureStageControls(ch4);
 		config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 		configParam(ATTENUATE_1_PARAM, 0.f, 1.f, 0.5f, "CH1 attenuverter");
 		configParam(CYCLE_1_PARAM, 0.f, 1.f, 0.f, "CH1 cycle");
@@ -899,8 +967,10 @@ struct IntegralFlux : Module {
 		json_object_set_new(rootJ, "ch4CycleLatched", json_boolean(ch4.cycleLatched));
 		json_object_set_new(rootJ, "bandlimitedGateOutputs", json_boolean(bandlimitedGateOutputs));
 		json_object_set_new(rootJ, "bandlimitedSignalOutputs", json_boolean(bandlimitedSignalOutputs));
-		json_object_set_new(rootJ, "timingUpdateDiv", json_integer(timingUpdateDiv));
+		json_object_set_new(rootJ, "timingUpdateDiv", json_integer(timingClock.divider));
 		json_object_set_new(rootJ, "timingInterpolate", json_boolean(timingInterpolate));
+		json_object_set_new(rootJ, "sleepWhenIdle", json_boolean(sleepWhenIdle));
+		json_object_set_new(rootJ, "audioRateCycle", json_boolean(audioRateCycle));
 		return rootJ;
 	}
 
@@ -934,6 +1004,16 @@ struct IntegralFlux : Module {
 		if (timingInterpJ) {
 			timingInterpolate = json_boolean_value(timingInterpJ);
 		}
+
+		json_t* sleepJ = json_object_get(rootJ, "sleepWhenIdle");
+		if (sleepJ) {
+			sleepWhenIdle = json_boolean_value(sleepJ);
+		}
+
+		json_t* audioRateJ = json_object_get(rootJ, "audioRateCycle");
+		if (audioRateJ) {
+			setAudioRateCycle(json_boolean_value(audioRateJ));
+		}
 	}
 
 	void process(const ProcessArgs& args) override {
@@ -951,7 +1031,9 @@ struct IntegralFlux : Module {
 			CH1_CYCLE_CV_INPUT,
 			std::log2(OUTER_LOG_SHAPE_SCALE),  // Shared CH1/CH4 low-curve timing scale.
 			std::log2(OUTER_EXP_SHAPE_SCALE),  // Shared CH1/CH4 high-curve timing scale.
-			OUTER_FALL
+			OUTER_FALL,
+			BLEP_CH1_GATE_LANE,
+			BLEP_CH1_SIGNAL_LANE
 		};
 		static const OuterChannelConfig ch4Cfg {
 			CYCLE_4_PARAM,
@@ -966,21 +1048,13 @@ struct IntegralFlux : Module {
 			CH4_CYCLE_CV_INPUT,
 			std::log2(OUTER_LOG_SHAPE_SCALE),  // Shared CH1/CH4 low-curve timing scale.
 			std::log2(OUTER_EXP_SHAPE_SCALE),  // Shared CH1/CH4 high-curve timing scale.
-			OUTER_RISE
+			OUTER_RISE,
+			BLEP_CH4_GATE_LANE,
+			BLEP_CH4_SIGNAL_LANE
 		};
 
-		bool timingTick = true;
-		if (timingUpdateDiv > 1) {
-			// Control-rate timing update option reduces CPU when heavy CV modulation is present.
-			timingUpdateCounter++;
-			if (timingUpdateCounter >= timingUpdateDiv) {
-				timingUpdateCounter = 0;
-				timingTick = true;
-			}
-			else {
-				timingTick = false;
-			}
-		}
+		// Control-rate timing update option reduces CPU when heavy CV modulation is present.
+		bool timingTick = timingClock.tick();
 		lightUpdateTimer += args.sampleTime;
 		bool lightTick = false;
 		if (lightUpdateTimer >= LIGHT_UPDATE_INTERVAL) {
@@ -992,10 +1066,21 @@ struct IntegralFlux : Module {
 		}
 		OuterChannelResult ch1Result;
 		OuterChannelResult ch4Result;
-		ch1Result = processOuterChannel(args, ch1, ch1Cfg, previewCh1, previewUpdateCh1, timingTick);
-		ch4Result = processOuterChannel(args, ch4, ch4Cfg, previewCh4, previewUpdateCh4, timingTick);
-		float ch1OutRendered = ch1.out + (bandlimitedSignalOutputs ? ch1.signalBlep.process() : 0.f);
-		float ch4OutRendered = ch4.out + (bandlimitedSignalOutputs ? ch4.signalBlep.process() : 0.f);
+		// Sleeping channels hold their settled output.
+		bool ch1Awake = !ch1.quiescence.quiescent || !pollQuiescentChannel(ch1, ch1Cfg);
+		bool ch4Awake = !ch4.quiescence.quiescent || !pollQuiescentChannel(ch4, ch4Cfg);
+		if (ch1Awake) {
+			ch1Result = processOuterChannel(args, ch1, ch1Cfg, previewCh1, previewUpdateCh1, timingTick);
+			updateQuiescence(ch1, ch1Cfg, ch1Result.settled);
+		}
+		if (ch4Awake) {
+			ch4Result = processOuterChannel(args, ch4, ch4Cfg, previewCh4, previewUpdateCh4, timingTick);
+			updateQuiescence(ch4, ch4Cfg, ch4Result.settled);
+		}
+		// One row read covers both channels' gate and signal residue; an empty bank returns at once.
+		blep.process();
+		float ch1OutRendered = ch1.out + (bandlimitedSignalOutputs ? blep.residue(BLEP_CH1_SIGNAL_LANE) : 0.f);
+		float ch4OutRendered = ch4.out + (bandlimitedSignalOutputs ? blep.residue(BLEP_CH4_SIGNAL_LANE) : 0.f);
 		// Variable outputs are attenuverters; unity outputs bypass this scaling.
 		float ch1Var = clamp(ch1OutRendered * attenuverterGain(params[ATTENUATE_1_PARAM].getValue()), -10.f, 10.f);
 		float ch2In = inputs[INPUT_2_INPUT].isConnected() ? inputs[INPUT_2_INPUT].getVoltage() : 10.f;
@@ -1003,8 +1088,8 @@ struct IntegralFlux : Module {
 		float ch3In = inputs[INPUT_3_INPUT].isConnected() ? inputs[INPUT_3_INPUT].getVoltage() : 5.f;
 		float ch3Var = clamp(ch3In * attenuverterGain(params[ATTENUATE_3_PARAM].getValue()), -10.f, 10.f);
 		float ch4Var = clamp(ch4OutRendered * attenuverterGain(params[ATTENUATE_4_PARAM].getValue()), -10.f, 10.f);
-		float eorOut = (ch1.gateState ? 10.f : 0.f) + (bandlimitedGateOutputs ? ch1.gateBlep.process() : 0.f);
-		float eocOut = (ch4.gateState ? 10.f : 0.f) + (bandlimitedGateOutputs ? ch4.gateBlep.process() : 0.f);
+		float eorOut = (ch1.gateState ? 10.f : 0.f) + (bandlimitedGateOutputs ? blep.residue(BLEP_CH1_GATE_LANE) : 0.f);
+		float eocOut = (ch4.gateState ? 10.f : 0.f) + (bandlimitedGateOutputs ? blep.residue(BLEP_CH4_GATE_LANE) : 0.f);
 		bool eorHigh = ch1.gateState;
 		bool eocHigh = ch4.gateState;
 		float sumOut = 0.f;
@@ -1092,203 +1177,24 @@ struct BananutBlack : app::SvgPort {
 	}
 };
 
-struct WavePreviewWidget : Widget {
-	static constexpr int POINT_COUNT = 320;
-	static constexpr int PREVIEW_LUT_SIZE = 1024;
-	static constexpr float CENTER_LINE_WIDTH = 1.0f;
-	static constexpr float WAVE_LINE_WIDTH = 1.4f;
-	static constexpr float WAVE_EDGE_PAD = 1.0f;
-	static constexpr float DOT_RADIUS = 2.1f;
-	static constexpr float DOT_SHOW_MAX_HZ = 2.0f;
-	static constexpr float DOT_HIDE_MIN_HZ = 2.4f;
-	static constexpr float LABEL_FONT_SIZE = 11.5f;
+struct FluxWavePreview : WavePreviewWidget {
 	int channel = 1;
-	std::array<Vec, POINT_COUNT> points {};
-	uint32_t lastVersion = 0;
-	bool pointsValid = false;
-	float lastFreqHz = 100.f;
-	float dotXNorm = 0.f;
-	float dotYNorm = 0.f;
-	bool dotVisible = false;
-
-	WavePreviewWidget(int channel) {
-		this->channel = channel;
-	}
-
-	static void buildSegmentLut(std::array<float, PREVIEW_LUT_SIZE>& lut, float curveSigned, bool rising) {
-		// Build once per preview update. Midpoint integration reduces visual artifacts at extreme curve asymmetry.
-		float scale = IntegralFlux::slopeWarpScale(curveSigned);
-		float dp = 1.f / float(PREVIEW_LUT_SIZE - 1);
-		float x = rising ? 0.f : 1.f;
-		lut[0] = x;
-		for (int i = 1; i < PREVIEW_LUT_SIZE; ++i) {
-			float k1 = IntegralFlux::slopeWarp(x, curveSigned) * scale;
-			float xMid = rising ? (x + 0.5f * dp * k1) : (x - 0.5f * dp * k1);
-			xMid = clamp(xMid, 0.f, 1.f);
-			float k2 = IntegralFlux::slopeWarp(xMid, curveSigned) * scale;
-			x += rising ? (dp * k2) : (-dp * k2);
-			x = clamp(x, 0.f, 1.f);
-			lut[i] = x;
-		}
-		lut.front() = rising ? 0.f : 1.f;
-		lut.back() = rising ? 1.f : 0.f;
-	}
-
-	static float sampleSegmentLut(const std::array<float, PREVIEW_LUT_SIZE>& lut, float t) {
-		t = clamp(t, 0.f, 1.f);
-		float idx = t * float(PREVIEW_LUT_SIZE - 1);
-		int i0 = int(idx);
-		int i1 = std::min(i0 + 1, PREVIEW_LUT_SIZE - 1);
-		float f = idx - float(i0);
-		return lut[i0] + (lut[i1] - lut[i0]) * f;
-	}
-
-	void rebuildPoints(float riseTime, float fallTime, float curveSigned, bool interactiveRecent) {
-		float w = std::max(box.size.x, 1.f);
-		float h = std::max(box.size.y, 1.f);
-		float drawPad = 0.5f * WAVE_LINE_WIDTH + WAVE_EDGE_PAD;
-		float left = drawPad;
-		float top = drawPad;
-		float right = std::max(left + 1.f, w - drawPad);
-		float bottom = std::max(top + 1.f, h - drawPad);
-		float drawW = right - left;
-		float drawH = bottom - top;
-		// The preview always shows exactly one full rise+fall cycle across widget width.
-		float totalTime = std::max(riseTime + fallTime, 1e-6f);
-		float riseRatio = riseTime / totalTime;
-		float peakX = left + riseRatio * drawW;
-		float riseWidth = std::max(peakX - left, 1e-4f);
-		float fallWidth = std::max(right - peakX, 1e-4f);
-		// Reserved hook if we later render interactive-state emphasis.
-		(void) interactiveRecent;
-		std::array<float, PREVIEW_LUT_SIZE> riseLut {};
-		std::array<float, PREVIEW_LUT_SIZE> fallLut {};
-		buildSegmentLut(riseLut, curveSigned, true);
-		buildSegmentLut(fallLut, curveSigned, false);
-
-		for (int i = 0; i < POINT_COUNT; ++i) {
-			float xNorm = float(i) / float(POINT_COUNT - 1);
-			float x = left + xNorm * drawW;
-			float y = -1.f;
-			if (x <= peakX) {
-				float t = (x - left) / riseWidth;
-				float v = sampleSegmentLut(riseLut, t);
-				y = -1.f + 2.f * v;
-			}
-			else {
-				float t = (x - peakX) / fallWidth;
-				float v = sampleSegmentLut(fallLut, t);
-				y = -1.f + 2.f * v;
-			}
-			float py = top + (0.5f - 0.5f * y) * drawH;
-			py = clamp(py, top, bottom);
-			points[i] = Vec(x, py);
-		}
 
-		int peakIndex = int(std::round(riseRatio * float(POINT_COUNT - 1)));
-		peakIndex = std::max(0, std::min(POINT_COUNT - 1, peakIndex));
-		float peakPx = left + (float(peakIndex) / float(POINT_COUNT - 1)) * drawW;
-		points[peakIndex] = Vec(peakPx, top);
-		points.front() = Vec(left, bottom);
-		points.back() = Vec(right, bottom);
-		pointsValid = true;
+	FluxWavePreview(int channel) {
+		this->channel = channel;
 	}
 
-	void step() override {
-		Widget::step();
+	bool readPreviewState(WavePreviewState& state) override {
 		IntegralFlux* modulePtr = nullptr;
 		if (ModuleWidget* moduleWidget = getAncestorOfType<ModuleWidget>()) {
 			modulePtr = moduleWidget->getModule<IntegralFlux>();
 		}
 		if (!modulePtr) {
-			if (!pointsValid) {
-				rebuildPoints(0.01f, 0.01f, 0.f, false);
-			}
-			return;
-		}
-		float riseTime = 0.01f;
-		float fallTime = 0.01f;
-		float curveSigned = 0.f;
-		float previewDotXNorm = 0.f;
-		float previewDotYNorm = 0.f;
-		bool previewDotVisible = false;
-		bool interactiveRecent = false;
-		uint32_t version = 0;
-		modulePtr->getPreviewState(channel, riseTime, fallTime, curveSigned, previewDotXNorm, previewDotYNorm,
-			previewDotVisible, interactiveRecent, version);
-		dotXNorm = previewDotXNorm;
-		dotYNorm = previewDotYNorm;
-		// Displayed frequency reflects the currently effective cycle period.
-		lastFreqHz = 1.f / std::max(riseTime + fallTime, 1e-6f);
-		if (lastFreqHz >= DOT_HIDE_MIN_HZ) {
-			dotVisible = false;
-		} else if (lastFreqHz <= DOT_SHOW_MAX_HZ) {
-			dotVisible = previewDotVisible;
-		}
-		if (!pointsValid || version != lastVersion) {
-			rebuildPoints(riseTime, fallTime, curveSigned, interactiveRecent);
-			lastVersion = version;
-		}
-	}
-
-	void draw(const DrawArgs& args) override {
-		nvgSave(args.vg);
-		nvgScissor(args.vg, 0.f, 0.f, box.size.x, box.size.y);
-
-		if (pointsValid) {
-			nvgBeginPath(args.vg);
-			nvgMoveTo(args.vg, points[0].x, points[0].y);
-			for (int i = 1; i < POINT_COUNT; ++i) {
-				nvgLineTo(args.vg, points[i].x, points[i].y);
-			}
-			nvgStrokeColor(args.vg, nvgRGBA(230, 230, 220, 255));
-			nvgStrokeWidth(args.vg, WAVE_LINE_WIDTH);
-			nvgLineCap(args.vg, NVG_BUTT);
-			nvgLineJoin(args.vg, NVG_ROUND);
-			nvgStroke(args.vg);
-		}
-		if (pointsValid && dotVisible) {
-			float w = std::max(box.size.x, 1.f);
-			float drawPad = 0.5f * WAVE_LINE_WIDTH + WAVE_EDGE_PAD;
-			float left = drawPad;
-			float right = std::max(left + 1.f, w - drawPad);
-			float drawW = right - left;
-			float x = left + clamp(dotXNorm, 0.f, 1.f) * drawW;
-			float idx = clamp(dotXNorm, 0.f, 1.f) * float(POINT_COUNT - 1);
-			int i0 = clamp(int(std::floor(idx)), 0, POINT_COUNT - 1);
-			int i1 = std::min(i0 + 1, POINT_COUNT - 1);
-			float f = idx - float(i0);
-			float y = points[i0].y + (points[i1].y - points[i0].y) * f;
-			nvgBeginPath(args.vg);
-			nvgCircle(args.vg, x, y, DOT_RADIUS);
-			nvgFillColor(args.vg, nvgRGBA(255, 232, 72, 255));
-			nvgFill(args.vg);
-			nvgBeginPath(args.vg);
-			nvgCircle(args.vg, x, y, DOT_RADIUS + 0.55f);
-			nvgStrokeWidth(args.vg, 0.9f);
-			nvgStrokeColor(args.vg, nvgRGBA(0, 0, 0, 220));
-			nvgStroke(args.vg);
-		}
-
-		nvgResetScissor(args.vg);
-		nvgRestore(args.vg);
-
-		char freqText[32];
-		if (lastFreqHz < 1.f) {
-			std::snprintf(freqText, sizeof(freqText), "%4.0f mHz", lastFreqHz * 1000.f);
-		}
-		else if (lastFreqHz >= 1000.f) {
-			std::snprintf(freqText, sizeof(freqText), "%4.2f kHz", lastFreqHz / 1000.f);
-		}
-		else {
-			std::snprintf(freqText, sizeof(freqText), "%5.1f Hz", lastFreqHz);
+			return false;
 		}
-		nvgFontSize(args.vg, LABEL_FONT_SIZE);
-		nvgFontFaceId(args.vg, APP->window->uiFont->handle);
-		nvgFillColor(args.vg, nvgRGBA(255, 255, 255, 255));
-		nvgTextAlign(args.vg, NVG_ALIGN_CENTER | NVG_ALIGN_TOP);
-		// Keep label outside preview box to avoid occluding waveform.
-		nvgText(args.vg, box.size.x * 0.5f, box.size.y + 1.5f, freqText, nullptr);
+		modulePtr->getPreviewState(channel, state.riseTime, state.fallTime, state.curveSigned, state.dotXNorm,
+			state.dotYNorm, state.dotVisible, state.interactiveRecent, state.version);
+		return true;
 	}
 };
 
@@ -1366,7 +1272,7 @@ struct IntegralFluxWidget : ModuleWidget {
 		addParam(createParamCentered<Davies1900hWhiteKnob>(mm2px(Vec(13.975, 50.526)), module, IntegralFlux::LIN_LOG_1_PARAM));
 		addParam(createParamCentered<Davies1900hWhiteKnob>(mm2px(Vec(91.716, 50.526)), module, IntegralFlux::LIN_LOG_4_PARAM));
 		{
-			WavePreviewWidget* ch1Preview = new WavePreviewWidget(1);
+			FluxWavePreview* ch1Preview = new FluxWavePreview(1);
 			math::Rect previewRectMm;
 			if (loadPreviewRectMm(panelPath, "CH1_PREVIEW", &previewRectMm)) {
 				previewRectMm = insetRectMm(previewRectMm, 0.2f);
@@ -1380,7 +1286,7 @@ struct IntegralFluxWidget : ModuleWidget {
 			addChild(ch1Preview);
 		}
 		{
-			WavePreviewWidget* ch4Preview = new WavePreviewWidget(4);
+			FluxWavePreview* ch4Preview = new FluxWavePreview(4);
 			math::Rect previewRectMm;
 			if (loadPreviewRectMm(panelPath, "CH4_PREVIEW", &previewRectMm)) {
 				previewRectMm = insetRectMm(previewRectMm, 0.2f);
@@ -1445,13 +1351,18 @@ struct IntegralFluxWidget : ModuleWidget {
 			menu->addChild(createMenuLabel("Performance"));
 			menu->addChild(createBoolPtrMenuItem("Bandlimited EOR/EOC", "", &maths->bandlimitedGateOutputs));
 			menu->addChild(createBoolPtrMenuItem("Bandlimited CH1/CH4 Signal Outputs", "", &maths->bandlimitedSignalOutputs));
+			menu->addChild(createBoolPtrMenuItem("Sleep Idle CH1/CH4", "", &maths->sleepWhenIdle));
 			menu->addChild(createMenuLabel("Rate Control"));
+			menu->addChild(createBoolMenuItem("Audio-Rate Cycle CH1/CH4", "",
+				[=]() { return maths->audioRateCycle; },
+				[=](bool enabled) { maths->setAudioRateCycle(enabled); }
+			));
 			menu->addChild(createBoolPtrMenuItem("Interpolate Timing Updates", "", &maths->timingInterpolate));
 			menu->addChild(createSubmenuItem("Timing Update Rate", "",
 				[=](Menu* submenu) {
 					auto addDivItem = [=](int div, std::string label) {
 						submenu->addChild(createCheckMenuItem(label, "",
-							[=]() { return maths->timingUpdateDiv == div; },
+							[=]() { return maths->timingClock.divider == div; },
 							[=]() { maths->setTimingUpdateDiv(div); }
 						));
 					};
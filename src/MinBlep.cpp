@@ -0,0 +1,108 @@
+#include "MinBlep.hpp"
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+namespace min_blep {
+
+namespace {
+
+typedef std::complex<double> Complex;
+
+void fft(std::vector<Complex>& x, bool inverse) {
+	// Iterative radix-2; sizes here are always powers of two.
+	size_t n = x.size();
+	for (size_t i = 1, j = 0; i < n; ++i) {
+		size_t bit = n >> 1;
+		for (; j & bit; bit >>= 1) {
+			j ^= bit;
+		}
+		j ^= bit;
+		if (i < j) {
+			std::swap(x[i], x[j]);
+		}
+	}
+	for (size_t len = 2; len <= n; len <<= 1) {
+		double angle = 2.0 * M_PI / double(len) * (inverse ? 1.0 : -1.0);
+		Complex wLen(std::cos(angle), std::sin(angle));
+		for (size_t i = 0; i < n; i += len) {
+			Complex w(1.0, 0.0);
+			for (size_t k = 0; k < len / 2; ++k) {
+				Complex u = x[i + k];
+				Complex v = x[i + k + len / 2] * w;
+				x[i + k] = u + v;
+				x[i + k + len / 2] = u - v;
+				w *= wLen;
+			}
+		}
+	}
+	if (inverse) {
+		for (size_t i = 0; i < n; ++i) {
+			x[i] /= double(n);
+		}
+	}
+}
+
+} // namespace
+
+void minBlepStep(int z, int o, float* out) {
+	int n = 2 * z * o;
+	std::vector<Complex> x(n);
+	// Blackman-Harris windowed sinc with z zero crossings per side.
+	for (int i = 0; i < n; ++i) {
+		double p = -double(z) + 2.0 * double(z) * double(i) / double(n - 1);
+		double sinc = (std::fabs(p) < 1e-12) ? 1.0 : std::sin(M_PI * p) / (M_PI * p);
+		double w = 2.0 * M_PI * double(i) / double(n - 1);
+		double window = 0.35875 - 0.48829 * std::cos(w) + 0.14128 * std::cos(2.0 * w) - 0.01168 * std::cos(3.0 * w);
+		x[i] = Complex(sinc * window, 0.0);
+	}
+	// Real cepstrum, folded so the rebuilt impulse is minimum phase.
+	fft(x, false);
+	for (int i = 0; i < n; ++i) {
+		x[i] = Complex(std::log(std::fmax(std::abs(x[i]), 1e-20)), 0.0);
+	}
+	fft(x, true);
+	for (int i = 1; i < n / 2; ++i) {
+		x[i] *= 2.0;
+	}
+	for (int i = n / 2 + 1; i < n; ++i) {
+		x[i] = 0.0;
+	}
+	fft(x, false);
+	for (int i = 0; i < n; ++i) {
+		x[i] = std::exp(x[i]);
+	}
+	fft(x, true);
+	// Integrate the impulse into a step that settles at exactly 1.
+	double total = 0.0;
+	std::vector<double> step(n);
+	for (int i = 0; i < n; ++i) {
+		total += x[i].real();
+		step[i] = total;
+	}
+	for (int i = 0; i < n; ++i) {
+		out[i] = float(step[i] / total);
+	}
+}
+
+const ResidualTable& sharedResidualTable() {
+	// Function-local static: built once, thread-safe initialization.
+	static const ResidualTable table = [] {
+		ResidualTable t;
+		minBlepStep(ZERO_CROSSINGS, OVERSAMPLE, t.linear);
+		t.linear[TABLE_SIZE - 1] = 1.f;
+		for (int i = 0; i < TABLE_SIZE; ++i) {
+			t.linear[i] -= 1.f;
+		}
+		for (int phase = 0; phase <= OVERSAMPLE; ++phase) {
+			for (int j = 0; j < TAPS; ++j) {
+				t.rows[phase][j] = t.linear[j * OVERSAMPLE + phase];
+			}
+		}
+		return t;
+	}();
+	return table;
+}
+
+} // namespace min_blep
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+
+// Band-limited step correction shared by Proc and IntegralFlux. One process-wide
+// minimum-phase residual table feeds lane-packed residue banks, so every output's
+// pending correction advances with a single row copy and idle banks cost nothing.
+namespace min_blep {
+
+static constexpr int ZERO_CROSSINGS = 16;
+static constexpr int OVERSAMPLE = 16;
+// Samples of residue left behind by one discontinuity.
+static constexpr int TAPS = 2 * ZERO_CROSSINGS;
+static constexpr int TABLE_SIZE = TAPS * OVERSAMPLE + 1;
+
+struct ResidualTable {
+	// MinBLEP step minus the ideal step, going from -1 to 0 over TAPS samples.
+	float linear[TABLE_SIZE];
+	// Same data transposed so each sub-sample phase is one contiguous kernel row.
+	float rows[OVERSAMPLE + 1][TAPS];
+};
+
+// Minimum-phase band-limited step (windowed sinc, cepstral minimum phase,
+// integrated and normalized to end at 1). `out` must hold `2 * z * o` values.
+void minBlepStep(int z, int o, float* out);
+
+// Returns the shared table, building it on first use. Safe from any thread, but the
+// first call runs FFTs and allocates, so banks make it when they are constructed.
+const ResidualTable& sharedResidualTable();
+
+// Writes the residue of a `step` discontinuity at `p` in (-1, 0] samples for the next TAPS samples.
+inline void residualKernel(const ResidualTable& table, float p, float step, float* out) {
+	float x = -p * float(OVERSAMPLE);
+	int i0 = int(x);
+	if (i0 >= OVERSAMPLE) {
+		i0 = OVERSAMPLE - 1;
+	}
+	float t = x - float(i0);
+	const float* a = table.rows[i0];
+	const float* b = table.rows[i0 + 1];
+	for (int j = 0; j < TAPS; ++j) {
+		out[j] = (a[j] + (b[j] - a[j]) * t) * step;
+	}
+}
+
+// Pending MinBLEP residue for LANES outputs (gates, signals, or polyphonic voices).
+// Each lane stamps when its residue runs out, and the bank counts down to the last
+// stamp; once nothing is outstanding process() returns straight away and every
+// residue() reads 0.
+template <int LANES>
+struct ResidualBank {
+	static_assert(LANES > 0 && LANES <= 32 && LANES % 4 == 0, "lanes must fill whole 4-wide vectors");
+	static_assert((TAPS & (TAPS - 1)) == 0, "residue ring must be a power of two");
+
+	// Ring of future samples; row `pos` is the next sample's residue for every lane.
+	alignas(16) float rows[TAPS][LANES] = {};
+	// Bound at construction, like Rack's MinBlepGenerator building its table in its
+	// constructor, so the first edge never builds it on the audio thread.
+	const ResidualTable* table = &sharedResidualTable();
+	alignas(16) float current[LANES] = {};
+	uint32_t laneEnd[LANES] = {};
+	uint32_t clock = 0;
+	int drainSamples = 0;
+	bool currentLive = false;
+	int pos = 0;
+
+	void insertDiscontinuity(int lane, float p, float step) {
+		// Same contract as Rack's MinBlepGenerator: p in (-1, 0] samples from the current sample.
+		if (!(p > -1.f && p <= 0.f) || lane < 0 || lane >= LANES) {
+			return;
+		}
+		float kernel[TAPS];
+		residualKernel(*table, p, step, kernel);
+		for (int j = 0; j < TAPS; ++j) {
+			rows[(pos + j) & (TAPS - 1)][lane] += kernel[j];
+		}
+		laneEnd[lane] = clock + uint32_t(TAPS);
+		drainSamples = TAPS;
+	}
+
+	void process() {
+		if (drainSamples == 0) {
+			if (currentLive) {
+				for (int l = 0; l < LANES; ++l) {
+					current[l] = 0.f;
+				}
+				currentLive = false;
+			}
+			return;
+		}
+		float* row = rows[pos];
+		for (int l = 0; l < LANES; ++l) {
+			current[l] = row[l];
+			row[l] = 0.f;
+		}
+		pos = (pos + 1) & (TAPS - 1);
+		clock++;
+		drainSamples--;
+		currentLive = true;
+	}
+
+	float residue(int lane) const {
+		return current[lane];
+	}
+
+	// True while the lane still has residue to emit (its stamp is 1..TAPS samples ahead).
+	bool isActive(int lane) const {
+		return uint32_t(laneEnd[lane] - clock) - 1u < uint32_t(TAPS);
+	}
+
+	uint32_t activeMask() const {
+		uint32_t mask = 0;
+		for (int l = 0; l < LANES; ++l) {
+			mask |= uint32_t(isActive(l)) << l;
+		}
+		return mask;
+	}
+
+	bool idle() const {
+		return drainSamples == 0 && !currentLive;
+	}
+
+	void reset() {
+		for (int j = 0; j < TAPS; ++j) {
+			for (int l = 0; l < LANES; ++l) {
+				rows[j][l] = 0.f;
+			}
+		}
+		for (int l = 0; l < LANES; ++l) {
+			current[l] = 0.f;
+			laneEnd[l] = 0;
+		}
+		clock = 0;
+		drainSamples = 0;
+		currentLive = false;
+		pos = 0;
+	}
+};
+
+} // namespace min_blep
@@ -1,5 +1,9 @@
 #include "plugin.hpp"
-#include <dsp/minblep.hpp>
+#include "WavePreviewWidget.hpp"
+#include "MinBlep.hpp"
+#include "SegmentOscillator.hpp"
+#include "ControlAcquisition.hpp"
+#include "ChannelQuiescence.hpp"
 #include <array>
 #include <cstdio>
 #include <atomic>
@@ -43,6 +47,12 @@ struct Proc : Module {
 		LIGHTS_LEN
 	};
 
+	enum BlepLane {
+		BLEP_EOR_LANE,
+		BLEP_EOC_LANE,
+		BLEP_SIGNAL_LANE
+	};
+
 	enum ChannelPhase {
 		// IDLE: no active function cycle unless cycle mode is engaged.
 		// RISE/FALL: function-generator mode integrates toward 8V then 0V.
@@ -51,14 +61,22 @@ struct Proc : Module {
 		CHANNEL_FALL
 	};
 
+	enum StageControlSlot {
+		STAGE_RISE_KNOB,
+		STAGE_FALL_KNOB,
+		STAGE_SHAPE_KNOB,
+		STAGE_RISE_CV,
+		STAGE_FALL_CV,
+		STAGE_BOTH_CV,
+		STAGE_CONTROL_SLOTS
+	};
+
 	struct ChannelState {
 		// Edge detectors for trigger input and momentary cycle button.
 		dsp::SchmittTrigger trigEdge;
 		dsp::SchmittTrigger cycleButtonEdge;
-		// Optional anti-alias compensation for hard output steps.
-		dsp::MinBlepGenerator<16, 16> eorGateBlep;
-		dsp::MinBlepGenerator<16, 16> eocGateBlep;
-		dsp::MinBlepGenerator<16, 16> signalBlep;
+		// Optional anti-alias compensation for hard output steps, one bank lane per output.
+		min_blep::ResidualBank<4> blep;
 
 		ChannelPhase phase = CHANNEL_IDLE;
 		// phasePos is a normalized [0..1+] phase accumulator for the active segment.
@@ -72,29 +90,24 @@ struct Proc : Module {
 		bool cycleLatched = false;
 		bool eorGateState = false;
 		bool eocGateState = false;
-		// Cached warp compensation for the current shape setting.
-		bool warpScaleValid = false;
+		// Closed-form curve constants for the current shape setting.
+		bool warpCurveValid = false;
 		float cachedShapeSigned = 0.f;
-		float cachedWarpScale = 1.f;
-		// Stage-time cache avoids recomputing expensive mapping every sample when unchanged.
+		segment_curve::WarpCurve warpCurve;
+		// Audio-rate cycle core, running while audioRateCycle and cycle are both on.
+		segment_oscillator::SegmentOscillator osc;
+		bool oscRunning = false;
+		// Stage-time controls latched at the timing update rate; times are recomputed only when one moves.
 		bool stageTimeValid = false;
-		float cachedRiseKnob = 0.f;
-		float cachedFallKnob = 0.f;
-		float cachedShape = 0.f;
-		float cachedRiseCv = 0.f;
-		float cachedFallCv = 0.f;
-		float cachedBothCv = 0.f;
-		float cachedRiseTime = 0.01f;
-		float cachedFallTime = 0.01f;
-		// Active times may interpolate toward cached targets at reduced timing update rates.
-		float activeRiseTime = 0.01f;
-		float activeFallTime = 0.01f;
+		control_acquisition::ControlBank<STAGE_CONTROL_SLOTS> stageControls;
+		// Active times may glide toward recomputed targets at reduced timing update rates.
+		control_acquisition::ControlRamp riseTimeRamp;
+		control_acquisition::ControlRamp fallTimeRamp;
 		// Trigger acceptance rearm timer for explicit max trigger rate behavior.
 		float trigRearmSec = 0.f;
-		float riseTimeStep = 0.f;
-		float fallTimeStep = 0.f;
-		int timeInterpSamplesLeft = 0;
 		float signalOutputGain = 1.f;
+		// Quiescent channels skip the DSP pipeline until an edge or control change wakes them.
+		channel_quiescence::ChannelQuiescence quiescence;
 	};
 
 	struct ChannelConfig {
@@ -116,6 +129,8 @@ struct Proc : Module {
 
 	struct ChannelResult {
 		bool cycleOn = false;
+		// Output, gates and preview are at rest and will stay there until an input changes.
+		bool settled = false;
 	};
 
 	struct SlewStepResult {
@@ -153,9 +168,10 @@ struct Proc : Module {
 	PreviewUpdateState previewUpdate;
 	bool bandlimitedGateOutputs = false;
 	bool bandlimitedSignalOutputs = true;
-	int timingUpdateDiv = 1;
-	int timingUpdateCounter = 0;
+	control_acquisition::ControlClock timingClock;
 	bool timingInterpolate = true;
+	bool sleepWhenIdle = true;
+	bool audioRateCycle = false;
 	// UI light updates are rate-limited to reduce engine overhead.
 	float lightUpdateTimer = 0.f;
 	static constexpr float LINEAR_SHAPE = 0.33f;
@@ -163,8 +179,6 @@ struct Proc : Module {
 	// Proc's free-running FG mode spans 0-10 V, while slew mode keeps the wider reference range.
 	static constexpr float FG_V_MAX = 10.f;
 	static constexpr float SLEW_REF_V_MAX = 10.2f;
-	static constexpr float WARP_K_MAX = 40.f;
-	static constexpr int WARP_SCALE_SAMPLES = 16;
 	static constexpr float PARAM_CACHE_EPS = 1e-4f;
 	static constexpr float CV_CACHE_EPS = 1e-3f;
 	static constexpr float TARGET_EPS = 1e-4f;
@@ -194,6 +208,9 @@ struct Proc : Module {
 	// Hardware-like FG ceilings.
 	static constexpr float MAX_CYCLE_HZ = 1000.f;
 	static constexpr float MAX_TRIGGER_HZ = 2000.f;
+	// Audio-rate cycling renders analytically with band-limited corners, so it may run far faster.
+	static constexpr float AUDIO_MAX_CYCLE_HZ = 20000.f;
+	static constexpr float AUDIO_MIN_STAGE_TIME = 0.00001f;
 	static constexpr float CV_OCT_CLAMP = 12.f;
 	static constexpr float STAGE_CV_OCT_PER_V = 0.5f;
 	static constexpr float PREVIEW_INTERACTIVE_INTERVAL = 1.f / 60.f;
@@ -244,38 +261,6 @@ struct Proc : Module {
 		return 0.f;
 	}
 
-	static float slopeWarp(float x, float s) {
-		// Differential warp used by both function-generator and slew modes.
-		// We shape local slope, then normalize total travel time with slopeWarpScale().
-		x = clamp(x, 0.f, 1.f);
-		float u = std::fabs(s);
-		if (u < 1e-6f) {
-			return 1.f;
-		}
-		float k = WARP_K_MAX * u;
-		float x2 = x * x;
-		if (s < 0.f) {
-			// LOG: fast near 0V, slow near top.
-			return 1.f / (1.f + k * x2);
-		}
-		// EXP: slow near 0V, fast near top.
-		return 1.f + k * x2;
-	}
-
-	static float slopeWarpScale(float s) {
-		// Numerically estimate scale so different curve settings keep similar segment duration.
-		// Integrates reciprocal slope over [0..1] with a small fixed sample count.
-		if (std::fabs(s) < 1e-6f) {
-			return 1.f;
-		}
-		float sum = 0.f;
-		for (int i = 0; i < WARP_SCALE_SAMPLES; ++i) {
-			float xi = (i + 0.5f) / float(WARP_SCALE_SAMPLES);
-			sum += 1.f / slopeWarp(xi, s);
-		}
-		return sum / float(WARP_SCALE_SAMPLES);
-	}
-
 	static float computeSegPhase(float out, float startOut, float invSpan) {
 		if (std::fabs(invSpan) < 1e-9f) {
 			return 1.f;
@@ -289,8 +274,7 @@ struct Proc : Module {
 		float in,
 		float riseTime,
 		float fallTime,
-		float shapeSigned,
-		float warpScale,
+		const segment_curve::WarpCurve& curve,
 		float dt
 	) {
 		// Shared "core limiter" path when the channel is acting as a slew on input signal.
@@ -330,22 +314,18 @@ struct Proc : Module {
 		stageTime = std::max(stageTime, 1e-6f);
 		float range = SLEW_REF_V_MAX - FUNCTION_V_MIN;
 		float x = computeSegPhase(out, ch.slewStartOut, ch.slewInvSpan);
-		float dp = clamp(dt / stageTime, 0.f, 0.5f);
-		float step = dp * slopeWarp(x, shapeSigned) * warpScale * range;
-
-		float prevOut = out;
-		float nextOut = out + ((delta > 0.f) ? step : -step);
-		if ((in - prevOut) * (in - nextOut) < 0.f) {
-			float denom = nextOut - prevOut;
-			if (std::fabs(denom) > 1e-9f) {
-				result.targetFraction = clamp((in - prevOut) / denom, 1e-6f, 1.f);
-			}
+		// The curve is drawn over the full reference range, so a shorter span is covered sooner.
+		float dp = clamp(dt / stageTime, 0.f, 0.5f) * range * std::fabs(ch.slewInvSpan);
+		float travel = segment_curve::warpTravel(curve, x) + dp;
+
+		if (travel >= 1.f) {
+			result.targetFraction = clamp(phaseCrossingFraction(travel, dp), 1e-6f, 1.f);
 			result.reachedTarget = true;
 			out = in;
 			ch.slewDir = 0;
 		}
 		else {
-			out = nextOut;
+			out = ch.slewStartOut + segment_curve::warpLevel(curve, travel) * (ch.slewTargetOut - ch.slewStartOut);
 			ch.slewDir = dir;
 		}
 		result.out = out;
@@ -361,7 +341,7 @@ struct Proc : Module {
 		return clamp(1.f - ((phasePos - 1.f) / dp), 0.f, 1.f);
 	}
 
-	static void insertGateTransition(dsp::MinBlepGenerator<16, 16>& blep, bool& state, bool newState, float fraction01) {
+	static void insertGateTransition(min_blep::ResidualBank<4>& blep, int lane, bool& state, bool newState, float fraction01) {
 		if (newState == state) {
 			return;
 		}
@@ -369,7 +349,7 @@ struct Proc : Module {
 		// Rack MinBLEP expects discontinuity position in [-1, 0] samples from current sample.
 		float p = f - 1.f;
 		float step = newState ? 10.f : -10.f;
-		blep.insertDiscontinuity(p, step);
+		blep.insertDiscontinuity(lane, p, step);
 		state = newState;
 	}
 
@@ -383,16 +363,31 @@ struct Proc : Module {
 		}
 		float f = clamp(fraction01, 1e-6f, 1.f);
 		float p = f - 1.f;
-		ch.signalBlep.insertDiscontinuity(p, step * ch.signalOutputGain);
+		ch.blep.insertDiscontinuity(BLEP_SIGNAL_LANE, p, step * ch.signalOutputGain);
 	}
 
 	void setTimingUpdateDiv(int div) {
 		// Changing update rate invalidates cached timing so the channel resyncs immediately.
-		timingUpdateDiv = std::max(1, div);
-		timingUpdateCounter = 0;
+		timingClock.setDivider(div);
+		channel.stageTimeValid = false;
+	}
+
+	void setAudioRateCycle(bool enabled) {
+		// The stage-time floor depends on the mode, so cached timing is rebuilt.
+		audioRateCycle = enabled;
 		channel.stageTimeValid = false;
 	}
 
+	void configureStageControls(ChannelState& ch) {
+		// Knob and CV hysteresis bands match the resolution each source can meaningfully resolve.
+		ch.stageControls.setThreshold(STAGE_RISE_KNOB, PARAM_CACHE_EPS);
+		ch.stageControls.setThreshold(STAGE_FALL_KNOB, PARAM_CACHE_EPS);
+		ch.stageControls.setThreshold(STAGE_SHAPE_KNOB, PARAM_CACHE_EPS);
+		ch.stageControls.setThreshold(STAGE_RISE_CV, CV_CACHE_EPS);
+		ch.stageControls.setThreshold(STAGE_FALL_CV, CV_CACHE_EPS);
+		ch.stageControls.setThreshold(STAGE_BOTH_CV, CV_CACHE_EPS);
+	}
+
 	void initKnobCurveLut() {
 		// Precompute knob taper to trade tiny memory for lower per-sample CPU.
 		for (int i = 0; i < KNOB_CURVE_LUT_SIZE; ++i) {
@@ -415,15 +410,8 @@ struct Proc : Module {
 
 	void updateActiveStageTimes(ChannelState& ch) {
 		// Optional de-zipper when timing is updated at control rate (/4, /8, ...).
-		if (ch.timeInterpSamplesLeft > 0) {
-			ch.activeRiseTime += ch.riseTimeStep;
-			ch.activeFallTime += ch.fallTimeStep;
-			ch.timeInterpSamplesLeft--;
-			if (ch.timeInterpSamplesLeft == 0) {
-				ch.activeRiseTime = ch.cachedRiseTime;
-				ch.activeFallTime = ch.cachedFallTime;
-			}
-		}
+		ch.riseTimeRamp.advance();
+		ch.fallTimeRamp.advance();
 	}
 
 	void publishPreviewState(PreviewSharedState& shared, float riseTime, float fallTime, float curveSigned, bool interactiveRecent) {
@@ -531,7 +519,7 @@ struct Proc : Module {
 		// - min dials at curve maximum ~1.0 kHz
 		const float minTime = MIN_STAGE_TIME;
 		// Absolute floor allows EXP/positive CV to run faster than the linear baseline.
-		const float absoluteMinTime = 0.0001f;
+		const float absoluteMinTime = audioRateCycle ? AUDIO_MIN_STAGE_TIME : 0.0001f;
 		const float maxTime = 1500.f;
 		// Use a curved knob law so noon timing tracks measured hardware behavior.
 		// With this exponent, knob=0.5 is ~23x slower than knob=0 (not ~1400x).
@@ -552,6 +540,40 @@ struct Proc : Module {
 		return clamp(t, absoluteMinTime, maxTime);
 	}
 
+	bool previewSettled(const PreviewUpdateState& state, float riseTime, float fallTime, float curveSigned) const {
+		return state.sentOnce && state.interactiveHold <= 0.f && !previewChangedMeaningfully(
+			riseTime, state.lastRiseSent,
+			fallTime, state.lastFallSent,
+			curveSigned, state.lastCurveSent
+		);
+	}
+
+	void updateQuiescence(ChannelState& ch, const ChannelConfig& cfg, bool settled) {
+		ch.quiescence.update(settled, sleepWhenIdle, inputs[cfg.signalInput].isConnected());
+	}
+
+	bool pollQuiescentChannel(ChannelState& ch, const ChannelConfig& cfg) {
+		// Returns true while the channel may keep sleeping. Edges and patch changes are
+		// checked every sample; anything that would move the output wakes it immediately.
+		bool immediateWake = !sleepWhenIdle
+			|| ch.cycleLatched
+			|| !ch.stageTimeValid
+			|| channel_quiescence::schmittWouldChange(ch.cycleButtonEdge.isHigh(), params[cfg.cycleParam].getValue())
+			|| channel_quiescence::schmittWouldChange(ch.trigEdge.isHigh(), inputs[cfg.trigInput].getVoltage())
+			|| inputs[cfg.haltInput].getVoltage() >= 2.5f;
+		bool signalPatched = inputs[cfg.signalInput].isConnected();
+		float signalIn = signalPatched ? inputs[cfg.signalInput].getVoltage() : 0.f;
+		return ch.quiescence.poll(immediateWake, signalPatched, signalIn, ch.out, TARGET_EPS, [&]() {
+			const control_acquisition::ControlBank<STAGE_CONTROL_SLOTS>& controls = ch.stageControls;
+			return controls.wouldChange(STAGE_RISE_KNOB, params[cfg.riseParam].getValue())
+				|| controls.wouldChange(STAGE_FALL_KNOB, params[cfg.fallParam].getValue())
+				|| controls.wouldChange(STAGE_SHAPE_KNOB, params[cfg.shapeParam].getValue())
+				|| controls.wouldChange(STAGE_RISE_CV, inputs[cfg.riseCvInput].getVoltage())
+				|| controls.wouldChange(STAGE_FALL_CV, inputs[cfg.fallCvInput].getVoltage())
+				|| controls.wouldChange(STAGE_BOTH_CV, inputs[cfg.bothCvInput].getVoltage());
+		});
+	}
+
 	void triggerFunction(ChannelState& ch) {
 		// Trigger always starts a fresh rise phase.
 		ch.phase = CHANNEL_RISE;
@@ -568,8 +590,8 @@ struct Proc : Module {
 	) {
 		auto updateGateOutputs = [&](bool eorHigh, bool eocHigh, float fraction01) {
 			if (bandlimitedGateOutputs) {
-				insertGateTransition(ch.eorGateBlep, ch.eorGateState, eorHigh, fraction01);
-				insertGateTransition(ch.eocGateBlep, ch.eocGateState, eocHigh, fraction01);
+				insertGateTransition(ch.blep, BLEP_EOR_LANE, ch.eorGateState, eorHigh, fraction01);
+				insertGateTransition(ch.blep, BLEP_EOC_LANE, ch.eocGateState, eocHigh, fraction01);
 			}
 			else {
 				setGateStateImmediate(ch.eorGateState, eorHigh);
@@ -598,71 +620,56 @@ struct Proc : Module {
 			ch.trigRearmSec = 1.f / std::max(MAX_TRIGGER_HZ, 1.f);
 		}
 
-		float riseKnob = params[cfg.riseParam].getValue();
-		float fallKnob = params[cfg.fallParam].getValue();
-		float shape = params[cfg.shapeParam].getValue();
-		float riseCv = inputs[cfg.riseCvInput].getVoltage();
-		float fallCv = inputs[cfg.fallCvInput].getVoltage();
-		float bothCv = inputs[cfg.bothCvInput].getVoltage();
+		control_acquisition::ControlBank<STAGE_CONTROL_SLOTS>& controls = ch.stageControls;
 		if (!ch.stageTimeValid || timingTick) {
-			// Recompute times only when a relevant source changed.
-			bool stageTimeDirty = !ch.stageTimeValid
-				|| std::fabs(riseKnob - ch.cachedRiseKnob) > PARAM_CACHE_EPS
-				|| std::fabs(fallKnob - ch.cachedFallKnob) > PARAM_CACHE_EPS
-				|| std::fabs(shape - ch.cachedShape) > PARAM_CACHE_EPS
-				|| std::fabs(riseCv - ch.cachedRiseCv) > CV_CACHE_EPS
-				|| std::fabs(fallCv - ch.cachedFallCv) > CV_CACHE_EPS
-				|| std::fabs(bothCv - ch.cachedBothCv) > CV_CACHE_EPS;
-			if (stageTimeDirty) {
-				float bothScale = bothTimeScaleFromCv(bothCv);
-				float shapeTimeScale = computeShapeTimeScale(shape, cfg.logShapeTimeScaleLog2, cfg.expShapeTimeScaleLog2);
-				ch.cachedRiseTime = computeStageTime(
-					riseKnob,
-					riseCv,
+			// Controls are only read on timing ticks, and times are recomputed only when one moved.
+			if (!ch.stageTimeValid) {
+				controls.invalidate();
+			}
+			controls.acquire(STAGE_RISE_KNOB, params[cfg.riseParam].getValue());
+			controls.acquire(STAGE_FALL_KNOB, params[cfg.fallParam].getValue());
+			controls.acquire(STAGE_SHAPE_KNOB, params[cfg.shapeParam].getValue());
+			controls.acquire(STAGE_RISE_CV, inputs[cfg.riseCvInput].getVoltage());
+			controls.acquire(STAGE_FALL_CV, inputs[cfg.fallCvInput].getVoltage());
+			controls.acquire(STAGE_BOTH_CV, inputs[cfg.bothCvInput].getVoltage());
+			if (controls.anyDirty()) {
+				controls.clearDirty();
+				float bothScale = bothTimeScaleFromCv(controls.value(STAGE_BOTH_CV));
+				float shapeTimeScale = computeShapeTimeScale(
+					controls.value(STAGE_SHAPE_KNOB), cfg.logShapeTimeScaleLog2, cfg.expShapeTimeScaleLog2);
+				float riseTarget = computeStageTime(
+					controls.value(STAGE_RISE_KNOB),
+					controls.value(STAGE_RISE_CV),
 					bothScale,
 					shapeTimeScale
 				);
-				ch.cachedFallTime = computeStageTime(
-					fallKnob,
-					fallCv,
+				float fallTarget = computeStageTime(
+					controls.value(STAGE_FALL_KNOB),
+					controls.value(STAGE_FALL_CV),
 					bothScale,
 					shapeTimeScale
 				);
-				ch.cachedRiseKnob = riseKnob;
-				ch.cachedFallKnob = fallKnob;
-				ch.cachedShape = shape;
-				ch.cachedRiseCv = riseCv;
-				ch.cachedFallCv = fallCv;
-				ch.cachedBothCv = bothCv;
-				if (!ch.stageTimeValid) {
-					// Cold start: avoid interpolation artifacts.
-					ch.activeRiseTime = ch.cachedRiseTime;
-					ch.activeFallTime = ch.cachedFallTime;
-					ch.riseTimeStep = 0.f;
-					ch.fallTimeStep = 0.f;
-					ch.timeInterpSamplesLeft = 0;
-				}
-				else if (timingInterpolate && timingUpdateDiv > 1) {
-					// Interpolate timing across N samples to avoid sample-and-hold zipper tone.
-					ch.riseTimeStep = (ch.cachedRiseTime - ch.activeRiseTime) / float(timingUpdateDiv);
-					ch.fallTimeStep = (ch.cachedFallTime - ch.activeFallTime) / float(timingUpdateDiv);
-					ch.timeInterpSamplesLeft = timingUpdateDiv;
-				}
-				else {
-					ch.activeRiseTime = ch.cachedRiseTime;
-					ch.activeFallTime = ch.cachedFallTime;
-					ch.riseTimeStep = 0.f;
-					ch.fallTimeStep = 0.f;
-					ch.timeInterpSamplesLeft = 0;
-				}
+				// Interpolate timing across N samples to avoid sample-and-hold zipper tone;
+				// a cold start jumps straight to the targets to avoid interpolation artifacts.
+				int glideSamples = (ch.stageTimeValid && timingInterpolate) ? timingClock.divider : 1;
+				ch.riseTimeRamp.glide(riseTarget, glideSamples);
+				ch.fallTimeRamp.glide(fallTarget, glideSamples);
 				ch.stageTimeValid = true;
 			}
 		}
+		float riseKnob = controls.value(STAGE_RISE_KNOB);
+		float fallKnob = controls.value(STAGE_FALL_KNOB);
+		float shape = controls.value(STAGE_SHAPE_KNOB);
 		updateActiveStageTimes(ch);
-		float riseTime = ch.activeRiseTime;
-		float fallTime = ch.activeFallTime;
+		float riseTime = ch.riseTimeRamp.value;
+		float fallTime = ch.fallTimeRamp.value;
 		bool fgActive = (ch.phase != CHANNEL_IDLE);
-		if (trigAccepted) {
+		bool audioCycle = audioRateCycle && cycleOn;
+		if (audioCycle) {
+			// Audio-rate cycling only answers to the Nyquist-side ceiling.
+			enforceSpeedLimit(riseTime, fallTime, 1.f / AUDIO_MAX_CYCLE_HZ);
+		}
+		else if (trigAccepted) {
 			// External trigger may run faster than self-cycle, but with an explicit ceiling.
 			enforceSpeedLimit(riseTime, fallTime, 1.f / std::max(MAX_TRIGGER_HZ, 1.f));
 		}
@@ -686,13 +693,13 @@ struct Proc : Module {
 			shapeSigned,
 			dt
 		);
-		if (!ch.warpScaleValid || std::fabs(shapeSigned - ch.cachedShapeSigned) > 1e-4f) {
-			// Curve normalization changes only when shape changes.
+		if (!ch.warpCurveValid || std::fabs(shapeSigned - ch.cachedShapeSigned) > 1e-4f) {
+			// Curve constants change only when shape changes.
 			ch.cachedShapeSigned = shapeSigned;
-			ch.cachedWarpScale = slopeWarpScale(shapeSigned);
-			ch.warpScaleValid = true;
+			ch.warpCurve = segment_curve::makeWarpCurve(shapeSigned);
+			ch.warpCurveValid = true;
 		}
-		float scale = ch.cachedWarpScale;
+		const segment_curve::WarpCurve& curve = ch.warpCurve;
 
 		float functionAmp = params[AMP_PARAM].getValue();
 		float functionAmpScale = functionAmp / FG_V_MAX;
@@ -708,6 +715,9 @@ struct Proc : Module {
 			result.cycleOn = cycleOn;
 			return result;
 		}
+		if (!audioCycle) {
+			ch.oscRunning = false;
+		}
 
 		if (ch.phase != CHANNEL_IDLE) {
 			bool eorGateIsHigh = (ch.phase == cfg.gateHighPhase);
@@ -718,10 +728,34 @@ struct Proc : Module {
 			updateGateOutputs(false, false, 1e-6f);
 		}
 
-		if (ch.phase != CHANNEL_IDLE) {
+		if (audioCycle) {
+			// Audio-rate core: the cycle is rendered straight from phase, two samples late so the
+			// peak and trough corners can be band-limited. Signal IN does not perturb it here.
+			float range = FG_V_MAX - FUNCTION_V_MIN;
+			float period = riseTime + fallTime;
+			float riseShare = riseTime / period;
+			if (!ch.oscRunning) {
+				// Pick up from wherever the function generator was.
+				float startPhase = (ch.phase == CHANNEL_FALL)
+					? riseShare + ch.phasePos * (1.f - riseShare)
+					: ch.phasePos * riseShare;
+				ch.osc.reset(startPhase, clamp((ch.out - FUNCTION_V_MIN) / range, 0.f, 1.f));
+				ch.oscRunning = true;
+			}
+			segment_oscillator::Frame frame = ch.osc.process(curve, riseShare, dt / period);
+			ch.signalOutputGain = functionAmpScale;
+			ch.out = FUNCTION_V_MIN + frame.level * range;
+			ch.phase = frame.rising ? CHANNEL_RISE : CHANNEL_FALL;
+			ch.phasePos = frame.rising
+				? frame.phase / riseShare
+				: (frame.phase - riseShare) / std::max(1.f - riseShare, 1e-6f);
+			ch.phasePos = clamp(ch.phasePos, 0.f, 1.f);
+			float f = std::max(std::max(frame.peakFraction, frame.troughFraction), 1e-6f);
+			updateGateOutputs(ch.phase == cfg.gateHighPhase, ch.phase == CHANNEL_RISE, f);
+		}
+		else if (ch.phase != CHANNEL_IDLE) {
 			// Function-generator integration path.
 			ch.signalOutputGain = functionAmpScale;
-			float s = shapeSigned;
 			float range = FG_V_MAX - FUNCTION_V_MIN;
 			float xIn = 0.f;
 			float injectAlpha = 0.f;
@@ -737,23 +771,28 @@ struct Proc : Module {
 				injectAlpha = SIGNAL_INJECT_GAIN * clamp(a, 0.f, 1.f);
 			}
 
+			// Time left in this sample for the fall, shortened when the rise ends mid-sample.
+			float fallDt = dt;
 			if (ch.phase == CHANNEL_RISE) {
 				float dpPhase = dt / riseTime;
 				ch.phasePos += dpPhase;
 				float x = clamp((ch.out - FUNCTION_V_MIN) / range, 0.f, 1.f);
-				float dp = clamp(dt / riseTime, 0.f, 0.5f);
-				x += dp * slopeWarp(x, s) * scale;
+				// Step along the closed-form curve from wherever the level sits now, so any
+				// step size stays on the curve and the end of the segment is known exactly.
+				float travel = segment_curve::warpTravel(curve, x) + dpPhase;
+				x = segment_curve::warpLevel(curve, travel);
 				if (injectAlpha > 0.f) {
 					// Hardware-like perturbation: gently pull active FG state toward input.
 					x += injectAlpha * (xIn - x);
 				}
 				x = clamp(x, 0.f, 1.f);
 				ch.out = FUNCTION_V_MIN + x * range;
-				if (ch.phasePos >= 1.f || x >= 1.f) {
-					// Preserve fractional overshoot so rise->fall transition remains sample-rate robust.
-					float f = phaseCrossingFraction(ch.phasePos, dpPhase);
-					float overshoot = std::max(ch.phasePos - 1.f, 0.f);
-					ch.phasePos = overshoot * (riseTime / std::max(fallTime, 1e-6f));
+				if (ch.phasePos >= 1.f || travel >= 1.f || x >= 1.f) {
+					// Whichever of time or level reached the end first sets the crossing; the
+					// rest of the sample goes to the fall so the peak stays sample-rate robust.
+					float f = std::min(phaseCrossingFraction(ch.phasePos, dpPhase), phaseCrossingFraction(travel, dpPhase));
+					fallDt = (1.f - f) * dt;
+					ch.phasePos = 0.f;
 					ch.phase = CHANNEL_FALL;
 					float prevOut = ch.out;
 					ch.out = FG_V_MAX;
@@ -765,18 +804,19 @@ struct Proc : Module {
 			}
 
 			if (ch.phase == CHANNEL_FALL) {
-				float dpPhase = dt / fallTime;
+				float dpPhase = fallDt / fallTime;
 				ch.phasePos += dpPhase;
 				float x = clamp((ch.out - FUNCTION_V_MIN) / range, 0.f, 1.f);
-				float dp = clamp(dt / fallTime, 0.f, 0.5f);
-				x -= dp * slopeWarp(x, s) * scale;
+				float travel = 1.f - segment_curve::warpTravel(curve, x) + dpPhase;
+				x = segment_curve::warpLevel(curve, 1.f - travel);
 				if (injectAlpha > 0.f) {
 					x += injectAlpha * (xIn - x);
 				}
 				x = clamp(x, 0.f, 1.f);
 				ch.out = FUNCTION_V_MIN + x * range;
-				if (ch.phasePos >= 1.f || x <= 0.f) {
-					float f = phaseCrossingFraction(ch.phasePos, dpPhase);
+				if (ch.phasePos >= 1.f || travel >= 1.f || x <= 0.f) {
+					float f = std::min(phaseCrossingFraction(ch.phasePos, dpPhase), phaseCrossingFraction(travel, dpPhase));
+					f = 1.f - (1.f - f) * fallDt / dt;
 					ch.phasePos = 0.f;
 					ch.phase = CHANNEL_IDLE;
 					float prevOut = ch.out;
@@ -796,8 +836,7 @@ struct Proc : Module {
 				signalIn,
 				riseTime,
 				fallTime,
-				shapeSigned,
-				scale,
+				ch.warpCurve,
 				dt
 			);
 			ch.out = slewStep.out;
@@ -826,11 +865,23 @@ struct Proc : Module {
 
 		ChannelResult result;
 		result.cycleOn = cycleOn;
+		result.settled = !cycleOn
+			&& ch.phase == CHANNEL_IDLE
+			&& ch.slewDir == 0
+			&& !ch.eorGateState
+			&& !ch.eocGateState
+			&& ch.trigRearmSec <= 0.f
+			&& !ch.riseTimeRamp.gliding()
+			&& !ch.fallTimeRamp.gliding()
+			&& ch.blep.idle()
+			&& (!signalPatched || std::fabs(signalIn - ch.out) <= TARGET_EPS)
+			&& previewSettled(previewUpdateState, riseTime, fallTime, shapeSigned);
 		return result;
 	}
 
 	Proc() {
 		initKnobCurveLut();
+		configureStageControls(channel);
 		config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 		configParam(CYCLE_PARAM, 0.f, 1.f, 0.f, "Cycle");
 		configParam(RISE_PARAM, 0.f, 1.f, 0.f, "Rise");
@@ -854,8 +905,10 @@ struct Proc : Module {
 		json_object_set_new(rootJ, "cycleLatched", json_boolean(channel.cycleLatched));
 		json_object_set_new(rootJ, "bandlimitedGateOutputs", json_boolean(bandlimitedGateOutputs));
 		json_object_set_new(rootJ, "bandlimitedSignalOutputs", json_boolean(bandlimitedSignalOutputs));
-		json_object_set_new(rootJ, "timingUpdateDiv", json_integer(timingUpdateDiv));
+		json_object_set_new(rootJ, "timingUpdateDiv", json_integer(timingClock.divider));
 		json_object_set_new(rootJ, "timingInterpolate", json_boolean(timingInterpolate));
+		json_object_set_new(rootJ, "sleepWhenIdle", json_boolean(sleepWhenIdle));
+		json_object_set_new(rootJ, "audioRateCycle", json_boolean(audioRateCycle));
 		return rootJ;
 	}
 
@@ -888,6 +941,24 @@ struct Proc : Module {
 		if (timingInterpJ) {
 			timingInterpolate = json_boolean_value(timingInterpJ);
 		}
+
+		json_t* sleepJ = json_object_get(rootJ, "sleepWhenIdle");
+		if (sleepJ) {
+			sleepWhenIdle = json_boolean_value(sleepJ);
+		}
+
+		json_t* audioRateJ = json_object_get(rootJ, "audioRateCycle");
+		if (audioRateJ) {
+			setAudioRateCycle(json_boolean_value(audioRateJ));
+		}
+	}
+
+	void updateLights(bool cycleOn, float outRendered) {
+		lights[CYCLE_LIGHT].setBrightness(cycleOn ? 1.f : 0.f);
+		lights[EOR_LIGHT].setBrightness(channel.eorGateState ? 1.f : 0.f);
+		lights[EOC_LIGHT].setBrightness(channel.eocGateState ? 1.f : 0.f);
+		lights[MAIN_LIGHT].setBrightness(clamp(std::fabs(outRendered) / FG_V_MAX, 0.f, 1.f));
+		lights[NEG_LIGHT].setBrightness(clamp(std::fabs(outRendered) / FG_V_MAX, 0.f, 1.f));
 	}
 
 	void process(const ProcessArgs& args) override {
@@ -907,16 +978,7 @@ struct Proc : Module {
 			CHANNEL_FALL
 		};
 
-		bool timingTick = true;
-		if (timingUpdateDiv > 1) {
-			timingUpdateCounter++;
-			if (timingUpdateCounter >= timingUpdateDiv) {
-				timingUpdateCounter = 0;
-			}
-			else {
-				timingTick = false;
-			}
-		}
+		bool timingTick = timingClock.tick();
 		lightUpdateTimer += args.sampleTime;
 		bool lightTick = false;
 		if (lightUpdateTimer >= LIGHT_UPDATE_INTERVAL) {
@@ -927,11 +989,22 @@ struct Proc : Module {
 			lightTick = true;
 		}
 
+		if (channel.quiescence.quiescent && pollQuiescentChannel(channel, channelConfig)) {
+			// Outputs keep the settled voltages written before the channel went to sleep.
+			if (lightTick) {
+				updateLights(false, channel.out * channel.signalOutputGain);
+			}
+			return;
+		}
+
 		ChannelResult channelResult = processChannel(args, channel, channelConfig, previewState, previewUpdate, timingTick);
+		updateQuiescence(channel, channelConfig, channelResult.settled);
+		// One row read covers all three outputs; a bank with nothing pending returns at once.
+		channel.blep.process();
 		float outRendered = channel.out * channel.signalOutputGain
-			+ (bandlimitedSignalOutputs ? channel.signalBlep.process() : 0.f);
-		float eorOut = (channel.eorGateState ? 10.f : 0.f) + (bandlimitedGateOutputs ? channel.eorGateBlep.process() : 0.f);
-		float eocOut = (channel.eocGateState ? 10.f : 0.f) + (bandlimitedGateOutputs ? channel.eocGateBlep.process() : 0.f);
+			+ (bandlimitedSignalOutputs ? channel.blep.residue(BLEP_SIGNAL_LANE) : 0.f);
+		float eorOut = (channel.eorGateState ? 10.f : 0.f) + (bandlimitedGateOutputs ? channel.blep.residue(BLEP_EOR_LANE) : 0.f);
+		float eocOut = (channel.eocGateState ? 10.f : 0.f) + (bandlimitedGateOutputs ? channel.blep.residue(BLEP_EOC_LANE) : 0.f);
 		float negOut = -outRendered;
 
 		outputs[EOR_OUTPUT].setVoltage(eorOut);
@@ -940,11 +1013,7 @@ struct Proc : Module {
 		outputs[NEG_OUTPUT].setVoltage(negOut);
 
 		if (lightTick) {
-			lights[CYCLE_LIGHT].setBrightness(channelResult.cycleOn ? 1.f : 0.f);
-			lights[EOR_LIGHT].setBrightness(channel.eorGateState ? 1.f : 0.f);
-			lights[EOC_LIGHT].setBrightness(channel.eocGateState ? 1.f : 0.f);
-			lights[MAIN_LIGHT].setBrightness(clamp(std::fabs(outRendered) / FG_V_MAX, 0.f, 1.f));
-			lights[NEG_LIGHT].setBrightness(clamp(std::fabs(negOut) / FG_V_MAX, 0.f, 1.f));
+			updateLights(channelResult.cycleOn, outRendered);
 		}
 	}
 };
@@ -985,200 +1054,16 @@ struct BananutBlack : app::SvgPort {
 	}
 };
 
-struct WavePreviewWidget : Widget {
-	static constexpr int POINT_COUNT = 320;
-	static constexpr int PREVIEW_LUT_SIZE = 1024;
-	static constexpr float CENTER_LINE_WIDTH = 1.0f;
-	static constexpr float WAVE_LINE_WIDTH = 1.4f;
-	static constexpr float WAVE_EDGE_PAD = 1.0f;
-	static constexpr float DOT_RADIUS = 2.1f;
-	static constexpr float DOT_SHOW_MAX_HZ = 2.0f;
-	static constexpr float DOT_HIDE_MIN_HZ = 2.4f;
-	static constexpr float LABEL_FONT_SIZE = 11.5f;
-	std::array<Vec, POINT_COUNT> points {};
-	uint32_t lastVersion = 0;
-	bool pointsValid = false;
-	float lastFreqHz = 100.f;
-	float dotXNorm = 0.f;
-	float dotYNorm = 0.f;
-	bool dotVisible = false;
-
-	WavePreviewWidget() = default;
-
-	static void buildSegmentLut(std::array<float, PREVIEW_LUT_SIZE>& lut, float curveSigned, bool rising) {
-		// Build once per preview update. Midpoint integration reduces visual artifacts at extreme curve asymmetry.
-		float scale = Proc::slopeWarpScale(curveSigned);
-		float dp = 1.f / float(PREVIEW_LUT_SIZE - 1);
-		float x = rising ? 0.f : 1.f;
-		lut[0] = x;
-		for (int i = 1; i < PREVIEW_LUT_SIZE; ++i) {
-			float k1 = Proc::slopeWarp(x, curveSigned) * scale;
-			float xMid = rising ? (x + 0.5f * dp * k1) : (x - 0.5f * dp * k1);
-			xMid = clamp(xMid, 0.f, 1.f);
-			float k2 = Proc::slopeWarp(xMid, curveSigned) * scale;
-			x += rising ? (dp * k2) : (-dp * k2);
-			x = clamp(x, 0.f, 1.f);
-			lut[i] = x;
-		}
-		lut.front() = rising ? 0.f : 1.f;
-		lut.back() = rising ? 1.f : 0.f;
-	}
-
-	static float sampleSegmentLut(const std::array<float, PREVIEW_LUT_SIZE>& lut, float t) {
-		t = clamp(t, 0.f, 1.f);
-		float idx = t * float(PREVIEW_LUT_SIZE - 1);
-		int i0 = int(idx);
-		int i1 = std::min(i0 + 1, PREVIEW_LUT_SIZE - 1);
-		float f = idx - float(i0);
-		return lut[i0] + (lut[i1] - lut[i0]) * f;
-	}
-
-	void rebuildPoints(float riseTime, float fallTime, float curveSigned, bool interactiveRecent) {
-		float w = std::max(box.size.x, 1.f);
-		float h = std::max(box.size.y, 1.f);
-		float drawPad = 0.5f * WAVE_LINE_WIDTH + WAVE_EDGE_PAD;
-		float left = drawPad;
-		float top = drawPad;
-		float right = std::max(left + 1.f, w - drawPad);
-		float bottom = std::max(top + 1.f, h - drawPad);
-		float drawW = right - left;
-		float drawH = bottom - top;
-		// The preview always shows exactly one full rise+fall cycle across widget width.
-		float totalTime = std::max(riseTime + fallTime, 1e-6f);
-		float riseRatio = riseTime / totalTime;
-		float peakX = left + riseRatio * drawW;
-		float riseWidth = std::max(peakX - left, 1e-4f);
-		float fallWidth = std::max(right - peakX, 1e-4f);
-		// Reserved hook if we later render interactive-state emphasis.
-		(void) interactiveRecent;
-		std::array<float, PREVIEW_LUT_SIZE> riseLut {};
-		std::array<float, PREVIEW_LUT_SIZE> fallLut {};
-		buildSegmentLut(riseLut, curveSigned, true);
-		buildSegmentLut(fallLut, curveSigned, false);
-
-		for (int i = 0; i < POINT_COUNT; ++i) {
-			float xNorm = float(i) / float(POINT_COUNT - 1);
-			float x = left + xNorm * drawW;
-			float y = -1.f;
-			if (x <= peakX) {
-				float t = (x - left) / riseWidth;
-				float v = sampleSegmentLut(riseLut, t);
-				y = -1.f + 2.f * v;
-			}
-			else {
-				float t = (x - peakX) / fallWidth;
-				float v = sampleSegmentLut(fallLut, t);
-				y = -1.f + 2.f * v;
-			}
-			float py = top + (0.5f - 0.5f * y) * drawH;
-			py = clamp(py, top, bottom);
-			points[i] = Vec(x, py);
-		}
-
-		int peakIndex = int(std::round(riseRatio * float(POINT_COUNT - 1)));
-		peakIndex = std::max(0, std::min(POINT_COUNT - 1, peakIndex));
-		float peakPx = left + (float(peakIndex) / float(POINT_COUNT - 1)) * drawW;
-		points[peakIndex] = Vec(peakPx, top);
-		points.front() = Vec(left, bottom);
-		points.back() = Vec(right, bottom);
-		pointsValid = true;
-	}
-
-	void step() override {
-		Widget::step();
+struct ProcWavePreview : WavePreviewWidget {
+	bool readPreviewState(WavePreviewState& state) override {
 		ModuleWidget* moduleWidget = getAncestorOfType<ModuleWidget>();
 		Proc* modulePtr = moduleWidget ? moduleWidget->getModule<Proc>() : nullptr;
 		if (!modulePtr) {
-			if (!pointsValid) {
-				rebuildPoints(0.01f, 0.01f, 0.f, false);
-			}
-			return;
-		}
-		float riseTime = 0.01f;
-		float fallTime = 0.01f;
-		float curveSigned = 0.f;
-		float previewDotXNorm = 0.f;
-		float previewDotYNorm = 0.f;
-		bool previewDotVisible = false;
-		bool interactiveRecent = false;
-		uint32_t version = 0;
-		modulePtr->getPreviewState(riseTime, fallTime, curveSigned, previewDotXNorm, previewDotYNorm, previewDotVisible,
-			interactiveRecent, version);
-		dotXNorm = previewDotXNorm;
-		dotYNorm = previewDotYNorm;
-		// Displayed frequency reflects the currently effective cycle period.
-		lastFreqHz = 1.f / std::max(riseTime + fallTime, 1e-6f);
-		if (lastFreqHz >= DOT_HIDE_MIN_HZ) {
-			dotVisible = false;
-		} else if (lastFreqHz <= DOT_SHOW_MAX_HZ) {
-			dotVisible = previewDotVisible;
-		}
-		if (!pointsValid || version != lastVersion) {
-			rebuildPoints(riseTime, fallTime, curveSigned, interactiveRecent);
-			lastVersion = version;
-		}
-	}
-
-	void draw(const DrawArgs& args) override {
-		nvgSave(args.vg);
-		nvgScissor(args.vg, 0.f, 0.f, box.size.x, box.size.y);
-
-		if (pointsValid) {
-			nvgBeginPath(args.vg);
-			nvgMoveTo(args.vg, points[0].x, points[0].y);
-			for (int i = 1; i < POINT_COUNT; ++i) {
-				nvgLineTo(args.vg, points[i].x, points[i].y);
-			}
-			nvgStrokeColor(args.vg, nvgRGBA(230, 230, 220, 255));
-			nvgStrokeWidth(args.vg, WAVE_LINE_WIDTH);
-			nvgLineCap(args.vg, NVG_BUTT);
-			nvgLineJoin(args.vg, NVG_ROUND);
-			nvgStroke(args.vg);
-		}
-		if (pointsValid && dotVisible) {
-			float w = std::max(box.size.x, 1.f);
-			float drawPad = 0.5f * WAVE_LINE_WIDTH + WAVE_EDGE_PAD;
-			float left = drawPad;
-			float right = std::max(left + 1.f, w - drawPad);
-			float drawW = right - left;
-			float x = left + clamp(dotXNorm, 0.f, 1.f) * drawW;
-			// Keep the marker visually glued to the rendered waveform by sampling
-			// directly from the preview polyline instead of a separately published y.
-			float idx = clamp(dotXNorm, 0.f, 1.f) * float(POINT_COUNT - 1);
-			int i0 = clamp(int(std::floor(idx)), 0, POINT_COUNT - 1);
-			int i1 = std::min(i0 + 1, POINT_COUNT - 1);
-			float f = idx - float(i0);
-			float y = points[i0].y + (points[i1].y - points[i0].y) * f;
-			nvgBeginPath(args.vg);
-			nvgCircle(args.vg, x, y, DOT_RADIUS);
-			nvgFillColor(args.vg, nvgRGBA(255, 232, 72, 255));
-			nvgFill(args.vg);
-			nvgBeginPath(args.vg);
-			nvgCircle(args.vg, x, y, DOT_RADIUS + 0.55f);
-			nvgStrokeWidth(args.vg, 0.9f);
-			nvgStrokeColor(args.vg, nvgRGBA(0, 0, 0, 220));
-			nvgStroke(args.vg);
-		}
-
-		nvgResetScissor(args.vg);
-		nvgRestore(args.vg);
-
-		char freqText[32];
-		if (lastFreqHz < 1.f) {
-			std::snprintf(freqText, sizeof(freqText), "%4.0f mHz", lastFreqHz * 1000.f);
-		}
-		else if (lastFreqHz >= 1000.f) {
-			std::snprintf(freqText, sizeof(freqText), "%4.2f kHz", lastFreqHz / 1000.f);
-		}
-		else {
-			std::snprintf(freqText, sizeof(freqText), "%5.1f Hz", lastFreqHz);
+			return false;
 		}
-		nvgFontSize(args.vg, LABEL_FONT_SIZE);
-		nvgFontFaceId(args.vg, APP->window->uiFont->handle);
-		nvgFillColor(args.vg, nvgRGBA(255, 255, 255, 255));
-		nvgTextAlign(args.vg, NVG_ALIGN_CENTER | NVG_ALIGN_TOP);
-		// Keep label outside preview box to avoid occluding waveform.
-		nvgText(args.vg, box.size.x * 0.5f, box.size.y + 1.5f, freqText, nullptr);
+		modulePtr->getPreviewState(state.riseTime, state.fallTime, state.curveSigned, state.dotXNorm, state.dotYNorm,
+			state.dotVisible, state.interactiveRecent, state.version);
+		return true;
 	}
 };
 
@@ -1276,7 +1161,7 @@ struct ProcWidget : ModuleWidget {
 			addChild(ampReadout);
 		}
 		{
-			WavePreviewWidget* previewWidget = new WavePreviewWidget();
+			ProcWavePreview* previewWidget = new ProcWavePreview();
 			math::Rect previewRectMm;
 			if (loadPreviewRectMm(panelPath, "CH1_PREVIEW", &previewRectMm)) {
 				// Keep the legacy SVG id until proc.svg is cleaned up as well.
@@ -1320,13 +1205,18 @@ struct ProcWidget : ModuleWidget {
 			menu->addChild(createMenuLabel("Performance"));
 			menu->addChild(createBoolPtrMenuItem("Bandlimited EOR/EOC", "", &proc->bandlimitedGateOutputs));
 			menu->addChild(createBoolPtrMenuItem("Bandlimited Signal Outputs", "", &proc->bandlimitedSignalOutputs));
+			menu->addChild(createBoolPtrMenuItem("Sleep When Idle", "", &proc->sleepWhenIdle));
 			menu->addChild(createMenuLabel("Rate Control"));
+			menu->addChild(createBoolMenuItem("Audio-Rate Cycle", "",
+				[=]() { return proc->audioRateCycle; },
+				[=](bool enabled) { proc->setAudioRateCycle(enabled); }
+			));
 			menu->addChild(createBoolPtrMenuItem("Interpolate Timing Updates", "", &proc->timingInterpolate));
 			menu->addChild(createSubmenuItem("Timing Update Rate", "",
 				[=](Menu* submenu) {
 					auto addDivItem = [=](int div, std::string label) {
 						submenu->addChild(createCheckMenuItem(label, "",
-							[=]() { return proc->timingUpdateDiv == div; },
+							[=]() { return proc->timingClock.divider == div; },
 							[=]() { proc->setTimingUpdateDiv(div); }
 						));
 					};
@@ -0,0 +1,81 @@
+#include "SegmentCurve.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace segment_curve {
+
+namespace {
+
+struct LutCache {
+	std::atomic<const SegmentLutPair*> entries[CURVE_KEY_COUNT];
+
+	LutCache() {
+		for (int i = 0; i < CURVE_KEY_COUNT; ++i) {
+			entries[i].store(nullptr, std::memory_order_relaxed);
+		}
+	}
+
+	~LutCache() {
+		for (int i = 0; i < CURVE_KEY_COUNT; ++i) {
+			delete entries[i].load(std::memory_order_relaxed);
+		}
+	}
+};
+
+LutCache& lutCache() {
+	static LutCache cache;
+	return cache;
+}
+
+} // namespace
+
+int curveKey(float curveSigned) {
+	float s = std::fmin(std::fmax(curveSigned, -1.f), 1.f);
+	return int(std::lround(s * float(CURVE_STEPS))) + CURVE_STEPS;
+}
+
+float curveForKey(int key) {
+	return float(std::min(std::max(key, 0), CURVE_KEY_COUNT - 1) - CURVE_STEPS) / float(CURVE_STEPS);
+}
+
+void buildSegmentLut(SegmentLut& lut, float curveSigned, bool rising) {
+	WarpCurve curve = makeWarpCurve(curveSigned);
+	for (int i = 0; i < LUT_SIZE; ++i) {
+		float t = float(i) / float(LUT_SIZE - 1);
+		lut[i] = warpLevel(curve, rising ? t : 1.f - t);
+	}
+	lut.front() = rising ? 0.f : 1.f;
+	lut.back() = rising ? 1.f : 0.f;
+}
+
+float sampleSegmentLut(const SegmentLut& lut, float t) {
+	t = std::fmin(std::fmax(t, 0.f), 1.f);
+	float idx = t * float(LUT_SIZE - 1);
+	int i0 = int(idx);
+	int i1 = std::min(i0 + 1, LUT_SIZE - 1);
+	float f = idx - float(i0);
+	return lut[i0] + (lut[i1] - lut[i0]) * f;
+}
+
+const SegmentLutPair& sharedSegmentLuts(float curveSigned) {
+	int key = curveKey(curveSigned);
+	std::atomic<const SegmentLutPair*>& slot = lutCache().entries[key];
+	const SegmentLutPair* luts = slot.load(std::memory_order_acquire);
+	if (luts) {
+		return *luts;
+	}
+	SegmentLutPair* built = new SegmentLutPair();
+	float curve = curveForKey(key);
+	buildSegmentLut(built->rise, curve, true);
+	buildSegmentLut(built->fall, curve, false);
+	const SegmentLutPair* expected = nullptr;
+	if (slot.compare_exchange_strong(expected, built, std::memory_order_acq_rel)) {
+		return *built;
+	}
+	// Another thread published the same curve first.
+	delete built;
+	return *expected;
+}
+
+} // namespace segment_curve
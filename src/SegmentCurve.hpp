@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+
+// Curve math shared by Proc and IntegralFlux, plus a process-wide cache of the
+// normalized segment shapes their panel previews draw.
+namespace segment_curve {
+
+static constexpr float WARP_K_MAX = 40.f;
+static constexpr int LUT_SIZE = 1024;
+// Cached curves are quantized to this many steps per side of linear.
+static constexpr int CURVE_STEPS = 128;
+static constexpr int CURVE_KEY_COUNT = 2 * CURVE_STEPS + 1;
+
+inline float slopeWarp(float x, float s) {
+	// Local slope of the curve family used by both function-generator and slew modes.
+	// Segments follow dx/dp = slopeWarp(x) * slopeWarpScale(); see WarpCurve for the solution.
+	x = std::fmin(std::fmax(x, 0.f), 1.f);
+	float u = std::fabs(s);
+	if (u < 1e-6f) {
+		return 1.f;
+	}
+	float k = WARP_K_MAX * u;
+	float x2 = x * x;
+	if (s < 0.f) {
+		// LOG: fast near 0V, slow near top.
+		return 1.f / (1.f + k * x2);
+	}
+	// EXP: slow near 0V, fast near top.
+	return 1.f + k * x2;
+}
+
+// Closed-form solution of dx/dp = slopeWarp(x, s) * scale for one segment, so a stage
+// maps phase p in [0, 1] straight to level x in [0, 1] and back without integrating.
+// LOG (slope 1/(1 + k x^2)) travels p = (x + k x^3 / 3) / scale, inverted with sinh/asinh;
+// EXP (slope 1 + k x^2) travels p = atan(sqrt(k) x) / atan(sqrt(k)), inverted with tan.
+// The constants depend only on the curve, so callers rebuild one per shape change.
+struct WarpCurve {
+	// -1 LOG, 0 linear, 1 EXP.
+	int mode = 0;
+	float k = 0.f;
+	float rootK = 0.f;
+	// Normalization that keeps every curve's segment at unit duration.
+	float scale = 1.f;
+	// LOG: 1.5 * scale * sqrt(k). EXP: atan(sqrt(k)).
+	float inverseGain = 0.f;
+};
+
+inline WarpCurve makeWarpCurve(float s) {
+	WarpCurve curve;
+	float u = std::fabs(s);
+	if (u < 1e-6f) {
+		return curve;
+	}
+	curve.k = WARP_K_MAX * u;
+	curve.rootK = std::sqrt(curve.k);
+	if (s < 0.f) {
+		curve.mode = -1;
+		curve.scale = 1.f + curve.k / 3.f;
+		curve.inverseGain = 1.5f * curve.scale * curve.rootK;
+	}
+	else {
+		curve.mode = 1;
+		curve.inverseGain = std::atan(curve.rootK);
+		curve.scale = curve.inverseGain / curve.rootK;
+	}
+	return curve;
+}
+
+// Phase at which a rising segment reaches level x (falling segments reach x at 1 - this).
+inline float warpTravel(const WarpCurve& curve, float x) {
+	x = std::fmin(std::fmax(x, 0.f), 1.f);
+	if (curve.mode < 0) {
+		return x * (1.f + curve.k * x * x / 3.f) / curve.scale;
+	}
+	if (curve.mode > 0) {
+		return std::atan(curve.rootK * x) / curve.inverseGain;
+	}
+	return x;
+}
+
+// Level of a rising segment after phase p; exact for any step size.
+inline float warpLevel(const WarpCurve& curve, float p) {
+	p = std::fmin(std::fmax(p, 0.f), 1.f);
+	float x = p;
+	if (curve.mode < 0) {
+		// Real root of x^3 + (3/k) x - 3 scale p / k = 0.
+		x = 2.f / curve.rootK * std::sinh(std::asinh(curve.inverseGain * p) / 3.f);
+	}
+	else if (curve.mode > 0) {
+		x = std::tan(curve.inverseGain * p) / curve.rootK;
+	}
+	return std::fmin(std::fmax(x, 0.f), 1.f);
+}
+
+inline float slopeWarpScale(float s) {
+	// Keeps different curve settings at the same segment duration: the integral of
+	// 1 / slopeWarp() over [0..1], which is 1 + k/3 for LOG and atan(sqrt(k))/sqrt(k) for EXP.
+	return makeWarpCurve(s).scale;
+}
+
+typedef std::array<float, LUT_SIZE> SegmentLut;
+
+// Normalized rise (0 -> 1) and fall (1 -> 0) travel over one segment.
+struct SegmentLutPair {
+	SegmentLut rise;
+	SegmentLut fall;
+};
+
+int curveKey(float curveSigned);
+float curveForKey(int key);
+
+// Samples the closed-form curve across one segment.
+void buildSegmentLut(SegmentLut& lut, float curveSigned, bool rising);
+
+float sampleSegmentLut(const SegmentLut& lut, float t);
+
+// Returns the shared LUTs for the quantized curve, building them on first use.
+// Safe from any thread; entries live until exit.
+const SegmentLutPair& sharedSegmentLuts(float curveSigned);
+
+} // namespace segment_curve
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "SegmentCurve.hpp"
+
+// Audio-rate rise/fall cycle shared by Proc and IntegralFlux. The waveform is rendered
+// straight from the cycle phase with the closed-form segment curve, and the slope corners
+// at the peak and trough get a four-point polynomial BLAMP so the core stays clean well
+// above the hardware-like LFO ceiling.
+namespace segment_oscillator {
+
+// Keeps a cycle at or below Nyquist so at most one peak and one trough land per sample.
+static constexpr float MAX_PHASE_STEP = 0.5f;
+// Shortest rise or fall as a share of the cycle.
+static constexpr float MIN_SEGMENT_SHARE = 1e-4f;
+
+struct Frame {
+	// Level in [0, 1], rounded slightly inside around corrected corners.
+	float level = 0.f;
+	// Cycle phase of this sample; the rise spans [0, riseShare).
+	float phase = 0.f;
+	bool rising = true;
+	// Position within the sample (0, 1] of a peak or trough crossing, or 0 when there was none.
+	float peakFraction = 0.f;
+	float troughFraction = 0.f;
+};
+
+// Rounding a slope corner through a cubic B-spline: the band-limited ramp minus the ideal one,
+// `t` samples after the corner. Nonzero only for t in (-2, 2).
+inline float blampResidual(float t) {
+	static const float weights[5] = {1.f, -4.f, 6.f, -4.f, 1.f};
+	float sum = 0.f;
+	for (int k = 0; k < 5; ++k) {
+		float u = t + 2.f - float(k);
+		if (u > 0.f) {
+			sum += weights[k] * u * u * u * u * u;
+		}
+	}
+	return sum / 120.f - std::fmax(t, 0.f);
+}
+
+// The BLAMP correction reaches two samples back from a corner, so every frame is emitted
+// LATENCY samples after it is rendered. Crossing fractions travel with their frame, so gates
+// inserted from them stay aligned with the level.
+static constexpr int LATENCY = 2;
+
+struct SegmentOscillator {
+	// Double so long runs keep their pitch and crossing times.
+	double phase = 0.0;
+	// Rendered frames waiting for corrections from corners still ahead of them, oldest first.
+	Frame held[LATENCY];
+	// Correction owed to the frame after the next one rendered.
+	float carry = 0.f;
+
+	// Starts the cycle at `startPhase` with `level` already waiting to be emitted.
+	void reset(float startPhase, float level) {
+		phase = std::fmin(std::fmax(double(startPhase), 0.0), 1.0);
+		if (phase >= 1.0) {
+			phase = 0.0;
+		}
+		for (int i = 0; i < LATENCY; ++i) {
+			held[i] = Frame();
+			held[i].level = level;
+			held[i].phase = float(phase);
+		}
+		carry = 0.f;
+	}
+
+	Frame process(const segment_curve::WarpCurve& curve, float riseShare, float phaseStep) {
+		riseShare = std::fmin(std::fmax(riseShare, MIN_SEGMENT_SHARE), 1.f - MIN_SEGMENT_SHARE);
+		float fallShare = 1.f - riseShare;
+		float step = std::fmin(std::fmax(phaseStep, 0.f), MAX_PHASE_STEP);
+		Frame next;
+		float nextCorrection = carry;
+		carry = 0.f;
+		auto edgeSlope = [&](float share, bool top) {
+			// Mean slope, in levels per sample, over the half sample of a segment next to a corner.
+			// The tangent would overshoot on steep curves that bend inside the correction kernel.
+			float span = std::fmin(0.5f * step / share, 1.f);
+			float travel = top ? 1.f - segment_curve::warpLevel(curve, 1.f - span) : segment_curve::warpLevel(curve, span);
+			return travel * step / (span * share);
+		};
+		double start = phase;
+		double end = phase + double(step);
+		auto addCorner = [&](float crossing, float slopeChange) {
+			// crossing is the corner's position in (-1, 0] samples from the rendered sample.
+			float t = -crossing;
+			held[0].level += slopeChange * blampResidual(t - 2.f);
+			held[1].level += slopeChange * blampResidual(t - 1.f);
+			nextCorrection += slopeChange * blampResidual(t);
+			carry += slopeChange * blampResidual(t + 1.f);
+		};
+		if (start < riseShare && end >= riseShare) {
+			float crossing = float(double(riseShare) - end) / step;
+			addCorner(crossing, -(edgeSlope(riseShare, true) + edgeSlope(fallShare, true)));
+			next.peakFraction = 1.f + crossing;
+		}
+		if (end >= 1.0) {
+			float crossing = float(1.0 - end) / step;
+			addCorner(crossing, edgeSlope(fallShare, false) + edgeSlope(riseShare, false));
+			next.troughFraction = 1.f + crossing;
+			end -= 1.0;
+			if (end >= riseShare) {
+				crossing = float(double(riseShare) - end) / step;
+				addCorner(crossing, -(edgeSlope(riseShare, true) + edgeSlope(fallShare, true)));
+				next.peakFraction = 1.f + crossing;
+			}
+		}
+		phase = end;
+		next.phase = float(phase);
+		next.rising = next.phase < riseShare;
+		next.level = next.rising
+			? segment_curve::warpLevel(curve, next.phase / riseShare)
+			: segment_curve::warpLevel(curve, (1.f - next.phase) / fallShare);
+		next.level += nextCorrection;
+		Frame out = held[0];
+		held[0] = held[1];
+		held[1] = next;
+		return out;
+	}
+};
+
+} // namespace segment_oscillator
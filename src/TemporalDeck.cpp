@@ -1,18 +1,25 @@
+#include "ControlAcquisition.hpp"
 #include "TemporalDeckArcLights.hpp"
 #include "TemporalDeck.hpp"
 #include "TemporalDeckEngine.hpp"
 #include "TemporalDeckFrameInput.hpp"
+#include "TemporalDeckOutputRecorder.hpp"
 #include "TemporalDeckPlatterInput.hpp"
+#include "TemporalDeckQualityGovernor.hpp"
 #include "TemporalDeckSampleLifecycle.hpp"
+#include "TemporalDeckSessionRecord.hpp"
 #include "TemporalDeckTransportControl.hpp"
+#include "TemporalDeckUiSnapshot.hpp"
 
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <fstream>
 #include <limits>
+#include <memory>
 #include <mutex>
 #include <new>
 #include <string>
@@ -32,8 +39,23 @@ constexpr int TemporalDeck::CARTRIDGE_COUNT;
 constexpr int TemporalDeck::SCRATCH_INTERP_CUBIC;
 constexpr int TemporalDeck::SCRATCH_INTERP_LAGRANGE6;
 constexpr int TemporalDeck::SCRATCH_INTERP_SINC;
+constexpr int TemporalDeck::SCRATCH_INTERP_AUTO;
 constexpr int TemporalDeck::SCRATCH_INTERP_COUNT;
 
+constexpr int TemporalDeck::INTERP_TIER_LINEAR;
+constexpr int TemporalDeck::INTERP_TIER_CUBIC;
+constexpr int TemporalDeck::INTERP_TIER_LAGRANGE6;
+constexpr int TemporalDeck::INTERP_TIER_SINC;
+constexpr int TemporalDeck::INTERP_TIER_COUNT;
+constexpr int TemporalDeck::QUALITY_BUDGET_COUNT;
+constexpr float TemporalDeck::kQualityBudgetOptions[TemporalDeck::QUALITY_BUDGET_COUNT];
+constexpr int TemporalDeck::kLoadProbeIntervalFrames;
+constexpr int TemporalDeck::kLoadProbesPerPublish;
+constexpr int TemporalDeck::kKnobControlDivider;
+constexpr int TemporalDeck::kMaxReadHeads;
+constexpr int TemporalDeck::PROFILE_STAGE_COUNT;
+constexpr int TemporalDeck::PROFILE_COUNTER_COUNT;
+
 constexpr int TemporalDeck::SLIP_RETURN_SLOW;
 constexpr int TemporalDeck::SLIP_RETURN_NORMAL;
 constexpr int TemporalDeck::SLIP_RETURN_INSTANT;
@@ -70,15 +92,26 @@ constexpr float TemporalDeck::kMouseScratchTravelScale;
 constexpr float TemporalDeck::kWheelScratchTravelScale;
 constexpr float TemporalDeck::kUiPublishRateHz;
 constexpr float TemporalDeck::kUiPublishIntervalSec;
+constexpr int TemporalDeck::kUiSnapshotIntervalFrames;
 constexpr int TemporalDeck::kArcLightCount;
 
+using temporaldeck::TemporalDeckBuffer;
 using temporaldeck::TemporalDeckEngine;
 
 namespace {
+
+using temporaldeck_modes::isLongBufferMode;
 using temporaldeck_modes::isMonoBufferMode;
 using temporaldeck_modes::usableBufferSecondsForMode;
 
+// Live buffer snapshot kept in the module's patch storage directory.
+static const char *const kLiveBufferSnapshotFile = "live_buffer.tdlb";
+// The worker writes snapshots here, under the user folder, and onSave moves
+// the latest completed one into patch storage.
+static const char *const kLiveBufferStagingDir = "Leviathan/TemporalDeck/LiveBuffers";
+
 using temporaldeck::PreparedSampleData;
+using temporaldeck::TemporalDeckQualityGovernor;
 using temporaldeck::PlatterInputSnapshot;
 using temporaldeck::PlatterInputState;
 
@@ -270,17 +303,42 @@ struct ScratchSensitivityQuantity : ParamQuantity {
 
 } // namespace
 
+// Slots of Impl::knobs.
+enum DeckKnobSlot { KNOB_BUFFER, KNOB_RATE, KNOB_MIX, KNOB_FEEDBACK, KNOB_SLOT_COUNT };
+
 struct TemporalDeck::Impl {
   TemporalDeckEngine engine;
+  // Extra read heads on engine.buffer, built up front so enabling poly or
+  // adding channels never allocates on the audio thread.
+  std::array<std::unique_ptr<TemporalDeckEngine>, TemporalDeck::kMaxReadHeads - 1> tapEngines;
+  int activeTapCount = 0;
+  std::atomic<bool> polyReadHeads{false};
   dsp::SchmittTrigger freezeTrigger;
   dsp::SchmittTrigger reverseTrigger;
   dsp::SchmittTrigger slipTrigger;
   dsp::SchmittTrigger cartridgeCycleTrigger;
   float cachedSampleRate = 0.f;
+  // Live ring job in flight on the sample worker (LiveRingJob type, or -1).
+  // The ring must not be reallocated until it finishes.
+  int liveRingJobPending = -1;
+  int liveRingJobEndIndex = 0;
+  int liveRingInterimFrames = 0;
+  std::atomic<bool> saveLiveBuffer{false};
+  // Save handshake: onSave requests a snapshot and never waits for it. The
+  // audio thread sets liveSnapshotStaged once the worker has completed one at
+  // liveSnapshotStagingPath (UI thread only).
+  std::atomic<bool> liveSnapshotRequested{false};
+  std::atomic<bool> liveSnapshotStaged{false};
+  std::string liveSnapshotStagingPath;
+  std::atomic<bool> pendingLiveRestore{false};
+  std::atomic<bool> pendingLiveExport{false};
   temporaldeck_transport::TransportControlState transportControl;
   temporaldeck_lifecycle::TemporalDeckSampleLifecycle sampleLifecycle;
+  temporaldeck_session::SessionRecorder sessionRecorder;
+  temporaldeck::OutputRecorder outputRecorder;
   std::atomic<bool> sampleModeEnabled{false};
   std::atomic<bool> sampleLoopEnabled{false};
+  std::atomic<bool> sampleSeekSnap{false};
   PlatterInputState platterInput;
   std::atomic<bool> pendingLiveToSampleConvert{false};
   std::atomic<float> pendingSampleSeekNormalized{0.f};
@@ -289,27 +347,46 @@ struct TemporalDeck::Impl {
   std::atomic<float> pendingLiveSeekArcNormalized{0.f};
   std::atomic<uint32_t> pendingLiveSeekRevision{0};
   uint32_t appliedLiveSeekRevision = 0;
-  std::atomic<double> uiLagSamples{0.0};
-  std::atomic<double> uiAccessibleLagSamples{0.0};
-  std::atomic<float> uiSampleRate{44100.f};
-  std::atomic<float> uiPlatterAngle{0.f};
-  std::atomic<bool> uiFreezeLatched{false};
-  std::atomic<bool> uiSampleModeEnabled{false};
-  std::atomic<bool> uiSampleLoaded{false};
-  std::atomic<bool> uiSampleTransportPlaying{false};
-  std::atomic<double> uiSamplePlayheadSeconds{0.0};
-  std::atomic<double> uiSampleDurationSeconds{0.0};
-  std::atomic<double> uiSampleProgress{0.0};
+  // Written by the audio thread once per kUiSnapshotIntervalFrames; the UI
+  // thread reads it and owns the panel lights.
+  temporaldeck_ui::SeqlockCell<temporaldeck_ui::UiSnapshot> uiSnapshot;
+  int uiSnapshotCountdown = 0;
+  // UI thread only: last consistent read, and the version the lights show.
+  mutable temporaldeck_ui::UiSnapshot uiLastSnapshot;
+  uint32_t uiLightsSequence = 0;
   float uiPublishTimerSec = 0.f;
   int scratchInterpolationMode = TemporalDeck::SCRATCH_INTERP_LAGRANGE6;
+  int governorSlot = -1;
+  std::atomic<bool> profilingEnabled{false};
+  std::atomic<bool> pendingProfileReset{false};
+  std::atomic<float> uiDeckLoad{0.f};
+  std::array<std::atomic<double>, TemporalDeck::PROFILE_STAGE_COUNT> uiProfileStageNs;
+  std::array<std::atomic<uint64_t>, TemporalDeck::PROFILE_COUNTER_COUNT> uiProfileCounters;
+  int loadProbeCountdown = 0;
+  int loadProbeCount = 0;
+  double loadProbeNs = 0.0;
+  // Knobs are latched at control rate. MIX and FEEDBACK scale audio directly, so
+  // they glide across the block; BUFFER and RATE can simply step.
+  control_acquisition::ControlClock knobClock;
+  control_acquisition::ControlBank<KNOB_SLOT_COUNT> knobs;
+  control_acquisition::ControlRamp mixRamp;
+  control_acquisition::ControlRamp feedbackRamp;
   bool platterTraceLoggingEnabled = false;
   int cartridgeCharacter = TemporalDeck::CARTRIDGE_CLEAN;
+  int cartridgeOversamplingMode = TemporalDeck::CARTRIDGE_OVERSAMPLING_OFF;
   std::atomic<int> bufferDurationMode{TemporalDeck::BUFFER_DURATION_10S};
+  std::atomic<bool> compactLongBuffers{false};
   int externalGatePosMode = TemporalDeck::EXTERNAL_GATE_POS_GLIDE;
   int platterArtMode = TemporalDeck::PLATTER_ART_DRAGON_KING;
   int platterBrightnessMode = TemporalDeck::PLATTER_BRIGHTNESS_FULL;
   std::string customPlatterArtPath;
   bool pendingInitialPlatterArtSelection = true;
+
+  // UI thread only; the audio thread reads uiSnapshot into locals.
+  const temporaldeck_ui::UiSnapshot &readUiSnapshot() const {
+    uiSnapshot.read(uiLastSnapshot);
+    return uiLastSnapshot;
+  }
 };
 
 using ProcessSignalInputs = temporaldeck_frameinput::SignalInputs;
@@ -332,11 +409,37 @@ static ProcessSignalInputs readProcessSignalInputs(TemporalDeck &module) {
   return in;
 }
 
-static void writeFrameOutputs(TemporalDeck &module, const TemporalDeckEngine::FrameResult &frame) {
-  module.outputs[TemporalDeck::OUTPUT_L_OUTPUT].setVoltage(frame.outL);
-  module.outputs[TemporalDeck::S_GATE_O_OUTPUT].setVoltage(frame.scratchGateOut);
-  module.outputs[TemporalDeck::OUTPUT_R_OUTPUT].setVoltage(frame.outR);
-  module.outputs[TemporalDeck::S_POS_O_OUTPUT].setVoltage(frame.scratchPosOut);
+// Head count follows the widest of the per-head CV inputs.
+static int readHeadCountFor(TemporalDeck &module) {
+  int channels = std::max(module.inputs[TemporalDeck::POSITION_CV_INPUT].getChannels(),
+                          module.inputs[TemporalDeck::RATE_CV_INPUT].getChannels());
+  channels = std::max(channels, module.inputs[TemporalDeck::SCRATCH_GATE_INPUT].getChannels());
+  return clamp(channels, 1, TemporalDeck::kMaxReadHeads);
+}
+
+// Head `channel` sees its own POS/RATE/S.GATE channel; a mono cable drives
+// every head alike.
+static ProcessSignalInputs signalInputsForHead(TemporalDeck &module, const ProcessSignalInputs &head0, int channel) {
+  ProcessSignalInputs in = head0;
+  in.positionCv = module.inputs[TemporalDeck::POSITION_CV_INPUT].getPolyVoltage(channel);
+  in.rateCv = module.inputs[TemporalDeck::RATE_CV_INPUT].getPolyVoltage(channel);
+  in.scratchGateHigh =
+    module.inputs[TemporalDeck::SCRATCH_GATE_INPUT].getPolyVoltage(channel) >= TemporalDeckEngine::kScratchGateThreshold;
+  return in;
+}
+
+static void writeFrameOutputs(TemporalDeck &module, const TemporalDeckEngine::FrameResult &frame, int channel = 0) {
+  module.outputs[TemporalDeck::OUTPUT_L_OUTPUT].setVoltage(frame.outL, channel);
+  module.outputs[TemporalDeck::S_GATE_O_OUTPUT].setVoltage(frame.scratchGateOut, channel);
+  module.outputs[TemporalDeck::OUTPUT_R_OUTPUT].setVoltage(frame.outR, channel);
+  module.outputs[TemporalDeck::S_POS_O_OUTPUT].setVoltage(frame.scratchPosOut, channel);
+}
+
+static void setOutputChannels(TemporalDeck &module, int channels) {
+  module.outputs[TemporalDeck::OUTPUT_L_OUTPUT].setChannels(channels);
+  module.outputs[TemporalDeck::S_GATE_O_OUTPUT].setChannels(channels);
+  module.outputs[TemporalDeck::OUTPUT_R_OUTPUT].setChannels(channels);
+  module.outputs[TemporalDeck::S_POS_O_OUTPUT].setChannels(channels);
 }
 
 static void updateTransportModeLights(TemporalDeck &module, bool freezeActive, bool reverseLatched, bool slipLatched,
@@ -359,26 +462,16 @@ static void updateTransportModeLights(TemporalDeck &module, bool freezeActive, b
     slipReturnMode == TemporalDeck::SLIP_RETURN_INSTANT ? selectedModeBrightness : unselectedModeBrightness);
 }
 
-namespace temporaldeck_ui {
-
-static void applyArcLightState(TemporalDeck *module, const ArcLightState &state) {
-  static_assert(TemporalDeck::kArcLightCount == kTemporalDeckArcLightCount, "Arc light count mismatch");
+static void applyArcLightState(TemporalDeck &module, const temporaldeck_ui::ArcLightState &state) {
+  static_assert(TemporalDeck::kArcLightCount == temporaldeck_ui::kTemporalDeckArcLightCount, "Arc light count mismatch");
   for (int i = 0; i < TemporalDeck::kArcLightCount; ++i) {
-    module->lights[TemporalDeck::ARC_LIGHT_START + i].setBrightness(state.yellow[i]);
-    module->lights[TemporalDeck::ARC_MAX_LIGHT_START + i].setBrightness(state.red[i]);
+    module.lights[TemporalDeck::ARC_LIGHT_START + i].setBrightness(state.yellow[i]);
+    module.lights[TemporalDeck::ARC_MAX_LIGHT_START + i].setBrightness(state.red[i]);
   }
 }
 
-void publishArcLights(TemporalDeck *module, int sampleFrames, float maxLagSamples, bool sampleMode, bool sampleLoaded,
-                      double lag, double accessibleLag, double sampleProgress) {
-  ArcLightState state =
-    computeArcLightState(sampleFrames, maxLagSamples, sampleMode, sampleLoaded, lag, accessibleLag, sampleProgress);
-  applyArcLightState(module, state);
-}
-
-} // namespace temporaldeck_ui
-
 TemporalDeck::TemporalDeck() : impl(new Impl()) {
+  impl->knobClock.setDivider(kKnobControlDivider);
   config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
   configParam(BUFFER_PARAM, 0.f, 1.f, 1.f, "Buffer", " s", 0.f, 10.f);
   configParam<DeckRateQuantity>(RATE_PARAM, 0.f, 1.f, 0.5f, "Rate");
@@ -403,13 +496,27 @@ TemporalDeck::TemporalDeck() : impl(new Impl()) {
     int mode = clamp(impl->bufferDurationMode.load(), 0, BUFFER_DURATION_COUNT - 1);
     paramQuantities[BUFFER_PARAM]->displayMultiplier = usableBufferSecondsForMode(mode);
   }
+  for (auto &tap : impl->tapEngines) {
+    tap.reset(new TemporalDeckEngine(impl->engine.buffer));
+  }
+  for (auto &stageNs : impl->uiProfileStageNs) {
+    stageNs.store(0.0);
+  }
+  for (auto &counter : impl->uiProfileCounters) {
+    counter.store(0);
+  }
   impl->sampleLifecycle.startWorker();
+  impl->governorSlot = TemporalDeckQualityGovernor::instance().acquireSlot();
   applySampleRateChange(APP->engine->getSampleRate());
 }
 
 TemporalDeck::~TemporalDeck() {
   if (impl) {
     impl->sampleLifecycle.stopWorker();
+    TemporalDeckQualityGovernor::instance().releaseSlot(impl->governorSlot);
+    if (!impl->liveSnapshotStagingPath.empty() && system::isFile(impl->liveSnapshotStagingPath)) {
+      system::remove(impl->liveSnapshotStagingPath);
+    }
   }
 }
 
@@ -425,24 +532,32 @@ void TemporalDeck::applyBufferDurationMode(int mode) {
   }
 }
 
-void TemporalDeck::applySampleRateChange(float sampleRate) {
+void TemporalDeck::applySampleRateChange(float sampleRate, bool keepLiveRing) {
   impl->cachedSampleRate = sampleRate;
   int mode = clamp(impl->bufferDurationMode.load(), 0, BUFFER_DURATION_COUNT - 1);
   bool sampleModeEnabled = impl->sampleModeEnabled.load(std::memory_order_relaxed);
   bool sampleLoopEnabled = impl->sampleLoopEnabled.load(std::memory_order_relaxed);
   auto applyUiState = [&](int uiMode) {
-    impl->uiSampleRate.store(impl->cachedSampleRate);
-    impl->uiLagSamples.store(0.0);
-    impl->uiAccessibleLagSamples.store(0.0);
-    impl->uiPlatterAngle.store(0.f);
-    impl->uiFreezeLatched.store(false);
-    impl->uiSampleModeEnabled.store(impl->engine.sampleModeEnabled);
-    impl->uiSampleLoaded.store(impl->engine.sampleLoaded);
-    impl->uiSampleTransportPlaying.store(impl->engine.sampleTransportPlaying);
-    impl->uiSamplePlayheadSeconds.store(0.0);
-    impl->uiSampleDurationSeconds.store(
-      impl->engine.sampleLoaded ? double(impl->engine.sampleFrames) / std::max(double(impl->cachedSampleRate), 1.0) : 0.0);
-    impl->uiSampleProgress.store(0.0);
+    // Runs serialized with process(), so it may publish like the audio thread
+    // does. It reads into a local: uiLastSnapshot belongs to the UI thread.
+    temporaldeck_ui::UiSnapshot uiState;
+    impl->uiSnapshot.read(uiState);
+    uiState.sampleRate = impl->cachedSampleRate;
+    uiState.lagSamples = 0.0;
+    uiState.accessibleLagSamples = 0.0;
+    uiState.platterAngle = 0.f;
+    uiState.freezeLatched = false;
+    uiState.sampleModeEnabled = impl->engine.sampleModeEnabled;
+    uiState.sampleLoaded = impl->engine.sampleLoaded;
+    uiState.sampleTransportPlaying = impl->engine.sampleTransportPlaying;
+    uiState.samplePlayheadSeconds = 0.0;
+    uiState.sampleDurationSeconds =
+      impl->engine.sampleLoaded ? double(impl->engine.sampleFrames) / std::max(double(impl->cachedSampleRate), 1.0) : 0.0;
+    uiState.sampleProgress = 0.0;
+    uiState.sampleFrames = impl->engine.sampleFrames;
+    uiState.maxLagSamples = std::max(1.f, impl->cachedSampleRate * usableBufferSecondsForMode(uiMode));
+    impl->uiSnapshot.publish(uiState);
+    impl->uiSnapshotCountdown = 0;
     if (paramQuantities[BUFFER_PARAM]) {
       float displaySeconds = usableBufferSecondsForMode(uiMode);
       if (impl->engine.sampleLoaded && impl->engine.sampleFrames > 0) {
@@ -452,15 +567,15 @@ void TemporalDeck::applySampleRateChange(float sampleRate) {
     }
     impl->uiPublishTimerSec = 0.f;
     impl->platterInput.resetAudioHoldState();
-    for (int i = 0; i < kArcLightCount; ++i) {
-      lights[ARC_LIGHT_START + i].setBrightness(0.f);
-      lights[ARC_MAX_LIGHT_START + i].setBrightness(0.f);
-    }
   };
 
   try {
     impl->engine.bufferDurationMode = mode;
-    impl->engine.reset(impl->cachedSampleRate);
+    impl->engine.compactLongBuffers = impl->compactLongBuffers.load(std::memory_order_relaxed);
+    impl->engine.reset(impl->cachedSampleRate, !keepLiveRing);
+    if (keepLiveRing) {
+      impl->engine.readHead = impl->engine.newestReadablePos();
+    }
     impl->engine.sampleModeEnabled = sampleModeEnabled;
     impl->engine.sampleLoopEnabled = sampleLoopEnabled;
     impl->engine.externalGatePosMode = impl->externalGatePosMode;
@@ -479,6 +594,73 @@ void TemporalDeck::applySampleRateChange(float sampleRate) {
   applyUiState(mode);
 }
 
+void TemporalDeck::requestLiveRingJob(int type, float targetSampleRate, int frames) {
+  const TemporalDeckBuffer &liveRing = impl->engine.buffer;
+  temporaldeck_lifecycle::TemporalDeckSampleLifecycle::LiveRingJob job;
+  job.type = type;
+  job.source = &liveRing;
+  job.endIndex = liveRing.writeHead;
+  job.frames = std::min(liveRing.filled,
+                        int(usableBufferSecondsForMode(impl->engine.bufferDurationMode) * liveRing.sampleRate));
+  if (type == temporaldeck_lifecycle::TemporalDeckSampleLifecycle::LiveRingJob::SESSION_SNAPSHOT) {
+    // Record start already cleared everything older than the margin.
+    job.frames = liveRing.filled;
+  }
+  if (frames >= 0) {
+    job.frames = std::min(job.frames, frames);
+  }
+  job.targetSampleRate = targetSampleRate;
+  job.bufferMode = impl->engine.bufferDurationMode;
+  job.compactLongBuffers = impl->engine.compactLongBuffers;
+  impl->sampleLifecycle.requestLiveRingJob(job);
+  impl->liveRingJobPending = type;
+  impl->liveRingJobEndIndex = liveRing.writeHead;
+  impl->liveRingInterimFrames = 0;
+}
+
+void TemporalDeck::onSave(const SaveEvent &e) {
+  Module::onSave(e);
+  bool liveDeck = !isSampleModeEnabled() && !hasLoadedSample();
+  if (impl->saveLiveBuffer.load() && liveDeck) {
+    // Autosave sends SaveEvent too, so this must not wait for a long buffer to
+    // encode. The last completed snapshot is moved into patch storage, and the
+    // worker starts a fresh one for the next save. A snapshot that is late or
+    // fails leaves the previous file where it is.
+    if (impl->liveSnapshotStagingPath.empty()) {
+      std::string stagingDir = system::join(asset::user(), kLiveBufferStagingDir);
+      system::createDirectories(stagingDir);
+      impl->liveSnapshotStagingPath = system::join(stagingDir, string::f("%lld.tdlb", (long long)id));
+      impl->sampleLifecycle.setLiveRingStagingPath(impl->liveSnapshotStagingPath);
+    }
+    std::string path = system::join(createPatchStorageDirectory(), kLiveBufferSnapshotFile);
+    const std::string &staged = impl->liveSnapshotStagingPath;
+    if (impl->liveSnapshotStaged.exchange(false, std::memory_order_acquire) && system::isFile(staged) &&
+        !system::rename(staged, path)) {
+      WARN("TemporalDeck: could not move the live buffer snapshot into patch storage");
+      impl->liveSnapshotStaged.store(true, std::memory_order_relaxed);
+    }
+    impl->liveSnapshotRequested.store(true, std::memory_order_release);
+    return;
+  }
+  // Don't restore a stale buffer into a deck saved without one.
+  std::string path = system::join(getPatchStorageDirectory(), kLiveBufferSnapshotFile);
+  if (system::isFile(path)) {
+    system::remove(path);
+  }
+}
+
+void TemporalDeck::onAdd(const AddEvent &e) {
+  Module::onAdd(e);
+  if (!impl->saveLiveBuffer.load()) {
+    return;
+  }
+  std::string path = system::join(getPatchStorageDirectory(), kLiveBufferSnapshotFile);
+  if (system::isFile(path)) {
+    impl->sampleLifecycle.setLiveRingSnapshotPath(path);
+    impl->pendingLiveRestore.store(true, std::memory_order_relaxed);
+  }
+}
+
 void TemporalDeck::onSampleRateChange() {
   // Reconfiguration is applied on the audio thread from process() to avoid
   // cross-thread buffer reallocations.
@@ -494,13 +676,19 @@ json_t *TemporalDeck::dataToJson() {
   json_object_set_new(root, "reverseLatched", json_boolean(impl->transportControl.reverseLatched));
   json_object_set_new(root, "slipLatched", json_boolean(impl->transportControl.slipLatched));
   json_object_set_new(root, "scratchInterpolationMode", json_integer(impl->scratchInterpolationMode));
+  json_object_set_new(root, "qualityBudget", json_real(TemporalDeckQualityGovernor::instance().budget()));
   json_object_set_new(root, "platterTraceLoggingEnabled", json_boolean(impl->platterTraceLoggingEnabled));
   json_object_set_new(root, "externalGatePosMode", json_integer(impl->externalGatePosMode));
   json_object_set_new(root, "slipReturnMode", json_integer(impl->transportControl.slipReturnMode));
   json_object_set_new(root, "cartridgeCharacter", json_integer(impl->cartridgeCharacter));
+  json_object_set_new(root, "cartridgeOversamplingMode", json_integer(impl->cartridgeOversamplingMode));
   json_object_set_new(root, "bufferDurationMode", json_integer(impl->bufferDurationMode.load()));
+  json_object_set_new(root, "compactLongBuffers", json_boolean(impl->compactLongBuffers.load()));
+  json_object_set_new(root, "polyReadHeads", json_boolean(impl->polyReadHeads.load()));
+  json_object_set_new(root, "saveLiveBuffer", json_boolean(impl->saveLiveBuffer.load()));
   json_object_set_new(root, "sampleModeEnabled", json_boolean(sampleModeEnabled));
   json_object_set_new(root, "sampleLoopEnabled", json_boolean(impl->sampleLoopEnabled.load(std::memory_order_relaxed)));
+  json_object_set_new(root, "sampleSeekSnap", json_boolean(impl->sampleSeekSnap.load(std::memory_order_relaxed)));
   json_object_set_new(root, "sampleAutoPlayOnLoad", json_boolean(sampleAutoPlayOnLoad));
   json_object_set_new(root, "platterArtMode", json_integer(impl->platterArtMode));
   json_object_set_new(root, "platterBrightnessMode", json_integer(impl->platterBrightnessMode));
@@ -523,12 +711,18 @@ void TemporalDeck::dataFromJson(json_t *root) {
   json_t *slipJ = json_object_get(root, "slipLatched");
   json_t *scratchInterpModeJ = json_object_get(root, "scratchInterpolationMode");
   json_t *platterTraceLoggingJ = json_object_get(root, "platterTraceLoggingEnabled");
+  json_t *qualityBudgetJ = json_object_get(root, "qualityBudget");
   json_t *externalGatePosModeJ = json_object_get(root, "externalGatePosMode");
   json_t *slipReturnModeJ = json_object_get(root, "slipReturnMode");
   json_t *cartridgeJ = json_object_get(root, "cartridgeCharacter");
+  json_t *cartridgeOversamplingJ = json_object_get(root, "cartridgeOversamplingMode");
   json_t *bufferDurationJ = json_object_get(root, "bufferDurationMode");
+  json_t *compactLongBuffersJ = json_object_get(root, "compactLongBuffers");
+  json_t *polyReadHeadsJ = json_object_get(root, "polyReadHeads");
+  json_t *saveLiveBufferJ = json_object_get(root, "saveLiveBuffer");
   json_t *sampleModeEnabledJ = json_object_get(root, "sampleModeEnabled");
   json_t *sampleLoopEnabledJ = json_object_get(root, "sampleLoopEnabled");
+  json_t *sampleSeekSnapJ = json_object_get(root, "sampleSeekSnap");
   json_t *platterArtModeJ = json_object_get(root, "platterArtMode");
   json_t *platterBrightnessModeJ = json_object_get(root, "platterBrightnessMode");
   json_t *customPlatterArtPathJ = json_object_get(root, "customPlatterArtPath");
@@ -547,6 +741,10 @@ void TemporalDeck::dataFromJson(json_t *root) {
     impl->scratchInterpolationMode =
       clamp((int)json_integer_value(scratchInterpModeJ), SCRATCH_INTERP_CUBIC, SCRATCH_INTERP_COUNT - 1);
   }
+  if (qualityBudgetJ) {
+    // The governor is shared, so the most recently loaded deck sets the budget.
+    TemporalDeckQualityGovernor::instance().setBudget(float(json_number_value(qualityBudgetJ)));
+  }
   if (platterTraceLoggingJ) {
     impl->platterTraceLoggingEnabled = json_boolean_value(platterTraceLoggingJ);
   }
@@ -560,15 +758,31 @@ void TemporalDeck::dataFromJson(json_t *root) {
   if (cartridgeJ) {
     impl->cartridgeCharacter = clamp((int)json_integer_value(cartridgeJ), 0, CARTRIDGE_COUNT - 1);
   }
+  if (cartridgeOversamplingJ) {
+    impl->cartridgeOversamplingMode = clamp((int)json_integer_value(cartridgeOversamplingJ), CARTRIDGE_OVERSAMPLING_OFF,
+                                            CARTRIDGE_OVERSAMPLING_COUNT - 1);
+  }
   if (bufferDurationJ) {
     impl->bufferDurationMode.store(clamp((int)json_integer_value(bufferDurationJ), 0, BUFFER_DURATION_COUNT - 1));
   }
+  if (compactLongBuffersJ) {
+    impl->compactLongBuffers.store(json_boolean_value(compactLongBuffersJ));
+  }
+  if (polyReadHeadsJ) {
+    impl->polyReadHeads.store(json_boolean_value(polyReadHeadsJ));
+  }
+  if (saveLiveBufferJ) {
+    impl->saveLiveBuffer.store(json_boolean_value(saveLiveBufferJ));
+  }
   if (sampleModeEnabledJ) {
     impl->sampleModeEnabled.store(json_boolean_value(sampleModeEnabledJ), std::memory_order_relaxed);
   }
   if (sampleLoopEnabledJ) {
     impl->sampleLoopEnabled.store(json_boolean_value(sampleLoopEnabledJ), std::memory_order_relaxed);
   }
+  if (sampleSeekSnapJ) {
+    impl->sampleSeekSnap.store(json_boolean_value(sampleSeekSnapJ), std::memory_order_relaxed);
+  }
   impl->sampleLifecycle.setSampleAutoPlayOnLoad(true);
   if (platterArtModeJ) {
     impl->platterArtMode =
@@ -605,6 +819,10 @@ void TemporalDeck::dataFromJson(json_t *root) {
 }
 
 void TemporalDeck::process(const ProcessArgs &args) {
+  if (impl->sessionRecorder.consumeStopRequest()) {
+    impl->sessionRecorder.endSession();
+  }
+
   if (impl->sampleLifecycle.consumeAllocationFallbackPending()) {
     impl->sampleLifecycle.clearDecodedAndPreparedState();
     impl->sampleModeEnabled.store(false, std::memory_order_relaxed);
@@ -612,8 +830,46 @@ void TemporalDeck::process(const ProcessArgs &args) {
     impl->sampleLifecycle.setPendingSampleStateApply();
   }
 
+  if (impl->liveRingJobPending >= 0) {
+    using LiveRingJob = temporaldeck_lifecycle::TemporalDeckSampleLifecycle::LiveRingJob;
+    bool jobBusy = impl->sampleLifecycle.liveRingJobBusy();
+    TemporalDeckBuffer finished;
+    if (impl->sampleLifecycle.consumeLiveRing(&finished)) {
+      const TemporalDeckBuffer &current = impl->engine.buffer;
+      if (!impl->engine.sampleLoaded && finished.sampleRate == impl->cachedSampleRate) {
+        // Carry over what was captured while the worker ran.
+        int interim = current.wrapIndex(current.writeHead - impl->liveRingJobEndIndex);
+        for (int i = 0; i < interim; ++i) {
+          int idx = current.wrapIndex(impl->liveRingJobEndIndex + i);
+          finished.write(current.leftSample(idx), current.rightSample(idx));
+        }
+        impl->engine.adoptResampledRing(&finished);
+      }
+      impl->sampleLifecycle.retireLiveRing(&finished);
+      impl->liveRingJobPending = -1;
+    } else if (!jobBusy) {
+      // Snapshots and exports finish without a ring to install. The worker
+      // sets the failure flag before it clears busy, so it is read once idle.
+      bool failed = impl->sampleLifecycle.consumeLiveRingJobFailed();
+      if (failed && impl->liveRingJobPending == LiveRingJob::RESAMPLE) {
+        applySampleRateChange(impl->cachedSampleRate);
+      } else if (failed && impl->liveRingJobPending == LiveRingJob::SESSION_SNAPSHOT) {
+        // Without its start ring the take cannot be replayed.
+        impl->sessionRecorder.endSession();
+      } else if (!failed && impl->liveRingJobPending == LiveRingJob::SNAPSHOT) {
+        impl->liveSnapshotStaged.store(true, std::memory_order_release);
+      }
+      impl->liveRingJobPending = -1;
+    } else {
+      impl->sampleLifecycle.setLiveRingInterimFrames(++impl->liveRingInterimFrames);
+    }
+  }
+  bool liveRingBusy = impl->liveRingJobPending >= 0;
+
   PreparedSampleData prepared;
-  if (impl->sampleLifecycle.consumePendingPreparedSample(&prepared)) {
+  if (!liveRingBusy && impl->sampleLifecycle.consumePendingPreparedSample(&prepared)) {
+    // A buffer swap cannot be replayed from the frame stream.
+    impl->sessionRecorder.endSession();
     impl->cachedSampleRate = prepared.sampleRate;
     impl->bufferDurationMode.store(prepared.bufferMode, std::memory_order_relaxed);
     impl->engine.bufferDurationMode = prepared.bufferMode;
@@ -621,21 +877,52 @@ void TemporalDeck::process(const ProcessArgs &args) {
     impl->engine.sampleModeEnabled = impl->sampleModeEnabled.load(std::memory_order_relaxed);
     impl->engine.sampleLoopEnabled = impl->sampleLoopEnabled.load(std::memory_order_relaxed);
     impl->engine.externalGatePosMode = impl->externalGatePosMode;
-    impl->engine.installPreparedSample(std::move(prepared.left), std::move(prepared.right), prepared.frames,
-                                       prepared.autoPlayOnLoad, prepared.truncated, prepared.monoStorage);
+    if (prepared.stream) {
+      impl->engine.installStreamedSample(prepared.stream, prepared.autoPlayOnLoad, prepared.monoStorage);
+    } else {
+      impl->engine.installPreparedSample(std::move(prepared.left), std::move(prepared.right), prepared.frames,
+                                         prepared.autoPlayOnLoad, prepared.truncated, prepared.monoStorage,
+                                         std::move(prepared.mips), std::move(prepared.onsets));
+    }
     impl->sampleModeEnabled.store(true, std::memory_order_relaxed);
     if (paramQuantities[BUFFER_PARAM]) {
       paramQuantities[BUFFER_PARAM]->displayMultiplier = float(impl->engine.sampleFrames) / std::max(prepared.sampleRate, 1.f);
     }
   }
 
+  // Buffer changes wait for an in-flight live resample.
   int requestedBufferMode = clamp(impl->bufferDurationMode.load(std::memory_order_relaxed), 0, BUFFER_DURATION_COUNT - 1);
-  bool bufferModeChanged = requestedBufferMode != impl->engine.bufferDurationMode;
-  bool sampleStateApplyRequested = impl->sampleLifecycle.consumePendingSampleStateApply();
-  bool sampleRateChanged = args.sampleRate != impl->cachedSampleRate;
+  bool bufferModeChanged = !liveRingBusy && requestedBufferMode != impl->engine.bufferDurationMode;
+  bool compactLongBuffers = impl->compactLongBuffers.load(std::memory_order_relaxed);
+  if (!liveRingBusy && compactLongBuffers != impl->engine.compactLongBuffers) {
+    // Only a live long buffer needs reallocating; loaded samples stay float and
+    // other modes pick the setting up on their next allocation.
+    bool liveLongBuffer = isLongBufferMode(requestedBufferMode) && !impl->engine.sampleLoaded &&
+                          !impl->sampleLifecycle.decodedSampleAvailable();
+    impl->engine.compactLongBuffers = compactLongBuffers;
+    bufferModeChanged = bufferModeChanged || liveLongBuffer;
+  }
+  bool sampleStateApplyRequested = !liveRingBusy && impl->sampleLifecycle.consumePendingSampleStateApply();
+  bool sampleRateChanged = !liveRingBusy && args.sampleRate != impl->cachedSampleRate;
   bool decodedAvailable = impl->sampleLifecycle.decodedSampleAvailable();
   bool shouldRebuildLoadedSample = decodedAvailable && (bufferModeChanged || sampleRateChanged || sampleStateApplyRequested);
-  if (!decodedAvailable && (bufferModeChanged || sampleRateChanged || sampleStateApplyRequested)) {
+  if (bufferModeChanged || sampleRateChanged) {
+    impl->sessionRecorder.endSession();
+  }
+  if (sampleRateChanged) {
+    // The file's rate is fixed at start.
+    impl->outputRecorder.endRecording();
+  }
+  const TemporalDeckBuffer &liveRing = impl->engine.buffer;
+  bool keepLiveHistory = sampleRateChanged && !bufferModeChanged && !sampleStateApplyRequested && !decodedAvailable &&
+                         !impl->engine.sampleLoaded && liveRing.filled > 1;
+  if (keepLiveHistory) {
+    // Rebuild the history at the new rate on the worker and keep running on
+    // the current ring until it is ready. The guard second stays free for
+    // writes made in the meantime.
+    requestLiveRingJob(temporaldeck_lifecycle::TemporalDeckSampleLifecycle::LiveRingJob::RESAMPLE, args.sampleRate);
+    applySampleRateChange(args.sampleRate, true);
+  } else if (!decodedAvailable && (bufferModeChanged || sampleRateChanged || sampleStateApplyRequested)) {
     applySampleRateChange(args.sampleRate);
   } else if (shouldRebuildLoadedSample && !impl->sampleLifecycle.sampleBuildInProgress()) {
     temporaldeck_lifecycle::TemporalDeckSampleLifecycle::AsyncSampleBuildRequest request;
@@ -645,14 +932,59 @@ void TemporalDeck::process(const ProcessArgs &args) {
     impl->sampleLifecycle.requestAsyncSampleBuild(request);
   }
 
-  if (impl->pendingLiveToSampleConvert.exchange(false, std::memory_order_relaxed)) {
-    bool autoPlayOnLoad = impl->sampleLifecycle.sampleAutoPlayOnLoad();
-    if (impl->engine.convertLiveWindowToSample(params[BUFFER_PARAM].getValue(), autoPlayOnLoad)) {
-      impl->sampleModeEnabled.store(true, std::memory_order_relaxed);
-      if (paramQuantities[BUFFER_PARAM]) {
-        paramQuantities[BUFFER_PARAM]->displayMultiplier =
-          float(impl->engine.sampleFrames) / std::max(args.sampleRate, 1.f);
-      }
+  if (impl->liveRingJobPending < 0) {
+    using LiveRingJob = temporaldeck_lifecycle::TemporalDeckSampleLifecycle::LiveRingJob;
+    bool liveDeck = !impl->engine.sampleLoaded && !impl->sampleLifecycle.decodedSampleAvailable();
+    if (impl->pendingLiveRestore.exchange(false, std::memory_order_relaxed) && liveDeck) {
+      requestLiveRingJob(LiveRingJob::RESTORE, impl->cachedSampleRate);
+    } else if (impl->liveSnapshotRequested.exchange(false, std::memory_order_acquire) && liveDeck &&
+               impl->engine.buffer.filled > 1) {
+      // The window is fixed at the current write head. The worker encodes it
+      // oldest first straight from the live ring, like a resample, and stays
+      // ahead of the writes as long as it starts within the guard second.
+      requestLiveRingJob(LiveRingJob::SNAPSHOT, impl->cachedSampleRate);
+    } else if (impl->pendingLiveExport.exchange(false, std::memory_order_relaxed) && liveDeck &&
+               impl->engine.buffer.filled > 1) {
+      // Same window as converting the live buffer to a sample.
+      double lag = std::max(0.0, impl->engine.accessibleLag(params[BUFFER_PARAM].getValue()));
+      requestLiveRingJob(LiveRingJob::EXPORT, impl->cachedSampleRate, int(std::floor(lag)) + 1);
+    }
+  }
+
+  if (impl->liveRingJobPending < 0 && impl->sessionRecorder.consumeStartRequest()) {
+    // Sessions replay from a reset transport. The performer's history stays:
+    // the worker saves it beside the session and replay restores it in place.
+    const TemporalDeckBuffer &liveRing = impl->engine.buffer;
+    bool keepHistory = liveRing.filled > 1;
+    applySampleRateChange(args.sampleRate, keepHistory);
+    temporaldeck_session::SessionHeader header;
+    header.sampleRate = args.sampleRate;
+    header.bufferDurationMode = impl->engine.bufferDurationMode;
+    header.compactLongBuffers = impl->engine.compactLongBuffers;
+    if (keepHistory) {
+      // Replay rebuilds the ring from the saved frames alone, so history the
+      // knob cannot reach is cleared rather than left for edge taps to read.
+      impl->engine.buffer.clearHistoryBefore(
+        int(usableBufferSecondsForMode(impl->engine.bufferDurationMode) * args.sampleRate) +
+        temporaldeck_session::kSessionStartRingMarginFrames);
+      header.hasStartRing = true;
+      header.startRingWriteHead = liveRing.writeHead;
+      header.startRingFilled = liveRing.filled;
+      requestLiveRingJob(temporaldeck_lifecycle::TemporalDeckSampleLifecycle::LiveRingJob::SESSION_SNAPSHOT,
+                         args.sampleRate);
+    }
+    impl->sessionRecorder.beginSession(header);
+  }
+
+  if (impl->liveRingJobPending < 0 && impl->pendingLiveToSampleConvert.exchange(false, std::memory_order_relaxed)) {
+    impl->sessionRecorder.endSession();
+    bool sampleModeActive = impl->engine.sampleModeEnabled && impl->engine.sampleLoaded && impl->engine.sampleFrames > 0;
+    if (!sampleModeActive && impl->engine.buffer.filled > 0) {
+      // Copying the window and building its read levels and onsets takes tens
+      // of ms, so the worker does it and the result installs like a loaded file.
+      double lag = std::max(0.0, impl->engine.accessibleLag(params[BUFFER_PARAM].getValue()));
+      requestLiveRingJob(temporaldeck_lifecycle::TemporalDeckSampleLifecycle::LiveRingJob::CONVERT,
+                         impl->cachedSampleRate, int(std::floor(lag)) + 1);
     }
   }
 
@@ -665,7 +997,6 @@ void TemporalDeck::process(const ProcessArgs &args) {
     impl->transportControl, transportButtons, desiredSampleModeEnabled, impl->engine.sampleLoaded);
   if (transportResult.forceSampleTransportPlay) {
     impl->engine.sampleTransportPlaying = true;
-    impl->uiSampleTransportPlaying.store(true, std::memory_order_relaxed);
   }
 
   if (impl->cartridgeCycleTrigger.process(params[CARTRIDGE_CYCLE_PARAM].getValue())) {
@@ -688,14 +1019,34 @@ void TemporalDeck::process(const ProcessArgs &args) {
   impl->engine.slipReturnMode = impl->transportControl.slipReturnMode;
   impl->engine.externalGatePosMode = impl->externalGatePosMode;
   impl->engine.cartridgeCharacter = impl->cartridgeCharacter;
+  impl->engine.cartridgeOversamplingMode = impl->cartridgeOversamplingMode;
+  impl->engine.autoInterpolationCap =
+    impl->governorSlot >= 0 ? TemporalDeckQualityGovernor::instance().tierCap() : int(INTERP_TIER_SINC);
+  impl->engine.profilingEnabled = impl->profilingEnabled.load(std::memory_order_relaxed);
+  if (impl->pendingProfileReset.exchange(false, std::memory_order_relaxed)) {
+    impl->engine.profile = TemporalDeckEngine::Profile();
+  }
   impl->engine.sampleRate = args.sampleRate;
   impl->engine.sampleModeEnabled = desiredSampleModeEnabled;
   impl->engine.sampleLoopEnabled = impl->sampleLoopEnabled.load(std::memory_order_relaxed);
+  impl->engine.sampleSeekSnap = impl->sampleSeekSnap.load(std::memory_order_relaxed);
   uint32_t pendingSeekRevision = impl->pendingSampleSeekRevision.load(std::memory_order_relaxed);
   float pendingSeekNorm = impl->pendingSampleSeekNormalized.load(std::memory_order_relaxed);
   uint32_t pendingLiveSeekRevision = impl->pendingLiveSeekRevision.load(std::memory_order_relaxed);
   float pendingLiveSeekArcNorm = impl->pendingLiveSeekArcNormalized.load(std::memory_order_relaxed);
-  float bufferKnob = params[BUFFER_PARAM].getValue();
+  if (impl->knobClock.tick() || impl->knobs.awaitingReading()) {
+    int glideFrames = impl->knobs.awaitingReading() ? 1 : impl->knobClock.divider;
+    impl->knobs.acquire(KNOB_BUFFER, params[BUFFER_PARAM].getValue());
+    impl->knobs.acquire(KNOB_RATE, params[RATE_PARAM].getValue());
+    if (impl->knobs.acquire(KNOB_MIX, params[MIX_PARAM].getValue())) {
+      impl->mixRamp.glide(impl->knobs.value(KNOB_MIX), glideFrames);
+    }
+    if (impl->knobs.acquire(KNOB_FEEDBACK, params[FEEDBACK_PARAM].getValue())) {
+      impl->feedbackRamp.glide(impl->knobs.value(KNOB_FEEDBACK), glideFrames);
+    }
+    impl->knobs.clearDirty();
+  }
+  float bufferKnob = impl->knobs.value(KNOB_BUFFER);
   impl->appliedSampleSeekRevision = temporaldeck_transport::applyPendingSampleSeek(
     impl->engine, impl->appliedSampleSeekRevision, pendingSeekRevision, pendingSeekNorm, bufferKnob);
   impl->appliedLiveSeekRevision = temporaldeck_transport::applyPendingLiveSeekArc(
@@ -704,10 +1055,10 @@ void TemporalDeck::process(const ProcessArgs &args) {
 
   temporaldeck_frameinput::FrameInputControls controls;
   controls.dt = args.sampleTime;
-  controls.bufferKnob = params[BUFFER_PARAM].getValue();
-  controls.rateKnob = params[RATE_PARAM].getValue();
-  controls.mixKnob = params[MIX_PARAM].getValue();
-  controls.feedbackKnob = params[FEEDBACK_PARAM].getValue();
+  controls.bufferKnob = bufferKnob;
+  controls.rateKnob = impl->knobs.value(KNOB_RATE);
+  controls.mixKnob = impl->mixRamp.advance();
+  controls.feedbackKnob = impl->feedbackRamp.advance();
   controls.freezeButton = impl->transportControl.freezeLatched;
   controls.reverseButton = impl->transportControl.reverseLatched;
   controls.slipButton = impl->transportControl.slipLatched;
@@ -726,35 +1077,113 @@ void TemporalDeck::process(const ProcessArgs &args) {
   TemporalDeckEngine::FrameInput frameInput =
     temporaldeck_frameinput::buildFrameInput(frameSignals, controls, platterInput);
 
+  if (impl->sessionRecorder.active()) {
+    temporaldeck_session::SessionFrame sessionFrame;
+    sessionFrame.input = frameInput;
+    sessionFrame.sampleRate = args.sampleRate;
+    sessionFrame.scratchInterpolationMode = impl->engine.scratchInterpolationMode;
+    sessionFrame.slipReturnMode = impl->engine.slipReturnMode;
+    sessionFrame.externalGatePosMode = impl->engine.externalGatePosMode;
+    sessionFrame.cartridgeCharacter = impl->engine.cartridgeCharacter;
+    sessionFrame.cartridgeOversamplingMode = impl->engine.cartridgeOversamplingMode;
+    sessionFrame.autoInterpolationCap = impl->engine.autoInterpolationCap;
+    sessionFrame.sampleModeEnabled = impl->engine.sampleModeEnabled;
+    sessionFrame.sampleLoopEnabled = impl->engine.sampleLoopEnabled;
+    sessionFrame.sampleSeekSnap = impl->engine.sampleSeekSnap;
+    sessionFrame.sampleSeekRevision = pendingSeekRevision;
+    sessionFrame.sampleSeekNormalized = pendingSeekNorm;
+    sessionFrame.liveSeekRevision = pendingLiveSeekRevision;
+    sessionFrame.liveSeekArcNormalized = pendingLiveSeekArcNorm;
+    impl->sessionRecorder.push(sessionFrame);
+  }
+
+  // Sparse timing of the engine feeds the shared quality governor; one clock
+  // pair every kLoadProbeIntervalFrames keeps the probe itself negligible.
+  bool probeLoad = --impl->loadProbeCountdown <= 0;
+  std::chrono::steady_clock::time_point probeStart;
+  if (probeLoad) {
+    impl->loadProbeCountdown = kLoadProbeIntervalFrames;
+    probeStart = std::chrono::steady_clock::now();
+  }
   auto frame = impl->engine.process(frameInput);
 
+  // Extra heads run after the owner's write and never write themselves. The
+  // platter only steers head 0.
+  int headCount = impl->polyReadHeads.load(std::memory_order_relaxed) ? readHeadCountFor(*this) : 1;
+  setOutputChannels(*this, headCount);
+  for (int h = 1; h < headCount; ++h) {
+    TemporalDeckEngine &tap = *impl->tapEngines[h - 1];
+    if (h > impl->activeTapCount) {
+      tap.restartTapOn(impl->engine);
+    }
+    tap.scratchInterpolationMode = impl->engine.scratchInterpolationMode;
+    tap.slipReturnMode = impl->engine.slipReturnMode;
+    tap.externalGatePosMode = impl->engine.externalGatePosMode;
+    tap.cartridgeCharacter = impl->engine.cartridgeCharacter;
+    tap.cartridgeOversamplingMode = impl->engine.cartridgeOversamplingMode;
+    tap.autoInterpolationCap = impl->engine.autoInterpolationCap;
+    tap.followOwner(impl->engine);
+    TemporalDeckEngine::FrameInput tapInput = temporaldeck_frameinput::buildFrameInput(
+      signalInputsForHead(*this, frameSignals, h), controls, PlatterInputSnapshot());
+    writeFrameOutputs(*this, tap.process(tapInput), h);
+  }
+  impl->activeTapCount = headCount - 1;
+  if (probeLoad) {
+    impl->loadProbeNs +=
+      std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - probeStart).count();
+    if (++impl->loadProbeCount >= kLoadProbesPerPublish) {
+      double loadFraction = impl->loadProbeNs / double(impl->loadProbeCount) * 1e-9 * double(args.sampleRate);
+      TemporalDeckQualityGovernor::instance().publishLoad(impl->governorSlot, float(loadFraction));
+      impl->uiDeckLoad.store(float(loadFraction), std::memory_order_relaxed);
+      impl->loadProbeNs = 0.0;
+      impl->loadProbeCount = 0;
+    }
+  }
+
   temporaldeck_transport::applyAutoFreezeRequest(impl->transportControl, frame.autoFreezeRequested, freezeGateHigh);
 
   writeFrameOutputs(*this, frame);
-  bool freezeActive = impl->transportControl.freezeLatched || freezeGateHigh;
-  updateTransportModeLights(*this, freezeActive, impl->transportControl.reverseLatched, impl->transportControl.slipLatched,
-                            impl->transportControl.slipReturnMode);
-  impl->uiPlatterAngle.store(frame.platterAngle, std::memory_order_relaxed);
-  impl->uiLagSamples.store(frame.lag, std::memory_order_relaxed);
-  impl->uiAccessibleLagSamples.store(frame.accessibleLag, std::memory_order_relaxed);
-  impl->uiSampleRate.store(args.sampleRate, std::memory_order_relaxed);
-  impl->uiFreezeLatched.store(freezeActive, std::memory_order_relaxed);
-  impl->uiSampleModeEnabled.store(frame.sampleMode, std::memory_order_relaxed);
-  impl->uiSampleLoaded.store(frame.sampleLoaded, std::memory_order_relaxed);
-  impl->uiSampleTransportPlaying.store(frame.sampleTransportPlaying, std::memory_order_relaxed);
-  impl->uiSamplePlayheadSeconds.store(frame.samplePlayhead, std::memory_order_relaxed);
-  impl->uiSampleDurationSeconds.store(frame.sampleDuration, std::memory_order_relaxed);
-  impl->uiSampleProgress.store(frame.sampleProgress, std::memory_order_relaxed);
+  impl->outputRecorder.push(frame.outL, frame.outR);
+  if (--impl->uiSnapshotCountdown <= 0) {
+    // One sequence-locked copy per block; lights and readouts are derived on the UI thread.
+    impl->uiSnapshotCountdown = kUiSnapshotIntervalFrames;
+    temporaldeck_ui::UiSnapshot uiState;
+    uiState.lagSamples = frame.lag;
+    uiState.accessibleLagSamples = frame.accessibleLag;
+    uiState.samplePlayheadSeconds = frame.samplePlayhead;
+    uiState.sampleDurationSeconds = frame.sampleDuration;
+    uiState.sampleProgress = frame.sampleProgress;
+    uiState.sampleRate = args.sampleRate;
+    uiState.platterAngle = frame.platterAngle;
+    int bufferMode = impl->bufferDurationMode.load(std::memory_order_relaxed);
+    uiState.maxLagSamples = std::max(1.f, args.sampleRate * usableBufferSecondsForMode(bufferMode));
+    uiState.sampleFrames = impl->engine.sampleFrames;
+    uiState.readHeadCount = headCount;
+    uiState.interpolationTier = impl->engine.activeInterpolationTier;
+    uiState.slipReturnMode = impl->transportControl.slipReturnMode;
+    uiState.freezeLatched = impl->transportControl.freezeLatched || freezeGateHigh;
+    uiState.reverseLatched = impl->transportControl.reverseLatched;
+    uiState.slipLatched = impl->transportControl.slipLatched;
+    uiState.sampleModeEnabled = frame.sampleMode;
+    uiState.sampleLoaded = frame.sampleLoaded;
+    uiState.sampleTransportPlaying = frame.sampleTransportPlaying;
+    impl->uiSnapshot.publish(uiState);
+  }
 
   impl->sampleModeEnabled.store(impl->engine.sampleModeEnabled, std::memory_order_relaxed);
   impl->uiPublishTimerSec += args.sampleTime;
   if (impl->uiPublishTimerSec >= kUiPublishIntervalSec) {
     impl->uiPublishTimerSec = std::fmod(impl->uiPublishTimerSec, kUiPublishIntervalSec);
-    int sampleFrames = impl->engine.sampleFrames;
-    int bufferMode = impl->bufferDurationMode.load(std::memory_order_relaxed);
-    float maxLagSamples = std::max(1.f, args.sampleRate * usableBufferSecondsForMode(bufferMode));
-    temporaldeck_ui::publishArcLights(this, sampleFrames, maxLagSamples, frame.sampleMode, frame.sampleLoaded,
-                                      frame.lag, frame.accessibleLag, frame.sampleProgress);
+    if (impl->engine.profilingEnabled) {
+      const TemporalDeckEngine::Profile &profile = impl->engine.profile;
+      double timedFrames = double(std::max<uint64_t>(1, profile.counters[TemporalDeckEngine::PROFILE_TIMED_FRAMES]));
+      for (int i = 0; i < PROFILE_STAGE_COUNT; ++i) {
+        impl->uiProfileStageNs[i].store(profile.stageNs[i] / timedFrames, std::memory_order_relaxed);
+      }
+      for (int i = 0; i < PROFILE_COUNTER_COUNT; ++i) {
+        impl->uiProfileCounters[i].store(profile.counters[i], std::memory_order_relaxed);
+      }
+    }
   }
 }
 
@@ -774,33 +1203,46 @@ void TemporalDeck::triggerQuickSlipReturn() {
   impl->platterInput.triggerQuickSlipReturn();
 }
 
+void TemporalDeck::refreshPanelLights() {
+  uint32_t sequence = 0;
+  temporaldeck_ui::UiSnapshot snapshot;
+  if (impl->uiSnapshot.sequence() == impl->uiLightsSequence || !impl->uiSnapshot.read(snapshot, &sequence)) {
+    return;
+  }
+  impl->uiLightsSequence = sequence;
+  impl->uiLastSnapshot = snapshot;
+  updateTransportModeLights(*this, snapshot.freezeLatched, snapshot.reverseLatched, snapshot.slipLatched,
+                            snapshot.slipReturnMode);
+  applyArcLightState(*this, temporaldeck_ui::arcLightStateFor(snapshot));
+}
+
 double TemporalDeck::getUiLagSamples() const {
-  return impl->uiLagSamples.load(std::memory_order_relaxed);
+  return impl->readUiSnapshot().lagSamples;
 }
 
 double TemporalDeck::getUiAccessibleLagSamples() const {
-  return impl->uiAccessibleLagSamples.load(std::memory_order_relaxed);
+  return impl->readUiSnapshot().accessibleLagSamples;
 }
 
 float TemporalDeck::getUiSampleRate() const {
-  return impl->uiSampleRate.load(std::memory_order_relaxed);
+  return impl->readUiSnapshot().sampleRate;
 }
 
 float TemporalDeck::getUiPlatterAngle() const {
-  return impl->uiPlatterAngle.load(std::memory_order_relaxed);
+  return impl->readUiSnapshot().platterAngle;
 }
 
 bool TemporalDeck::isUiFreezeLatched() const {
-  return impl->uiFreezeLatched.load(std::memory_order_relaxed);
+  return impl->readUiSnapshot().freezeLatched;
 }
 
 
 bool TemporalDeck::isSampleModeEnabled() const {
-  return impl->uiSampleModeEnabled.load(std::memory_order_relaxed);
+  return impl->readUiSnapshot().sampleModeEnabled;
 }
 
 bool TemporalDeck::hasLoadedSample() const {
-  return impl->uiSampleLoaded.load(std::memory_order_relaxed);
+  return impl->readUiSnapshot().sampleLoaded;
 }
 
 bool TemporalDeck::isSampleAutoPlayOnLoadEnabled() const {
@@ -815,11 +1257,10 @@ void TemporalDeck::setSampleAutoPlayOnLoadEnabled(bool enabled) {
 void TemporalDeck::setSampleModeEnabled(bool enabled) {
   impl->sampleModeEnabled.store(enabled, std::memory_order_relaxed);
   impl->sampleLifecycle.setPendingSampleStateApply();
-  impl->uiSampleModeEnabled.store(enabled && impl->engine.sampleLoaded, std::memory_order_relaxed);
 }
 
 bool TemporalDeck::isSampleTransportPlaying() const {
-  return impl->uiSampleTransportPlaying.load(std::memory_order_relaxed);
+  return impl->readUiSnapshot().sampleTransportPlaying;
 }
 
 bool TemporalDeck::isSampleLoopEnabled() const {
@@ -831,9 +1272,16 @@ void TemporalDeck::setSampleLoopEnabled(bool enabled) {
   impl->engine.sampleLoopEnabled = enabled;
 }
 
+bool TemporalDeck::isSampleSeekSnapEnabled() const {
+  return impl->sampleSeekSnap.load(std::memory_order_relaxed);
+}
+
+void TemporalDeck::setSampleSeekSnapEnabled(bool enabled) {
+  impl->sampleSeekSnap.store(enabled, std::memory_order_relaxed);
+}
+
 void TemporalDeck::setSampleTransportPlaying(bool enabled) {
   impl->engine.sampleTransportPlaying = enabled && impl->engine.sampleLoaded;
-  impl->uiSampleTransportPlaying.store(impl->engine.sampleTransportPlaying, std::memory_order_relaxed);
 }
 
 void TemporalDeck::stopSampleTransport() {
@@ -842,9 +1290,6 @@ void TemporalDeck::stopSampleTransport() {
     impl->engine.samplePlayhead = 0.0;
     impl->engine.readHead = 0.0;
   }
-  impl->uiSampleTransportPlaying.store(false, std::memory_order_relaxed);
-  impl->uiSamplePlayheadSeconds.store(0.0, std::memory_order_relaxed);
-  impl->uiSampleProgress.store(0.0, std::memory_order_relaxed);
 }
 
 void TemporalDeck::clearLoadedSample() {
@@ -923,6 +1368,12 @@ bool TemporalDeck::saveLoadedSampleToPath(const std::string &path, std::string *
     }
     return false;
   }
+  if (impl->engine.sampleStream) {
+    if (errorOut) {
+      *errorOut = "Streamed samples are already saved on disk";
+    }
+    return false;
+  }
   int frames = impl->engine.sampleFrames;
   int channels = impl->engine.buffer.monoStorage ? 1 : 2;
   if (!writeStereoOrMonoWav16(path, impl->engine.buffer.left, impl->engine.buffer.right, frames, channels,
@@ -935,15 +1386,15 @@ bool TemporalDeck::saveLoadedSampleToPath(const std::string &path, std::string *
 }
 
 double TemporalDeck::getUiSamplePlayheadSeconds() const {
-  return impl->uiSamplePlayheadSeconds.load();
+  return impl->readUiSnapshot().samplePlayheadSeconds;
 }
 
 double TemporalDeck::getUiSampleDurationSeconds() const {
-  return impl->uiSampleDurationSeconds.load();
+  return impl->readUiSnapshot().sampleDurationSeconds;
 }
 
 double TemporalDeck::getUiSampleProgress() const {
-  return impl->uiSampleProgress.load();
+  return impl->readUiSnapshot().sampleProgress;
 }
 
 std::string TemporalDeck::getLoadedSampleDisplayName() const {
@@ -966,6 +1417,22 @@ int TemporalDeck::getBufferDurationMode() const {
   return clamp(impl->bufferDurationMode.load(), 0, BUFFER_DURATION_COUNT - 1);
 }
 
+bool TemporalDeck::isCompactLongBuffersEnabled() const {
+  return impl->compactLongBuffers.load();
+}
+
+void TemporalDeck::setCompactLongBuffersEnabled(bool enabled) {
+  impl->compactLongBuffers.store(enabled);
+}
+
+bool TemporalDeck::isSaveLiveBufferEnabled() const {
+  return impl->saveLiveBuffer.load();
+}
+
+void TemporalDeck::setSaveLiveBufferEnabled(bool enabled) {
+  impl->saveLiveBuffer.store(enabled);
+}
+
 bool TemporalDeck::isBufferModeMono() const {
   return isMonoBufferMode(clamp(impl->bufferDurationMode.load(), 0, BUFFER_DURATION_COUNT - 1));
 }
@@ -1023,6 +1490,53 @@ void TemporalDeck::setPlatterTraceLoggingEnabled(bool enabled) {
   impl->platterTraceLoggingEnabled = enabled;
 }
 
+bool TemporalDeck::startSessionRecording(const std::string &path, std::string *errorOut) {
+  if (hasLoadedSample()) {
+    if (errorOut) {
+      *errorOut = "Session recording is only available in live mode";
+    }
+    return false;
+  }
+  impl->sampleLifecycle.setLiveRingSessionPath(temporaldeck_session::sessionStartRingPath(path));
+  return impl->sessionRecorder.start(path, errorOut);
+}
+
+void TemporalDeck::stopSessionRecording() {
+  impl->sessionRecorder.requestStop();
+}
+
+bool TemporalDeck::isSessionRecording() const {
+  return impl->sessionRecorder.isRecording();
+}
+
+bool TemporalDeck::startOutputRecording(const std::string &path, std::string *errorOut) {
+  return impl->outputRecorder.start(path, APP->engine->getSampleRate(), errorOut);
+}
+
+void TemporalDeck::stopOutputRecording() {
+  impl->outputRecorder.requestStop();
+}
+
+bool TemporalDeck::isOutputRecording() const {
+  return impl->outputRecorder.isRecording();
+}
+
+uint64_t TemporalDeck::getOutputRecordingOverruns() const {
+  return impl->outputRecorder.overruns();
+}
+
+bool TemporalDeck::exportCaptureWindow(const std::string &path, std::string *errorOut) {
+  if (isSampleModeEnabled() || hasLoadedSample()) {
+    if (errorOut) {
+      *errorOut = "Capture window export is only available in live mode";
+    }
+    return false;
+  }
+  impl->sampleLifecycle.setLiveRingExportPath(path);
+  impl->pendingLiveExport.store(true, std::memory_order_relaxed);
+  return true;
+}
+
 bool TemporalDeck::isHighQualityScratchInterpolationEnabled() const {
   return impl->scratchInterpolationMode != SCRATCH_INTERP_CUBIC;
 }
@@ -1039,6 +1553,109 @@ void TemporalDeck::setScratchInterpolationMode(int mode) {
   impl->scratchInterpolationMode = clamp(mode, SCRATCH_INTERP_CUBIC, SCRATCH_INTERP_COUNT - 1);
 }
 
+bool TemporalDeck::isPolyReadHeadsEnabled() const {
+  return impl->polyReadHeads.load();
+}
+
+void TemporalDeck::setPolyReadHeadsEnabled(bool enabled) {
+  impl->polyReadHeads.store(enabled);
+}
+
+int TemporalDeck::getActiveReadHeadCount() const {
+  return impl->readUiSnapshot().readHeadCount;
+}
+
+bool TemporalDeck::isProfilingEnabled() const {
+  return impl->profilingEnabled.load();
+}
+
+void TemporalDeck::setProfilingEnabled(bool enabled) {
+  impl->profilingEnabled.store(enabled);
+}
+
+void TemporalDeck::resetProfiling() {
+  impl->pendingProfileReset.store(true);
+}
+
+TemporalDeck::PerformanceSnapshot TemporalDeck::getPerformanceSnapshot() const {
+  static_assert(PROFILE_STAGE_COUNT == TemporalDeckEngine::PROFILE_STAGE_COUNT, "Profile stage count mismatch");
+  static_assert(PROFILE_COUNTER_COUNT == TemporalDeckEngine::PROFILE_COUNTER_COUNT, "Profile counter count mismatch");
+  PerformanceSnapshot snapshot;
+  snapshot.enabled = impl->profilingEnabled.load(std::memory_order_relaxed);
+  snapshot.loadFraction = impl->uiDeckLoad.load(std::memory_order_relaxed);
+  for (int i = 0; i < PROFILE_STAGE_COUNT; ++i) {
+    snapshot.stageNsPerFrame[i] = impl->uiProfileStageNs[i].load(std::memory_order_relaxed);
+  }
+  for (int i = 0; i < PROFILE_COUNTER_COUNT; ++i) {
+    snapshot.counters[i] = impl->uiProfileCounters[i].load(std::memory_order_relaxed);
+  }
+  return snapshot;
+}
+
+json_t *TemporalDeck::performanceToJson() const {
+  static const char *const kStageKeys[PROFILE_STAGE_COUNT] = {"control", "read", "cartridge", "output", "write"};
+  static const char *const kCounterKeys[PROFILE_COUNTER_COUNT] = {
+    "frames", "timedFrames", "slipReturns", "edgeGathers", "readsLinear", "readsCubic", "readsLagrange6", "readsSinc"};
+  PerformanceSnapshot snapshot = getPerformanceSnapshot();
+  json_t *root = json_object();
+  json_object_set_new(root, "moduleId", json_integer(id));
+  json_object_set_new(root, "enabled", json_boolean(snapshot.enabled));
+  json_object_set_new(root, "sampleRate", json_real(impl->readUiSnapshot().sampleRate));
+  json_object_set_new(root, "loadFraction", json_real(snapshot.loadFraction));
+  json_t *stagesJ = json_object();
+  for (int i = 0; i < PROFILE_STAGE_COUNT; ++i) {
+    json_object_set_new(stagesJ, kStageKeys[i], json_real(snapshot.stageNsPerFrame[i]));
+  }
+  json_object_set_new(root, "stageNsPerFrame", stagesJ);
+  json_t *countersJ = json_object();
+  for (int i = 0; i < PROFILE_COUNTER_COUNT; ++i) {
+    json_object_set_new(countersJ, kCounterKeys[i], json_integer(json_int_t(snapshot.counters[i])));
+  }
+  json_object_set_new(root, "counters", countersJ);
+  return root;
+}
+
+bool TemporalDeck::exportPerformanceJson(const std::string &path, std::string *errorOut) const {
+  json_t *root = performanceToJson();
+  int rc = json_dump_file(root, path.c_str(), JSON_INDENT(2));
+  json_decref(root);
+  if (rc != 0) {
+    if (errorOut) {
+      *errorOut = "Failed to write " + path;
+    }
+    return false;
+  }
+  return true;
+}
+
+int TemporalDeck::getActiveInterpolationTier() const {
+  return impl->readUiSnapshot().interpolationTier;
+}
+
+int TemporalDeck::getQualityGovernorTierCap() const {
+  return TemporalDeckQualityGovernor::instance().tierCap();
+}
+
+float TemporalDeck::getQualityGovernorLoad() const {
+  return TemporalDeckQualityGovernor::instance().aggregateLoad();
+}
+
+float TemporalDeck::getQualityBudget() const {
+  return TemporalDeckQualityGovernor::instance().budget();
+}
+
+void TemporalDeck::setQualityBudget(float loadFraction) {
+  TemporalDeckQualityGovernor::instance().setBudget(loadFraction);
+}
+
+int TemporalDeck::getCartridgeOversamplingMode() const {
+  return impl->cartridgeOversamplingMode;
+}
+
+void TemporalDeck::setCartridgeOversamplingMode(int mode) {
+  impl->cartridgeOversamplingMode = clamp(mode, CARTRIDGE_OVERSAMPLING_OFF, CARTRIDGE_OVERSAMPLING_COUNT - 1);
+}
+
 void TemporalDeck::setSlipLatched(bool enabled) {
   impl->transportControl.slipLatched = enabled;
   if (enabled) {
@@ -1106,12 +1723,80 @@ const char *TemporalDeck::scratchInterpolationLabelFor(int index) {
     return "6-point Lagrange";
   case SCRATCH_INTERP_SINC:
     return "Sinc (CPU heavy)";
+  case SCRATCH_INTERP_AUTO:
+    return "Auto (speed + CPU adaptive)";
   case SCRATCH_INTERP_CUBIC:
   default:
     return "Cubic";
   }
 }
 
+const char *TemporalDeck::interpolationTierLabelFor(int index) {
+  switch (index) {
+  case INTERP_TIER_LINEAR:
+    return "Linear";
+  case INTERP_TIER_LAGRANGE6:
+    return "6-point Lagrange";
+  case INTERP_TIER_SINC:
+    return "Sinc";
+  case INTERP_TIER_CUBIC:
+  default:
+    return "Cubic";
+  }
+}
+
+const char *TemporalDeck::profileStageLabelFor(int index) {
+  switch (index) {
+  case TemporalDeckEngine::PROFILE_STAGE_CONTROL:
+    return "Transport/slip";
+  case TemporalDeckEngine::PROFILE_STAGE_READ:
+    return "Interpolation";
+  case TemporalDeckEngine::PROFILE_STAGE_CARTRIDGE:
+    return "Cartridge";
+  case TemporalDeckEngine::PROFILE_STAGE_OUTPUT:
+    return "Tone/mix";
+  case TemporalDeckEngine::PROFILE_STAGE_WRITE:
+    return "Buffer write";
+  default:
+    return "";
+  }
+}
+
+const char *TemporalDeck::profileCounterLabelFor(int index) {
+  switch (index) {
+  case TemporalDeckEngine::PROFILE_FRAMES:
+    return "Frames";
+  case TemporalDeckEngine::PROFILE_TIMED_FRAMES:
+    return "Timed frames";
+  case TemporalDeckEngine::PROFILE_SLIP_RETURNS:
+    return "Slip returns";
+  case TemporalDeckEngine::PROFILE_EDGE_GATHERS:
+    return "Edge-gather reads";
+  case TemporalDeckEngine::PROFILE_READS_LINEAR:
+    return "Linear reads";
+  case TemporalDeckEngine::PROFILE_READS_CUBIC:
+    return "Cubic reads";
+  case TemporalDeckEngine::PROFILE_READS_LAGRANGE6:
+    return "Lagrange reads";
+  case TemporalDeckEngine::PROFILE_READS_SINC:
+    return "Sinc reads";
+  default:
+    return "";
+  }
+}
+
+const char *TemporalDeck::cartridgeOversamplingLabelFor(int index) {
+  switch (index) {
+  case CARTRIDGE_OVERSAMPLING_2X:
+    return "2x";
+  case CARTRIDGE_OVERSAMPLING_4X:
+    return "4x (CPU heavy)";
+  case CARTRIDGE_OVERSAMPLING_OFF:
+  default:
+    return "Off";
+  }
+}
+
 const char *TemporalDeck::slipReturnLabelFor(int index) {
   switch (index) {
   case SLIP_RETURN_SLOW:
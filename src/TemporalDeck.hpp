@@ -23,7 +23,36 @@ struct TemporalDeck final : Module {
   static constexpr int SCRATCH_INTERP_CUBIC = 0;
   static constexpr int SCRATCH_INTERP_LAGRANGE6 = 1;
   static constexpr int SCRATCH_INTERP_SINC = 2;
-  static constexpr int SCRATCH_INTERP_COUNT = 3;
+  static constexpr int SCRATCH_INTERP_AUTO = 3;
+  static constexpr int SCRATCH_INTERP_COUNT = 4;
+
+  static constexpr int INTERP_TIER_LINEAR = 0;
+  static constexpr int INTERP_TIER_CUBIC = 1;
+  static constexpr int INTERP_TIER_LAGRANGE6 = 2;
+  static constexpr int INTERP_TIER_SINC = 3;
+  static constexpr int INTERP_TIER_COUNT = 4;
+
+  // Aggregate DSP load, as a share of one core, at which the governor starts
+  // stepping every Auto deck down a tier.
+  static constexpr int QUALITY_BUDGET_COUNT = 4;
+  static constexpr float kQualityBudgetOptions[QUALITY_BUDGET_COUNT] = {0.10f, 0.25f, 0.50f, 1.00f};
+  static constexpr int kLoadProbeIntervalFrames = 16;
+  static constexpr int kLoadProbesPerPublish = 256;
+
+  // Frames between reads of the BUFFER/RATE/MIX/FEEDBACK knobs.
+  static constexpr int kKnobControlDivider = 16;
+  // Poly POS/RATE/S.GATE channels each get a read head on the shared ring.
+  static constexpr int kMaxReadHeads = 16;
+
+  static constexpr int CARTRIDGE_OVERSAMPLING_OFF = 0;
+  static constexpr int CARTRIDGE_OVERSAMPLING_2X = 1;
+  static constexpr int CARTRIDGE_OVERSAMPLING_4X = 2;
+  static constexpr int CARTRIDGE_OVERSAMPLING_COUNT = 3;
+
+  // Performance submenu rows, in TemporalDeckEngine::ProfileStage and
+  // ProfileCounter order.
+  static constexpr int PROFILE_STAGE_COUNT = 5;
+  static constexpr int PROFILE_COUNTER_COUNT = 8;
 
   static constexpr int SLIP_RETURN_SLOW = 0;
   static constexpr int SLIP_RETURN_NORMAL = 1;
@@ -60,8 +89,18 @@ struct TemporalDeck final : Module {
 
   static constexpr float kUiPublishRateHz = 120.f;
   static constexpr float kUiPublishIntervalSec = 1.f / kUiPublishRateHz;
+  // Frames per UI snapshot; the audio thread's only per-block UI work.
+  static constexpr int kUiSnapshotIntervalFrames = 32;
   static constexpr int kArcLightCount = 31;
 
+  struct PerformanceSnapshot {
+    bool enabled = false;
+    // Whole-deck share of one core from the governor's load probe.
+    float loadFraction = 0.f;
+    double stageNsPerFrame[PROFILE_STAGE_COUNT] = {};
+    uint64_t counters[PROFILE_COUNTER_COUNT] = {};
+  };
+
   enum ParamId {
     BUFFER_PARAM,
     RATE_PARAM,
@@ -101,13 +140,19 @@ struct TemporalDeck final : Module {
   static const char *cartridgeLabelFor(int index);
   static CartridgeVisualStyle cartridgeVisualStyleFor(int index);
   static const char *scratchInterpolationLabelFor(int index);
+  static const char *interpolationTierLabelFor(int index);
+  static const char *cartridgeOversamplingLabelFor(int index);
   static const char *slipReturnLabelFor(int index);
   static const char *bufferDurationLabelFor(int index);
   static const char *externalGatePosLabelFor(int index);
   static const char *platterArtModeLabelFor(int index);
   static const char *platterBrightnessLabelFor(int index);
+  static const char *profileStageLabelFor(int index);
+  static const char *profileCounterLabelFor(int index);
 
   void onSampleRateChange() override;
+  void onSave(const SaveEvent &e) override;
+  void onAdd(const AddEvent &e) override;
   json_t *dataToJson() override;
   void dataFromJson(json_t *root) override;
   void process(const ProcessArgs &args) override;
@@ -120,6 +165,10 @@ struct TemporalDeck final : Module {
   void addPlatterWheelDelta(float delta, int holdSamples);
   void triggerQuickSlipReturn();
 
+  // UI thread: turns the latest snapshot into arc, freeze, reverse and slip
+  // light brightness. Called from the widget's step().
+  void refreshPanelLights();
+
   double getUiLagSamples() const;
   double getUiAccessibleLagSamples() const;
   float getUiSampleRate() const;
@@ -134,6 +183,8 @@ struct TemporalDeck final : Module {
   void setSampleTransportPlaying(bool enabled);
   bool isSampleLoopEnabled() const;
   void setSampleLoopEnabled(bool enabled);
+  bool isSampleSeekSnapEnabled() const;
+  void setSampleSeekSnapEnabled(bool enabled);
   void stopSampleTransport();
   void clearLoadedSample();
   bool loadSampleFromPath(const std::string &path, std::string *errorOut = nullptr);
@@ -153,6 +204,13 @@ struct TemporalDeck final : Module {
 
   int getBufferDurationMode() const;
   bool isBufferModeMono() const;
+  bool isCompactLongBuffersEnabled() const;
+  void setCompactLongBuffersEnabled(bool enabled);
+  bool isSaveLiveBufferEnabled() const;
+  void setSaveLiveBufferEnabled(bool enabled);
+  bool isPolyReadHeadsEnabled() const;
+  void setPolyReadHeadsEnabled(bool enabled);
+  int getActiveReadHeadCount() const;
   bool consumePendingInitialPlatterArtSelection();
   int getPlatterArtMode() const;
   void setPlatterArtMode(int mode);
@@ -164,11 +222,36 @@ struct TemporalDeck final : Module {
 
   bool isPlatterTraceLoggingEnabled() const;
   void setPlatterTraceLoggingEnabled(bool enabled);
+  bool startSessionRecording(const std::string &path, std::string *errorOut = nullptr);
+  void stopSessionRecording();
+  bool isSessionRecording() const;
+  // Records head 0's output to a WAV or FLAC file until stopped or the engine
+  // rate changes.
+  bool startOutputRecording(const std::string &path, std::string *errorOut = nullptr);
+  void stopOutputRecording();
+  bool isOutputRecording() const;
+  uint64_t getOutputRecordingOverruns() const;
+  // Writes the live window under the buffer knob to a WAV or FLAC file on the
+  // sample worker.
+  bool exportCaptureWindow(const std::string &path, std::string *errorOut = nullptr);
 
   bool isHighQualityScratchInterpolationEnabled() const;
   void setHighQualityScratchInterpolationEnabled(bool enabled);
   int getScratchInterpolationMode() const;
   void setScratchInterpolationMode(int mode);
+  int getActiveInterpolationTier() const;
+  int getQualityGovernorTierCap() const;
+  float getQualityGovernorLoad() const;
+  float getQualityBudget() const;
+  void setQualityBudget(float loadFraction);
+  bool isProfilingEnabled() const;
+  void setProfilingEnabled(bool enabled);
+  void resetProfiling();
+  PerformanceSnapshot getPerformanceSnapshot() const;
+  json_t *performanceToJson() const;
+  bool exportPerformanceJson(const std::string &path, std::string *errorOut = nullptr) const;
+  int getCartridgeOversamplingMode() const;
+  void setCartridgeOversamplingMode(int mode);
   void setSlipLatched(bool enabled);
   int getSlipReturnMode() const;
   void setSlipReturnMode(int mode);
@@ -176,7 +259,8 @@ struct TemporalDeck final : Module {
   void setExternalGatePosMode(int mode);
 
 private:
-  void applySampleRateChange(float sampleRate);
+  void applySampleRateChange(float sampleRate, bool keepLiveRing = false);
+  void requestLiveRingJob(int type, float targetSampleRate, int frames = -1);
 
   struct Impl;
   std::unique_ptr<Impl> impl;
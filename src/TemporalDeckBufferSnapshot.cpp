@@ -0,0 +1,348 @@
+#include "TemporalDeckBufferSnapshot.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace temporaldeck {
+
+namespace {
+
+static constexpr char kSnapshotMagic[8] = {'T', 'D', 'L', 'I', 'V', 'E', 'B', '\0'};
+static constexpr uint32_t kSnapshotVersion = 1;
+static constexpr size_t kSnapshotHeaderBytes = 8 + 5 * 4;
+// Encoded bytes are flushed to disk roughly this often.
+static constexpr size_t kWriteChunkBytes = 256 * 1024;
+static constexpr int kPollFrames = 4096;
+
+void setError(std::string *errorOut, const char *message) {
+  if (errorOut) {
+    *errorOut = message;
+  }
+}
+
+// Sign-magnitude float bits to an integer that orders like the float
+// (-0 maps to -1).
+int64_t orderedFromFloat(float v) {
+  uint32_t bits;
+  std::memcpy(&bits, &v, sizeof(bits));
+  int64_t magnitude = int64_t(bits & 0x7FFFFFFFu);
+  return (bits & 0x80000000u) ? -magnitude - 1 : magnitude;
+}
+
+float floatFromOrdered(int64_t o) {
+  uint32_t bits = o < 0 ? (uint32_t(-(o + 1)) | 0x80000000u) : uint32_t(o);
+  float v;
+  std::memcpy(&v, &bits, sizeof(v));
+  return v;
+}
+
+void appendLe32(std::vector<uint8_t> *out, uint32_t v) {
+  for (int i = 0; i < 4; ++i) {
+    out->push_back(uint8_t(v >> (8 * i)));
+  }
+}
+
+uint32_t readLe32(const uint8_t *p) {
+  return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+void appendVarint64(std::vector<uint8_t> *out, uint64_t v) {
+  while (v >= 0x80u) {
+    out->push_back(uint8_t(v | 0x80u));
+    v >>= 7;
+  }
+  out->push_back(uint8_t(v));
+}
+
+bool readVarint64(const uint8_t *bytes, size_t *pos, size_t end, uint64_t *v) {
+  uint64_t result = 0;
+  for (int shift = 0; shift < 64 && *pos < end; shift += 7) {
+    uint8_t b = bytes[(*pos)++];
+    result |= uint64_t(b & 0x7Fu) << shift;
+    if (!(b & 0x80u)) {
+      *v = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Fixed order-2 predictor; encoder and decoder run the same state.
+struct ChannelPredictor {
+  int64_t prev1 = 0;
+  int64_t prev2 = 0;
+
+  int64_t predict() const { return 2 * prev1 - prev2; }
+  void push(int64_t v) {
+    prev2 = prev1;
+    prev1 = v;
+  }
+};
+
+uint64_t zigzag(int64_t v) {
+  return (uint64_t(v) << 1) ^ uint64_t(v >> 63);
+}
+
+int64_t unzigzag(uint64_t v) {
+  return int64_t(v >> 1) ^ -int64_t(v & 1u);
+}
+
+#ifdef _WIN32
+// Patch storage paths are UTF-8; the ANSI Win32 calls would mangle anything
+// outside the active code page.
+std::wstring widenPath(const std::string &path) {
+  int count = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, NULL, 0);
+  if (count <= 0) {
+    return std::wstring();
+  }
+  std::wstring wide(size_t(count), L'\0');
+  MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &wide[0], count);
+  wide.resize(size_t(count - 1));
+  return wide;
+}
+#endif
+
+std::FILE *openFile(const std::string &path, const char *mode) {
+#ifdef _WIN32
+  std::wstring wideMode(mode, mode + std::strlen(mode));
+  return _wfopen(widenPath(path).c_str(), wideMode.c_str());
+#else
+  return std::fopen(path.c_str(), mode);
+#endif
+}
+
+void removeFile(const std::string &path) {
+#ifdef _WIN32
+  _wremove(widenPath(path).c_str());
+#else
+  std::remove(path.c_str());
+#endif
+}
+
+struct MappedFile {
+  const uint8_t *data = nullptr;
+  size_t size = 0;
+#ifdef _WIN32
+  HANDLE file = INVALID_HANDLE_VALUE;
+  HANDLE mapping = NULL;
+#else
+  int fd = -1;
+#endif
+
+  bool open(const std::string &path) {
+#ifdef _WIN32
+    file = CreateFileW(widenPath(path).c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+      return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0) {
+      return false;
+    }
+    size = size_t(fileSize.QuadPart);
+    mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping) {
+      return false;
+    }
+    data = static_cast<const uint8_t *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    return data != nullptr;
+#else
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+      return false;
+    }
+    size = size_t(st.st_size);
+    void *p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+      return false;
+    }
+    data = static_cast<const uint8_t *>(p);
+    // Decoding is one sequential pass.
+    madvise(p, size, MADV_SEQUENTIAL);
+    return true;
+#endif
+  }
+
+  ~MappedFile() {
+#ifdef _WIN32
+    if (data) {
+      UnmapViewOfFile(data);
+    }
+    if (mapping) {
+      CloseHandle(mapping);
+    }
+    if (file != INVALID_HANDLE_VALUE) {
+      CloseHandle(file);
+    }
+#else
+    if (data) {
+      munmap(const_cast<uint8_t *>(data), size);
+    }
+    if (fd >= 0) {
+      ::close(fd);
+    }
+#endif
+  }
+};
+
+bool replaceFile(const std::string &from, const std::string &to) {
+#ifdef _WIN32
+  return MoveFileExW(widenPath(from).c_str(), widenPath(to).c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+} // namespace
+
+bool writeRingSnapshot(const std::string &path, const TemporalDeckBuffer &ring, int endIndex, int frames,
+                       int bufferMode, const std::function<bool(int)> &keepGoing, std::string *errorOut) {
+  frames = std::max(0, std::min(frames, ring.size));
+  std::string tmpPath = path + ".tmp";
+  std::FILE *file = openFile(tmpPath, "wb");
+  if (!file) {
+    setError(errorOut, "Failed to open snapshot for writing");
+    return false;
+  }
+  int channels = ring.monoStorage ? 1 : 2;
+  std::vector<uint8_t> bytes;
+  bytes.reserve(kWriteChunkBytes + 64);
+  bytes.insert(bytes.end(), kSnapshotMagic, kSnapshotMagic + 8);
+  appendLe32(&bytes, kSnapshotVersion);
+  uint32_t rateBits;
+  std::memcpy(&rateBits, &ring.sampleRate, sizeof(rateBits));
+  appendLe32(&bytes, rateBits);
+  appendLe32(&bytes, uint32_t(bufferMode));
+  appendLe32(&bytes, uint32_t(channels));
+  appendLe32(&bytes, uint32_t(frames));
+
+  bool ok = true;
+  ChannelPredictor predictL;
+  ChannelPredictor predictR;
+  int oldest = endIndex - frames;
+  for (int i = 0; i < frames && ok; ++i) {
+    if (i % kPollFrames == 0 && keepGoing && !keepGoing(i)) {
+      setError(errorOut, "Snapshot abandoned");
+      ok = false;
+      break;
+    }
+    int idx = ring.wrapIndex(oldest + i);
+    int64_t l = orderedFromFloat(ring.leftSample(idx));
+    appendVarint64(&bytes, zigzag(l - predictL.predict()));
+    predictL.push(l);
+    if (channels > 1) {
+      int64_t r = orderedFromFloat(ring.rightSample(idx));
+      appendVarint64(&bytes, zigzag(r - predictR.predict()));
+      predictR.push(r);
+    }
+    if (bytes.size() >= kWriteChunkBytes) {
+      ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+      bytes.clear();
+    }
+  }
+  if (ok && keepGoing && !keepGoing(frames)) {
+    setError(errorOut, "Snapshot abandoned");
+    ok = false;
+  }
+  if (ok && !bytes.empty()) {
+    ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+  }
+  ok = (std::fclose(file) == 0) && ok;
+  if (ok && !replaceFile(tmpPath, path)) {
+    setError(errorOut, "Failed to replace snapshot");
+    ok = false;
+  }
+  if (!ok) {
+    removeFile(tmpPath);
+  }
+  return ok;
+}
+
+bool readRingSnapshot(const std::string &path, bool compactLongBuffers, TemporalDeckBuffer *out,
+                      RingSnapshotInfo *infoOut, std::string *errorOut) {
+  if (!out) {
+    return false;
+  }
+  MappedFile file;
+  if (!file.open(path)) {
+    setError(errorOut, "Failed to map snapshot");
+    return false;
+  }
+  if (file.size < kSnapshotHeaderBytes || std::memcmp(file.data, kSnapshotMagic, 8) != 0) {
+    setError(errorOut, "Not a live buffer snapshot");
+    return false;
+  }
+  const uint8_t *p = file.data + 8;
+  if (readLe32(p) != kSnapshotVersion) {
+    setError(errorOut, "Unsupported snapshot version");
+    return false;
+  }
+  RingSnapshotInfo info;
+  uint32_t rateBits = readLe32(p + 4);
+  std::memcpy(&info.sampleRate, &rateBits, sizeof(rateBits));
+  info.bufferMode = int(readLe32(p + 8));
+  int channels = int(readLe32(p + 12));
+  info.frames = int(readLe32(p + 16));
+  info.monoStorage = channels == 1;
+  if (!(info.sampleRate > 1.f && info.sampleRate < 1e6f) || info.bufferMode < 0 ||
+      info.bufferMode >= TemporalDeckEngine::BUFFER_DURATION_COUNT || (channels != 1 && channels != 2) ||
+      info.monoStorage != isMonoBufferMode(info.bufferMode) || info.frames < 0) {
+    setError(errorOut, "Corrupt snapshot header");
+    return false;
+  }
+
+  out->resetForMode(info.sampleRate, info.bufferMode, compactLongBuffers);
+  if (info.frames > out->size) {
+    setError(errorOut, "Snapshot longer than its buffer mode");
+    return false;
+  }
+  size_t pos = kSnapshotHeaderBytes;
+  ChannelPredictor predictL;
+  ChannelPredictor predictR;
+  for (int i = 0; i < info.frames; ++i) {
+    uint64_t code = 0;
+    if (!readVarint64(file.data, &pos, file.size, &code)) {
+      setError(errorOut, "Truncated snapshot");
+      return false;
+    }
+    int64_t l = predictL.predict() + unzigzag(code);
+    predictL.push(l);
+    int64_t r = l;
+    if (channels > 1) {
+      if (!readVarint64(file.data, &pos, file.size, &code)) {
+        setError(errorOut, "Truncated snapshot");
+        return false;
+      }
+      r = predictR.predict() + unzigzag(code);
+      predictR.push(r);
+    }
+    out->write(floatFromOrdered(l), floatFromOrdered(r));
+  }
+  if (infoOut) {
+    *infoOut = info;
+  }
+  return true;
+}
+
+} // namespace temporaldeck
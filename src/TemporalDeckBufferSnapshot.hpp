@@ -0,0 +1,33 @@
+#pragma once
+
+#include "TemporalDeckEngine.hpp"
+
+#include <functional>
+#include <string>
+
+namespace temporaldeck {
+
+// Live ring history saved alongside a patch. Frames are stored oldest first as
+// a fixed second-order (FLAC-style) prediction over an order-preserving integer
+// view of each float, zigzag/varint coded, so the round trip is bit-exact and
+// independent of the host's floating-point state.
+struct RingSnapshotInfo {
+  float sampleRate = 44100.f;
+  int bufferMode = TemporalDeckEngine::BUFFER_DURATION_10S;
+  bool monoStorage = false;
+  int frames = 0;
+};
+
+// Encodes the `frames` frames behind `endIndex` to `path` (via a temporary
+// file and rename, so readers never see a partial snapshot). `keepGoing` is
+// polled between blocks with the number of frames encoded so far; returning
+// false abandons the write.
+bool writeRingSnapshot(const std::string &path, const TemporalDeckBuffer &ring, int endIndex, int frames,
+                       int bufferMode, const std::function<bool(int)> &keepGoing, std::string *errorOut = nullptr);
+
+// Memory-maps `path` and decodes it into `out`, which is reset for the saved
+// rate and mode first.
+bool readRingSnapshot(const std::string &path, bool compactLongBuffers, TemporalDeckBuffer *out,
+                      RingSnapshotInfo *infoOut = nullptr, std::string *errorOut = nullptr);
+
+} // namespace temporaldeck
@@ -4,8 +4,12 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -30,10 +34,13 @@ inline float usableBufferSecondsForMode(int index) { return std::max(1.f, realBu
 
 inline bool isMonoBufferMode(int index) { return index == 3; }
 
+inline bool isLongBufferMode(int index) { return index == 2 || index == 3; }
+
 } // namespace temporaldeck_modes
 
 namespace temporaldeck {
 
+using temporaldeck_modes::isLongBufferMode;
 using temporaldeck_modes::isMonoBufferMode;
 using temporaldeck_modes::realBufferSecondsForMode;
 using temporaldeck_modes::usableBufferSecondsForMode;
@@ -70,68 +77,801 @@ inline T crossfade(T a, T b, U x) {
   return a + (b - a) * x;
 }
 
+// Frame position in 32.32 fixed point: index in the high word, fraction in the
+// low word. Wrapping is an integer compare and the index/fraction split is
+// exact, so a head advanced by the same step lands on the same bits however
+// long it runs. Reads and assigns as a double for everything else.
+constexpr double kPositionUnit = 4294967296.0;
+constexpr double kPositionMaxFrames = 2147483647.0;
+
+struct TemporalDeckPosition {
+  int64_t raw = 0;
+
+  TemporalDeckPosition() = default;
+  TemporalDeckPosition(double pos) : raw(rawFrom(pos)) {}
+  operator double() const { return double(raw) * (1.0 / kPositionUnit); }
+
+  static int64_t rawFrom(double frames) {
+    return int64_t(std::llround(std::max(-kPositionMaxFrames, std::min(frames, kPositionMaxFrames)) * kPositionUnit));
+  }
+  static int64_t span(int length) { return int64_t(length) << 32; }
+  static TemporalDeckPosition fromRaw(int64_t raw) {
+    TemporalDeckPosition pos;
+    pos.raw = raw;
+    return pos;
+  }
+
+  int index() const { return int(raw >> 32); }
+  float fraction() const { return float(double(uint32_t(raw)) * (1.0 / kPositionUnit)); }
+
+  // Into [0, length). Steps shorter than the length take one add or subtract.
+  void wrap(int length) {
+    if (length <= 0) {
+      raw = 0;
+      return;
+    }
+    int64_t s = span(length);
+    if (raw >= s) {
+      raw -= s;
+    } else if (raw < 0) {
+      raw += s;
+    }
+    if (raw < 0 || raw >= s) {
+      raw %= s;
+      raw += raw < 0 ? s : 0;
+    }
+  }
+
+  // Distance back from this position to `pos` on a ring of `length`, in
+  // [0, length) raw units.
+  int64_t distanceBackTo(TemporalDeckPosition pos, int length) const {
+    TemporalDeckPosition lag = fromRaw(raw - pos.raw);
+    lag.wrap(length);
+    return lag.raw;
+  }
+};
+
+// IEEE 754 binary16 conversion for compact buffer storage. Round-to-nearest-even
+// on the way in (values past the half range saturate to +/-65504); the way
+// out is a shift plus one exponent-rebias multiply, which also covers
+// subnormals without branching.
+inline uint16_t floatToHalf(float value) {
+  uint32_t f;
+  std::memcpy(&f, &value, sizeof(f));
+  uint32_t sign = (f >> 16) & 0x8000u;
+  f &= 0x7FFFFFFFu;
+  uint32_t h;
+  if (f >= 0x477FF000u) {
+    // Rounds to >= 65520 (or Inf/NaN): clamp to the largest finite half.
+    h = 0x7BFFu;
+  } else if (f < 0x38800000u) {
+    // Subnormal half: let the FPU round by adding 0.5 and reading the low bits.
+    float magnitude;
+    std::memcpy(&magnitude, &f, sizeof(magnitude));
+    float shifted = magnitude + 0.5f;
+    uint32_t bits;
+    std::memcpy(&bits, &shifted, sizeof(bits));
+    h = bits - 0x3F000000u;
+  } else {
+    uint32_t mantissaOdd = (f >> 13) & 1u;
+    f += (uint32_t(15 - 127) << 23) + 0xFFFu + mantissaOdd;
+    h = f >> 13;
+  }
+  return uint16_t(h | sign);
+}
+
+inline float halfToFloat(uint16_t h) {
+  uint32_t bits = uint32_t(h & 0x7FFFu) << 13;
+  float magnitude;
+  std::memcpy(&magnitude, &bits, sizeof(magnitude));
+  magnitude *= 5.192296858534828e33f; // 2^112: rebias exponent 15 -> 127
+  uint32_t out;
+  std::memcpy(&out, &magnitude, sizeof(out));
+  out |= uint32_t(h & 0x8000u) << 16;
+  float result;
+  std::memcpy(&result, &out, sizeof(result));
+  return result;
+}
+
+// Linear-phase halfband lowpass shared by the cartridge oversampler and the
+// buffer mip levels. Every
+// even tap except the centre (0.5) is zero, so only the odd taps are kept:
+// oddTaps[j] weights offsets +/-(2j + 1).
+static constexpr int kHalfbandOddTaps = 8;
+static_assert((kHalfbandOddTaps & (kHalfbandOddTaps - 1)) == 0, "halfband rings use power-of-two masks");
+
+struct HalfbandKernel {
+  float oddTaps[kHalfbandOddTaps];
+};
+
+inline const HalfbandKernel &halfbandKernel() {
+  static const HalfbandKernel kernel = [] {
+    constexpr double kPiD = 3.14159265358979323846;
+    const double windowHalfLength = 2.0 * kHalfbandOddTaps;
+    double taps[kHalfbandOddTaps];
+    double oddSum = 0.0;
+    for (int j = 0; j < kHalfbandOddTaps; ++j) {
+      double n = double(2 * j + 1);
+      double sinc = std::sin(kPiD * n * 0.5) / (kPiD * n * 0.5);
+      // 4-term Blackman-Harris, zero at +/-windowHalfLength.
+      double x = (n + windowHalfLength) / (2.0 * windowHalfLength);
+      double w = 0.35875 - 0.48829 * std::cos(2.0 * kPiD * x) + 0.14128 * std::cos(4.0 * kPiD * x) -
+                 0.01168 * std::cos(6.0 * kPiD * x);
+      taps[j] = 0.5 * sinc * w;
+      oddSum += 2.0 * taps[j];
+    }
+    // Odd taps sum to 0.5 so both polyphase branches have exact unity DC gain.
+    HalfbandKernel k;
+    for (int j = 0; j < kHalfbandOddTaps; ++j) {
+      k.oddTaps[j] = float(taps[j] * 0.5 / oddSum);
+    }
+    return k;
+  }();
+  return kernel;
+}
+
+// Stereo 2x polyphase halfband interpolator/decimator pair. upsample() turns
+// one base-rate frame into two high-rate frames, downsample() folds two back
+// into one; only the non-zero odd branch is ever multiplied. A round trip
+// delays the signal by 2 * kHalfbandOddTaps - 1 base-rate samples.
+//
+// Histories are mirrored rings (every write lands at i and i + length) so the
+// filter always reads one contiguous newest-first window without shifting.
+struct HalfbandStereoStage {
+  static constexpr int kUpHistory = 2 * kHalfbandOddTaps;
+  static constexpr int kDownHistory = 4 * kHalfbandOddTaps;
+  float up[2][2 * kUpHistory] = {};
+  float down[2][2 * kDownHistory] = {};
+  int upPos = 0;
+  int downPos = 0;
+
+  void reset() {
+    for (int c = 0; c < 2; ++c) {
+      std::fill(up[c], up[c] + 2 * kUpHistory, 0.f);
+      std::fill(down[c], down[c] + 2 * kDownHistory, 0.f);
+    }
+    upPos = 0;
+    downPos = 0;
+  }
+
+  void upsample(const float x[2], float out0[2], float out1[2]) {
+    const HalfbandKernel &k = halfbandKernel();
+    constexpr int kCentre = kHalfbandOddTaps;
+    upPos = (upPos + kUpHistory - 1) & (kUpHistory - 1);
+    for (int c = 0; c < 2; ++c) {
+      up[c][upPos] = x[c];
+      up[c][upPos + kUpHistory] = x[c];
+      const float *h = up[c] + upPos;
+      float odd = 0.f;
+      for (int j = 0; j < kHalfbandOddTaps; ++j) {
+        odd += k.oddTaps[j] * (h[kCentre + j] + h[kCentre - 1 - j]);
+      }
+      out0[c] = h[kCentre];
+      out1[c] = 2.f * odd;
+    }
+  }
+
+  void downsample(const float v0[2], const float v1[2], float out[2]) {
+    const HalfbandKernel &k = halfbandKernel();
+    constexpr int kCentre = 2 * kHalfbandOddTaps - 1;
+    downPos = (downPos + kDownHistory - 2) & (kDownHistory - 1);
+    for (int c = 0; c < 2; ++c) {
+      float *ring = down[c];
+      ring[downPos] = v1[c];
+      ring[downPos + kDownHistory] = v1[c];
+      ring[downPos + 1] = v0[c];
+      ring[downPos + 1 + kDownHistory] = v0[c];
+      const float *h = ring + downPos;
+      float odd = 0.f;
+      for (int j = 0; j < kHalfbandOddTaps; ++j) {
+        odd += k.oddTaps[j] * (h[kCentre - 1 - 2 * j] + h[kCentre + 1 + 2 * j]);
+      }
+      out[c] = 0.5f * h[kCentre] + odd;
+    }
+  }
+};
+
+// Read-speed levels of detail. Level k (1..kMipLevels) holds the timeline
+// halfband-filtered and decimated by 2^k, with its sample j centred on base
+// sample j << k, so a base-rate position maps to pos / 2^k on every level.
+static constexpr int kMipLevels = 3;
+static constexpr double kMipLodBias = 0.5;
+
+// Fractional level for a read advancing `speed` base samples per output
+// sample. Past 2x the pick sits half a level up (ramping in from 1x) so the
+// level in use is already band-limited for the speed, not an octave behind.
+inline float mipLodForSpeed(double speed) {
+  double absSpeed = std::fabs(speed);
+  if (absSpeed <= 1.0) {
+    return 0.f;
+  }
+  double octaves = std::log2(absSpeed);
+  return float(std::min(octaves + kMipLodBias * std::min(octaves, 1.0), double(kMipLevels)));
+}
+
+struct TemporalDeckMipLevels {
+  std::vector<float> left[kMipLevels];
+  // Empty for mono timelines; readers use left for both channels.
+  std::vector<float> right[kMipLevels];
+
+  bool empty() const { return left[0].empty(); }
+
+  void clear() {
+    for (int k = 0; k < kMipLevels; ++k) {
+      std::vector<float>().swap(left[k]);
+      std::vector<float>().swap(right[k]);
+    }
+  }
+};
+
+// Zero-phase halfband decimation of a finished channel; edges hold the first
+// and last frame.
+inline void decimateHalfband(const std::vector<float> &src, int frames, std::vector<float> *dst) {
+  const HalfbandKernel &k = halfbandKernel();
+  constexpr int kReach = 2 * kHalfbandOddTaps - 1;
+  int outFrames = (frames + 1) / 2;
+  int last = frames - 1;
+  dst->assign(outFrames, 0.f);
+  for (int j = 0; j < outFrames; ++j) {
+    int c = 2 * j;
+    float odd = 0.f;
+    if (c - kReach >= 0 && c + kReach <= last) {
+      for (int i = 0; i < kHalfbandOddTaps; ++i) {
+        odd += k.oddTaps[i] * (src[c - 1 - 2 * i] + src[c + 1 + 2 * i]);
+      }
+    } else {
+      for (int i = 0; i < kHalfbandOddTaps; ++i) {
+        odd += k.oddTaps[i] * (src[std::max(0, c - 1 - 2 * i)] + src[std::min(last, c + 1 + 2 * i)]);
+      }
+    }
+    (*dst)[j] = 0.5f * src[c] + odd;
+  }
+}
+
+// Builds every mip level of a loaded sample in one pass. Runs on the sample
+// worker so installs on the audio thread stay a move. `right` may be empty
+// for mono timelines.
+inline void buildMipLevels(const std::vector<float> &left, const std::vector<float> &right, int frames,
+                           TemporalDeckMipLevels *out) {
+  out->clear();
+  frames = std::min(frames, int(left.size()));
+  if (frames <= 0) {
+    return;
+  }
+  bool stereo = int(right.size()) >= frames;
+  const std::vector<float> *srcL = &left;
+  const std::vector<float> *srcR = &right;
+  for (int k = 0; k < kMipLevels; ++k) {
+    decimateHalfband(*srcL, frames, &out->left[k]);
+    if (stereo) {
+      decimateHalfband(*srcR, frames, &out->right[k]);
+    }
+    srcL = &out->left[k];
+    srcR = &out->right[k];
+    frames = int(out->left[k].size());
+  }
+}
+
+static constexpr int kOnsetBlockFrames = 256;
+static constexpr uint16_t kOnsetNoCrossing = 0xFFFF;
+// Trailing blocks averaged as the reference level for the next block.
+static constexpr int kOnsetHistoryBlocks = 8;
+// A block is an onset when its RMS clears this multiple of the reference
+// level plus the floor (about -48 dB below full scale at Rack voltages).
+static constexpr float kOnsetRiseRatio = 2.f;
+static constexpr float kOnsetFloorRms = 0.02f;
+static constexpr float kOnsetMinGapSec = 0.05f;
+
+// Transient map of a loaded sample, built once on the sample worker so the
+// audio thread can snap seeks without touching the audio around them.
+struct TemporalDeckOnsetIndex {
+  // Ascending frames; each sits on the zero crossing just before its attack.
+  std::vector<int> onsets;
+  // RMS of the mono fold per kOnsetBlockFrames block.
+  std::vector<float> blockRms;
+  // Offset of the first zero crossing in each block, or kOnsetNoCrossing.
+  std::vector<uint16_t> blockCrossing;
+
+  bool empty() const { return blockRms.empty(); }
+
+  void clear() {
+    std::vector<int>().swap(onsets);
+    std::vector<float>().swap(blockRms);
+    std::vector<uint16_t>().swap(blockCrossing);
+  }
+
+  // Nearest onset no more than `maxDistance` frames away, or -1.
+  int nearestOnset(int frame, int maxDistance) const {
+    std::vector<int>::const_iterator it = std::lower_bound(onsets.begin(), onsets.end(), frame);
+    int best = -1;
+    int bestDistance = maxDistance + 1;
+    if (it != onsets.end() && *it - frame < bestDistance) {
+      best = *it;
+      bestDistance = *it - frame;
+    }
+    if (it != onsets.begin() && frame - *(it - 1) < bestDistance) {
+      best = *(it - 1);
+    }
+    return best;
+  }
+
+  // Nearest indexed zero crossing in the frame's block or its neighbours, or -1.
+  int nearestZeroCrossing(int frame) const {
+    int block = frame / kOnsetBlockFrames;
+    int best = -1;
+    int bestDistance = 0;
+    for (int b = std::max(0, block - 1); b <= block + 1 && b < int(blockCrossing.size()); ++b) {
+      if (blockCrossing[b] == kOnsetNoCrossing) {
+        continue;
+      }
+      int crossing = b * kOnsetBlockFrames + int(blockCrossing[b]);
+      int distance = std::abs(crossing - frame);
+      if (best < 0 || distance < bestDistance) {
+        best = crossing;
+        bestDistance = distance;
+      }
+    }
+    return best;
+  }
+
+  // Seek target for `frame`: the nearest onset within `onsetRadius`, else the
+  // nearest zero crossing, else the frame itself.
+  int snapFrame(int frame, int onsetRadius) const {
+    int onset = nearestOnset(frame, onsetRadius);
+    if (onset >= 0) {
+      return onset;
+    }
+    int crossing = nearestZeroCrossing(frame);
+    return crossing >= 0 ? crossing : frame;
+  }
+};
+
+// One pass for block RMS and zero crossings, then onsets where a block's level
+// jumps over its recent average. Each onset is refined to the first frame at
+// half the block's peak and walked back to the preceding zero crossing.
+// `right` may be empty for mono timelines.
+inline void buildOnsetIndex(const std::vector<float> &left, const std::vector<float> &right, int frames,
+                            float sampleRate, TemporalDeckOnsetIndex *out) {
+  out->clear();
+  frames = std::min(frames, int(left.size()));
+  if (frames <= 0) {
+    return;
+  }
+  bool stereo = int(right.size()) >= frames;
+  auto mono = [&](int i) { return stereo ? 0.5f * (left[i] + right[i]) : left[i]; };
+  int blocks = (frames + kOnsetBlockFrames - 1) / kOnsetBlockFrames;
+  out->blockRms.assign(blocks, 0.f);
+  out->blockCrossing.assign(blocks, kOnsetNoCrossing);
+  float prev = mono(0);
+  for (int b = 0; b < blocks; ++b) {
+    int start = b * kOnsetBlockFrames;
+    int end = std::min(frames, start + kOnsetBlockFrames);
+    double energy = 0.0;
+    for (int i = start; i < end; ++i) {
+      float v = mono(i);
+      energy += double(v) * double(v);
+      if (out->blockCrossing[b] == kOnsetNoCrossing && i > 0 && (v >= 0.f) != (prev >= 0.f)) {
+        // Land on whichever side of the crossing is quieter.
+        int at = std::fabs(prev) < std::fabs(v) ? i - 1 : i;
+        if (at >= start) {
+          out->blockCrossing[b] = uint16_t(at - start);
+        }
+      }
+      prev = v;
+    }
+    out->blockRms[b] = float(std::sqrt(energy / double(end - start)));
+  }
+
+  int minGap = std::max(int(kOnsetMinGapSec * std::max(sampleRate, 1.f)), 3 * kOnsetBlockFrames);
+  int lastOnset = -minGap;
+  float historySum = 0.f;
+  for (int b = 0; b < blocks; ++b) {
+    int historyCount = std::min(b, kOnsetHistoryBlocks);
+    float reference = historyCount > 0 ? historySum / float(historyCount) : 0.f;
+    float rms = out->blockRms[b];
+    historySum += rms;
+    if (b >= kOnsetHistoryBlocks) {
+      historySum -= out->blockRms[b - kOnsetHistoryBlocks];
+    }
+    int blockStart = b * kOnsetBlockFrames;
+    if (rms < kOnsetRiseRatio * reference + kOnsetFloorRms || blockStart - lastOnset < minGap) {
+      continue;
+    }
+    int end = std::min(frames, blockStart + kOnsetBlockFrames);
+    float peak = 0.f;
+    for (int i = blockStart; i < end; ++i) {
+      peak = std::max(peak, std::fabs(mono(i)));
+    }
+    int attack = blockStart;
+    for (int i = std::max(0, blockStart - kOnsetBlockFrames); i < end; ++i) {
+      if (std::fabs(mono(i)) >= 0.5f * peak) {
+        attack = i;
+        break;
+      }
+    }
+    int onset = attack;
+    float attackValue = mono(attack);
+    for (int i = attack; i > 0 && i > attack - kOnsetBlockFrames; --i) {
+      float before = mono(i - 1);
+      if ((before >= 0.f) != (attackValue >= 0.f) || before == 0.f) {
+        onset = std::fabs(before) < std::fabs(mono(i)) ? i - 1 : i;
+        break;
+      }
+    }
+    if (onset <= lastOnset && !out->onsets.empty()) {
+      continue;
+    }
+    out->onsets.push_back(onset);
+    lastOnset = onset;
+  }
+}
+
+// Samples longer than the buffer stream from disk through a fixed set of
+// decoded pages at the engine rate. TemporalDeckSampleStream fills the pages
+// on its own thread around the head published here; the audio thread only
+// reads pages that are already resident and never waits for one.
+static constexpr int kStreamPageShift = 14;
+static constexpr int kStreamPageFrames = 1 << kStreamPageShift;
+static constexpr int kStreamPageMask = kStreamPageFrames - 1;
+static constexpr int kStreamSlotCount = 64;
+
+struct TemporalDeckPageCache {
+  struct Slot {
+    // Page held by the slot; -1 while empty or being refilled.
+    std::atomic<int> page;
+    std::vector<float> left;
+    std::vector<float> right;
+    Slot() : page(-1) {}
+  };
+
+  // Direct-mapped: page p can only live in slot p % kStreamSlotCount.
+  Slot slots[kStreamSlotCount];
+  int frames = 0;
+  bool mono = false;
+  std::atomic<double> headFrame;
+  std::atomic<float> headDelta;
+  std::atomic<uint64_t> misses;
+
+  TemporalDeckPageCache() : headFrame(0.0), headDelta(0.f), misses(0) {}
+
+  void allocate(int totalFrames, bool monoPages) {
+    frames = std::max(0, totalFrames);
+    mono = monoPages;
+    for (int i = 0; i < kStreamSlotCount; ++i) {
+      slots[i].page.store(-1, std::memory_order_relaxed);
+      slots[i].left.assign(kStreamPageFrames, 0.f);
+      if (mono) {
+        std::vector<float>().swap(slots[i].right);
+      } else {
+        slots[i].right.assign(kStreamPageFrames, 0.f);
+      }
+    }
+  }
+
+  int pageCount() const { return (frames + kStreamPageMask) >> kStreamPageShift; }
+  Slot &slotFor(int page) { return slots[page % kStreamSlotCount]; }
+  const Slot &slotFor(int page) const { return slots[page % kStreamSlotCount]; }
+  bool isResident(int page) const { return slotFor(page).page.load(std::memory_order_acquire) == page; }
+
+  void publishHead(double pos, double delta) {
+    headFrame.store(pos, std::memory_order_relaxed);
+    headDelta.store(float(delta), std::memory_order_relaxed);
+  }
+
+  // Frames adapter for TemporalDeckBuffer::readTierAt(). A tap on a page that
+  // is not resident reads silence and marks the read missed; valid() re-checks
+  // every page the read touched, so a page refilled mid-read is caught too.
+  struct Frames {
+    static constexpr int kMaxTouched = 3;
+    const TemporalDeckPageCache *cache;
+    int n;
+    mutable int touchedPage[kMaxTouched];
+    mutable const Slot *touchedSlot[kMaxTouched];
+    mutable int touchedCount;
+    mutable bool missed;
+
+    explicit Frames(const TemporalDeckPageCache &pages)
+        : cache(&pages), n(pages.frames), touchedCount(0), missed(false) {}
+
+    const Slot *slotAt(int idx) const {
+      int page = idx >> kStreamPageShift;
+      for (int i = 0; i < touchedCount; ++i) {
+        if (touchedPage[i] == page) {
+          return touchedSlot[i];
+        }
+      }
+      const Slot &slot = cache->slotFor(page);
+      if (touchedCount == kMaxTouched || slot.page.load(std::memory_order_acquire) != page) {
+        missed = true;
+        return nullptr;
+      }
+      touchedPage[touchedCount] = page;
+      touchedSlot[touchedCount] = &slot;
+      touchedCount++;
+      return &slot;
+    }
+
+    float leftAt(int idx) const {
+      const Slot *slot = slotAt(idx);
+      return slot ? slot->left[idx & kStreamPageMask] : 0.f;
+    }
+
+    float rightAt(int idx) const {
+      const Slot *slot = slotAt(idx);
+      if (!slot) {
+        return 0.f;
+      }
+      return cache->mono ? slot->left[idx & kStreamPageMask] : slot->right[idx & kStreamPageMask];
+    }
+
+    bool valid() const {
+      if (missed) {
+        return false;
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      for (int i = 0; i < touchedCount; ++i) {
+        if (touchedSlot[i]->page.load(std::memory_order_relaxed) != touchedPage[i]) {
+          return false;
+        }
+      }
+      return true;
+    }
+  };
+};
+
 struct TemporalDeckBuffer {
   std::vector<float> left;
   std::vector<float> right;
+  // Binary16 storage used in place of left/right when halfStorage is set
+  // (compact long live buffers). Sample-mode buffers are always float.
+  std::vector<uint16_t> leftHalf;
+  std::vector<uint16_t> rightHalf;
   int size = 0;
   int writeHead = 0;
   int filled = 0;
   float sampleRate = 44100.f;
   float durationSeconds = 11.f;
   bool monoStorage = false;
-
-  void reset(float sr, float seconds = 11.f, bool mono = false) {
+  bool halfStorage = false;
+  // Decimated copies for fast reads. When mipMapped is set the levels are
+  // rings that follow the base ring and write() keeps them current; installed
+  // samples carry levels built on the worker instead.
+  TemporalDeckMipLevels mips;
+  HalfbandStereoStage mipDecimators[kMipLevels];
+  bool mipMapped = false;
+
+  // Reads this close (in base samples, scaled by 2^level) to the write head
+  // would touch level taps the decimators have not produced yet.
+  static constexpr double kMipGuardSamples = 26.0;
+
+  void reset(float sr, float seconds = 11.f, bool mono = false, bool half = false, bool mip = false) {
     sampleRate = sr;
     durationSeconds = std::max(1.f, seconds);
     monoStorage = mono;
+    halfStorage = half;
+    mipMapped = mip && !half;
     size = std::max(1, int(std::round(sampleRate * durationSeconds)));
-    left.assign(size, 0.f);
-    if (monoStorage) {
+    if (mipMapped) {
+      // Every level ring must divide evenly so base and level indices wrap together.
+      constexpr int kAlign = 1 << kMipLevels;
+      size = (size + kAlign - 1) / kAlign * kAlign;
+    }
+    if (halfStorage) {
+      std::vector<float>().swap(left);
       std::vector<float>().swap(right);
+      leftHalf.assign(size, 0);
+      if (monoStorage) {
+        std::vector<uint16_t>().swap(rightHalf);
+      } else {
+        rightHalf.assign(size, 0);
+      }
     } else {
-      right.assign(size, 0.f);
+      std::vector<uint16_t>().swap(leftHalf);
+      std::vector<uint16_t>().swap(rightHalf);
+      left.assign(size, 0.f);
+      if (monoStorage) {
+        std::vector<float>().swap(right);
+      } else {
+        right.assign(size, 0.f);
+      }
+    }
+    mips.clear();
+    if (mipMapped) {
+      for (int k = 0; k < kMipLevels; ++k) {
+        mips.left[k].assign(size >> (k + 1), 0.f);
+        if (!monoStorage) {
+          mips.right[k].assign(size >> (k + 1), 0.f);
+        }
+      }
+    }
+    for (int k = 0; k < kMipLevels; ++k) {
+      mipDecimators[k].reset();
     }
     writeHead = 0;
     filled = 0;
   }
 
-  int wrapIndex(int index) const {
-    if (size <= 0) {
+  // Ring layout for a live buffer mode. Short rings carry 2x/4x/8x read
+  // levels (+87.5% memory); 10-minute rings skip them to keep their footprint
+  // bounded, and store binary16 when compact long buffers are enabled.
+  void resetForMode(float sr, int mode, bool compactLong) {
+    bool longBuffer = isLongBufferMode(mode);
+    reset(sr, realBufferSecondsForMode(mode), isMonoBufferMode(mode), compactLong && longBuffer, !longBuffer);
+  }
+
+  static int wrapIndexIn(int index, int length) {
+    if (length <= 0) {
       return 0;
     }
-    index %= size;
+    index %= length;
     if (index < 0) {
-      index += size;
+      index += length;
     }
     return index;
   }
 
-  double wrapPosition(double pos) const {
-    if (size <= 0) {
+  int wrapIndex(int index) const { return wrapIndexIn(index, size); }
+
+  static double wrapPositionIn(double pos, int length) {
+    if (length <= 0) {
       return 0.0;
     }
-    pos = std::fmod(pos, double(size));
+    // Heads move less than a ring per frame; both branches match fmod exactly.
+    double lengthF = double(length);
+    if (pos >= 0.0 && pos < lengthF) {
+      return pos;
+    }
+    if (pos >= lengthF && pos < 2.0 * lengthF) {
+      return pos - lengthF;
+    }
+    pos = std::fmod(pos, lengthF);
     if (pos < 0.0) {
-      pos += double(size);
+      pos += double(length);
     }
     return pos;
   }
 
+  double wrapPosition(double pos) const { return wrapPositionIn(pos, size); }
+
   void write(float inL, float inR) {
     if (size <= 0) {
       return;
     }
-    if (monoStorage) {
+    if (halfStorage) {
+      if (monoStorage) {
+        leftHalf[writeHead] = floatToHalf(0.5f * (inL + inR));
+      } else {
+        leftHalf[writeHead] = floatToHalf(inL);
+        rightHalf[writeHead] = floatToHalf(inR);
+      }
+    } else if (monoStorage) {
       left[writeHead] = 0.5f * (inL + inR);
     } else {
       left[writeHead] = inL;
       right[writeHead] = inR;
     }
+    if (mipMapped) {
+      updateMipLevels(writeHead);
+    }
     writeHead = wrapIndex(writeHead + 1);
     filled = std::min(filled + 1, size);
   }
 
-  float rightSample(int idx) const { return monoStorage ? left[idx] : right[idx]; }
+  // Feeds each completed (even, odd) frame pair one level down. The
+  // decimator's latency is absorbed by writing its output kHalfbandOddTaps - 1
+  // slots back, which keeps level indices aligned with the base ring.
+  void updateMipLevels(int index) {
+    const float *srcL = left.data();
+    const float *srcR = monoStorage ? left.data() : right.data();
+    int levelSize = size;
+    for (int k = 0; k < kMipLevels && (index & 1); ++k) {
+      float v0[2] = {srcL[index - 1], srcR[index - 1]};
+      float v1[2] = {srcL[index], srcR[index]};
+      float out[2];
+      mipDecimators[k].downsample(v0, v1, out);
+      levelSize >>= 1;
+      index = wrapIndexIn((index >> 1) - (kHalfbandOddTaps - 1), levelSize);
+      float *dstL = mips.left[k].data();
+      float *dstR = monoStorage ? dstL : mips.right[k].data();
+      dstL[index] = out[0];
+      dstR[index] = out[1];
+      srcL = dstL;
+      srcR = dstR;
+    }
+  }
+
+  // Zeroes all but the newest `keepFrames` frames, on every level, plus the
+  // level slots the decimators have not reached yet. Interpolation taps that
+  // straddle the write head then read silence instead of last lap's audio,
+  // so the kept frames alone describe everything a read can touch.
+  void clearHistoryBefore(int keepFrames) {
+    keepFrames = clamp(keepFrames, 0, size);
+    int clearFrames = size - keepFrames;
+    clearRingRange(&left, writeHead, clearFrames);
+    clearRingRange(&right, writeHead, clearFrames);
+    clearRingRange(&leftHalf, writeHead, clearFrames);
+    clearRingRange(&rightHalf, writeHead, clearFrames);
+    if (mipMapped) {
+      constexpr int kPendingSlots = 2 * kHalfbandOddTaps;
+      for (int k = 0; k < kMipLevels; ++k) {
+        int shift = k + 1;
+        int levelSize = size >> shift;
+        int start = wrapIndexIn((writeHead >> shift) - kPendingSlots, levelSize);
+        int count = std::min(levelSize, (clearFrames >> shift) + kPendingSlots);
+        clearRingRange(&mips.left[k], start, count);
+        clearRingRange(&mips.right[k], start, count);
+      }
+    }
+    filled = std::min(filled, keepFrames);
+  }
+
+  template <typename T>
+  static void clearRingRange(std::vector<T> *ring, int start, int count) {
+    int length = int(ring->size());
+    count = std::min(count, length);
+    if (count <= 0) {
+      return;
+    }
+    int first = std::min(count, length - start);
+    std::fill(ring->begin() + start, ring->begin() + start + first, T(0));
+    std::fill(ring->begin(), ring->begin() + (count - first), T(0));
+  }
+
+  // mipLodForSpeed() for a live read at `pos`. Near the write head the upper
+  // level of the crossfade is held back to one whose taps have all been written.
+  float mipLodFor(double pos, double speed) const {
+    float lod = mipMapped ? mipLodForSpeed(speed) : 0.f;
+    if (lod <= 0.f) {
+      return 0.f;
+    }
+    double lag = wrapPosition(double(writeHead - 1) - pos);
+    double maxLod = std::log2(std::max(lag, 1.0) / kMipGuardSamples) - 1.0;
+    return float(clampd(std::min(double(lod), maxLod), 0.0, double(kMipLevels)));
+  }
+
+  // Storage views handed to the interpolation kernels, so the sample format
+  // and mono/stereo layout are resolved once per read instead of per tap.
+  struct FloatFrames {
+    const float *l;
+    const float *r;
+    int n;
+    float leftAt(int idx) const { return l[idx]; }
+    float rightAt(int idx) const { return r[idx]; }
+  };
+
+  struct HalfFrames {
+    const uint16_t *l;
+    const uint16_t *r;
+    int n;
+    float leftAt(int idx) const { return halfToFloat(l[idx]); }
+    float rightAt(int idx) const { return halfToFloat(r[idx]); }
+  };
+
+  FloatFrames floatFrames() const {
+    FloatFrames frames = {left.data(), monoStorage ? left.data() : right.data(), size};
+    return frames;
+  }
+
+  // Level 1..kMipLevels of a mip-mapped ring; positions are base / 2^level.
+  FloatFrames mipFrames(int level) const {
+    const std::vector<float> &l = mips.left[level - 1];
+    FloatFrames frames = {l.data(), monoStorage ? l.data() : mips.right[level - 1].data(), int(l.size())};
+    return frames;
+  }
+
+  HalfFrames halfFrames() const {
+    HalfFrames frames = {leftHalf.data(), monoStorage ? leftHalf.data() : rightHalf.data(), size};
+    return frames;
+  }
+
+  float leftSample(int idx) const { return halfStorage ? halfToFloat(leftHalf[idx]) : left[idx]; }
+
+  float rightSample(int idx) const {
+    if (halfStorage) {
+      return halfToFloat(monoStorage ? leftHalf[idx] : rightHalf[idx]);
+    }
+    return monoStorage ? left[idx] : right[idx];
+  }
 
   static float cubicSample(float y0, float y1, float y2, float y3, float t) {
     float a0 = y3 - y2 - y0 + y1;
@@ -189,87 +929,211 @@ struct TemporalDeckBuffer {
     if (size <= 0 || filled <= 0) {
       return {0.f, 0.f};
     }
-    pos = wrapPosition(pos);
-    int i1 = int(std::floor(pos));
-    float t = float(pos - double(i1));
-    // Exact/near-exact sample-center reads are common during transport playback.
-    // Skip cubic math when phase is effectively integral.
-    if (std::fabs(t) <= 1e-6f || std::fabs(1.f - t) <= 1e-6f) {
-      int idx = wrapIndex(int(std::round(pos)));
-      return {left[idx], rightSample(idx)};
-    }
-    int i0 = wrapIndex(i1 - 1);
-    int i2 = wrapIndex(i1 + 1);
-    int i3 = wrapIndex(i1 + 2);
-    return {cubicSample(left[i0], left[i1], left[i2], left[i3], t),
-            cubicSample(rightSample(i0), rightSample(i1), rightSample(i2), rightSample(i3), t)};
+    return halfStorage ? readCubicFrom(halfFrames(), pos) : readCubicFrom(floatFrames(), pos);
   }
 
   std::pair<float, float> readLinear(double pos) const {
     if (size <= 0 || filled <= 0) {
       return {0.f, 0.f};
     }
-    pos = wrapPosition(pos);
-    int i0 = int(pos);
-    int i1 = wrapIndex(i0 + 1);
-    float t = float(pos - double(i0));
-    return {crossfade(left[i0], left[i1], t), crossfade(rightSample(i0), rightSample(i1), t)};
+    return halfStorage ? readLinearFrom(halfFrames(), pos) : readLinearFrom(floatFrames(), pos);
   }
 
   std::pair<float, float> readHighQuality(double pos) const {
     if (size <= 0 || filled <= 0) {
       return {0.f, 0.f};
     }
-    pos = wrapPosition(pos);
-    int i2 = int(std::floor(pos));
-    float t = float(pos - double(i2));
-    if (std::fabs(t) <= 1e-6f || std::fabs(1.f - t) <= 1e-6f) {
-      int idx = wrapIndex(int(std::round(pos)));
-      return {left[idx], rightSample(idx)};
-    }
-    int i0 = wrapIndex(i2 - 2);
-    int i1 = wrapIndex(i2 - 1);
-    int i3 = wrapIndex(i2 + 1);
-    int i4 = wrapIndex(i2 + 2);
-    int i5 = wrapIndex(i2 + 3);
-    Lagrange6Weights w = lagrange6Weights(t);
-    float outL = left[i0] * w.w0 + left[i1] * w.w1 + left[i2] * w.w2 + left[i3] * w.w3 + left[i4] * w.w4 +
-                 left[i5] * w.w5;
-    float outR = rightSample(i0) * w.w0 + rightSample(i1) * w.w1 + rightSample(i2) * w.w2 + rightSample(i3) * w.w3 +
-                 rightSample(i4) * w.w4 + rightSample(i5) * w.w5;
-    return {outL, outR};
+    return halfStorage ? readHighQualityFrom(halfFrames(), pos) : readHighQualityFrom(floatFrames(), pos);
   }
 
   std::pair<float, float> readSinc(double pos) const {
     if (size <= 0 || filled <= 0) {
       return {0.f, 0.f};
     }
-    pos = wrapPosition(pos);
-    int center = int(std::floor(pos));
-    float frac = float(pos - double(center));
-    if (std::fabs(frac) <= 1e-6f || std::fabs(1.f - frac) <= 1e-6f) {
-      int idx = wrapIndex(int(std::round(pos)));
-      return {left[idx], rightSample(idx)};
-    }
-
-    constexpr int kRadius = 8;
-    float accL = 0.f;
-    float accR = 0.f;
-    float weightSum = 0.f;
-    for (int k = -kRadius + 1; k <= kRadius; ++k) {
-      int idx = wrapIndex(center + k);
-      float dist = float(k) - frac;
-      float w = windowedSinc(dist, float(kRadius));
-      accL += left[idx] * w;
-      accR += rightSample(idx) * w;
-      weightSum += w;
-    }
-    if (std::fabs(weightSum) > 1e-6f) {
-      float inv = 1.f / weightSum;
-      accL *= inv;
-      accR *= inv;
-    }
-    return {accL, accR};
+    return halfStorage ? readSincFrom(halfFrames(), pos) : readSincFrom(floatFrames(), pos);
+  }
+
+  // Interpolation kernels, cheapest first (TemporalDeckEngine::INTERP_TIER_*).
+  enum Kernel {
+    KERNEL_LINEAR,
+    KERNEL_CUBIC,
+    KERNEL_LAGRANGE6,
+    KERNEL_SINC,
+  };
+
+  // Kernel taps relative to the kernel centre. Interior reads index the
+  // storage directly; reads whose support crosses an edge gather the taps
+  // through the caller's wrap/clamp first, so the per-tap index math only
+  // runs near edges.
+  template <typename Frames>
+  struct DirectTaps {
+    const Frames &frames;
+    int centre;
+    float leftAt(int k) const { return frames.leftAt(centre + k); }
+    float rightAt(int k) const { return frames.rightAt(centre + k); }
+  };
+
+  template <int Before, int After>
+  struct GatheredTaps {
+    float l[Before + After + 1];
+    float r[Before + After + 1];
+    float leftAt(int k) const { return l[k + Before]; }
+    float rightAt(int k) const { return r[k + Before]; }
+  };
+
+  // Index mapping for reads around the ring. `gathers`, when set, counts
+  // reads that fell back to the gather.
+  struct RingIndex {
+    int n;
+    uint64_t *gathers;
+    int operator()(int idx) const { return wrapIndexIn(idx, n); }
+    void noteGather() const {
+      if (gathers) {
+        ++*gathers;
+      }
+    }
+  };
+
+  // Runs `kernel` over taps [centre - Before, centre + After], checking once
+  // whether that support lies inside [0, lastIndex].
+  template <int Before, int After, typename Frames, typename MapIndex, typename Kernel>
+  static std::pair<float, float> readTaps(const Frames &frames, int centre, int lastIndex, const MapIndex &mapIndex,
+                                          const Kernel &kernel) {
+    if (centre - Before >= 0 && centre + After <= lastIndex) {
+      DirectTaps<Frames> taps = {frames, centre};
+      return kernel(taps);
+    }
+    mapIndex.noteGather();
+    GatheredTaps<Before, After> taps;
+    for (int k = -Before; k <= After; ++k) {
+      int idx = mapIndex(centre + k);
+      taps.l[k + Before] = frames.leftAt(idx);
+      taps.r[k + Before] = frames.rightAt(idx);
+    }
+    return kernel(taps);
+  }
+
+  static constexpr int kSincRadius = 8;
+
+  struct LinearKernel {
+    float t;
+    template <typename Taps>
+    std::pair<float, float> operator()(const Taps &taps) const {
+      return {crossfade(taps.leftAt(0), taps.leftAt(1), t), crossfade(taps.rightAt(0), taps.rightAt(1), t)};
+    }
+  };
+
+  struct CubicKernel {
+    float t;
+    template <typename Taps>
+    std::pair<float, float> operator()(const Taps &taps) const {
+      return {cubicSample(taps.leftAt(-1), taps.leftAt(0), taps.leftAt(1), taps.leftAt(2), t),
+              cubicSample(taps.rightAt(-1), taps.rightAt(0), taps.rightAt(1), taps.rightAt(2), t)};
+    }
+  };
+
+  struct Lagrange6Kernel {
+    Lagrange6Weights w;
+    template <typename Taps>
+    std::pair<float, float> operator()(const Taps &taps) const {
+      float outL = taps.leftAt(-2) * w.w0 + taps.leftAt(-1) * w.w1 + taps.leftAt(0) * w.w2 + taps.leftAt(1) * w.w3 +
+                   taps.leftAt(2) * w.w4 + taps.leftAt(3) * w.w5;
+      float outR = taps.rightAt(-2) * w.w0 + taps.rightAt(-1) * w.w1 + taps.rightAt(0) * w.w2 +
+                   taps.rightAt(1) * w.w3 + taps.rightAt(2) * w.w4 + taps.rightAt(3) * w.w5;
+      return {outL, outR};
+    }
+  };
+
+  struct SincKernel {
+    float frac;
+    template <typename Taps>
+    std::pair<float, float> operator()(const Taps &taps) const {
+      float accL = 0.f;
+      float accR = 0.f;
+      float weightSum = 0.f;
+      for (int k = -kSincRadius + 1; k <= kSincRadius; ++k) {
+        float w = windowedSinc(float(k) - frac, float(kSincRadius));
+        accL += taps.leftAt(k) * w;
+        accR += taps.rightAt(k) * w;
+        weightSum += w;
+      }
+      if (std::fabs(weightSum) > 1e-6f) {
+        float inv = 1.f / weightSum;
+        accL *= inv;
+        accR *= inv;
+      }
+      return {accL, accR};
+    }
+  };
+
+  // Kernel reads shared by the live ring and loaded samples. `pos` must
+  // already be inside [0, lastIndex + 1).
+  template <typename Frames, typename MapIndex>
+  static std::pair<float, float> readTierAt(const Frames &frames, double pos, int interpolationTier, int lastIndex,
+                                            const MapIndex &mapIndex) {
+    int i1 = int(std::floor(pos));
+    return readTierSplit(frames, i1, float(pos - double(i1)), interpolationTier, lastIndex, mapIndex);
+  }
+
+  // As readTierAt() for a position already split into index and fraction.
+  template <typename Frames, typename MapIndex>
+  static std::pair<float, float> readTierSplit(const Frames &frames, int i1, float t, int interpolationTier,
+                                               int lastIndex, const MapIndex &mapIndex) {
+    if (interpolationTier == KERNEL_LINEAR) {
+      LinearKernel kernel = {t};
+      return readTaps<0, 1>(frames, i1, lastIndex, mapIndex, kernel);
+    }
+    // Exact/near-exact sample-center reads are common during transport
+    // playback. Skip interpolation math when phase is effectively integral.
+    if (std::fabs(t) <= 1e-6f || std::fabs(1.f - t) <= 1e-6f) {
+      int idx = mapIndex(t < 0.5f ? i1 : i1 + 1);
+      return {frames.leftAt(idx), frames.rightAt(idx)};
+    }
+    if (interpolationTier == KERNEL_SINC) {
+      SincKernel kernel = {t};
+      return readTaps<kSincRadius - 1, kSincRadius>(frames, i1, lastIndex, mapIndex, kernel);
+    }
+    if (interpolationTier == KERNEL_LAGRANGE6) {
+      Lagrange6Kernel kernel = {lagrange6Weights(t)};
+      return readTaps<2, 3>(frames, i1, lastIndex, mapIndex, kernel);
+    }
+    CubicKernel kernel = {t};
+    return readTaps<1, 2>(frames, i1, lastIndex, mapIndex, kernel);
+  }
+
+  template <typename Frames>
+  std::pair<float, float> readRingFrom(const Frames &frames, double pos, int interpolationTier,
+                                       uint64_t *gathers = nullptr) const {
+    RingIndex ring = {frames.n, gathers};
+    return readTierAt(frames, wrapPositionIn(pos, frames.n), interpolationTier, frames.n - 1, ring);
+  }
+
+  template <typename Frames>
+  std::pair<float, float> readRingFrom(const Frames &frames, TemporalDeckPosition pos, int interpolationTier,
+                                       uint64_t *gathers = nullptr) const {
+    RingIndex ring = {frames.n, gathers};
+    pos.wrap(frames.n);
+    return readTierSplit(frames, pos.index(), pos.fraction(), interpolationTier, frames.n - 1, ring);
+  }
+
+  template <typename Frames>
+  std::pair<float, float> readCubicFrom(const Frames &frames, double pos) const {
+    return readRingFrom(frames, pos, KERNEL_CUBIC);
+  }
+
+  template <typename Frames>
+  std::pair<float, float> readLinearFrom(const Frames &frames, double pos) const {
+    return readRingFrom(frames, pos, KERNEL_LINEAR);
+  }
+
+  template <typename Frames>
+  std::pair<float, float> readHighQualityFrom(const Frames &frames, double pos) const {
+    return readRingFrom(frames, pos, KERNEL_LAGRANGE6);
+  }
+
+  template <typename Frames>
+  std::pair<float, float> readSincFrom(const Frames &frames, double pos) const {
+    return readRingFrom(frames, pos, KERNEL_SINC);
   }
 };
 
@@ -297,6 +1161,25 @@ struct TemporalDeckEngine {
   static constexpr float kSlipCatchMaxExtraRatioNormal = 1.65f;
   static constexpr float kSlipCatchMaxExtraRatioInstant = 3.50f;
   static constexpr float kSlipCatchAccelQuick = 16.0f;
+  // Read speed is smoothed before it selects a mip level so the crossfade
+  // never steps; jumps beyond any real motion (loop wraps, snaps) are ignored.
+  static constexpr float kMipSpeedSmoothingHz = 200.f;
+  static constexpr double kMipMaxTrackedSpeed = 128.0;
+  // Snapped seeks prefer an onset this close; otherwise a zero crossing.
+  static constexpr float kSeekSnapRadiusSec = 0.25f;
+  // Equal-power crossfade from the pre-seek position after a sample seek.
+  static constexpr float kSeekFadeSec = 0.004f;
+  static constexpr float kMipBlendEpsilon = 1e-3f;
+  // Auto interpolation re-decides once per block. Below the stationary speed
+  // the read barely moves and any kernel sounds the same; up to the sinc
+  // speed the read is upsampling and kernel quality is audible; faster than
+  // that the mip levels already band-limit the source.
+  static constexpr int kAutoInterpBlockFrames = 32;
+  static constexpr double kAutoInterpStationarySpeed = 0.02;
+  static constexpr double kAutoInterpSincMaxSpeed = 2.0;
+  static constexpr double kAutoInterpUnitySpeedTolerance = 0.02;
+  // Two clock reads per stage on one frame in this many.
+  static constexpr int kProfileIntervalFrames = 64;
   static constexpr float kSlipCatchAccelSlow = 7.5f;
   static constexpr float kSlipCatchAccelNormal = 11.0f;
   static constexpr float kSlipCatchAccelInstant = 22.0f;
@@ -338,7 +1221,9 @@ struct TemporalDeckEngine {
   static constexpr float kScratchInertiaDampingHz = 380.f;
   static constexpr float kInertiaBlend = 0.25f;
   static constexpr float kNominalPlatterRpm = 33.333333f;
-  static constexpr float kLofiModControlRateHz = 3000.f;
+  static constexpr int kLofiBlockFrames = 32;
+  static constexpr int kLofiNoiseLanes = 4;
+  static constexpr float kCartridgeMotionMixEpsilon = 1.f / 512.f;
 
   enum CartridgeCharacter {
     CARTRIDGE_CLEAN,
@@ -360,8 +1245,43 @@ struct TemporalDeckEngine {
     SCRATCH_INTERP_CUBIC,
     SCRATCH_INTERP_LAGRANGE6,
     SCRATCH_INTERP_SINC,
+    SCRATCH_INTERP_AUTO,
     SCRATCH_INTERP_COUNT
   };
+  // Kernels the readers run, cheapest first. Fixed modes map to one tier;
+  // auto moves between them.
+  enum InterpolationTier {
+    INTERP_TIER_LINEAR = TemporalDeckBuffer::KERNEL_LINEAR,
+    INTERP_TIER_CUBIC = TemporalDeckBuffer::KERNEL_CUBIC,
+    INTERP_TIER_LAGRANGE6 = TemporalDeckBuffer::KERNEL_LAGRANGE6,
+    INTERP_TIER_SINC = TemporalDeckBuffer::KERNEL_SINC,
+    INTERP_TIER_COUNT
+  };
+  // Opt-in profiling. Counters run on every frame while enabled; the stage
+  // clocks run on one frame in kProfileIntervalFrames.
+  enum ProfileStage {
+    PROFILE_STAGE_CONTROL,   // transport, scratch and slip integration
+    PROFILE_STAGE_READ,      // interpolation
+    PROFILE_STAGE_CARTRIDGE, // cartridge character
+    PROFILE_STAGE_OUTPUT,    // slip tone, scratch shaping, mix
+    PROFILE_STAGE_WRITE,     // ring and mip writes, lag bookkeeping
+    PROFILE_STAGE_COUNT
+  };
+  enum ProfileCounter {
+    PROFILE_FRAMES,
+    PROFILE_TIMED_FRAMES,
+    PROFILE_SLIP_RETURNS,
+    PROFILE_EDGE_GATHERS,
+    PROFILE_READS_LINEAR,
+    PROFILE_READS_CUBIC,
+    PROFILE_READS_LAGRANGE6,
+    PROFILE_READS_SINC,
+    PROFILE_COUNTER_COUNT
+  };
+  struct Profile {
+    double stageNs[PROFILE_STAGE_COUNT] = {};
+    uint64_t counters[PROFILE_COUNTER_COUNT] = {};
+  };
   enum SlipReturnMode {
     SLIP_RETURN_SLOW,
     SLIP_RETURN_NORMAL,
@@ -373,30 +1293,110 @@ struct TemporalDeckEngine {
     EXTERNAL_GATE_POS_MODULE_SYNC,
     EXTERNAL_GATE_POS_COUNT
   };
+  enum CartridgeOversamplingMode {
+    CARTRIDGE_OVERSAMPLING_OFF,
+    CARTRIDGE_OVERSAMPLING_2X,
+    CARTRIDGE_OVERSAMPLING_4X,
+    CARTRIDGE_OVERSAMPLING_COUNT
+  };
 
-  struct OnePoleState {
-    float z = 0.f;
-
-    void reset() { z = 0.f; }
+  // L/R cartridge filters share every coefficient, so their states are kept
+  // lane-packed (0 = left, 1 = right) and stepped together. The fixed 2-wide
+  // loops let the compiler issue one vector op per filter stage.
+  struct CartridgeStereoState {
+    float rumble[2] = {0.f, 0.f};
+    float body[2] = {0.f, 0.f};
+    float air[2] = {0.f, 0.f};
 
-    float lowpass(float in, float coeff) {
-      z += coeff * (in - z);
-      return z;
+    void reset() {
+      for (int c = 0; c < 2; ++c) {
+        rumble[c] = 0.f;
+        body[c] = 0.f;
+        air[c] = 0.f;
+      }
     }
   };
 
-  struct CartridgeChannelState {
-    OnePoleState rumble;
-    OnePoleState body;
-    OnePoleState air;
+  // Oversampled drive stage. 2x runs the shaper between one halfband pair;
+  // 4x nests a second pair at the 2x rate. The nested pair's latency is half a
+  // base-rate sample, so one extra 2x-rate delay rounds the total up to a whole
+  // sample and the dry path can be aligned with a plain integer delay.
+  static constexpr int kCartridgeDryDelaySize = 32;
+
+  struct CartridgeOversamplerState {
+    HalfbandStereoStage outer;
+    HalfbandStereoStage inner;
+    float innerAlign[2] = {0.f, 0.f};
+    float dryDelay[2][kCartridgeDryDelaySize] = {};
+    int dryWriteIndex = 0;
 
     void reset() {
-      rumble.reset();
-      body.reset();
-      air.reset();
+      outer.reset();
+      inner.reset();
+      for (int c = 0; c < 2; ++c) {
+        innerAlign[c] = 0.f;
+        std::fill(dryDelay[c], dryDelay[c] + kCartridgeDryDelaySize, 0.f);
+      }
+      dryWriteIndex = 0;
+    }
+
+    // Replaces dry[] with its value from `latency` samples ago.
+    void delayDry(float dry[2], int latency) {
+      int readIndex = (dryWriteIndex - latency) & (kCartridgeDryDelaySize - 1);
+      for (int c = 0; c < 2; ++c) {
+        dryDelay[c][dryWriteIndex] = dry[c];
+        dry[c] = dryDelay[c][readIndex];
+      }
+      dryWriteIndex = (dryWriteIndex + 1) & (kCartridgeDryDelaySize - 1);
     }
   };
 
+  // LOFI wear generator, refilled once every kLofiBlockFrames. Hiss for both
+  // channels comes from interleaved xorshift32 lanes (one vector op per step),
+  // wow/flutter is evaluated at block edges and ramped across the block, and
+  // crackles are scheduled by exponential waiting times drawn per event
+  // rather than by a random roll every sample.
+  struct LofiBlockState {
+    float hiss[2][kLofiBlockFrames] = {};
+    float wowFlutter[kLofiBlockFrames] = {};
+    uint32_t noiseRng[kLofiNoiseLanes] = {0x5A17C3E1u, 0x9E3779B9u, 0x7F4A7C15u, 0x2545F491u};
+    int pos = kLofiBlockFrames;
+    float wowFlutterEnd = 0.f;
+    // Remaining crackle hazard; each sample subtracts its crackle probability
+    // and a pop fires when it runs out (<= 0 means "draw a new wait").
+    float crackleWait = 0.f;
+
+    void reset() { *this = LofiBlockState(); }
+
+    // Fills hiss[][] with uniform noise in [-1, 1).
+    void fillHiss() {
+      static_assert((2 * kLofiBlockFrames) % kLofiNoiseLanes == 0, "hiss block must split evenly across lanes");
+      float *out = &hiss[0][0];
+      for (int step = 0; step < (2 * kLofiBlockFrames) / kLofiNoiseLanes; ++step) {
+        for (int l = 0; l < kLofiNoiseLanes; ++l) {
+          uint32_t x = noiseRng[l];
+          x ^= x << 13;
+          x ^= x >> 17;
+          x ^= x << 5;
+          noiseRng[l] = x;
+          out[step * kLofiNoiseLanes + l] = float(int32_t(x)) * (1.f / 2147483648.f);
+        }
+      }
+    }
+  };
+
+  static int cartridgeOversamplingLatency(int mode) {
+    switch (mode) {
+    case CARTRIDGE_OVERSAMPLING_2X:
+      return 2 * kHalfbandOddTaps - 1;
+    case CARTRIDGE_OVERSAMPLING_4X:
+      return 3 * kHalfbandOddTaps - 1;
+    case CARTRIDGE_OVERSAMPLING_OFF:
+    default:
+      return 0;
+    }
+  }
+
   struct CartridgeParams {
     float hpHz = 0.f;
     float bodyHz = 0.f;
@@ -421,72 +1421,91 @@ struct TemporalDeckEngine {
           saturationMix(saturationMix), motionDulling(motionDulling), scratchCompensation(scratchCompensation) {}
   };
 
-  TemporalDeckBuffer buffer;
+  // Members are laid out hot to cold. process() reads and writes the first
+  // block on every frame, so it is kept contiguous at the start of the engine
+  // (a handful of cache lines) instead of being spread between the ring
+  // header, the oversampler history and the sample metadata. The owned ring
+  // follows, so its header sits next to the hot block. Mode-dependent DSP
+  // history comes after it, and configuration, sample metadata and profiling
+  // go last.
+
+  // Hot: transport, heads and scratch/slip integrators.
+  TemporalDeckBuffer &buffer;
+  TemporalDeckPosition readHead;
+  TemporalDeckPosition timelineHead;
+  double samplePlayhead = 0.0;
+  double seekFadeFromPos = 0.0;
+  double slipBlendStartReadHead = 0.0;
+  double slipBlendStartLag = 0.0;
+  double sampleSlipAnchorPos = 0.0;
+  double scratchLagSamples = 0.0;
+  double scratchLagTargetSamples = 0.0;
+  double liveManualScratchAnchorNewestPos = 0.0;
+  double liveManualScratchAnchorLagSamples = 0.0;
+  double filteredManualLagTargetSamples = 0.0;
+  double lastPlatterLagTarget = 0.0;
+  double externalCvAnchorLagSamples = 0.0;
+  double scratchOutAnchorLagSamples = 0.0;
+  double mipReadSpeed = 1.0;
   float sampleRate = 44100.f;
-  std::atomic<bool> sampleModeEnabled{false};
-  bool sampleLoopEnabled = false;
-  bool sampleLoaded = false;
-  bool sampleTransportPlaying = false;
-  bool sampleTruncated = false;
   int sampleFrames = 0;
-  double samplePlayhead = 0.0;
-  double readHead = 0.0;
-  double timelineHead = 0.0;
+  int seekFadeFrames = 0;
+  int seekFadeRemaining = 0;
   float platterPhase = 0.f;
   float platterVelocity = 0.f;
-  bool freezeState = false;
-  bool reverseState = false;
-  bool slipState = false;
-  int scratchInterpolationMode = SCRATCH_INTERP_LAGRANGE6;
-  int externalGatePosMode = EXTERNAL_GATE_POS_GLIDE;
-  int slipReturnMode = SLIP_RETURN_NORMAL;
-  bool scratchActive = false;
-  bool slipReturning = false;
-  bool slipBlendActive = false;
-  bool nowCatchActive = false;
   float slipReturnOverrideTime = -1.f;
   float slipCatchVelocity = 0.f;
   float sampleSlipVelocity = 0.f;
   float slipBlendRemaining = 0.f;
-  double slipBlendStartReadHead = 0.0;
-  double slipBlendStartLag = 0.0;
-  double sampleSlipAnchorPos = 0.0;
   float nowCatchRemaining = 0.f;
   float nowCatchStartLag = 0.f;
-  double scratchLagSamples = 0.0;
-  double scratchLagTargetSamples = 0.0;
-  double liveManualScratchAnchorNewestPos = 0.0;
-  double liveManualScratchAnchorLagSamples = 0.0;
   float scratchHandVelocity = 0.f;
   float scratchMotionVelocity = 0.f;
   float scratch3LagVelocity = 0.f;
   float scratch3GestureAgeSec = 0.f;
   float scratchWheelVelocityBurst = 0.f;
-  double filteredManualLagTargetSamples = 0.0;
-  double lastPlatterLagTarget = 0.0;
   uint32_t lastPlatterGestureRevision = 0;
-  int cartridgeCharacter = CARTRIDGE_CLEAN;
-  int bufferDurationMode = BUFFER_DURATION_10S;
+  float prevBaseSpeed = 1.f;
+  float mipReadSpeedCoeff = 0.f;
+  int scratchInterpolationMode = SCRATCH_INTERP_LAGRANGE6;
+  // Highest tier auto mode may pick; lowered by the CPU governor.
+  int autoInterpolationCap = INTERP_TIER_SINC;
+  // Tier used by the most recent wet read, for the UI.
+  int activeInterpolationTier = INTERP_TIER_CUBIC;
+  int autoInterpolationTier = INTERP_TIER_CUBIC;
+  int autoInterpBlockCountdown = 0;
+  int externalGatePosMode = EXTERNAL_GATE_POS_GLIDE;
+  int slipReturnMode = SLIP_RETURN_NORMAL;
   int lastSlipReturnMode = SLIP_RETURN_NORMAL;
-  CartridgeChannelState cartridgeLeft;
-  CartridgeChannelState cartridgeRight;
-  float lofiWowPhaseA = 0.f;
-  float lofiWowPhaseB = 0.f;
-  float lofiFlutterPhase = 0.f;
-  float lofiWowFlutterCached = 0.f;
-  int lofiModUpdateCountdown = 0;
-  int lofiModUpdateIntervalSamples = 1;
-  float lofiCrackleEnv = 0.f;
-  float lofiCracklePolarity = 1.f;
-  uint32_t lofiRng = 0x5A17C3E1u;
+  std::atomic<bool> sampleModeEnabled{false};
+  bool sampleLoopEnabled = false;
+  bool sampleLoaded = false;
+  bool sampleTransportPlaying = false;
+  bool sampleSeekSnap = false;
+  bool freezeState = false;
+  bool reverseState = false;
+  bool slipState = false;
+  bool scratchActive = false;
+  bool slipReturning = false;
+  bool slipBlendActive = false;
+  bool nowCatchActive = false;
+  bool externalCvGateHigh = false;
+  bool scratchOutGateHigh = false;
+  bool profilingEnabled = false;
+  bool profileTiming = false;
+
+  // Hot: cartridge coefficients and filter state.
+  int cartridgeCharacter = CARTRIDGE_CLEAN;
+  int cartridgeOversamplingMode = CARTRIDGE_OVERSAMPLING_OFF;
+  int activeCartridgeOversampling = -1;
   int cachedCartridgeCharacter = -1;
+  CartridgeStereoState cartridgeState;
   CartridgeParams cachedCartridgeParams;
   float cachedHpCoeff = 0.f;
   float cachedBodyCoeff = 0.f;
   float cachedLpCoeffBase = 0.f;
   float cachedLpCoeffMotion = 0.f;
   float cachedDriveNorm = 1.f;
-  bool cachedDriveEnabled = false;
   float cachedSaturationMix = 1.f;
   float cachedCrossfeed = 0.f;
   float cachedStereoTilt = 0.f;
@@ -497,6 +1516,8 @@ struct TemporalDeckEngine {
   float cachedMakeupGain = 1.f;
   float cachedPlaybackColorMix = 1.f;
   float cachedScratchCompensation = 0.f;
+  float cachedLpMotionMix = -1.f;
+  float cachedLpCoeff = 0.f;
   float prevScratchReadDelta = 0.f;
   int prevScratchDeltaSign = 0;
   float scratchFlipTransientEnv = 0.f;
@@ -510,23 +1531,61 @@ struct TemporalDeckEngine {
   float scratchDcOutR = 0.f;
   float slipDynLpStateL = 0.f;
   float slipDynLpStateR = 0.f;
+  float lofiWowPhaseA = 0.f;
+  float lofiWowPhaseB = 0.f;
+  float lofiFlutterPhase = 0.f;
+  float lofiCrackleEnv = 0.f;
+  float lofiCracklePolarity = 1.f;
+  uint32_t lofiRng = 0x5A17C3E1u;
+  bool cachedDriveEnabled = false;
   bool slipDynLpPrimed = false;
-  bool externalCvGateHigh = false;
-  double externalCvAnchorLagSamples = 0.0;
-  bool scratchOutGateHigh = false;
-  double scratchOutAnchorLagSamples = 0.0;
-  float prevBaseSpeed = 1.f;
+
+  // Tap engines read a ring owned by another engine instead of their own, so
+  // several read heads can share one capture (see followOwner()).
+  TemporalDeckBuffer ownedBuffer;
+
+  // Warm: history used only by the oversampled and lofi cartridge paths.
+  CartridgeOversamplerState cartridgeOversampler;
+  LofiBlockState lofiBlock;
+
+  // Cold: configuration, sample metadata, tap bookkeeping and profiling.
+  // Set while the loaded sample streams from disk (see installStreamedSample()).
+  std::shared_ptr<TemporalDeckPageCache> sampleStream;
+  // Built with the sample (see buildOnsetIndex()); empty when unloaded.
+  TemporalDeckOnsetIndex sampleOnsets;
+  double snapWindowRawEnd = -1.0;
+  double snapWindowEnd = 0.0;
+  int bufferDurationMode = BUFFER_DURATION_10S;
+  // Store 10-minute live buffers as half floats (applied on the next reset()).
+  bool compactLongBuffers = false;
+  bool sampleTruncated = false;
+  bool sharedBufferTap = false;
+  int tapSeenWriteHead = 0;
+  int tapSeenFilled = 0;
+  int profileCountdown = 0;
+  // Mutable so the const read paths can count edge gathers.
+  mutable Profile profile;
+  std::chrono::steady_clock::time_point profileMarkTime;
+
+  TemporalDeckEngine() : buffer(ownedBuffer) {}
+  explicit TemporalDeckEngine(TemporalDeckBuffer &sharedBuffer) : buffer(sharedBuffer), sharedBufferTap(true) {}
+  TemporalDeckEngine(const TemporalDeckEngine &) = delete;
+  TemporalDeckEngine &operator=(const TemporalDeckEngine &) = delete;
 
   void reset(float sr, bool resetBuffer = true) {
     sampleRate = sr;
-    if (resetBuffer) {
-      buffer.reset(sr, realBufferSecondsForMode(bufferDurationMode), isMonoBufferMode(bufferDurationMode));
+    if (resetBuffer && !sharedBufferTap) {
+      buffer.resetForMode(sr, bufferDurationMode, compactLongBuffers);
     }
     sampleLoaded = false;
     sampleTransportPlaying = false;
     sampleTruncated = false;
     sampleFrames = 0;
     samplePlayhead = 0.f;
+    sampleOnsets.clear();
+    sampleStream.reset();
+    snapWindowRawEnd = -1.0;
+    seekFadeRemaining = 0;
     readHead = 0.f;
     timelineHead = 0.f;
     platterPhase = 0.f;
@@ -556,14 +1615,15 @@ struct TemporalDeckEngine {
     filteredManualLagTargetSamples = 0.f;
     lastPlatterLagTarget = 0.f;
     lastPlatterGestureRevision = 0;
-    cartridgeLeft.reset();
-    cartridgeRight.reset();
+    cartridgeState.reset();
+    cartridgeOversampler.reset();
+    activeCartridgeOversampling = -1;
+    cachedLpMotionMix = -1.f;
+    cachedLpCoeff = 0.f;
     lofiWowPhaseA = 0.f;
     lofiWowPhaseB = 0.f;
     lofiFlutterPhase = 0.f;
-    lofiWowFlutterCached = 0.f;
-    lofiModUpdateCountdown = 0;
-    lofiModUpdateIntervalSamples = 1;
+    lofiBlock.reset();
     lofiCrackleEnv = 0.f;
     lofiCracklePolarity = 1.f;
     lofiRng = 0x5A17C3E1u;
@@ -602,6 +1662,52 @@ struct TemporalDeckEngine {
     scratchOutGateHigh = false;
     scratchOutAnchorLagSamples = 0.0;
     prevBaseSpeed = 1.f;
+    mipReadSpeed = 1.0;
+    mipReadSpeedCoeff = onePoleCoeff(kMipSpeedSmoothingHz);
+    activeInterpolationTier = INTERP_TIER_CUBIC;
+    autoInterpolationTier = INTERP_TIER_CUBIC;
+    autoInterpBlockCountdown = 0;
+    tapSeenWriteHead = buffer.writeHead;
+    tapSeenFilled = buffer.filled;
+  }
+
+  // Swaps in a ring rebuilt at a new sample rate off the audio thread. The
+  // previous storage comes back in `ring` so it can be released elsewhere;
+  // transport state restarts at NOW, as after any sample-rate change.
+  void adoptResampledRing(TemporalDeckBuffer *ring) {
+    std::swap(buffer, *ring);
+    reset(buffer.sampleRate, false);
+    readHead = newestReadablePos();
+  }
+
+  // Drops a tap's read state and starts it where the owner's head is now.
+  void restartTapOn(const TemporalDeckEngine &owner) {
+    bufferDurationMode = owner.bufferDurationMode;
+    reset(owner.sampleRate, false);
+    sampleLoaded = owner.sampleLoaded;
+    sampleFrames = owner.sampleFrames;
+    sampleTruncated = owner.sampleTruncated;
+    // A streamed sample is not in the shared buffer; without the stream the
+    // tap would index the one-frame placeholder with the file's length.
+    sampleStream = owner.sampleStream;
+    readHead = owner.readHead;
+    timelineHead = owner.timelineHead;
+    samplePlayhead = owner.samplePlayhead;
+  }
+
+  // Called on a tap engine before each frame, after the owner has processed
+  // it. Timeline changes on the owner (sample rate, ring length, sample load,
+  // eject or stream swap) restart the tap on the new timeline.
+  void followOwner(const TemporalDeckEngine &owner) {
+    bool timelineChanged = owner.sampleRate != sampleRate || owner.bufferDurationMode != bufferDurationMode ||
+                           owner.sampleLoaded != sampleLoaded || owner.sampleFrames != sampleFrames ||
+                           owner.sampleStream != sampleStream;
+    if (timelineChanged) {
+      restartTapOn(owner);
+    }
+    sampleModeEnabled.store(owner.sampleModeEnabled.load());
+    sampleTransportPlaying = owner.sampleTransportPlaying;
+    sampleLoopEnabled = owner.sampleLoopEnabled;
   }
 
   double maxLagFromKnob(float knob) const {
@@ -1060,6 +2166,9 @@ struct TemporalDeckEngine {
     cachedMakeupGain = makeupGainForCartridge(cartridgeCharacter);
     cachedPlaybackColorMix = playbackColorMixForCartridge(cartridgeCharacter);
     cachedScratchCompensation = std::max(cachedCartridgeParams.scratchCompensation, 0.f);
+    cachedLpMotionMix = -1.f;
+    // Oversampler history belongs to the previous cartridge's drive curve.
+    activeCartridgeOversampling = -1;
   }
 
   float lofiRandUnit() {
@@ -1072,38 +2181,81 @@ struct TemporalDeckEngine {
 
   float lofiRandSigned() { return lofiRandUnit() * 2.f - 1.f; }
 
-  float updateLofiWowFlutter() {
-    float sr = std::max(sampleRate, 1.f);
-    int desiredInterval = clamp(int(std::round(sr / kLofiModControlRateHz)), 1, 64);
-    if (desiredInterval != lofiModUpdateIntervalSamples) {
-      lofiModUpdateIntervalSamples = desiredInterval;
-      if (lofiModUpdateCountdown > lofiModUpdateIntervalSamples) {
-        lofiModUpdateCountdown = lofiModUpdateIntervalSamples;
-      }
-    }
-    if (lofiModUpdateCountdown <= 0) {
-      float dt = float(lofiModUpdateIntervalSamples) / sr;
-      constexpr float kTau = kTwoPi;
-      lofiWowPhaseA += kTau * 0.33f * dt;
-      lofiWowPhaseB += kTau * 0.57f * dt;
-      lofiFlutterPhase += kTau * 7.6f * dt;
-      auto wrapPhase = [&](float &phase) {
-        if (phase > kTau || phase < 0.f) {
-          phase = std::fmod(phase, kTau);
-          if (phase < 0.f) {
-            phase += kTau;
-          }
+  // Exponential waiting time (in units of crackle probability) to the next pop.
+  float drawLofiCrackleWait() { return -std::log(1.f - lofiRandUnit()); }
+
+  void refillLofiBlock() {
+    LofiBlockState &lb = lofiBlock;
+    float dt = float(kLofiBlockFrames) / std::max(sampleRate, 1.f);
+    constexpr float kTau = kTwoPi;
+    lofiWowPhaseA += kTau * 0.33f * dt;
+    lofiWowPhaseB += kTau * 0.57f * dt;
+    lofiFlutterPhase += kTau * 7.6f * dt;
+    auto wrapPhase = [&](float &phase) {
+      if (phase > kTau || phase < 0.f) {
+        phase = std::fmod(phase, kTau);
+        if (phase < 0.f) {
+          phase += kTau;
         }
-      };
-      wrapPhase(lofiWowPhaseA);
-      wrapPhase(lofiWowPhaseB);
-      wrapPhase(lofiFlutterPhase);
-      lofiWowFlutterCached = 0.0064f * std::sin(lofiWowPhaseA) + 0.0041f * std::sin(lofiWowPhaseB + 0.7f) +
-                             0.0022f * std::sin(lofiFlutterPhase + 1.4f);
-      lofiModUpdateCountdown = lofiModUpdateIntervalSamples;
+      }
+    };
+    wrapPhase(lofiWowPhaseA);
+    wrapPhase(lofiWowPhaseB);
+    wrapPhase(lofiFlutterPhase);
+    // Sum of slow wow + quicker flutter components; all well below the block
+    // rate, so a linear ramp between block edges is indistinguishable.
+    float start = lb.wowFlutterEnd;
+    float end = 0.0064f * std::sin(lofiWowPhaseA) + 0.0041f * std::sin(lofiWowPhaseB + 0.7f) +
+                0.0022f * std::sin(lofiFlutterPhase + 1.4f);
+    float step = (end - start) / float(kLofiBlockFrames);
+    for (int i = 0; i < kLofiBlockFrames; ++i) {
+      lb.wowFlutter[i] = start + step * float(i + 1);
+    }
+    lb.wowFlutterEnd = end;
+    lb.fillHiss();
+    if (!(lb.crackleWait > 0.f)) {
+      lb.crackleWait = drawLofiCrackleWait();
+    }
+    lb.pos = 0;
+  }
+
+  void shapeCartridgeDrive(float v[2]) const {
+    for (int c = 0; c < 2; ++c) {
+      float sat = fastTanh(v[c] * cachedCartridgeParams.drive) / cachedDriveNorm;
+      v[c] = crossfade(v[c], sat, cachedSaturationMix);
+    }
+  }
+
+  // Runs the drive shaper at 2x or 4x so its harmonics above base-rate Nyquist
+  // are filtered out instead of folding back down.
+  void saturateOversampled(float voiced[2], bool fourX) {
+    CartridgeOversamplerState &os = cartridgeOversampler;
+    float a0[2];
+    float a1[2];
+    os.outer.upsample(voiced, a0, a1);
+    if (!fourX) {
+      shapeCartridgeDrive(a0);
+      shapeCartridgeDrive(a1);
+    } else {
+      float b0[2];
+      float b1[2];
+      float c0[2];
+      float c1[2];
+      os.inner.upsample(a0, b0, b1);
+      shapeCartridgeDrive(b0);
+      shapeCartridgeDrive(b1);
+      os.inner.downsample(b0, b1, c0);
+      os.inner.upsample(a1, b0, b1);
+      shapeCartridgeDrive(b0);
+      shapeCartridgeDrive(b1);
+      os.inner.downsample(b0, b1, c1);
+      for (int c = 0; c < 2; ++c) {
+        a0[c] = os.innerAlign[c];
+        a1[c] = c0[c];
+        os.innerAlign[c] = c1[c];
+      }
     }
-    lofiModUpdateCountdown -= 1;
-    return lofiWowFlutterCached;
+    os.outer.downsample(a0, a1, voiced);
   }
 
   std::pair<float, float> applyCartridgeCharacter(std::pair<float, float> in, float motionAmount, bool scratchReadPath) {
@@ -1115,26 +2267,45 @@ struct TemporalDeckEngine {
     motionAmount = clamp(motionAmount, 0.f, 1.f);
 
     // Motion amount modulates LP corner for "stylus under motion" dulling.
-    // Use cached endpoint coefficients to avoid per-sample exp() in onePoleCoeff().
+    // Use cached endpoint coefficients to avoid per-sample exp() in onePoleCoeff(),
+    // and only re-derive the blended coefficient once motion has moved enough
+    // to be audible.
     float lpMotionMix = clamp(motionAmount * p.motionDulling, 0.f, 1.f);
-    float lpCoeff = crossfade(cachedLpCoeffBase, cachedLpCoeffMotion, lpMotionMix);
-
-    auto processChannel = [&](float x, CartridgeChannelState &state, float lpCoeff) {
-      float rumble = state.rumble.lowpass(x, cachedHpCoeff);
-      float hp = x - rumble;
-      float body = state.body.lowpass(hp, cachedBodyCoeff);
-      float air = state.air.lowpass(hp, lpCoeff);
-      float voiced = air * cachedAirMixGain + body * cachedBodyMixGain;
-      if (cachedDriveEnabled) {
-        float dry = voiced;
-        float sat = fastTanh(voiced * p.drive) / cachedDriveNorm;
-        voiced = crossfade(dry, sat, cachedSaturationMix);
-      }
-      return voiced;
-    };
+    if (std::fabs(lpMotionMix - cachedLpMotionMix) > kCartridgeMotionMixEpsilon ||
+        (lpMotionMix != cachedLpMotionMix && (lpMotionMix == 0.f || lpMotionMix == 1.f))) {
+      cachedLpMotionMix = lpMotionMix;
+      cachedLpCoeff = crossfade(cachedLpCoeffBase, cachedLpCoeffMotion, lpMotionMix);
+    }
+    const float lpCoeff = cachedLpCoeff;
+
+    CartridgeStereoState &st = cartridgeState;
+    float x[2] = {in.first, in.second};
+    float voiced[2];
+    for (int c = 0; c < 2; ++c) {
+      st.rumble[c] += cachedHpCoeff * (x[c] - st.rumble[c]);
+      float hp = x[c] - st.rumble[c];
+      st.body[c] += cachedBodyCoeff * (hp - st.body[c]);
+      st.air[c] += lpCoeff * (hp - st.air[c]);
+      voiced[c] = st.air[c] * cachedAirMixGain + st.body[c] * cachedBodyMixGain;
+    }
+    float dry[2] = {in.first, in.second};
+    if (cachedDriveEnabled) {
+      int oversampling = clamp(cartridgeOversamplingMode, CARTRIDGE_OVERSAMPLING_OFF, CARTRIDGE_OVERSAMPLING_COUNT - 1);
+      if (oversampling != activeCartridgeOversampling) {
+        cartridgeOversampler.reset();
+        activeCartridgeOversampling = oversampling;
+      }
+      if (oversampling == CARTRIDGE_OVERSAMPLING_OFF) {
+        shapeCartridgeDrive(voiced);
+      } else {
+        saturateOversampled(voiced, oversampling == CARTRIDGE_OVERSAMPLING_4X);
+        // Keep the playback color blend below phase-aligned with the delayed wet path.
+        cartridgeOversampler.delayDry(dry, cartridgeOversamplingLatency(oversampling));
+      }
+    }
 
-    float left = processChannel(in.first, cartridgeLeft, lpCoeff);
-    float right = processChannel(in.second, cartridgeRight, lpCoeff);
+    float left = voiced[0];
+    float right = voiced[1];
     if (cachedStereoTilt != 0.f) {
       // Lightweight stereo mismatch emulation (channel imbalance/azimuth-ish).
       left *= cachedTiltLeftGain;
@@ -1148,8 +2319,12 @@ struct TemporalDeckEngine {
     }
 
     if (cartridgeCharacter == CARTRIDGE_LOFI) {
-      // Sum of slow wow + quicker flutter components (deterministic, low cost).
-      float wowFlutter = updateLofiWowFlutter();
+      LofiBlockState &lb = lofiBlock;
+      if (lb.pos >= kLofiBlockFrames) {
+        refillLofiBlock();
+      }
+      int blockIndex = lb.pos++;
+      float wowFlutter = lb.wowFlutter[blockIndex];
       float wearTilt = 1.f + wowFlutter;
 
       // Semi-worn character: gentle high smearing + channel mismatch.
@@ -1162,17 +2337,23 @@ struct TemporalDeckEngine {
 
       // Light vinyl bed noise.
       float hissBase = 0.0024f + 0.0018f * motionAmount;
-      float hissL = hissBase * lofiRandSigned();
-      float hissR = hissBase * lofiRandSigned();
+      float hissL = hissBase * lb.hiss[0][blockIndex];
+      float hissR = hissBase * lb.hiss[1][blockIndex];
 
       // Occasional tiny crackle pops, slightly more frequent during motion.
       float crackleChance = 0.00009f + 0.00020f * motionAmount;
-      if (lofiRandUnit() < crackleChance) {
+      lb.crackleWait -= crackleChance;
+      if (lb.crackleWait <= 0.f) {
         lofiCrackleEnv = std::max(lofiCrackleEnv, 0.45f + 0.55f * lofiRandUnit());
         lofiCracklePolarity = lofiRandSigned() >= 0.f ? 1.f : -1.f;
+        lb.crackleWait = drawLofiCrackleWait();
       }
       float crackle = lofiCracklePolarity * lofiCrackleEnv * (0.010f + 0.008f * motionAmount);
       lofiCrackleEnv *= 0.87f;
+      if (lofiCrackleEnv < 1e-6f) {
+        // Settle to zero instead of decaying into denormals between pops.
+        lofiCrackleEnv = 0.f;
+      }
 
       left += hissL + crackle;
       right += hissR + crackle * 0.94f;
@@ -1181,8 +2362,8 @@ struct TemporalDeckEngine {
     right *= cachedMakeupGain;
     if (!scratchReadPath && cartridgeCharacter != CARTRIDGE_LOFI) {
       // Keep cartridge level while reducing non-scratch coloration intensity.
-      float dryL = in.first * cachedMakeupGain;
-      float dryR = in.second * cachedMakeupGain;
+      float dryL = dry[0] * cachedMakeupGain;
+      float dryR = dry[1] * cachedMakeupGain;
       float playbackMix = clamp(cachedPlaybackColorMix, 0.f, 1.f);
       left = crossfade(dryL, left, playbackMix);
       right = crossfade(dryR, right, playbackMix);
@@ -1305,7 +2486,8 @@ struct TemporalDeckEngine {
     return clamp(idx, 0, std::max(0, maxIndex));
   }
 
-  std::pair<float, float> readSampleBounded(double pos, int interpolationMode, double newestPos) const {
+  std::pair<float, float> readSampleBounded(double pos, int interpolationTier, double newestPos,
+                                            double speed = 1.0) const {
     int maxIndex = std::max(0, sampleFrames - 1);
     if (!sampleLoaded || sampleFrames <= 0 || maxIndex < 0) {
       return {0.f, 0.f};
@@ -1313,125 +2495,277 @@ struct TemporalDeckEngine {
     bool loopActive = isSampleLoopActive();
     int readMaxIndex = loopActive ? sampleLoopMaxIndex(newestPos) : maxIndex;
     pos = loopActive ? normalizeSamplePosition(pos, newestPos) : clampd(pos, 0.0, double(readMaxIndex));
-    int i1 = int(std::floor(pos));
-    float t = float(pos - double(i1));
-    const float *leftData = buffer.left.data();
-    const float *rightData = buffer.monoStorage ? buffer.left.data() : buffer.right.data();
-    auto wrappedIndex = [&](int idx) {
-      if (!loopActive) {
-        return clampSampleIndex(idx, readMaxIndex);
-      }
-      int length = std::max(1, readMaxIndex + 1);
-      int wrapped = idx % length;
-      if (wrapped < 0) {
-        wrapped += length;
-      }
-      return wrapped;
-    };
-    auto leftAt = [&](int idx) { return leftData[wrappedIndex(idx)]; };
-    auto rightAt = [&](int idx) { return rightData[wrappedIndex(idx)]; };
+    float lod = sampleMipLodFor(speed);
+    int lower = int(lod);
+    float frac = lod - float(lower);
+    std::pair<float, float> out = readSampleLevel(lower, pos, interpolationTier, maxIndex, readMaxIndex, loopActive);
+    if (frac > kMipBlendEpsilon) {
+      std::pair<float, float> upper =
+        readSampleLevel(lower + 1, pos, interpolationTier, maxIndex, readMaxIndex, loopActive);
+      out.first = crossfade(out.first, upper.first, frac);
+      out.second = crossfade(out.second, upper.second, frac);
+    }
+    return out;
+  }
+
+  float sampleMipLodFor(double speed) const { return buffer.mips.empty() ? 0.f : mipLodForSpeed(speed); }
+
+  // Window end for the buffer knob. With snapping on, a partial window ends
+  // just before the nearest transient (or on a zero crossing) so the loop seam
+  // lands cleanly; the lookup only reruns when the knob moves.
+  double sampleWindowEndFor(float bufferKnob) {
+    double sampleEndPos = std::max(0.0, double(sampleFrames - 1));
+    double rawEnd = sampleEndPos * double(clamp(bufferKnob, 0.f, 1.f));
+    if (!sampleSeekSnap || sampleOnsets.empty() || rawEnd >= sampleEndPos) {
+      return rawEnd;
+    }
+    if (rawEnd != snapWindowRawEnd) {
+      snapWindowRawEnd = rawEnd;
+      int snapped = sampleOnsets.snapFrame(int(rawEnd + 0.5), int(kSeekSnapRadiusSec * sampleRate));
+      snapWindowEnd = snapped > 0 ? std::min(double(snapped - 1), sampleEndPos) : rawEnd;
+    }
+    return snapWindowEnd;
+  }
+
+  // Moves the sample transport to `targetFrame` (snapped when enabled) and
+  // fades in from where playback was, so a seek never lands as a click.
+  void seekSampleTo(double targetFrame, double windowEndPos) {
+    if (!sampleLoaded || sampleFrames <= 0) {
+      return;
+    }
+    if (sampleSeekSnap && !sampleOnsets.empty()) {
+      targetFrame = double(sampleOnsets.snapFrame(int(targetFrame + 0.5), int(kSeekSnapRadiusSec * sampleRate)));
+    }
+    targetFrame = clampd(targetFrame, 0.0, std::max(0.0, windowEndPos));
+    if (std::fabs(targetFrame - readHead) >= 1.0) {
+      seekFadeFromPos = readHead;
+      seekFadeFrames = std::max(1, int(kSeekFadeSec * sampleRate));
+      seekFadeRemaining = seekFadeFrames;
+    }
+    samplePlayhead = targetFrame;
+    readHead = targetFrame;
+    publishStreamHead(0.0);
+    scratchLagSamples = 0.0;
+    scratchLagTargetSamples = 0.0;
+    nowCatchActive = false;
+    cancelSlipReturnState();
+  }
+
+  // Blends the pre-seek position, advanced by the same read delta, into `wet`.
+  std::pair<float, float> applySeekFade(std::pair<float, float> wet, double readDelta, int interpolationTier,
+                                        double newestPos) {
+    if (seekFadeRemaining <= 0) {
+      return wet;
+    }
+    seekFadeFromPos = normalizeSamplePosition(seekFadeFromPos + readDelta, newestPos);
+    std::pair<float, float> from = readSampleBounded(seekFadeFromPos, interpolationTier, newestPos, mipReadSpeed);
+    float theta = (1.f - float(seekFadeRemaining) / float(seekFadeFrames)) * 0.5f * kPi;
+    float fromGain = std::cos(theta);
+    float toGain = std::sin(theta);
+    seekFadeRemaining--;
+    return {from.first * fromGain + wet.first * toGain, from.second * fromGain + wet.second * toGain};
+  }
+
+  // Tells the stream prefetcher where playback is and which way it is going.
+  // Only the owner steers it; taps read whatever pages are resident.
+  void publishStreamHead(double readDelta) {
+    if (sampleStream && !sharedBufferTap) {
+      sampleStream->publishHead(readHead, readDelta);
+    }
+  }
+
+  // Timeline length the read delta wraps on; a streamed sample is not held in
+  // the buffer.
+  double readWrapSize() const { return sampleStream ? double(sampleFrames) : double(buffer.size); }
+
+  // Loop bounds are rounded down to each level's grid, so a loop seam read
+  // from a decimated level may land up to 2^level base samples early.
+  std::pair<float, float> readSampleLevel(int level, double pos, int interpolationTier, int maxIndex, int readMaxIndex,
+                                          bool loopActive) const {
+    if (sampleStream) {
+      return readStreamFrom(pos, interpolationTier, readMaxIndex, loopActive);
+    }
+    // Installed samples always use float storage (see installPreparedSample()).
+    if (level <= 0) {
+      const float *leftData = buffer.left.data();
+      const float *rightData = buffer.monoStorage ? buffer.left.data() : buffer.right.data();
+      return readSampleFrom(leftData, rightData, readMaxIndex, loopActive, pos, interpolationTier, profileGathers());
+    }
+    const std::vector<float> &levelLeft = buffer.mips.left[level - 1];
+    const std::vector<float> &levelRight = buffer.mips.right[level - 1];
+    const float *leftData = levelLeft.data();
+    const float *rightData = levelRight.empty() ? leftData : levelRight.data();
+    int levelMax = std::min(int(levelLeft.size()) - 1, maxIndex >> level);
+    int levelReadMax = loopActive ? std::max(0, ((readMaxIndex + 1) >> level) - 1) : std::min(levelMax, readMaxIndex >> level);
+    return readSampleFrom(leftData, rightData, levelReadMax, loopActive, std::ldexp(pos, -level), interpolationTier,
+                          profileGathers());
+  }
+
+  // Index mapping for sample reads: wraps inside an active loop, clamps to
+  // the readable end otherwise.
+  struct SampleIndex {
+    int readMaxIndex;
+    bool loopActive;
+    uint64_t *gathers;
+    int operator()(int idx) const {
+      return loopActive ? TemporalDeckBuffer::wrapIndexIn(idx, std::max(1, readMaxIndex + 1))
+                        : clampSampleIndex(idx, readMaxIndex);
+    }
+    void noteGather() const {
+      if (gathers) {
+        ++*gathers;
+      }
+    }
+  };
 
-    // Exact/near-exact sample-center reads are common in transport playback.
-    // Skip interpolation math when the phase is effectively integral.
-    if (std::fabs(t) <= 1e-6f || std::fabs(1.f - t) <= 1e-6f) {
-      int idx = clampSampleIndex(int(std::round(pos)), maxIndex);
-      return {leftData[idx], rightData[idx]};
+  static std::pair<float, float> readSampleFrom(const float *leftData, const float *rightData, int readMaxIndex,
+                                                bool loopActive, double pos, int interpolationTier,
+                                                uint64_t *gathers) {
+    TemporalDeckBuffer::FloatFrames frames = {leftData, rightData, readMaxIndex + 1};
+    SampleIndex mapIndex = {readMaxIndex, loopActive, gathers};
+    return TemporalDeckBuffer::readTierAt(frames, pos, interpolationTier, readMaxIndex, mapIndex);
+  }
+
+  // Streamed samples have no mip levels. A read that touches a page the
+  // prefetcher has not brought in yet plays silence rather than waiting.
+  std::pair<float, float> readStreamFrom(double pos, int interpolationTier, int readMaxIndex, bool loopActive) const {
+    TemporalDeckPageCache::Frames frames(*sampleStream);
+    SampleIndex mapIndex = {readMaxIndex, loopActive, profileGathers()};
+    std::pair<float, float> out = TemporalDeckBuffer::readTierAt(frames, pos, interpolationTier, readMaxIndex, mapIndex);
+    if (!frames.valid()) {
+      sampleStream->misses.fetch_add(1, std::memory_order_relaxed);
+      return {0.f, 0.f};
     }
+    return out;
+  }
 
-    if (interpolationMode == SCRATCH_INTERP_SINC) {
-      constexpr int kRadius = 8;
-      float accL = 0.f;
-      float accR = 0.f;
-      float weightSum = 0.f;
-      bool interior = !loopActive && (i1 - (kRadius - 1) >= 0) && (i1 + kRadius <= readMaxIndex);
-      if (interior) {
-        for (int k = -kRadius + 1; k <= kRadius; ++k) {
-          int idx = i1 + k;
-          float dist = float(k) - t;
-          float w = TemporalDeckBuffer::windowedSinc(dist, float(kRadius));
-          accL += leftData[idx] * w;
-          accR += rightData[idx] * w;
-          weightSum += w;
-        }
-      } else {
-        for (int k = -kRadius + 1; k <= kRadius; ++k) {
-          int idx = clampSampleIndex(i1 + k, maxIndex);
-          float dist = float(k) - t;
-          float w = TemporalDeckBuffer::windowedSinc(dist, float(kRadius));
-          accL += leftData[idx] * w;
-          accR += rightData[idx] * w;
-          weightSum += w;
-        }
-      }
-      if (std::fabs(weightSum) > 1e-6f) {
-        float inv = 1.f / weightSum;
-        accL *= inv;
-        accR *= inv;
+  // `speed` is base samples per output sample; above 1x the read crossfades
+  // the two mip levels bracketing mipLodForSpeed(), so every speed runs the
+  // same kernel on data already band-limited for it. A TemporalDeckPosition
+  // reads the base level without the floor and fmod a double needs.
+  template <typename Position>
+  std::pair<float, float> readLiveInterpolatedAt(Position pos, int interpolationTier, double speed = 1.0) const {
+    float lod = buffer.mipLodFor(pos, speed);
+    int lower = int(lod);
+    float frac = lod - float(lower);
+    std::pair<float, float> out = readLiveLevel(lower, pos, interpolationTier);
+    if (frac > kMipBlendEpsilon) {
+      std::pair<float, float> upper = readLiveLevel(lower + 1, pos, interpolationTier);
+      out.first = crossfade(out.first, upper.first, frac);
+      out.second = crossfade(out.second, upper.second, frac);
+    }
+    return out;
+  }
+
+  template <typename Position>
+  std::pair<float, float> readLiveLevel(int level, Position pos, int interpolationTier) const {
+    if (level <= 0) {
+      if (buffer.size <= 0 || buffer.filled <= 0) {
+        return {0.f, 0.f};
       }
-      return {accL, accR};
+      return buffer.halfStorage ? buffer.readRingFrom(buffer.halfFrames(), pos, interpolationTier, profileGathers())
+                                : buffer.readRingFrom(buffer.floatFrames(), pos, interpolationTier, profileGathers());
     }
+    return buffer.readRingFrom(buffer.mipFrames(level), std::ldexp(double(pos), -level), interpolationTier,
+                               profileGathers());
+  }
 
-    if (interpolationMode == SCRATCH_INTERP_LAGRANGE6) {
-      auto w = TemporalDeckBuffer::lagrange6Weights(t);
-      bool interior = (i1 >= 2) && (i1 + 3 <= maxIndex);
-      if (interior) {
-        int i0 = i1 - 2;
-        int iA = i1 - 1;
-        int iB = i1 + 1;
-        int iC = i1 + 2;
-        int iD = i1 + 3;
-        float outL = leftData[i0] * w.w0 + leftData[iA] * w.w1 + leftData[i1] * w.w2 + leftData[iB] * w.w3 +
-                     leftData[iC] * w.w4 + leftData[iD] * w.w5;
-        float outR = rightData[i0] * w.w0 + rightData[iA] * w.w1 + rightData[i1] * w.w2 + rightData[iB] * w.w3 +
-                     rightData[iC] * w.w4 + rightData[iD] * w.w5;
-        return {outL, outR};
-      }
-      int i0 = clampSampleIndex(i1 - 2, maxIndex);
-      int iA = clampSampleIndex(i1 - 1, maxIndex);
-      int iB = clampSampleIndex(i1 + 1, maxIndex);
-      int iC = clampSampleIndex(i1 + 2, maxIndex);
-      int iD = clampSampleIndex(i1 + 3, maxIndex);
-      float outL = leftData[i0] * w.w0 + leftData[iA] * w.w1 + leftData[i1] * w.w2 + leftData[iB] * w.w3 +
-                   leftData[iC] * w.w4 + leftData[iD] * w.w5;
-      float outR = rightData[i0] * w.w0 + rightData[iA] * w.w1 + rightData[i1] * w.w2 + rightData[iB] * w.w3 +
-                   rightData[iC] * w.w4 + rightData[iD] * w.w5;
-      return {outL, outR};
+  uint64_t *profileGathers() const { return profilingEnabled ? &profile.counters[PROFILE_EDGE_GATHERS] : nullptr; }
+
+  // Charges the time since the previous mark to `stage` on timed frames.
+  void profileMark(int stage) {
+    if (!profileTiming) {
+      return;
     }
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    profile.stageNs[stage] += std::chrono::duration<double, std::nano>(now - profileMarkTime).count();
+    profileMarkTime = now;
+  }
 
-    bool interior = (i1 >= 1) && (i1 + 2 <= maxIndex);
-    if (interior) {
-      int i0 = i1 - 1;
-      int i2 = i1 + 1;
-      int i3 = i1 + 2;
-      return {TemporalDeckBuffer::cubicSample(leftData[i0], leftData[i1], leftData[i2], leftData[i3], t),
-              TemporalDeckBuffer::cubicSample(rightData[i0], rightData[i1], rightData[i2], rightData[i3], t)};
+  void profileBeginFrame() {
+    profileTiming = false;
+    if (!profilingEnabled) {
+      return;
+    }
+    profile.counters[PROFILE_FRAMES]++;
+    if (--profileCountdown <= 0) {
+      profileCountdown = kProfileIntervalFrames;
+      profileTiming = true;
+      profile.counters[PROFILE_TIMED_FRAMES]++;
+      profileMarkTime = std::chrono::steady_clock::now();
     }
-    int i0 = clampSampleIndex(i1 - 1, maxIndex);
-    int i2 = clampSampleIndex(i1 + 1, maxIndex);
-    int i3 = clampSampleIndex(i1 + 2, maxIndex);
-    return {TemporalDeckBuffer::cubicSample(leftAt(i0), leftAt(i1), leftAt(i2), leftAt(i3), t),
-            TemporalDeckBuffer::cubicSample(rightAt(i0), rightAt(i1), rightAt(i2), rightAt(i3), t)};
   }
 
-  std::pair<float, float> readLiveInterpolatedAt(double pos, int interpolationMode) const {
-    if (interpolationMode == SCRATCH_INTERP_LAGRANGE6) {
-      return buffer.readHighQuality(pos);
+  void profileEndFrame(int lastStage, bool wasSlipReturning) {
+    if (!profilingEnabled) {
+      return;
+    }
+    profileMark(lastStage);
+    profile.counters[PROFILE_READS_LINEAR + clamp(activeInterpolationTier, 0, INTERP_TIER_COUNT - 1)]++;
+    if (slipReturning && !wasSlipReturning) {
+      profile.counters[PROFILE_SLIP_RETURNS]++;
     }
-    if (interpolationMode == SCRATCH_INTERP_SINC) {
-      return buffer.readSinc(pos);
+  }
+
+  static int tierForInterpolationMode(int mode) {
+    switch (mode) {
+    case SCRATCH_INTERP_SINC:
+      return INTERP_TIER_SINC;
+    case SCRATCH_INTERP_LAGRANGE6:
+      return INTERP_TIER_LAGRANGE6;
+    default:
+      return INTERP_TIER_CUBIC;
     }
-    return buffer.readCubic(pos);
+  }
+
+  int autoInterpolationTierFor(double speed, bool scratching) const {
+    double absSpeed = std::fabs(speed);
+    int tier = INTERP_TIER_LAGRANGE6;
+    if (absSpeed <= kAutoInterpStationarySpeed) {
+      tier = INTERP_TIER_LINEAR;
+    } else if (scratching) {
+      tier = absSpeed <= kAutoInterpSincMaxSpeed ? INTERP_TIER_SINC : INTERP_TIER_LAGRANGE6;
+    } else if (std::fabs(absSpeed - 1.0) <= kAutoInterpUnitySpeedTolerance) {
+      tier = INTERP_TIER_CUBIC;
+    }
+    return std::min(tier, clamp(autoInterpolationCap, int(INTERP_TIER_LINEAR), int(INTERP_TIER_SINC)));
+  }
+
+  // Tier for this frame's variable-rate read. Auto re-decides once per
+  // kAutoInterpBlockFrames from the smoothed read speed and scratch state.
+  int variableRateInterpolationTier(bool scratching) {
+    if (scratchInterpolationMode != SCRATCH_INTERP_AUTO) {
+      return tierForInterpolationMode(scratchInterpolationMode);
+    }
+    if (--autoInterpBlockCountdown <= 0) {
+      autoInterpBlockCountdown = kAutoInterpBlockFrames;
+      autoInterpolationTier = autoInterpolationTierFor(mipReadSpeed, scratching);
+    }
+    return autoInterpolationTier;
+  }
+
+  void trackMipReadSpeed(double readDelta) {
+    double absDelta = std::fabs(readDelta);
+    if (absDelta > kMipMaxTrackedSpeed) {
+      return;
+    }
+    mipReadSpeed += (absDelta - mipReadSpeed) * double(mipReadSpeedCoeff);
   }
 
   void installSample(const std::vector<float> &left, const std::vector<float> &right, int frames, bool autoplay,
                      bool truncated) {
     (void)autoplay;
+    sampleStream.reset();
     sampleLoaded = frames > 0 && !left.empty();
     sampleModeEnabled = sampleLoaded || sampleModeEnabled;
     // Transport run-state is freeze-driven in sample mode. Keep transport
     // armed when a sample is loaded so unfreezing always resumes playback.
     sampleTransportPlaying = sampleLoaded;
     sampleTruncated = truncated;
+    if (buffer.halfStorage) {
+      // Sample mode reads float storage directly; same length, float layout.
+      buffer.reset(buffer.sampleRate, buffer.durationSeconds, buffer.monoStorage, false);
+    }
     sampleFrames = std::max(0, std::min(frames, buffer.size));
     samplePlayhead = 0.0;
     readHead = 0.0;
@@ -1455,10 +2789,23 @@ struct TemporalDeckEngine {
         buffer.right[i] = r;
       }
     }
+    if (buffer.mipMapped) {
+      // Built over the whole ring so the levels keep their ring layout.
+      buildMipLevels(buffer.left, buffer.right, buffer.size, &buffer.mips);
+    }
+    buildOnsetIndex(buffer.left, buffer.monoStorage ? std::vector<float>() : buffer.right, sampleFrames, sampleRate,
+                    &sampleOnsets);
+    snapWindowRawEnd = -1.0;
+    seekFadeRemaining = 0;
   }
 
+  // `mips` are the worker-built read levels (see buildMipLevels()); leaving
+  // them empty plays the sample from the base level only. Likewise an empty
+  // `onsets` leaves snapped seeks unsnapped.
   void installPreparedSample(std::vector<float> &&left, std::vector<float> &&right, int frames, bool autoplay,
-                             bool truncated, bool monoStorage) {
+                             bool truncated, bool monoStorage, TemporalDeckMipLevels &&mips = TemporalDeckMipLevels(),
+                             TemporalDeckOnsetIndex &&onsets = TemporalDeckOnsetIndex()) {
+    sampleStream.reset();
     sampleLoaded = frames > 0 && !left.empty();
     sampleModeEnabled = sampleLoaded || sampleModeEnabled;
     sampleTransportPlaying = autoplay && sampleLoaded;
@@ -1469,6 +2816,14 @@ struct TemporalDeckEngine {
 
     buffer.sampleRate = sampleRate;
     buffer.monoStorage = monoStorage;
+    buffer.halfStorage = false;
+    buffer.mipMapped = false;
+    std::vector<uint16_t>().swap(buffer.leftHalf);
+    std::vector<uint16_t>().swap(buffer.rightHalf);
+    buffer.mips = std::move(mips);
+    sampleOnsets = std::move(onsets);
+    snapWindowRawEnd = -1.0;
+    seekFadeRemaining = 0;
     buffer.left = std::move(left);
     if (monoStorage) {
       std::vector<float>().swap(buffer.right);
@@ -1489,38 +2844,19 @@ struct TemporalDeckEngine {
     buffer.writeHead = buffer.wrapIndex(sampleFrames);
   }
 
-  bool convertLiveWindowToSample(float bufferKnob, bool autoplay) {
-    bool sampleModeActive = sampleModeEnabled && sampleLoaded && sampleFrames > 0;
-    if (sampleModeActive || buffer.filled <= 0 || buffer.size <= 0) {
-      return false;
-    }
-
-    double liveLimit = accessibleLag(bufferKnob);
-    int capturedFrames = std::max(1, int(std::floor(std::max(0.0, liveLimit))) + 1);
-    capturedFrames = std::min(capturedFrames, buffer.filled);
-    if (capturedFrames <= 0) {
-      return false;
-    }
-
-    std::vector<float> left(capturedFrames, 0.f);
-    std::vector<float> right;
-    if (!buffer.monoStorage) {
-      right.assign(capturedFrames, 0.f);
-    }
-
-    int newestIndex = buffer.wrapIndex(buffer.writeHead - 1);
-    int oldestIndex = buffer.wrapIndex(newestIndex - (capturedFrames - 1));
-    for (int i = 0; i < capturedFrames; ++i) {
-      int src = buffer.wrapIndex(oldestIndex + i);
-      left[i] = buffer.left[src];
-      if (!buffer.monoStorage) {
-        right[i] = buffer.rightSample(src);
-      }
+  // Plays `pages` in place of buffer contents. The buffer shrinks to a single
+  // frame; the sample length is the stream's, not capped by the buffer mode.
+  void installStreamedSample(const std::shared_ptr<TemporalDeckPageCache> &pages, bool autoplay, bool monoStorage) {
+    installPreparedSample(std::vector<float>(1, 0.f), std::vector<float>(), 1, autoplay, false, monoStorage);
+    if (!pages || pages->frames <= 0) {
+      sampleLoaded = false;
+      sampleTransportPlaying = false;
+      sampleFrames = 0;
+      return;
     }
-
-    installPreparedSample(std::move(left), std::move(right), capturedFrames, autoplay, false, buffer.monoStorage);
-    sampleModeEnabled = sampleLoaded;
-    return sampleLoaded;
+    sampleStream = pages;
+    sampleFrames = pages->frames;
+    publishStreamHead(0.0);
   }
 
   void clearScratchMotionState() {
@@ -1821,6 +3157,8 @@ struct TemporalDeckEngine {
     const float platterGestureVelocity = input.platterGestureVelocity;
     const float wheelDelta = input.wheelDelta;
     FrameResult result;
+    profileBeginFrame();
+    const bool wasSlipReturning = slipReturning;
     double prevReadHead = readHead;
     float nowSnapThresholdSamples = sampleRate * (kNowSnapThresholdMs / 1000.f);
     bool sampleModeActive = sampleModeEnabled && sampleLoaded && sampleFrames > 0;
@@ -1835,8 +3173,7 @@ struct TemporalDeckEngine {
     bool slipModeChanged = slipReturnMode != lastSlipReturnMode;
     lastSlipReturnMode = slipReturnMode;
 
-    double sampleEndPos = sampleModeActive ? std::max(0.0, double(sampleFrames - 1)) : 0.0;
-    double sampleWindowEndPos = sampleModeActive ? sampleEndPos * double(clamp(bufferKnob, 0.f, 1.f)) : 0.0;
+    double sampleWindowEndPos = sampleModeActive ? sampleWindowEndFor(bufferKnob) : 0.0;
     double limit = sampleModeActive ? sampleWindowEndPos : accessibleLag(bufferKnob);
     double minLag = 0.0;
     double maxLag = sampleModeActive ? sampleWindowEndPos : std::max(limit, 0.0);
@@ -1933,10 +3270,17 @@ struct TemporalDeckEngine {
       readHead = samplePlayhead;
       newestPos = sampleWindowEndPos;
 
-      std::pair<float, float> wet = readSampleBounded(readHead, SCRATCH_INTERP_CUBIC, sampleWindowEndPos);
       float readDeltaForTone = float(readHead - prevReadHead);
+      trackMipReadSpeed(readDeltaForTone);
+      activeInterpolationTier = INTERP_TIER_CUBIC;
+      profileMark(PROFILE_STAGE_CONTROL);
+      std::pair<float, float> wet = readSampleBounded(readHead, INTERP_TIER_CUBIC, sampleWindowEndPos, mipReadSpeed);
+      wet = applySeekFade(wet, readHead - prevReadHead, INTERP_TIER_CUBIC, sampleWindowEndPos);
+      publishStreamHead(readHead - prevReadHead);
+      profileMark(PROFILE_STAGE_READ);
       float motionAmount = clamp(float((std::fabs(readDeltaForTone) - 1.0) / 3.0), 0.f, 1.f);
       wet = applyCartridgeCharacter(wet, motionAmount, false);
+      profileMark(PROFILE_STAGE_CARTRIDGE);
 
       scratchFlipTransientEnv *= 0.92f;
       if (scratchFlipTransientEnv < 1e-4f) {
@@ -1983,6 +3327,7 @@ struct TemporalDeckEngine {
       result.samplePlayhead = std::max(0.0, sampleUiFrame / std::max(sampleRate, 1.f));
       result.sampleDuration = std::max(0.0, (sampleUiEndFrame + 1.0) / std::max(sampleRate, 1.f));
       result.sampleProgress = sampleUiEndFrame > 0.0 ? clampd(sampleUiFrame / sampleUiEndFrame, 0.0, 1.0) : 0.0;
+      profileEndFrame(PROFILE_STAGE_OUTPUT, wasSlipReturning);
       return result;
     }
     auto startNowCatch = [&](float startLag) {
@@ -2321,9 +3666,13 @@ struct TemporalDeckEngine {
         // cursor, not the scratch lag reference frame.
         readHead = samplePlayhead;
       } else {
-        double candidate = unwrapReadNearWrite(readHead, newestPos) + double(speed);
-        candidate = std::max(newestPos - maxLag, std::min(candidate, newestPos - minLag));
-        readHead = buffer.wrapPosition(candidate);
+        // In fixed point the lag bounds are integer compares and the wrap a
+        // single add, so steady playback never accumulates rounding.
+        TemporalDeckPosition newest(newestPos);
+        int64_t lag = newest.distanceBackTo(readHead, buffer.size) - TemporalDeckPosition::rawFrom(double(speed));
+        lag = std::min(TemporalDeckPosition::rawFrom(maxLag), std::max(lag, TemporalDeckPosition::rawFrom(minLag)));
+        readHead = TemporalDeckPosition::fromRaw(newest.raw - lag);
+        readHead.wrap(buffer.size);
       }
     }
 
@@ -2354,18 +3703,20 @@ struct TemporalDeckEngine {
     bool scratchReadPath = anyScratch;
     bool slipReadPath = !sampleModeActive && (slipReturning || slipBlendActive);
     bool variableRateReadPath = scratchReadPath || slipReadPath;
-    int effectiveScratchInterpolation = clamp(scratchInterpolationMode, SCRATCH_INTERP_CUBIC,
-                                              SCRATCH_INTERP_COUNT - 1);
+    int effectiveScratchInterpolation =
+      variableRateReadPath ? variableRateInterpolationTier(scratchReadPath) : int(INTERP_TIER_CUBIC);
     double readDeltaForTone = readHead - prevReadHead;
     if (buffer.size > 0) {
-      double halfSize = double(buffer.size) * 0.5;
+      double wrapSize = readWrapSize();
+      double halfSize = wrapSize * 0.5;
       if (readDeltaForTone > halfSize) {
-        readDeltaForTone -= double(buffer.size);
+        readDeltaForTone -= wrapSize;
       }
       if (readDeltaForTone < -halfSize) {
-        readDeltaForTone += double(buffer.size);
+        readDeltaForTone += wrapSize;
       }
     }
+    trackMipReadSpeed(readDeltaForTone);
     float motionAmount = clamp(float((std::fabs(readDeltaForTone) - 1.0) / 3.0), 0.f, 1.f);
     if (scratchReadPath) {
       // Preserve more buffer detail during scratching by reducing motion-driven
@@ -2373,13 +3724,19 @@ struct TemporalDeckEngine {
       motionAmount *= 0.4f;
     }
     std::pair<float, float> wet;
+    profileMark(PROFILE_STAGE_CONTROL);
     if (sampleModeActive) {
       // Match live-mode behavior: normal transport playback uses cubic.
-      int sampleInterp = scratchReadPath ? effectiveScratchInterpolation : SCRATCH_INTERP_CUBIC;
-      wet = readSampleBounded(readHead, sampleInterp, sampleWindowEndPos);
+      int sampleInterp = scratchReadPath ? effectiveScratchInterpolation : int(INTERP_TIER_CUBIC);
+      activeInterpolationTier = sampleInterp;
+      wet = readSampleBounded(readHead, sampleInterp, sampleWindowEndPos, mipReadSpeed);
+      wet = applySeekFade(wet, readHead - prevReadHead, sampleInterp, sampleWindowEndPos);
+      publishStreamHead(readHead - prevReadHead);
     } else if (slipBlendActive) {
-      std::pair<float, float> catchWet = readLiveInterpolatedAt(readHead, effectiveScratchInterpolation);
+      std::pair<float, float> catchWet =
+        readLiveInterpolatedAt(readHead, effectiveScratchInterpolation, mipReadSpeed);
       std::pair<float, float> liveWet = readLiveInterpolatedAt(newestPos, effectiveScratchInterpolation);
+      activeInterpolationTier = effectiveScratchInterpolation;
       float blendProgress = 1.f - clamp(slipBlendRemaining / std::max(kSlipBlendTime, 1e-6f), 0.f, 1.f);
       float theta = blendProgress * 0.5f * kPi;
       float catchGain = std::cos(theta);
@@ -2393,11 +3750,15 @@ struct TemporalDeckEngine {
         pinToNow = true;
       }
     } else if (variableRateReadPath) {
-      wet = readLiveInterpolatedAt(readHead, effectiveScratchInterpolation);
+      wet = readLiveInterpolatedAt(readHead, effectiveScratchInterpolation, mipReadSpeed);
+      activeInterpolationTier = effectiveScratchInterpolation;
     } else {
-      wet = buffer.readCubic(readHead);
+      wet = readLiveInterpolatedAt(readHead, INTERP_TIER_CUBIC, mipReadSpeed);
+      activeInterpolationTier = INTERP_TIER_CUBIC;
     }
+    profileMark(PROFILE_STAGE_READ);
     wet = applyCartridgeCharacter(wet, motionAmount, scratchReadPath);
+    profileMark(PROFILE_STAGE_CARTRIDGE);
     if (slipReadPath) {
       float slipSpeedNorm =
         clamp(slipCatchVelocity / std::max(sampleRate * std::max(slipCatchMaxExtraRatio(), 0.1f), 1.f), 0.f, 1.f);
@@ -2535,14 +3896,24 @@ struct TemporalDeckEngine {
       lagPreWriteForVisual = currentLagFromNewest(newestPos);
     }
 
+    profileMark(PROFILE_STAGE_OUTPUT);
     bool writeAdvanced = false;
-    if (!sampleModeActive && !freezeState && !holdAtBufferEdge) {
+    if (sharedBufferTap) {
+      // The owner already wrote this frame (or held the ring); follow it so
+      // lag-anchored state stays in write-head time.
+      writeAdvanced = !sampleModeActive &&
+                      (buffer.writeHead != tapSeenWriteHead || buffer.filled != tapSeenFilled);
+      tapSeenWriteHead = buffer.writeHead;
+      tapSeenFilled = buffer.filled;
+    } else if (!sampleModeActive && !freezeState && !holdAtBufferEdge) {
       if (noFeedback) {
         buffer.write(inL, inR);
       } else {
         buffer.write(inL + outL * feedback, inR + outR * feedback);
       }
       writeAdvanced = true;
+    }
+    if (writeAdvanced) {
       newestPos = newestReadablePos();
       if (pinToNow) {
         readHead = newestPos;
@@ -2563,12 +3934,13 @@ struct TemporalDeckEngine {
 
     if (buffer.size > 0) {
       double readDelta = readHead - prevReadHead;
-      double halfSize = double(buffer.size) * 0.5;
+      double wrapSize = readWrapSize();
+      double halfSize = wrapSize * 0.5;
       if (readDelta > halfSize) {
-        readDelta -= double(buffer.size);
+        readDelta -= wrapSize;
       }
       if (readDelta < -halfSize) {
-        readDelta += double(buffer.size);
+        readDelta += wrapSize;
       }
       // Drive the platter UI from actual read-head movement so the visual stays
       // synchronized when transport is causality-limited near NOW.
@@ -2597,6 +3969,7 @@ struct TemporalDeckEngine {
     result.samplePlayhead = sampleModeActive ? std::max(0.0, sampleUiFrame / std::max(sampleRate, 1.f)) : 0.0;
     result.sampleDuration = sampleModeActive ? std::max(0.0, (sampleUiEndFrame + 1.0) / std::max(sampleRate, 1.f)) : 0.0;
     result.sampleProgress = sampleModeActive && sampleUiEndFrame > 0.0 ? clampd(sampleUiFrame / sampleUiEndFrame, 0.0, 1.0) : 0.0;
+    profileEndFrame(PROFILE_STAGE_WRITE, wasSlipReturning);
     return result;
   }
 };
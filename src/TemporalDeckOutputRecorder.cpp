@@ -0,0 +1,576 @@
+#include "TemporalDeckOutputRecorder.hpp"
+#include "TemporalDeckSamplePrep.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace temporaldeck {
+
+namespace {
+
+static constexpr int kFlacBitsPerSample = 24;
+static constexpr int kFlacMaxFixedOrder = 4;
+static constexpr float kFlacFullScale = 8388607.f;
+// Offset of STREAMINFO's first byte: "fLaC" plus the metadata block header.
+static constexpr long kFlacStreamInfoOffset = 8;
+
+void setError(std::string *errorOut, const char *message) {
+  if (errorOut) {
+    *errorOut = message;
+  }
+}
+
+void appendLe32(std::vector<uint8_t> *bytes, uint32_t value) {
+  for (int i = 0; i < 4; ++i) {
+    bytes->push_back(uint8_t((value >> (8 * i)) & 0xFFu));
+  }
+}
+
+void appendLe16(std::vector<uint8_t> *bytes, uint16_t value) {
+  bytes->push_back(uint8_t(value & 0xFFu));
+  bytes->push_back(uint8_t(value >> 8));
+}
+
+uint32_t floatBits(float v) {
+  uint32_t bits;
+  std::memcpy(&bits, &v, sizeof(bits));
+  return bits;
+}
+
+std::vector<uint8_t> wavFloatHeader(uint32_t sampleRate, uint64_t dataBytes) {
+  std::vector<uint8_t> bytes;
+  auto appendTag = [&](const char *tag) { bytes.insert(bytes.end(), tag, tag + 4); };
+  appendTag("RIFF");
+  appendLe32(&bytes, uint32_t(36ull + dataBytes));
+  appendTag("WAVE");
+  appendTag("fmt ");
+  appendLe32(&bytes, 16u);
+  appendLe16(&bytes, 3); // IEEE float
+  appendLe16(&bytes, 2);
+  appendLe32(&bytes, sampleRate);
+  appendLe32(&bytes, sampleRate * 8u);
+  appendLe16(&bytes, 8);
+  appendLe16(&bytes, 32);
+  appendTag("data");
+  appendLe32(&bytes, uint32_t(dataBytes));
+  return bytes;
+}
+
+// MSB-first bit packer for FLAC frames.
+struct BitWriter {
+  std::vector<uint8_t> *bytes = nullptr;
+  uint64_t acc = 0;
+  int bits = 0;
+
+  explicit BitWriter(std::vector<uint8_t> *out) : bytes(out) {}
+
+  void put(uint32_t value, int count) {
+    acc = (acc << count) | (uint64_t(value) & ((1ull << count) - 1ull));
+    bits += count;
+    while (bits >= 8) {
+      bits -= 8;
+      bytes->push_back(uint8_t(acc >> bits));
+    }
+    acc &= (1ull << bits) - 1ull;
+  }
+
+  void putUnary(uint32_t zeros) {
+    while (zeros >= 32) {
+      put(0, 32);
+      zeros -= 32;
+    }
+    put(1, int(zeros) + 1);
+  }
+
+  // FLAC's UTF-8-style coded frame number.
+  void putCodedNumber(uint64_t value) {
+    if (value < 0x80) {
+      put(uint32_t(value), 8);
+      return;
+    }
+    int n = value < 0x800 ? 2 : value < 0x10000 ? 3 : value < 0x200000 ? 4 : value < 0x4000000 ? 5 : 6;
+    put(((0xFF00u >> n) & 0xFFu) | uint32_t(value >> (6 * (n - 1))), 8);
+    for (int i = n - 2; i >= 0; --i) {
+      put(0x80u | uint32_t((value >> (6 * i)) & 0x3Fu), 8);
+    }
+  }
+
+  void alignToByte() {
+    if (bits > 0) {
+      put(0, 8 - bits);
+    }
+  }
+};
+
+uint8_t crc8(const uint8_t *data, size_t count) {
+  uint8_t crc = 0;
+  for (size_t i = 0; i < count; ++i) {
+    crc ^= data[i];
+    for (int b = 0; b < 8; ++b) {
+      crc = uint8_t((crc & 0x80u) ? (crc << 1) ^ 0x07u : crc << 1);
+    }
+  }
+  return crc;
+}
+
+uint16_t crc16(const uint8_t *data, size_t count) {
+  uint16_t crc = 0;
+  for (size_t i = 0; i < count; ++i) {
+    crc ^= uint16_t(data[i]) << 8;
+    for (int b = 0; b < 8; ++b) {
+      crc = uint16_t((crc & 0x8000u) ? (crc << 1) ^ 0x8005u : crc << 1);
+    }
+  }
+  return crc;
+}
+
+int32_t quantize24(float v) {
+  return int32_t(std::lround(clamp(v, -1.f, 1.f) * kFlacFullScale));
+}
+
+// Fixed-predictor residual of the given order at sample i (i >= order).
+int32_t fixedResidual(const int32_t *s, int i, int order) {
+  switch (order) {
+  case 0:
+    return s[i];
+  case 1:
+    return s[i] - s[i - 1];
+  case 2:
+    return s[i] - 2 * s[i - 1] + s[i - 2];
+  case 3:
+    return s[i] - 3 * s[i - 1] + 3 * s[i - 2] - s[i - 3];
+  default:
+    return s[i] - 4 * s[i - 1] + 6 * s[i - 2] - 4 * s[i - 3] + s[i - 4];
+  }
+}
+
+uint32_t zigzag(int32_t v) {
+  return (uint32_t(v) << 1) ^ uint32_t(v >> 31);
+}
+
+struct RiceChoice {
+  int parameter = 0;
+  uint64_t bits = 0;
+};
+
+// Best single-partition Rice parameter for the residual of `order`.
+RiceChoice chooseRice(const int32_t *s, int n, int order) {
+  uint64_t sum = 0;
+  for (int i = order; i < n; ++i) {
+    sum += zigzag(fixedResidual(s, i, order));
+  }
+  int count = n - order;
+  int guess = 0;
+  while (guess < 30 && (uint64_t(count) << (guess + 1)) <= sum) {
+    guess++;
+  }
+  RiceChoice best;
+  best.bits = std::numeric_limits<uint64_t>::max();
+  for (int k = std::max(0, guess - 1); k <= std::min(30, guess + 1); ++k) {
+    uint64_t bits = uint64_t(count) * uint64_t(k + 1);
+    for (int i = order; i < n; ++i) {
+      bits += zigzag(fixedResidual(s, i, order)) >> k;
+    }
+    if (bits < best.bits) {
+      best.parameter = k;
+      best.bits = bits;
+    }
+  }
+  return best;
+}
+
+void writeSubframe(BitWriter &out, const int32_t *s, int n) {
+  bool constant = true;
+  for (int i = 1; i < n && constant; ++i) {
+    constant = s[i] == s[0];
+  }
+  if (constant) {
+    out.put(0x00, 8);
+    out.put(uint32_t(s[0]), kFlacBitsPerSample);
+    return;
+  }
+
+  int bestOrder = -1;
+  RiceChoice bestRice;
+  uint64_t bestBits = uint64_t(n) * kFlacBitsPerSample; // verbatim
+  for (int order = 0; order <= std::min(kFlacMaxFixedOrder, n - 1); ++order) {
+    RiceChoice rice = chooseRice(s, n, order);
+    int parameterBits = rice.parameter > 14 ? 5 : 4;
+    uint64_t bits = uint64_t(order) * kFlacBitsPerSample + 6u + uint64_t(parameterBits) + rice.bits;
+    if (bits < bestBits) {
+      bestOrder = order;
+      bestRice = rice;
+      bestBits = bits;
+    }
+  }
+
+  if (bestOrder < 0) {
+    out.put(0x02, 8);
+    for (int i = 0; i < n; ++i) {
+      out.put(uint32_t(s[i]), kFlacBitsPerSample);
+    }
+    return;
+  }
+  out.put(uint32_t(0x10 | (bestOrder << 1)), 8);
+  for (int i = 0; i < bestOrder; ++i) {
+    out.put(uint32_t(s[i]), kFlacBitsPerSample);
+  }
+  // Rice (4-bit parameter) or Rice2 (5-bit) with a single partition.
+  bool rice2 = bestRice.parameter > 14;
+  out.put(rice2 ? 1u : 0u, 2);
+  out.put(0, 4);
+  out.put(uint32_t(bestRice.parameter), rice2 ? 5 : 4);
+  int k = bestRice.parameter;
+  for (int i = bestOrder; i < n; ++i) {
+    uint32_t u = zigzag(fixedResidual(s, i, bestOrder));
+    out.putUnary(u >> k);
+    if (k > 0) {
+      out.put(u & ((1u << k) - 1u), k);
+    }
+  }
+}
+
+} // namespace
+
+int audioFileFormatForPath(const std::string &path) {
+  size_t dot = path.find_last_of('.');
+  if (dot == std::string::npos) {
+    return AUDIO_FILE_WAV_FLOAT;
+  }
+  std::string ext = path.substr(dot + 1);
+  std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+  return ext == "flac" ? AUDIO_FILE_FLAC_24 : AUDIO_FILE_WAV_FLOAT;
+}
+
+AudioFileWriter::~AudioFileWriter() {
+  close();
+}
+
+bool AudioFileWriter::open(const std::string &path, int format, float sampleRate, std::string *errorOut) {
+  close();
+  format_ = format;
+  sampleRate_ = uint32_t(clamp(std::lround(double(sampleRate)), 1l, (1l << 20) - 1l));
+  framesWritten_ = 0;
+  failed_ = false;
+  blockFill_ = 0;
+  flacFrameNumber_ = 0;
+  minFrameBytes_ = 0;
+  maxFrameBytes_ = 0;
+  file_ = std::fopen(path.c_str(), "wb");
+  if (!file_) {
+    setError(errorOut, "Failed to open recording file");
+    return false;
+  }
+  std::vector<uint8_t> header;
+  if (format_ == AUDIO_FILE_FLAC_24) {
+    blockLeft_.assign(kFlacBlockFrames, 0);
+    blockRight_.assign(kFlacBlockFrames, 0);
+    const char magic[] = {'f', 'L', 'a', 'C'};
+    header.insert(header.end(), magic, magic + 4);
+    // Last metadata block, STREAMINFO, 34 bytes.
+    header.push_back(0x80);
+    header.push_back(0);
+    header.push_back(0);
+    header.push_back(34);
+    std::vector<uint8_t> info = flacStreamInfo();
+    header.insert(header.end(), info.begin(), info.end());
+  } else {
+    header = wavFloatHeader(sampleRate_, 0);
+  }
+  if (!writeBytes(header)) {
+    setError(errorOut, "Failed to write recording header");
+    std::fclose(file_);
+    file_ = nullptr;
+    return false;
+  }
+  return true;
+}
+
+bool AudioFileWriter::writeBytes(const std::vector<uint8_t> &bytes) {
+  if (!file_ || failed_) {
+    return false;
+  }
+  if (!bytes.empty() && std::fwrite(bytes.data(), 1, bytes.size(), file_) != bytes.size()) {
+    failed_ = true;
+  }
+  return !failed_;
+}
+
+bool AudioFileWriter::write(const float *left, const float *right, int frames) {
+  if (!file_ || failed_ || frames <= 0) {
+    return file_ && !failed_;
+  }
+  if (format_ == AUDIO_FILE_FLAC_24) {
+    for (int i = 0; i < frames; ++i) {
+      blockLeft_[blockFill_] = quantize24(left[i]);
+      blockRight_[blockFill_] = quantize24(right[i]);
+      if (++blockFill_ == kFlacBlockFrames && !encodeFlacBlock()) {
+        return false;
+      }
+    }
+    framesWritten_ += frames;
+    return true;
+  }
+
+  uint64_t dataBytes = uint64_t(framesWritten_ + frames) * 8ull;
+  if (dataBytes + 36ull > uint64_t(std::numeric_limits<uint32_t>::max())) {
+    return false;
+  }
+  scratch_.clear();
+  for (int i = 0; i < frames; ++i) {
+    appendLe32(&scratch_, floatBits(left[i]));
+    appendLe32(&scratch_, floatBits(right[i]));
+  }
+  if (!writeBytes(scratch_)) {
+    return false;
+  }
+  framesWritten_ += frames;
+  return true;
+}
+
+std::vector<uint8_t> AudioFileWriter::flacStreamInfo() const {
+  std::vector<uint8_t> bytes;
+  BitWriter out(&bytes);
+  uint64_t total = uint64_t(std::max<int64_t>(framesWritten_, 0));
+  out.put(kFlacBlockFrames, 16);
+  out.put(kFlacBlockFrames, 16);
+  out.put(minFrameBytes_, 24);
+  out.put(maxFrameBytes_, 24);
+  out.put(sampleRate_, 20);
+  out.put(2 - 1, 3);
+  out.put(kFlacBitsPerSample - 1, 5);
+  out.put(uint32_t(total >> 32) & 0xFu, 4);
+  out.put(uint32_t(total & 0xFFFFFFFFu), 32);
+  // MD5 left zero: decoders treat it as unknown.
+  for (int i = 0; i < 16; ++i) {
+    out.put(0, 8);
+  }
+  return bytes;
+}
+
+bool AudioFileWriter::encodeFlacBlock() {
+  int n = blockFill_;
+  blockFill_ = 0;
+  if (n <= 0) {
+    return true;
+  }
+  scratch_.clear();
+  BitWriter out(&scratch_);
+  out.put(0xFFF8, 16);
+  bool fullBlock = n == kFlacBlockFrames;
+  out.put(fullBlock ? 0xCu : 0x7u, 4); // 4096, or a 16-bit size after the number
+  out.put(0, 4);                       // rate from STREAMINFO
+  out.put(0x1, 4);                     // independent left/right
+  out.put(0x6, 3);                     // 24 bits
+  out.put(0, 1);
+  out.putCodedNumber(flacFrameNumber_++);
+  if (!fullBlock) {
+    out.put(uint32_t(n - 1), 16);
+  }
+  out.put(crc8(scratch_.data(), scratch_.size()), 8);
+  writeSubframe(out, blockLeft_.data(), n);
+  writeSubframe(out, blockRight_.data(), n);
+  out.alignToByte();
+  out.put(crc16(scratch_.data(), scratch_.size()), 16);
+
+  uint32_t frameBytes = uint32_t(scratch_.size());
+  minFrameBytes_ = minFrameBytes_ == 0 ? frameBytes : std::min(minFrameBytes_, frameBytes);
+  maxFrameBytes_ = std::max(maxFrameBytes_, frameBytes);
+  return writeBytes(scratch_);
+}
+
+bool AudioFileWriter::close(std::string *errorOut) {
+  if (!file_) {
+    return true;
+  }
+  bool ok = !failed_;
+  if (format_ == AUDIO_FILE_FLAC_24) {
+    ok = encodeFlacBlock() && ok;
+    ok = ok && std::fseek(file_, kFlacStreamInfoOffset, SEEK_SET) == 0 && writeBytes(flacStreamInfo());
+  } else {
+    ok = std::fseek(file_, 0, SEEK_SET) == 0 && writeBytes(wavFloatHeader(sampleRate_, uint64_t(framesWritten_) * 8ull)) &&
+         ok;
+  }
+  ok = std::fclose(file_) == 0 && ok;
+  file_ = nullptr;
+  if (!ok) {
+    setError(errorOut, "Failed to finish recording file");
+  }
+  return ok;
+}
+
+OutputRecorder::~OutputRecorder() {
+  producerDone_.store(true, std::memory_order_release);
+  joinWriter();
+}
+
+void OutputRecorder::joinWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  if (writerThread_.joinable()) {
+    writerThread_.join();
+  }
+}
+
+bool OutputRecorder::start(const std::string &path, float sampleRate, std::string *errorOut) {
+  if (recording_.load(std::memory_order_acquire)) {
+    setError(errorOut, "Already recording");
+    return false;
+  }
+  joinWriter();
+  if (!writer_.open(path, audioFileFormatForPath(path), sampleRate, errorOut)) {
+    return false;
+  }
+  ring_.allocate(int(std::ceil(double(sampleRate) * kRecorderRingSeconds)));
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = false;
+    path_ = path;
+    lastError_.clear();
+  }
+  overruns_.store(0, std::memory_order_relaxed);
+  framesWritten_.store(0, std::memory_order_relaxed);
+  stopRequested_.store(false, std::memory_order_relaxed);
+  producerDone_.store(false, std::memory_order_relaxed);
+  recording_.store(true, std::memory_order_release);
+  writerThread_ = std::thread(&OutputRecorder::writerLoop, this);
+  startRequested_.store(true, std::memory_order_release);
+  return true;
+}
+
+void OutputRecorder::requestStop() {
+  if (startRequested_.exchange(false, std::memory_order_acq_rel)) {
+    // The audio thread never picked the start up; nothing will be pushed.
+    producerDone_.store(true, std::memory_order_release);
+  } else {
+    stopRequested_.store(true, std::memory_order_release);
+  }
+  cv_.notify_all();
+}
+
+std::string OutputRecorder::path() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return path_;
+}
+
+std::string OutputRecorder::lastError() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return lastError_;
+}
+
+void OutputRecorder::push(float left, float right) {
+  if (!active_) {
+    if (!startRequested_.load(std::memory_order_relaxed) || !startRequested_.exchange(false, std::memory_order_acquire)) {
+      return;
+    }
+    active_ = true;
+  }
+  if (stopRequested_.load(std::memory_order_relaxed)) {
+    stopRequested_.store(false, std::memory_order_relaxed);
+    endRecording();
+    return;
+  }
+  const float scale = 1.f / kSampleFileVoltageScale;
+  if (!ring_.push(left * scale, right * scale)) {
+    overruns_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void OutputRecorder::endRecording() {
+  if (!active_) {
+    return;
+  }
+  active_ = false;
+  producerDone_.store(true, std::memory_order_release);
+}
+
+void OutputRecorder::writerLoop() {
+  std::vector<float> left(kRecorderChunkFrames);
+  std::vector<float> right(kRecorderChunkFrames);
+  bool writable = true;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    lock.unlock();
+    // Read before draining, so every frame pushed before the stop is written.
+    bool done = producerDone_.load(std::memory_order_acquire);
+    int got = 0;
+    while ((got = ring_.pop(left.data(), right.data(), kRecorderChunkFrames)) > 0) {
+      if (writable) {
+        writable = writer_.write(left.data(), right.data(), got);
+        framesWritten_.store(writer_.framesWritten(), std::memory_order_relaxed);
+      }
+    }
+    lock.lock();
+    if (!writable && lastError_.empty()) {
+      lastError_ = "Recording stopped: file write failed or reached the format size limit";
+    }
+    if (done || shutdown_) {
+      break;
+    }
+    cv_.wait_for(lock, std::chrono::milliseconds(kRecorderWriterPollMs));
+  }
+  lock.unlock();
+  std::string error;
+  if (!writer_.close(&error)) {
+    lock.lock();
+    if (lastError_.empty()) {
+      lastError_ = error;
+    }
+    lock.unlock();
+  }
+  recording_.store(false, std::memory_order_release);
+}
+
+bool exportRingWindow(const std::string &path, const TemporalDeckBuffer &ring, int endIndex, int frames,
+                      const std::function<bool(int)> &keepGoing, std::string *errorOut) {
+  AudioFileWriter writer;
+  if (ring.size <= 0 || frames <= 0) {
+    setError(errorOut, "Nothing to export");
+    return false;
+  }
+  frames = std::min(frames, ring.size);
+  if (!writer.open(path, audioFileFormatForPath(path), ring.sampleRate, errorOut)) {
+    return false;
+  }
+  const int kBlock = 4096;
+  const float scale = 1.f / kSampleFileVoltageScale;
+  std::vector<float> left(kBlock);
+  std::vector<float> right(kBlock);
+  int start = endIndex - frames;
+  bool ok = true;
+  for (int done = 0; done < frames && ok; done += kBlock) {
+    if (keepGoing && !keepGoing(done)) {
+      setError(errorOut, "Export abandoned");
+      ok = false;
+      break;
+    }
+    int count = std::min(kBlock, frames - done);
+    for (int i = 0; i < count; ++i) {
+      int idx = ring.wrapIndex(start + done + i);
+      left[i] = ring.leftSample(idx) * scale;
+      right[i] = ring.rightSample(idx) * scale;
+    }
+    ok = writer.write(left.data(), right.data(), count);
+    if (!ok) {
+      setError(errorOut, "Failed to write export");
+    }
+  }
+  if (ok && keepGoing && !keepGoing(frames)) {
+    setError(errorOut, "Export abandoned");
+    ok = false;
+  }
+  ok = writer.close(ok ? errorOut : nullptr) && ok;
+  if (!ok) {
+    std::remove(path.c_str());
+  }
+  return ok;
+}
+
+} // namespace temporaldeck
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "TemporalDeckEngine.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace temporaldeck {
+
+enum AudioFileFormat {
+  AUDIO_FILE_WAV_FLOAT = 0,
+  AUDIO_FILE_FLAC_24 = 1,
+};
+
+// FLAC for a ".flac" extension, 32-bit float WAV otherwise.
+int audioFileFormatForPath(const std::string &path);
+
+// Streaming stereo encoder for recordings and exports: 32-bit float WAV, or
+// 24-bit FLAC (fixed predictors, Rice-coded residuals). Input is normalized
+// +/-1. Lengths are patched into the header by close().
+class AudioFileWriter {
+public:
+  static constexpr int kFlacBlockFrames = 4096;
+
+  ~AudioFileWriter();
+
+  bool open(const std::string &path, int format, float sampleRate, std::string *errorOut = nullptr);
+  // False once the file can take no more (write error, or the 4 GB WAV limit).
+  bool write(const float *left, const float *right, int frames);
+  bool close(std::string *errorOut = nullptr);
+  bool isOpen() const { return file_ != nullptr; }
+  int64_t framesWritten() const { return framesWritten_; }
+
+private:
+  bool writeBytes(const std::vector<uint8_t> &bytes);
+  bool encodeFlacBlock();
+  std::vector<uint8_t> flacStreamInfo() const;
+
+  std::FILE *file_ = nullptr;
+  int format_ = AUDIO_FILE_WAV_FLOAT;
+  uint32_t sampleRate_ = 44100;
+  int64_t framesWritten_ = 0;
+  bool failed_ = false;
+  std::vector<uint8_t> scratch_;
+  // FLAC block being filled.
+  std::vector<int32_t> blockLeft_;
+  std::vector<int32_t> blockRight_;
+  int blockFill_ = 0;
+  uint64_t flacFrameNumber_ = 0;
+  uint32_t minFrameBytes_ = 0;
+  uint32_t maxFrameBytes_ = 0;
+};
+
+// Single-producer/single-consumer stereo FIFO with a power-of-two capacity.
+// Indices only grow, so the consumer can drop stale frames by catching up
+// with the producer without either side writing the other's index.
+struct StereoFrameRing {
+  std::vector<float> frames;
+  uint64_t mask = 0;
+  std::atomic<uint64_t> writeIndex{0};
+  std::atomic<uint64_t> readIndex{0};
+
+  void allocate(int minFrames) {
+    uint64_t capacity = 1;
+    while (capacity < uint64_t(std::max(minFrames, 1))) {
+      capacity <<= 1;
+    }
+    frames.assign(size_t(capacity) * 2u, 0.f);
+    mask = capacity - 1;
+    readIndex.store(writeIndex.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+
+  // Producer. False when full; the frame is dropped.
+  bool push(float left, float right) {
+    uint64_t w = writeIndex.load(std::memory_order_relaxed);
+    if (w - readIndex.load(std::memory_order_acquire) > mask) {
+      return false;
+    }
+    size_t slot = size_t(w & mask) * 2u;
+    frames[slot] = left;
+    frames[slot + 1] = right;
+    writeIndex.store(w + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer.
+  int pop(float *left, float *right, int maxFrames) {
+    uint64_t r = readIndex.load(std::memory_order_relaxed);
+    uint64_t available = writeIndex.load(std::memory_order_acquire) - r;
+    int count = int(std::min<uint64_t>(available, uint64_t(std::max(maxFrames, 0))));
+    for (int i = 0; i < count; ++i) {
+      size_t slot = size_t((r + uint64_t(i)) & mask) * 2u;
+      left[i] = frames[slot];
+      right[i] = frames[slot + 1];
+    }
+    readIndex.store(r + uint64_t(count), std::memory_order_release);
+    return count;
+  }
+};
+
+static constexpr float kRecorderRingSeconds = 2.f;
+static constexpr int kRecorderWriterPollMs = 10;
+static constexpr int kRecorderChunkFrames = 4096;
+
+// Records the deck output to disk. start()/requestStop() run on the UI thread;
+// push()/endRecording() only on the audio thread, which does nothing there but
+// copy into the ring. A writer thread polls the ring, encodes and writes.
+// Frames that find the ring full are dropped and counted as overruns.
+class OutputRecorder {
+public:
+  ~OutputRecorder();
+
+  bool start(const std::string &path, float sampleRate, std::string *errorOut = nullptr);
+  void requestStop();
+  bool isRecording() const { return recording_.load(std::memory_order_relaxed); }
+  uint64_t overruns() const { return overruns_.load(std::memory_order_relaxed); }
+  int64_t framesWritten() const { return framesWritten_.load(std::memory_order_relaxed); }
+  std::string path() const;
+  std::string lastError() const;
+
+  // Takes deck output in volts.
+  void push(float left, float right);
+  void endRecording();
+
+private:
+  void writerLoop();
+  void joinWriter();
+
+  AudioFileWriter writer_;
+  StereoFrameRing ring_;
+  std::thread writerThread_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  bool shutdown_ = false;
+  std::string path_;
+  std::string lastError_;
+  std::atomic<bool> startRequested_{false};
+  std::atomic<bool> stopRequested_{false};
+  std::atomic<bool> producerDone_{false};
+  std::atomic<bool> recording_{false};
+  std::atomic<uint64_t> overruns_{0};
+  std::atomic<int64_t> framesWritten_{0};
+  // Audio thread only.
+  bool active_ = false;
+};
+
+// Writes the `frames` frames of `ring` behind `endIndex`, oldest first, to
+// `path` in the format its extension selects. `keepGoing` is polled between
+// blocks with the number of frames written; returning false abandons the
+// export and removes the file.
+bool exportRingWindow(const std::string &path, const TemporalDeckBuffer &ring, int endIndex, int frames,
+                      const std::function<bool(int)> &keepGoing, std::string *errorOut = nullptr);
+
+} // namespace temporaldeck
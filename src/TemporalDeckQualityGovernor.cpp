@@ -0,0 +1,75 @@
+#include "TemporalDeckQualityGovernor.hpp"
+
+#include <algorithm>
+
+namespace temporaldeck {
+
+TemporalDeckQualityGovernor::TemporalDeckQualityGovernor()
+    : tierCap_(kTierCount - 1), aggregateLoad_(0.f), budget_(kDefaultBudget), holdPublishes_(0) {
+  for (int i = 0; i < kMaxDecks; ++i) {
+    used_[i].store(false, std::memory_order_relaxed);
+    load_[i].store(0.f, std::memory_order_relaxed);
+  }
+}
+
+TemporalDeckQualityGovernor &TemporalDeckQualityGovernor::instance() {
+  static TemporalDeckQualityGovernor governor;
+  return governor;
+}
+
+int TemporalDeckQualityGovernor::acquireSlot() {
+  for (int i = 0; i < kMaxDecks; ++i) {
+    bool expected = false;
+    if (used_[i].compare_exchange_strong(expected, true)) {
+      load_[i].store(0.f, std::memory_order_relaxed);
+      return i;
+    }
+  }
+  return -1;
+}
+
+void TemporalDeckQualityGovernor::releaseSlot(int slot) {
+  if (slot < 0 || slot >= kMaxDecks) {
+    return;
+  }
+  load_[slot].store(0.f, std::memory_order_relaxed);
+  used_[slot].store(false, std::memory_order_release);
+}
+
+void TemporalDeckQualityGovernor::setBudget(float loadFraction) {
+  budget_.store(std::max(loadFraction, 0.01f), std::memory_order_relaxed);
+}
+
+void TemporalDeckQualityGovernor::publishLoad(int slot, float loadFraction) {
+  if (slot < 0 || slot >= kMaxDecks) {
+    return;
+  }
+  load_[slot].store(std::max(loadFraction, 0.f), std::memory_order_relaxed);
+
+  float total = 0.f;
+  for (int i = 0; i < kMaxDecks; ++i) {
+    if (used_[i].load(std::memory_order_acquire)) {
+      total += load_[i].load(std::memory_order_relaxed);
+    }
+  }
+  aggregateLoad_.store(total, std::memory_order_relaxed);
+
+  int hold = holdPublishes_.load(std::memory_order_relaxed);
+  if (hold > 0) {
+    holdPublishes_.compare_exchange_strong(hold, hold - 1, std::memory_order_relaxed);
+    return;
+  }
+  float limit = budget();
+  int cap = tierCap();
+  int next = cap;
+  if (total > limit && cap > 0) {
+    next = cap - 1;
+  } else if (total < limit * kRecoverRatio && cap < kTierCount - 1) {
+    next = cap + 1;
+  }
+  if (next != cap && tierCap_.compare_exchange_strong(cap, next, std::memory_order_relaxed)) {
+    holdPublishes_.store(kHoldPublishes, std::memory_order_relaxed);
+  }
+}
+
+} // namespace temporaldeck
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+
+namespace temporaldeck {
+
+// Process-wide ceiling on the interpolation tier "Auto" decks may use. Every
+// deck publishes its measured DSP load as a fraction of one core; when the sum
+// over all decks passes the budget each deck steps down one tier, and the
+// ceiling climbs back one tier at a time once the sum falls well below it.
+//
+// Lock-free so it can be driven from any audio thread. Publishes from several
+// threads may race on a step; the hold counter keeps that to one step per
+// window either way.
+class TemporalDeckQualityGovernor {
+public:
+  static constexpr int kMaxDecks = 64;
+  // Mirrors TemporalDeckEngine::InterpolationTier: Linear, Cubic, Lagrange6, Sinc.
+  static constexpr int kTierCount = 4;
+  static constexpr float kDefaultBudget = 0.25f;
+  // Step back up only below this share of the budget, so one tier of
+  // headroom does not immediately trip the limit again.
+  static constexpr float kRecoverRatio = 0.6f;
+  // Publishes to wait after a step before the next one.
+  static constexpr int kHoldPublishes = 8;
+
+  TemporalDeckQualityGovernor();
+
+  // The shared instance used by every deck in the plugin.
+  static TemporalDeckQualityGovernor &instance();
+
+  // Returns -1 when every slot is taken; such decks run uncapped.
+  int acquireSlot();
+  void releaseSlot(int slot);
+
+  // Records a deck's load and re-evaluates the ceiling.
+  void publishLoad(int slot, float loadFraction);
+
+  int tierCap() const { return tierCap_.load(std::memory_order_relaxed); }
+  float aggregateLoad() const { return aggregateLoad_.load(std::memory_order_relaxed); }
+  float budget() const { return budget_.load(std::memory_order_relaxed); }
+  void setBudget(float loadFraction);
+
+private:
+  std::atomic<bool> used_[kMaxDecks];
+  std::atomic<float> load_[kMaxDecks];
+  std::atomic<int> tierCap_;
+  std::atomic<float> aggregateLoad_;
+  std::atomic<float> budget_;
+  std::atomic<int> holdPublishes_;
+};
+
+} // namespace temporaldeck
@@ -1,5 +1,7 @@
 #include "TemporalDeckSampleLifecycle.hpp"
 
+#include "TemporalDeckBufferSnapshot.hpp"
+#include "TemporalDeckOutputRecorder.hpp"
 #include "codec.hpp"
 #include "plugin.hpp"
 
@@ -13,6 +15,9 @@ using temporaldeck::chooseSampleBufferMode;
 using temporaldeck::decodeSampleFile;
 using temporaldeck::DecodedSampleFile;
 using temporaldeck::PreparedSampleData;
+using temporaldeck::TemporalDeckBuffer;
+using temporaldeck::TemporalDeckEngine;
+using temporaldeck::TemporalDeckSampleStream;
 
 TemporalDeckSampleLifecycle::~TemporalDeckSampleLifecycle() {
   stopWorker();
@@ -27,10 +32,12 @@ void TemporalDeckSampleLifecycle::startWorker() {
 }
 
 void TemporalDeckSampleLifecycle::stopWorker() {
+  liveRingAbort_.store(true, std::memory_order_relaxed);
   {
     std::lock_guard<std::mutex> lock(sampleBuildMutex_);
     sampleBuildStop_ = true;
     sampleBuildHasRequest_ = false;
+    liveRingHasJob_ = false;
   }
   sampleBuildCv_.notify_all();
   if (sampleBuildThread_.joinable()) {
@@ -70,17 +77,165 @@ bool TemporalDeckSampleLifecycle::consumePendingPreparedSample(PreparedSampleDat
   return true;
 }
 
+void TemporalDeckSampleLifecycle::requestLiveRingJob(const LiveRingJob &job) {
+  {
+    std::lock_guard<std::mutex> lock(sampleBuildMutex_);
+    liveRingJob_ = job;
+    liveRingHasJob_ = true;
+    liveRingInterimFrames_.store(0, std::memory_order_relaxed);
+    liveRingJobBusy_.store(true, std::memory_order_relaxed);
+  }
+  sampleBuildCv_.notify_one();
+}
+
+bool TemporalDeckSampleLifecycle::liveRingJobBusy() const {
+  return liveRingJobBusy_.load(std::memory_order_acquire) || pendingLiveRingInstall_.load(std::memory_order_relaxed);
+}
+
+void TemporalDeckSampleLifecycle::setLiveRingInterimFrames(int frames) {
+  liveRingInterimFrames_.store(frames, std::memory_order_release);
+}
+
+bool TemporalDeckSampleLifecycle::consumeLiveRing(TemporalDeckBuffer *ring) {
+  if (!ring || !pendingLiveRingInstall_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(liveRingMutex_);
+  std::swap(*ring, liveRing_);
+  pendingLiveRingInstall_.store(false, std::memory_order_relaxed);
+  return true;
+}
+
+bool TemporalDeckSampleLifecycle::consumeLiveRingJobFailed() {
+  return liveRingJobFailed_.exchange(false, std::memory_order_relaxed);
+}
+
+void TemporalDeckSampleLifecycle::setLiveRingSnapshotPath(const std::string &path) {
+  std::lock_guard<std::mutex> lock(sampleBuildMutex_);
+  liveRingSnapshotPath_ = path;
+}
+
+void TemporalDeckSampleLifecycle::setLiveRingStagingPath(const std::string &path) {
+  std::lock_guard<std::mutex> lock(sampleBuildMutex_);
+  liveRingStagingPath_ = path;
+}
+
+void TemporalDeckSampleLifecycle::setLiveRingExportPath(const std::string &path) {
+  std::lock_guard<std::mutex> lock(sampleBuildMutex_);
+  liveRingExportPath_ = path;
+}
+
+void TemporalDeckSampleLifecycle::setLiveRingSessionPath(const std::string &path) {
+  std::lock_guard<std::mutex> lock(sampleBuildMutex_);
+  liveRingSessionPath_ = path;
+}
+
+void TemporalDeckSampleLifecycle::retireLiveRing(TemporalDeckBuffer *ring) {
+  {
+    std::lock_guard<std::mutex> lock(liveRingMutex_);
+    std::swap(*ring, liveRing_);
+  }
+  {
+    std::lock_guard<std::mutex> lock(sampleBuildMutex_);
+    retiredRingPending_ = true;
+  }
+  sampleBuildCv_.notify_one();
+}
+
+void TemporalDeckSampleLifecycle::runLiveRingJob(const LiveRingJob &job) {
+  std::string snapshotPath;
+  std::string exportPath;
+  {
+    std::lock_guard<std::mutex> lock(sampleBuildMutex_);
+    if (job.type == LiveRingJob::SESSION_SNAPSHOT) {
+      snapshotPath = liveRingSessionPath_;
+    } else if (job.type == LiveRingJob::SNAPSHOT) {
+      snapshotPath = liveRingStagingPath_;
+    } else {
+      snapshotPath = liveRingSnapshotPath_;
+    }
+    exportPath = liveRingExportPath_;
+  }
+  // The audio thread overwrites the oldest history first; stop if it catches
+  // up with the read position or the worker is shutting down.
+  int freeSlots = job.source ? job.source->size - job.frames : 0;
+  auto keepGoing = [&](int consumed) {
+    int interim = liveRingInterimFrames_.load(std::memory_order_acquire);
+    return !liveRingAbort_.load(std::memory_order_relaxed) && interim + 2 < freeSlots + consumed;
+  };
+  bool ok = false;
+  TemporalDeckBuffer ring;
+  try {
+    if (job.type == LiveRingJob::RESAMPLE) {
+      ring.resetForMode(job.targetSampleRate, job.bufferMode, job.compactLongBuffers);
+      ok = temporaldeck::resampleLiveHistory(*job.source, job.endIndex, job.frames, &ring, keepGoing);
+    } else if (job.type == LiveRingJob::SNAPSHOT || job.type == LiveRingJob::SESSION_SNAPSHOT) {
+      std::string error;
+      ok = temporaldeck::writeRingSnapshot(snapshotPath, *job.source, job.endIndex, job.frames, job.bufferMode,
+                                           keepGoing, &error);
+      if (!ok) {
+        WARN("TemporalDeck: live buffer snapshot failed: %s", error.c_str());
+      }
+    } else if (job.type == LiveRingJob::CONVERT) {
+      PreparedSampleData prepared;
+      ok = temporaldeck::prepareLiveWindowSample(*job.source, job.endIndex, job.frames, job.bufferMode,
+                                                 sampleAutoPlayOnLoad(), keepGoing, &prepared);
+      if (ok) {
+        std::lock_guard<std::mutex> lock(preparedSampleMutex_);
+        preparedSample_ = std::move(prepared);
+        pendingPreparedSampleInstall_.store(true, std::memory_order_relaxed);
+      }
+    } else if (job.type == LiveRingJob::EXPORT) {
+      std::string error;
+      ok = temporaldeck::exportRingWindow(exportPath, *job.source, job.endIndex, job.frames, keepGoing, &error);
+      if (!ok) {
+        WARN("TemporalDeck: capture window export failed: %s", error.c_str());
+      }
+    } else if (job.type == LiveRingJob::RESTORE) {
+      std::string error;
+      temporaldeck::RingSnapshotInfo info;
+      TemporalDeckBuffer saved;
+      ok = temporaldeck::readRingSnapshot(snapshotPath, job.compactLongBuffers, &saved, &info, &error) &&
+           info.bufferMode == job.bufferMode;
+      if (ok && info.sampleRate == job.targetSampleRate) {
+        std::swap(ring, saved);
+      } else if (ok) {
+        // Saved at another engine rate: convert like a live rate change.
+        ring.resetForMode(job.targetSampleRate, job.bufferMode, job.compactLongBuffers);
+        ok = temporaldeck::resampleLiveHistory(saved, saved.writeHead, saved.filled, &ring, nullptr);
+      }
+      if (!ok && !error.empty()) {
+        WARN("TemporalDeck: live buffer restore failed: %s", error.c_str());
+      }
+    }
+  } catch (const std::bad_alloc &) {
+    WARN("TemporalDeck: live buffer job allocation failed");
+    ok = false;
+  }
+  if (ok && (job.type == LiveRingJob::RESAMPLE || job.type == LiveRingJob::RESTORE)) {
+    std::lock_guard<std::mutex> lock(liveRingMutex_);
+    liveRing_ = std::move(ring);
+    pendingLiveRingInstall_.store(true, std::memory_order_release);
+  } else if (!ok) {
+    liveRingJobFailed_.store(true, std::memory_order_relaxed);
+  }
+  liveRingJobBusy_.store(false, std::memory_order_release);
+}
+
 bool TemporalDeckSampleLifecycle::consumeAllocationFallbackPending() {
   return allocationFallbackPending_.exchange(false, std::memory_order_relaxed);
 }
 
 void TemporalDeckSampleLifecycle::clearDecodedAndPreparedState() {
+  std::unique_ptr<TemporalDeckSampleStream> stream;
   {
     std::lock_guard<std::mutex> lock(sampleStateMutex_);
     samplePath_.clear();
     sampleDisplayName_.clear();
     decodedSample_ = DecodedSampleFile();
+    stream = std::move(sampleStream_);
   }
+  retireSampleStream(std::move(stream));
   decodedSampleAvailable_.store(false, std::memory_order_relaxed);
   pendingPreparedSampleInstall_.store(false, std::memory_order_relaxed);
   {
@@ -133,16 +288,86 @@ void TemporalDeckSampleLifecycle::setSampleSavedPath(const std::string &path) {
   sampleDisplayName_ = path.empty() ? std::string() : system::getFilename(path);
 }
 
+void TemporalDeckSampleLifecycle::retireSampleStream(std::unique_ptr<TemporalDeckSampleStream> stream) {
+  if (!stream) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(sampleBuildMutex_);
+    retiredStreams_.push_back(std::move(stream));
+  }
+  sampleBuildCv_.notify_one();
+}
+
+// (Re)starts the open stream at `targetSampleRate` and hands its pages to the
+// audio thread like a prepared sample.
+bool TemporalDeckSampleLifecycle::prepareStreamedSample(float targetSampleRate, int bufferMode, bool autoPlayOnLoad,
+                                                        uint64_t requestSerial) {
+  PreparedSampleData prepared;
+  {
+    std::lock_guard<std::mutex> lock(sampleStateMutex_);
+    if (!sampleStream_ || !sampleStream_->start(targetSampleRate, temporaldeck_modes::isMonoBufferMode(bufferMode))) {
+      return false;
+    }
+    prepared.stream = sampleStream_->pages();
+    prepared.frames = sampleStream_->frames();
+  }
+  prepared.bufferMode = bufferMode;
+  prepared.sampleRate = targetSampleRate;
+  prepared.autoPlayOnLoad = autoPlayOnLoad;
+  prepared.monoStorage = temporaldeck_modes::isMonoBufferMode(bufferMode);
+  prepared.valid = prepared.frames > 0;
+  if (prepared.valid && requestSerial == sampleBuildRequestSerial_.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lock(preparedSampleMutex_);
+    preparedSample_ = std::move(prepared);
+    pendingPreparedSampleInstall_.store(true, std::memory_order_relaxed);
+  }
+  return true;
+}
+
 void TemporalDeckSampleLifecycle::workerLoop() {
   while (true) {
     AsyncSampleBuildRequest request;
     uint64_t requestSerial = 0;
+    LiveRingJob liveJob;
+    bool liveJobRequested = false;
+    bool releaseRetiredRing = false;
+    std::vector<std::unique_ptr<TemporalDeckSampleStream>> retiredStreams;
     {
       std::unique_lock<std::mutex> lock(sampleBuildMutex_);
-      sampleBuildCv_.wait(lock, [this]() { return sampleBuildStop_ || sampleBuildHasRequest_; });
+      sampleBuildCv_.wait(lock, [this]() {
+        return sampleBuildStop_ || sampleBuildHasRequest_ || liveRingHasJob_ || retiredRingPending_ ||
+               !retiredStreams_.empty();
+      });
       if (sampleBuildStop_) {
         break;
       }
+      retiredStreams.swap(retiredStreams_);
+      releaseRetiredRing = retiredRingPending_;
+      retiredRingPending_ = false;
+      liveJobRequested = liveRingHasJob_;
+      liveRingHasJob_ = false;
+      liveJob = liveRingJob_;
+    }
+    retiredStreams.clear();
+    if (releaseRetiredRing) {
+      // Freed outside the lock; the old ring can be hundreds of MB.
+      TemporalDeckBuffer retired;
+      {
+        std::lock_guard<std::mutex> lock(liveRingMutex_);
+        if (!pendingLiveRingInstall_.load(std::memory_order_relaxed)) {
+          std::swap(retired, liveRing_);
+        }
+      }
+    }
+    if (liveJobRequested) {
+      runLiveRingJob(liveJob);
+    }
+    {
+      std::lock_guard<std::mutex> lock(sampleBuildMutex_);
+      if (!sampleBuildHasRequest_) {
+        continue;
+      }
       request = sampleBuildRequest_;
       sampleBuildHasRequest_ = false;
       requestSerial = sampleBuildRequestSerial_.load(std::memory_order_relaxed);
@@ -153,6 +378,32 @@ void TemporalDeckSampleLifecycle::workerLoop() {
     bool validDecoded = false;
 
     if (request.type == AsyncSampleBuildRequest::LOAD_PATH) {
+      // Files longer than the 10-minute buffer stream from disk instead of
+      // being decoded and truncated.
+      std::unique_ptr<TemporalDeckSampleStream> stream(new TemporalDeckSampleStream());
+      if (stream->open(request.path) &&
+          stream->sourceSeconds() >
+            temporaldeck_modes::usableBufferSecondsForMode(TemporalDeckEngine::BUFFER_DURATION_10MIN_STEREO)) {
+        int streamMode = stream->sourceChannels() > 1 ? TemporalDeckEngine::BUFFER_DURATION_10MIN_STEREO
+                                                      : TemporalDeckEngine::BUFFER_DURATION_10MIN_MONO;
+        {
+          std::lock_guard<std::mutex> lock(sampleStateMutex_);
+          samplePath_ = request.path;
+          sampleDisplayName_ = system::getFilename(request.path);
+          decodedSample_ = DecodedSampleFile();
+          autoPlayOnLoad = sampleAutoPlayOnLoad_;
+          std::swap(sampleStream_, stream);
+          decodedSampleAvailable_.store(true, std::memory_order_relaxed);
+        }
+        retireSampleStream(std::move(stream));
+        if (!prepareStreamedSample(request.targetSampleRate, streamMode, autoPlayOnLoad, requestSerial)) {
+          WARN("TemporalDeck: sample stream failed to start for '%s'", request.path.c_str());
+        }
+        sampleBuildInProgress_.store(false, std::memory_order_relaxed);
+        continue;
+      }
+      stream.reset();
+
       std::string decodeError;
       bool decodeOk = false;
       try {
@@ -175,14 +426,25 @@ void TemporalDeckSampleLifecycle::workerLoop() {
         sampleDisplayName_ = system::getFilename(request.path);
         decodedSample_ = decoded;
         autoPlayOnLoad = sampleAutoPlayOnLoad_;
+        std::swap(sampleStream_, stream);
         decodedSampleAvailable_.store(decodedSample_.frames > 0 && !decodedSample_.left.empty(), std::memory_order_relaxed);
       }
+      retireSampleStream(std::move(stream));
       validDecoded = decoded.frames > 0 && !decoded.left.empty();
     } else if (request.type == AsyncSampleBuildRequest::REBUILD_FROM_DECODED) {
-      std::lock_guard<std::mutex> lock(sampleStateMutex_);
-      decoded = decodedSample_;
-      autoPlayOnLoad = sampleAutoPlayOnLoad_;
-      validDecoded = decoded.frames > 0 && !decoded.left.empty();
+      bool streamed = false;
+      {
+        std::lock_guard<std::mutex> lock(sampleStateMutex_);
+        decoded = decodedSample_;
+        autoPlayOnLoad = sampleAutoPlayOnLoad_;
+        validDecoded = decoded.frames > 0 && !decoded.left.empty();
+        streamed = sampleStream_ != nullptr;
+      }
+      if (streamed) {
+        prepareStreamedSample(request.targetSampleRate, request.requestedBufferMode, autoPlayOnLoad, requestSerial);
+        sampleBuildInProgress_.store(false, std::memory_order_relaxed);
+        continue;
+      }
     }
 
     if (!validDecoded) {
@@ -1,13 +1,16 @@
 #pragma once
 
 #include "TemporalDeckSamplePrep.hpp"
+#include "TemporalDeckSampleStream.hpp"
 
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace temporaldeck_lifecycle {
 
@@ -24,6 +27,32 @@ struct TemporalDeckSampleLifecycle {
     int requestedBufferMode = temporaldeck::TemporalDeckEngine::BUFFER_DURATION_10S;
   };
 
+  // Worker jobs on the live ring. RESAMPLE, SNAPSHOT, EXPORT, SESSION_SNAPSHOT
+  // and CONVERT read the history behind `endIndex` while the audio thread
+  // keeps writing into `source` from there on, so `frames` must leave the
+  // ring's guard second free. RESAMPLE and RESTORE deliver a new ring through
+  // consumeLiveRing(); CONVERT delivers a sample through
+  // consumePendingPreparedSample().
+  struct LiveRingJob {
+    enum Type {
+      RESAMPLE = 0,
+      SNAPSHOT = 1,
+      RESTORE = 2,
+      EXPORT = 3,
+      // The history a session recording starts from, saved beside the session.
+      SESSION_SNAPSHOT = 4,
+      // Live -> sample: the window under the buffer knob becomes the sample.
+      CONVERT = 5,
+    };
+    int type = RESAMPLE;
+    const temporaldeck::TemporalDeckBuffer *source = nullptr;
+    int endIndex = 0;
+    int frames = 0;
+    float targetSampleRate = 44100.f;
+    int bufferMode = temporaldeck::TemporalDeckEngine::BUFFER_DURATION_10S;
+    bool compactLongBuffers = false;
+  };
+
   TemporalDeckSampleLifecycle() = default;
   ~TemporalDeckSampleLifecycle();
 
@@ -37,6 +66,28 @@ struct TemporalDeckSampleLifecycle {
   bool consumePendingPreparedSample(temporaldeck::PreparedSampleData *outPrepared);
   bool consumeAllocationFallbackPending();
 
+  // One live ring job runs at a time. While busy the source ring must not be
+  // reallocated. The audio thread reports how many frames it has written into
+  // the source since the request; the worker gives up if they reach history
+  // it has not read yet.
+  void requestLiveRingJob(const LiveRingJob &job);
+  bool liveRingJobBusy() const;
+  void setLiveRingInterimFrames(int frames);
+  // Swaps a finished ring into `ring` (O(1), no allocation).
+  bool consumeLiveRing(temporaldeck::TemporalDeckBuffer *ring);
+  bool consumeLiveRingJobFailed();
+  // Snapshot file read by RESTORE jobs. Set from the UI thread.
+  void setLiveRingSnapshotPath(const std::string &path);
+  // File SNAPSHOT jobs write, outside patch storage so a save never archives
+  // one half written. Set from the UI thread.
+  void setLiveRingStagingPath(const std::string &path);
+  // Audio file written by EXPORT jobs; the extension picks WAV or FLAC.
+  void setLiveRingExportPath(const std::string &path);
+  // Snapshot file used by SESSION_SNAPSHOT jobs. Set from the UI thread.
+  void setLiveRingSessionPath(const std::string &path);
+  // Hands storage back to the worker to be freed off the audio thread.
+  void retireLiveRing(temporaldeck::TemporalDeckBuffer *ring);
+
   void clearDecodedAndPreparedState();
   void setPendingSampleStateApply();
   bool consumePendingSampleStateApply();
@@ -50,12 +101,17 @@ struct TemporalDeckSampleLifecycle {
 
 private:
   void workerLoop();
+  void runLiveRingJob(const LiveRingJob &job);
+  bool prepareStreamedSample(float targetSampleRate, int bufferMode, bool autoPlayOnLoad, uint64_t requestSerial);
+  void retireSampleStream(std::unique_ptr<temporaldeck::TemporalDeckSampleStream> stream);
 
   mutable std::mutex sampleStateMutex_;
   bool sampleAutoPlayOnLoad_ = true;
   std::string samplePath_;
   std::string sampleDisplayName_;
   temporaldeck::DecodedSampleFile decodedSample_;
+  // Set instead of decodedSample_ for files longer than the 10-minute buffer.
+  std::unique_ptr<temporaldeck::TemporalDeckSampleStream> sampleStream_;
   std::atomic<bool> decodedSampleAvailable_{false};
 
   mutable std::mutex preparedSampleMutex_;
@@ -73,6 +129,24 @@ private:
   std::atomic<bool> allocationFallbackPending_{false};
 
   std::atomic<bool> pendingSampleStateApply_{false};
+
+  // Guarded by sampleBuildMutex_.
+  bool liveRingHasJob_ = false;
+  LiveRingJob liveRingJob_;
+  bool retiredRingPending_ = false;
+  // Streams are stopped on the worker; stopping joins their prefetch thread.
+  std::vector<std::unique_ptr<temporaldeck::TemporalDeckSampleStream>> retiredStreams_;
+  std::string liveRingSnapshotPath_;
+  std::string liveRingStagingPath_;
+  std::string liveRingExportPath_;
+  std::string liveRingSessionPath_;
+  std::atomic<bool> liveRingJobBusy_{false};
+  std::atomic<bool> liveRingJobFailed_{false};
+  std::atomic<bool> liveRingAbort_{false};
+  std::atomic<int> liveRingInterimFrames_{0};
+  mutable std::mutex liveRingMutex_;
+  temporaldeck::TemporalDeckBuffer liveRing_;
+  std::atomic<bool> pendingLiveRingInstall_{false};
 };
 
 } // namespace temporaldeck_lifecycle
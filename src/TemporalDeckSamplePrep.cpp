@@ -7,8 +7,6 @@ namespace temporaldeck {
 
 namespace {
 
-static constexpr float kSampleFileVoltageScale = 5.f;
-
 int maxFramesForModeAtSampleRate(int mode, float sampleRate) {
   return std::max(1, int(std::floor(temporaldeck_modes::usableBufferSecondsForMode(mode) * std::max(sampleRate, 1.f))));
 }
@@ -110,8 +108,94 @@ bool buildPreparedSample(const DecodedSampleFile &decodedSample, float targetSam
 
   prepared.frames = std::min(outFrames, int(prepared.left.size()));
   prepared.valid = prepared.frames > 0;
+  if (prepared.valid && !temporaldeck_modes::isLongBufferMode(prepared.bufferMode)) {
+    buildMipLevels(prepared.left, prepared.right, prepared.frames, &prepared.mips);
+  }
+  if (prepared.valid) {
+    buildOnsetIndex(prepared.left, prepared.right, prepared.frames, prepared.sampleRate, &prepared.onsets);
+  }
   *outPrepared = std::move(prepared);
   return outPrepared->valid;
 }
 
+bool resampleLiveHistory(const TemporalDeckBuffer &source, int endIndex, int frames, TemporalDeckBuffer *out,
+                         const std::function<bool(int)> &keepGoing) {
+  if (!out || out->size <= 0 || source.size <= 0) {
+    return false;
+  }
+  frames = clamp(frames, 0, source.size);
+  int outFrames = resampledFrameCount(frames, source.sampleRate, out->sampleRate);
+  if (outFrames <= 0) {
+    return true;
+  }
+  // Frames that would wrap out of the destination are skipped rather than
+  // written and overwritten.
+  int skipped = std::max(0, outFrames - out->size);
+  double ratio = double(source.sampleRate) / double(out->sampleRate);
+  int oldest = endIndex - frames;
+  constexpr int kBlockFrames = 4096;
+  for (int i = skipped; i < outFrames; ++i) {
+    // Aligned on the newest frame so NOW lands on the same audio.
+    double srcPos = std::max(0.0, double(frames - 1) - double(outFrames - 1 - i) * ratio);
+    int i0 = std::min(int(srcPos), frames - 1);
+    if ((i - skipped) % kBlockFrames == 0 && keepGoing && !keepGoing(i0)) {
+      return false;
+    }
+    int i1 = std::min(i0 + 1, frames - 1);
+    float t = float(srcPos - double(i0));
+    int idx0 = source.wrapIndex(oldest + i0);
+    int idx1 = source.wrapIndex(oldest + i1);
+    out->write(crossfade(source.leftSample(idx0), source.leftSample(idx1), t),
+               crossfade(source.rightSample(idx0), source.rightSample(idx1), t));
+  }
+  return !keepGoing || keepGoing(frames);
+}
+
+bool prepareLiveWindowSample(const TemporalDeckBuffer &source, int endIndex, int frames, int bufferMode,
+                             bool autoPlayOnLoad, const std::function<bool(int)> &keepGoing,
+                             PreparedSampleData *outPrepared) {
+  if (!outPrepared) {
+    return false;
+  }
+  PreparedSampleData prepared;
+  frames = std::min(frames, source.filled);
+  if (frames <= 0 || source.size <= 0) {
+    *outPrepared = std::move(prepared);
+    return false;
+  }
+  prepared.bufferMode = bufferMode;
+  prepared.sampleRate = source.sampleRate;
+  prepared.autoPlayOnLoad = autoPlayOnLoad;
+  prepared.monoStorage = source.monoStorage;
+  prepared.left.assign(frames, 0.f);
+  if (!source.monoStorage) {
+    prepared.right.assign(frames, 0.f);
+  }
+  int oldest = endIndex - frames;
+  constexpr int kBlockFrames = 4096;
+  for (int i = 0; i < frames; ++i) {
+    if (i % kBlockFrames == 0 && keepGoing && !keepGoing(i)) {
+      *outPrepared = PreparedSampleData();
+      return false;
+    }
+    int idx = source.wrapIndex(oldest + i);
+    prepared.left[i] = source.leftSample(idx);
+    if (!source.monoStorage) {
+      prepared.right[i] = source.rightSample(idx);
+    }
+  }
+  if (keepGoing && !keepGoing(frames)) {
+    *outPrepared = PreparedSampleData();
+    return false;
+  }
+  prepared.frames = frames;
+  if (source.mipMapped) {
+    buildMipLevels(prepared.left, prepared.right, prepared.frames, &prepared.mips);
+  }
+  buildOnsetIndex(prepared.left, prepared.right, prepared.frames, prepared.sampleRate, &prepared.onsets);
+  prepared.valid = true;
+  *outPrepared = std::move(prepared);
+  return true;
+}
+
 } // namespace temporaldeck
@@ -3,13 +3,24 @@
 #include "TemporalDeckEngine.hpp"
 #include "codec.hpp"
 
+#include <functional>
+#include <memory>
 #include <vector>
 
 namespace temporaldeck {
 
+// Decoded files are normalized to +/-1; the deck buffer runs at Rack voltages.
+static constexpr float kSampleFileVoltageScale = 5.f;
+
 struct PreparedSampleData {
   std::vector<float> left;
   std::vector<float> right;
+  // Read levels for fast scratching; empty for 10-minute modes.
+  TemporalDeckMipLevels mips;
+  // Onsets, block RMS and zero crossings for snapped seeks.
+  TemporalDeckOnsetIndex onsets;
+  // Set instead of left/right for files streamed from disk.
+  std::shared_ptr<TemporalDeckPageCache> stream;
   int frames = 0;
   int bufferMode = TemporalDeckEngine::BUFFER_DURATION_10S;
   float sampleRate = 44100.f;
@@ -24,4 +35,21 @@ int chooseSampleBufferMode(const DecodedSampleFile &sample);
 bool buildPreparedSample(const DecodedSampleFile &decodedSample, float targetSampleRate, int bufferMode,
                          bool autoPlayOnLoad, PreparedSampleData *outPrepared);
 
+// Rebuilds the newest `frames` frames of a live ring, ending just before
+// `endIndex`, into `out` at out->sampleRate. `out` must already be reset for
+// its mode; writing through TemporalDeckBuffer::write() keeps its read levels
+// current. `keepGoing` is polled between blocks with the number of source
+// frames consumed (oldest first) and may stop the copy, in which case this
+// returns false.
+bool resampleLiveHistory(const TemporalDeckBuffer &source, int endIndex, int frames, TemporalDeckBuffer *out,
+                         const std::function<bool(int)> &keepGoing);
+
+// Live -> sample conversion: copies the newest `frames` frames of a live ring,
+// ending just before `endIndex`, into a sample at the ring's rate and builds
+// its read levels and onset index. `keepGoing` is polled like
+// resampleLiveHistory()'s; a stopped copy returns false.
+bool prepareLiveWindowSample(const TemporalDeckBuffer &source, int endIndex, int frames, int bufferMode,
+                             bool autoPlayOnLoad, const std::function<bool(int)> &keepGoing,
+                             PreparedSampleData *outPrepared);
+
 } // namespace temporaldeck
@@ -0,0 +1,203 @@
+#include "TemporalDeckSampleStream.hpp"
+#include "TemporalDeckSamplePrep.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+
+namespace temporaldeck {
+
+TemporalDeckSampleStream::~TemporalDeckSampleStream() {
+  stop();
+}
+
+bool TemporalDeckSampleStream::open(const std::string &path, std::string *errorOut) {
+  stop();
+  pages_.reset();
+  lastSourceFrame_ = -1;
+  return reader_.open(path, errorOut);
+}
+
+double TemporalDeckSampleStream::sourceSeconds() const {
+  if (!reader_.isOpen() || reader_.sampleRate() <= 0.f) {
+    return 0.0;
+  }
+  return double(reader_.frames()) / double(reader_.sampleRate());
+}
+
+int TemporalDeckSampleStream::sourceChannels() const {
+  return reader_.channels();
+}
+
+bool TemporalDeckSampleStream::start(float targetSampleRate, bool monoPages) {
+  stop();
+  if (!reader_.isOpen() || targetSampleRate <= 1.f) {
+    return false;
+  }
+  targetSampleRate_ = targetSampleRate;
+  sourceStep_ = double(reader_.sampleRate()) / double(targetSampleRate);
+  double outFrames = std::round(sourceSeconds() * double(targetSampleRate));
+  int frames = int(std::min(outFrames, double(INT_MAX - kStreamPageFrames)));
+  if (frames <= 0) {
+    return false;
+  }
+  pages_ = std::make_shared<TemporalDeckPageCache>();
+  pages_->allocate(frames, monoPages);
+  lastSourceFrame_ = -1;
+  // Resident before install so playback starts without a miss.
+  for (int page = 0; page < std::min(4, pages_->pageCount()); ++page) {
+    loadPage(page);
+  }
+  stopping_ = false;
+  thread_ = std::thread(&TemporalDeckSampleStream::prefetchLoop, this);
+  return true;
+}
+
+void TemporalDeckSampleStream::stop() {
+  {
+    std::lock_guard<std::mutex> lock(wakeMutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+size_t TemporalDeckSampleStream::pageBytes() const {
+  if (!pages_) {
+    return 0;
+  }
+  size_t bytes = 0;
+  for (int i = 0; i < kStreamSlotCount; ++i) {
+    bytes += (pages_->slots[i].left.capacity() + pages_->slots[i].right.capacity()) * sizeof(float);
+  }
+  return bytes;
+}
+
+void TemporalDeckSampleStream::prefetchLoop() {
+  std::unique_lock<std::mutex> lock(wakeMutex_);
+  while (!stopping_) {
+    lock.unlock();
+    bool loaded = loadNextWantedPage();
+    lock.lock();
+    if (!loaded && !stopping_) {
+      wake_.wait_for(lock, std::chrono::milliseconds(kStreamPollMs));
+    }
+  }
+}
+
+bool TemporalDeckSampleStream::loadNextWantedPage() {
+  const TemporalDeckPageCache &cache = *pages_;
+  int pageCount = cache.pageCount();
+  if (pageCount <= 0) {
+    return false;
+  }
+  double head = cache.headFrame.load(std::memory_order_relaxed);
+  int direction = cache.headDelta.load(std::memory_order_relaxed) < 0.f ? -1 : 1;
+  int headPage = clamp(int(std::max(0.0, head)) >> kStreamPageShift, 0, pageCount - 1);
+  auto wanted = [&](int page) { return page >= 0 && page < pageCount && !cache.isResident(page); };
+  if (wanted(headPage)) {
+    return loadPage(headPage);
+  }
+
+  // Nearest pages first, two ahead for every one behind. The head is re-read
+  // after every page, so a seek or scratch redirects the next load.
+  int ahead = 0;
+  int behind = 0;
+  while (ahead < kStreamPagesAhead || behind < kStreamPagesBehind) {
+    for (int k = 0; k < 2 && ahead < kStreamPagesAhead; ++k) {
+      int page = headPage + direction * ++ahead;
+      if (wanted(page)) {
+        return loadPage(page);
+      }
+    }
+    if (behind < kStreamPagesBehind) {
+      int page = headPage - direction * ++behind;
+      if (wanted(page)) {
+        return loadPage(page);
+      }
+    }
+  }
+
+  // Keep the start of the file for loop wraps and restarts, unless its slot
+  // belongs to the window.
+  int windowLow = headPage - (direction > 0 ? kStreamPagesBehind : kStreamPagesAhead);
+  int windowHigh = headPage + (direction > 0 ? kStreamPagesAhead : kStreamPagesBehind);
+  if (windowLow > 0 && wanted(0)) {
+    int held = cache.slotFor(0).page.load(std::memory_order_relaxed);
+    if (held < windowLow || held > windowHigh) {
+      return loadPage(0);
+    }
+  }
+  return false;
+}
+
+int TemporalDeckSampleStream::readSource(int64_t startFrame, int count) {
+  if (int(sourceLeft_.size()) < count) {
+    sourceLeft_.resize(count);
+    sourceRight_.resize(count);
+  }
+  int got = 0;
+  if (startFrame == lastSourceFrame_) {
+    sourceLeft_[0] = lastSourceLeft_;
+    sourceRight_[0] = lastSourceRight_;
+    got = 1;
+  }
+  if (got < count) {
+    got += reader_.read(startFrame + got, count - got, sourceLeft_.data() + got, sourceRight_.data() + got);
+  }
+  // A short read (truncated file) plays as silence.
+  std::fill(sourceLeft_.begin() + got, sourceLeft_.begin() + count, 0.f);
+  std::fill(sourceRight_.begin() + got, sourceRight_.begin() + count, 0.f);
+  if (got > 0) {
+    lastSourceFrame_ = startFrame + got - 1;
+    lastSourceLeft_ = sourceLeft_[got - 1];
+    lastSourceRight_ = sourceRight_[got - 1];
+  }
+  return got;
+}
+
+bool TemporalDeckSampleStream::loadPage(int page) {
+  TemporalDeckPageCache &cache = *pages_;
+  int start = page << kStreamPageShift;
+  int count = std::min(kStreamPageFrames, cache.frames - start);
+  int64_t sourceFrames = reader_.frames();
+  if (count <= 0 || sourceFrames <= 0) {
+    return false;
+  }
+  int64_t first = std::min<int64_t>(int64_t(std::floor(double(start) * sourceStep_)), sourceFrames - 1);
+  int64_t last = std::min<int64_t>(int64_t(std::floor(double(start + count - 1) * sourceStep_)) + 1, sourceFrames - 1);
+  int sourceCount = int(last - first + 1);
+  readSource(first, sourceCount);
+
+  TemporalDeckPageCache::Slot &slot = cache.slotFor(page);
+  slot.page.store(-1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  // Same linear resample as buildPreparedSample(), so a streamed file plays
+  // exactly like the decoded one would.
+  for (int i = 0; i < count; ++i) {
+    double sourcePos = double(start + i) * sourceStep_;
+    int64_t i0 = std::min(std::max(int64_t(std::floor(sourcePos)), first), last);
+    int j0 = int(i0 - first);
+    int j1 = std::min(j0 + 1, sourceCount - 1);
+    float t = float(sourcePos - double(i0));
+    float l = crossfade(sourceLeft_[j0], sourceLeft_[j1], t) * kSampleFileVoltageScale;
+    float r = crossfade(sourceRight_[j0], sourceRight_[j1], t) * kSampleFileVoltageScale;
+    if (cache.mono) {
+      slot.left[i] = sourceChannels() > 1 ? 0.5f * (l + r) : l;
+    } else {
+      slot.left[i] = l;
+      slot.right[i] = r;
+    }
+  }
+  std::fill(slot.left.begin() + count, slot.left.end(), 0.f);
+  if (!cache.mono) {
+    std::fill(slot.right.begin() + count, slot.right.end(), 0.f);
+  }
+  slot.page.store(page, std::memory_order_release);
+  return true;
+}
+
+} // namespace temporaldeck
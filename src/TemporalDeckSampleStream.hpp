@@ -0,0 +1,69 @@
+#pragma once
+
+#include "TemporalDeckEngine.hpp"
+#include "codec.hpp"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace temporaldeck {
+
+// Pages kept resident around the published head. Ahead follows the direction
+// of travel; together with the head page they stay under kStreamSlotCount, so
+// the window never evicts itself from the direct-mapped cache.
+static constexpr int kStreamPagesAhead = 40;
+static constexpr int kStreamPagesBehind = 16;
+static constexpr int kStreamPollMs = 5;
+
+// One sample streamed from disk: the file reader, the page cache shared with
+// the engine, and the prefetch thread that keeps the cache filled. Memory is
+// the fixed page set plus the reader's seek index, whatever the file length.
+class TemporalDeckSampleStream {
+public:
+  ~TemporalDeckSampleStream();
+
+  // Opens `path` for random access; nothing is decoded yet.
+  bool open(const std::string &path, std::string *errorOut = nullptr);
+  double sourceSeconds() const;
+  int sourceChannels() const;
+
+  // Allocates the pages at `targetSampleRate`, loads the first ones on the
+  // calling thread and starts prefetching. `monoPages` mixes stereo files down
+  // like the 10-minute mono buffer mode.
+  bool start(float targetSampleRate, bool monoPages);
+  void stop();
+
+  const std::shared_ptr<TemporalDeckPageCache> &pages() const { return pages_; }
+  int frames() const { return pages_ ? pages_->frames : 0; }
+  float sampleRate() const { return targetSampleRate_; }
+  size_t pageBytes() const;
+
+private:
+  void prefetchLoop();
+  bool loadNextWantedPage();
+  bool loadPage(int page);
+  int readSource(int64_t startFrame, int count);
+
+  SampleStreamReader reader_;
+  std::shared_ptr<TemporalDeckPageCache> pages_;
+  float targetSampleRate_ = 0.f;
+  double sourceStep_ = 1.0;
+  std::vector<float> sourceLeft_;
+  std::vector<float> sourceRight_;
+  // Last source frame decoded, kept so a page overlapping its predecessor by
+  // one frame still reads the file sequentially.
+  int64_t lastSourceFrame_ = -1;
+  float lastSourceLeft_ = 0.f;
+  float lastSourceRight_ = 0.f;
+
+  std::thread thread_;
+  std::mutex wakeMutex_;
+  std::condition_variable wake_;
+  bool stopping_ = false;
+};
+
+} // namespace temporaldeck
@@ -0,0 +1,831 @@
+#include "TemporalDeckSessionRecord.hpp"
+
+#include "TemporalDeckBufferSnapshot.hpp"
+#include "TemporalDeckTransportControl.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <utility>
+
+namespace temporaldeck_session {
+
+using temporaldeck::TemporalDeckEngine;
+using temporaldeck::TemporalDeckBuffer;
+
+namespace {
+
+static constexpr char kSessionMagic[8] = {'T', 'D', 'S', 'E', 'S', 'S', 'N', '\0'};
+// Version 2 adds the start ring words; version 1 files never have them.
+static constexpr uint32_t kSessionVersion = 2;
+// Storage flags share the header's buffer-mode word above the mode index.
+static constexpr uint32_t kHeaderBufferModeMask = 0xFFu;
+static constexpr uint32_t kHeaderCompactLongBuffers = 0x100u;
+// Followed by the start ring's write head and fill count.
+static constexpr uint32_t kHeaderStartRing = 0x200u;
+// Largest encoded block: every frame changes every control word and both
+// audio deltas take 5 bytes, plus the three length varints.
+static constexpr size_t kRecorderMaxBlockBytes =
+  15 + size_t(kSessionBlockFrames) * (5 + 5 * kSessionControlWordCount + 5) + size_t(kSessionBlockFrames) * 10;
+// Several seconds of typical output at 48 kHz before the writer must catch up.
+static constexpr size_t kRecorderRingBytes = 4 * 1024 * 1024;
+static constexpr size_t kRecorderWriteChunkBytes = 64 * 1024;
+static constexpr int kRecorderWriterPollMs = 10;
+
+enum ControlWord {
+  WORD_DT,
+  WORD_BUFFER_KNOB,
+  WORD_RATE_KNOB,
+  WORD_MIX_KNOB,
+  WORD_FEEDBACK_KNOB,
+  WORD_FLAGS,
+  WORD_POSITION_CV,
+  WORD_RATE_CV,
+  WORD_GESTURE_REVISION,
+  WORD_LAG_TARGET,
+  WORD_GESTURE_VELOCITY,
+  WORD_WHEEL_DELTA,
+  WORD_MODES,
+  WORD_SAMPLE_RATE,
+  WORD_SAMPLE_SEEK_REVISION,
+  WORD_SAMPLE_SEEK_NORM,
+  WORD_LIVE_SEEK_REVISION,
+  WORD_LIVE_SEEK_NORM,
+};
+static_assert(WORD_LIVE_SEEK_NORM + 1 == kSessionControlWordCount, "control word table out of sync");
+
+static constexpr uint32_t FLAG_FREEZE_BUTTON = 1u << 0;
+static constexpr uint32_t FLAG_REVERSE_BUTTON = 1u << 1;
+static constexpr uint32_t FLAG_SLIP_BUTTON = 1u << 2;
+static constexpr uint32_t FLAG_QUICK_SLIP = 1u << 3;
+static constexpr uint32_t FLAG_FREEZE_GATE = 1u << 4;
+static constexpr uint32_t FLAG_SCRATCH_GATE = 1u << 5;
+static constexpr uint32_t FLAG_SCRATCH_GATE_CONNECTED = 1u << 6;
+static constexpr uint32_t FLAG_POSITION_CONNECTED = 1u << 7;
+static constexpr uint32_t FLAG_RATE_CV_CONNECTED = 1u << 8;
+static constexpr uint32_t FLAG_PLATTER_TOUCHED = 1u << 9;
+static constexpr uint32_t FLAG_WHEEL_SCRATCH_HELD = 1u << 10;
+static constexpr uint32_t FLAG_PLATTER_MOTION_ACTIVE = 1u << 11;
+static constexpr uint32_t FLAG_SAMPLE_MODE_ENABLED = 1u << 12;
+static constexpr uint32_t FLAG_SAMPLE_LOOP_ENABLED = 1u << 13;
+static constexpr uint32_t FLAG_SAMPLE_SEEK_SNAP = 1u << 14;
+
+uint32_t floatBits(float v) {
+  uint32_t bits;
+  std::memcpy(&bits, &v, sizeof(bits));
+  return bits;
+}
+
+float bitsFloat(uint32_t bits) {
+  float v;
+  std::memcpy(&v, &bits, sizeof(v));
+  return v;
+}
+
+void packControl(const SessionFrame &frame, uint32_t *words) {
+  const TemporalDeckEngine::FrameInput &in = frame.input;
+  uint32_t flags = 0;
+  flags |= in.freezeButton ? FLAG_FREEZE_BUTTON : 0u;
+  flags |= in.reverseButton ? FLAG_REVERSE_BUTTON : 0u;
+  flags |= in.slipButton ? FLAG_SLIP_BUTTON : 0u;
+  flags |= in.quickSlipTrigger ? FLAG_QUICK_SLIP : 0u;
+  flags |= in.freezeGate ? FLAG_FREEZE_GATE : 0u;
+  flags |= in.scratchGate ? FLAG_SCRATCH_GATE : 0u;
+  flags |= in.scratchGateConnected ? FLAG_SCRATCH_GATE_CONNECTED : 0u;
+  flags |= in.positionConnected ? FLAG_POSITION_CONNECTED : 0u;
+  flags |= in.rateCvConnected ? FLAG_RATE_CV_CONNECTED : 0u;
+  flags |= in.platterTouched ? FLAG_PLATTER_TOUCHED : 0u;
+  flags |= in.wheelScratchHeld ? FLAG_WHEEL_SCRATCH_HELD : 0u;
+  flags |= in.platterMotionActive ? FLAG_PLATTER_MOTION_ACTIVE : 0u;
+  flags |= frame.sampleModeEnabled ? FLAG_SAMPLE_MODE_ENABLED : 0u;
+  flags |= frame.sampleLoopEnabled ? FLAG_SAMPLE_LOOP_ENABLED : 0u;
+  flags |= frame.sampleSeekSnap ? FLAG_SAMPLE_SEEK_SNAP : 0u;
+
+  words[WORD_DT] = floatBits(in.dt);
+  words[WORD_BUFFER_KNOB] = floatBits(in.bufferKnob);
+  words[WORD_RATE_KNOB] = floatBits(in.rateKnob);
+  words[WORD_MIX_KNOB] = floatBits(in.mixKnob);
+  words[WORD_FEEDBACK_KNOB] = floatBits(in.feedbackKnob);
+  words[WORD_FLAGS] = flags;
+  words[WORD_POSITION_CV] = floatBits(in.positionCv);
+  words[WORD_RATE_CV] = floatBits(in.rateCv);
+  words[WORD_GESTURE_REVISION] = in.platterGestureRevision;
+  words[WORD_LAG_TARGET] = floatBits(in.platterLagTarget);
+  words[WORD_GESTURE_VELOCITY] = floatBits(in.platterGestureVelocity);
+  words[WORD_WHEEL_DELTA] = floatBits(in.wheelDelta);
+  words[WORD_MODES] = (uint32_t(frame.scratchInterpolationMode) & 0xFu) | ((uint32_t(frame.slipReturnMode) & 0xFu) << 4) |
+                      ((uint32_t(frame.externalGatePosMode) & 0xFu) << 8) |
+                      ((uint32_t(frame.cartridgeCharacter) & 0xFu) << 12) |
+                      ((uint32_t(frame.cartridgeOversamplingMode) & 0xFu) << 16) |
+                      ((uint32_t(frame.autoInterpolationCap) & 0xFu) << 20);
+  words[WORD_SAMPLE_RATE] = floatBits(frame.sampleRate);
+  words[WORD_SAMPLE_SEEK_REVISION] = frame.sampleSeekRevision;
+  words[WORD_SAMPLE_SEEK_NORM] = floatBits(frame.sampleSeekNormalized);
+  words[WORD_LIVE_SEEK_REVISION] = frame.liveSeekRevision;
+  words[WORD_LIVE_SEEK_NORM] = floatBits(frame.liveSeekArcNormalized);
+}
+
+void unpackControl(const uint32_t *words, SessionFrame *frame) {
+  TemporalDeckEngine::FrameInput &in = frame->input;
+  uint32_t flags = words[WORD_FLAGS];
+  in.dt = bitsFloat(words[WORD_DT]);
+  in.bufferKnob = bitsFloat(words[WORD_BUFFER_KNOB]);
+  in.rateKnob = bitsFloat(words[WORD_RATE_KNOB]);
+  in.mixKnob = bitsFloat(words[WORD_MIX_KNOB]);
+  in.feedbackKnob = bitsFloat(words[WORD_FEEDBACK_KNOB]);
+  in.freezeButton = (flags & FLAG_FREEZE_BUTTON) != 0;
+  in.reverseButton = (flags & FLAG_REVERSE_BUTTON) != 0;
+  in.slipButton = (flags & FLAG_SLIP_BUTTON) != 0;
+  in.quickSlipTrigger = (flags & FLAG_QUICK_SLIP) != 0;
+  in.freezeGate = (flags & FLAG_FREEZE_GATE) != 0;
+  in.scratchGate = (flags & FLAG_SCRATCH_GATE) != 0;
+  in.scratchGateConnected = (flags & FLAG_SCRATCH_GATE_CONNECTED) != 0;
+  in.positionConnected = (flags & FLAG_POSITION_CONNECTED) != 0;
+  in.rateCvConnected = (flags & FLAG_RATE_CV_CONNECTED) != 0;
+  in.platterTouched = (flags & FLAG_PLATTER_TOUCHED) != 0;
+  in.wheelScratchHeld = (flags & FLAG_WHEEL_SCRATCH_HELD) != 0;
+  in.platterMotionActive = (flags & FLAG_PLATTER_MOTION_ACTIVE) != 0;
+  in.positionCv = bitsFloat(words[WORD_POSITION_CV]);
+  in.rateCv = bitsFloat(words[WORD_RATE_CV]);
+  in.platterGestureRevision = words[WORD_GESTURE_REVISION];
+  in.platterLagTarget = bitsFloat(words[WORD_LAG_TARGET]);
+  in.platterGestureVelocity = bitsFloat(words[WORD_GESTURE_VELOCITY]);
+  in.wheelDelta = bitsFloat(words[WORD_WHEEL_DELTA]);
+  frame->sampleModeEnabled = (flags & FLAG_SAMPLE_MODE_ENABLED) != 0;
+  frame->sampleLoopEnabled = (flags & FLAG_SAMPLE_LOOP_ENABLED) != 0;
+  frame->sampleSeekSnap = (flags & FLAG_SAMPLE_SEEK_SNAP) != 0;
+  uint32_t modes = words[WORD_MODES];
+  frame->scratchInterpolationMode = int(modes & 0xFu);
+  frame->slipReturnMode = int((modes >> 4) & 0xFu);
+  frame->externalGatePosMode = int((modes >> 8) & 0xFu);
+  frame->cartridgeCharacter = int((modes >> 12) & 0xFu);
+  frame->cartridgeOversamplingMode = int((modes >> 16) & 0xFu);
+  frame->autoInterpolationCap = int((modes >> 20) & 0xFu);
+  frame->sampleRate = bitsFloat(words[WORD_SAMPLE_RATE]);
+  frame->sampleSeekRevision = words[WORD_SAMPLE_SEEK_REVISION];
+  frame->sampleSeekNormalized = bitsFloat(words[WORD_SAMPLE_SEEK_NORM]);
+  frame->liveSeekRevision = words[WORD_LIVE_SEEK_REVISION];
+  frame->liveSeekArcNormalized = bitsFloat(words[WORD_LIVE_SEEK_NORM]);
+}
+
+void appendVarint(std::vector<uint8_t> *out, uint32_t v) {
+  while (v >= 0x80u) {
+    out->push_back(uint8_t(v | 0x80u));
+    v >>= 7;
+  }
+  out->push_back(uint8_t(v));
+}
+
+bool readVarint(const std::vector<uint8_t> &bytes, size_t *pos, size_t end, uint32_t *v) {
+  uint32_t result = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    if (*pos >= end) {
+      return false;
+    }
+    uint8_t b = bytes[(*pos)++];
+    result |= uint32_t(b & 0x7Fu) << shift;
+    if ((b & 0x80u) == 0) {
+      *v = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+void appendLe32(std::vector<uint8_t> *out, uint32_t v) {
+  out->push_back(uint8_t(v & 0xFFu));
+  out->push_back(uint8_t((v >> 8) & 0xFFu));
+  out->push_back(uint8_t((v >> 16) & 0xFFu));
+  out->push_back(uint8_t((v >> 24) & 0xFFu));
+}
+
+uint32_t readLe32(const uint8_t *p) {
+  return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+uint16_t readLe16(const uint8_t *p) {
+  return uint16_t(uint16_t(p[0]) | (uint16_t(p[1]) << 8));
+}
+
+void setError(std::string *errorOut, const char *message) {
+  if (errorOut) {
+    *errorOut = message;
+  }
+}
+
+} // namespace
+
+// SessionEncoder ------------------------------------------------------------
+
+SessionEncoder::SessionEncoder() {
+  // Worst case per frame: every control word changes (mask + words + run) and
+  // both audio deltas use 5 bytes.
+  controlBytes_.reserve(size_t(kSessionBlockFrames) * (5 + 5 * kSessionControlWordCount + 5));
+  audioBytes_.reserve(size_t(kSessionBlockFrames) * 10);
+  reset();
+}
+
+void SessionEncoder::reset() {
+  std::fill(prevControl_, prevControl_ + kSessionControlWordCount, 0u);
+  std::fill(runDelta_, runDelta_ + kSessionControlWordCount, 0u);
+  prevAudioL_ = 0;
+  prevAudioR_ = 0;
+  haveControl_ = false;
+  runLength_ = 0;
+  runMask_ = 0;
+  blockFrames_ = 0;
+  controlBytes_.clear();
+  audioBytes_.clear();
+}
+
+void SessionEncoder::appendHeader(const SessionHeader &header, std::vector<uint8_t> *out) {
+  out->insert(out->end(), kSessionMagic, kSessionMagic + sizeof(kSessionMagic));
+  appendLe32(out, kSessionVersion);
+  appendLe32(out, floatBits(header.sampleRate));
+  appendLe32(out, uint32_t(header.bufferDurationMode) | (header.compactLongBuffers ? kHeaderCompactLongBuffers : 0u) |
+                    (header.hasStartRing ? kHeaderStartRing : 0u));
+  if (header.hasStartRing) {
+    appendLe32(out, uint32_t(header.startRingWriteHead));
+    appendLe32(out, uint32_t(header.startRingFilled));
+  }
+}
+
+void SessionEncoder::closeRun() {
+  if (runLength_ == 0) {
+    return;
+  }
+  appendVarint(&controlBytes_, runMask_);
+  for (int i = 0; i < kSessionControlWordCount; ++i) {
+    if (runMask_ & (1u << i)) {
+      appendVarint(&controlBytes_, runDelta_[i]);
+    }
+  }
+  appendVarint(&controlBytes_, runLength_);
+  runLength_ = 0;
+  runMask_ = 0;
+}
+
+bool SessionEncoder::push(const SessionFrame &frame, std::vector<uint8_t> *out) {
+  uint32_t words[kSessionControlWordCount];
+  packControl(frame, words);
+
+  // Runs restart at block boundaries so every block decodes on its own once
+  // the previous control state is known.
+  bool sameAsRun = haveControl_ && runLength_ > 0;
+  for (int i = 0; sameAsRun && i < kSessionControlWordCount; ++i) {
+    sameAsRun = words[i] == prevControl_[i];
+  }
+  if (sameAsRun) {
+    runLength_++;
+  } else {
+    closeRun();
+    runMask_ = 0;
+    for (int i = 0; i < kSessionControlWordCount; ++i) {
+      uint32_t delta = words[i] ^ prevControl_[i];
+      if (delta != 0) {
+        runMask_ |= 1u << i;
+        runDelta_[i] = delta;
+      }
+      prevControl_[i] = words[i];
+    }
+    runLength_ = 1;
+    haveControl_ = true;
+  }
+
+  uint32_t l = floatBits(frame.input.inL);
+  uint32_t r = floatBits(frame.input.inR);
+  appendVarint(&audioBytes_, l ^ prevAudioL_);
+  appendVarint(&audioBytes_, r ^ prevAudioR_);
+  prevAudioL_ = l;
+  prevAudioR_ = r;
+
+  blockFrames_++;
+  if (blockFrames_ >= uint32_t(kSessionBlockFrames)) {
+    flush(out);
+    return true;
+  }
+  return false;
+}
+
+void SessionEncoder::flush(std::vector<uint8_t> *out) {
+  if (blockFrames_ == 0) {
+    return;
+  }
+  closeRun();
+  appendVarint(out, blockFrames_);
+  appendVarint(out, uint32_t(controlBytes_.size()));
+  appendVarint(out, uint32_t(audioBytes_.size()));
+  out->insert(out->end(), controlBytes_.begin(), controlBytes_.end());
+  out->insert(out->end(), audioBytes_.begin(), audioBytes_.end());
+  controlBytes_.clear();
+  audioBytes_.clear();
+  blockFrames_ = 0;
+}
+
+// SessionReader -------------------------------------------------------------
+
+bool SessionReader::open(const std::string &path, std::string *errorOut) {
+  std::ifstream in(path.c_str(), std::ios::binary);
+  if (!in.good()) {
+    setError(errorOut, "Failed to open session file");
+    return false;
+  }
+  std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  return openMemory(std::move(bytes), errorOut);
+}
+
+bool SessionReader::openMemory(std::vector<uint8_t> bytes, std::string *errorOut) {
+  *this = SessionReader();
+  bytes_ = std::move(bytes);
+  const size_t headerBytes = sizeof(kSessionMagic) + 12;
+  if (bytes_.size() < headerBytes || std::memcmp(bytes_.data(), kSessionMagic, sizeof(kSessionMagic)) != 0) {
+    setError(errorOut, "Not a TemporalDeck session file");
+    return false;
+  }
+  const uint8_t *p = bytes_.data() + sizeof(kSessionMagic);
+  uint32_t version = readLe32(p);
+  if (version != 1 && version != kSessionVersion) {
+    setError(errorOut, "Unsupported session file version");
+    return false;
+  }
+  header_.sampleRate = bitsFloat(readLe32(p + 4));
+  uint32_t bufferWord = readLe32(p + 8);
+  header_.bufferDurationMode = int(bufferWord & kHeaderBufferModeMask);
+  header_.compactLongBuffers = (bufferWord & kHeaderCompactLongBuffers) != 0;
+  header_.hasStartRing = version >= 2 && (bufferWord & kHeaderStartRing) != 0;
+  pos_ = headerBytes;
+  if (header_.hasStartRing) {
+    if (bytes_.size() < headerBytes + 8) {
+      setError(errorOut, "Corrupt session header");
+      return false;
+    }
+    header_.startRingWriteHead = int(readLe32(bytes_.data() + headerBytes));
+    header_.startRingFilled = int(readLe32(bytes_.data() + headerBytes + 4));
+    pos_ += 8;
+  }
+  if (!(header_.sampleRate > 0.f) || header_.bufferDurationMode < 0 ||
+      header_.bufferDurationMode >= TemporalDeckEngine::BUFFER_DURATION_COUNT || header_.startRingWriteHead < 0 ||
+      header_.startRingFilled < 0) {
+    setError(errorOut, "Corrupt session header");
+    return false;
+  }
+  return true;
+}
+
+bool SessionReader::beginBlock() {
+  uint32_t frames = 0;
+  uint32_t controlLen = 0;
+  uint32_t audioLen = 0;
+  if (pos_ >= bytes_.size()) {
+    return false;
+  }
+  if (!readVarint(bytes_, &pos_, bytes_.size(), &frames) || !readVarint(bytes_, &pos_, bytes_.size(), &controlLen) ||
+      !readVarint(bytes_, &pos_, bytes_.size(), &audioLen) || frames == 0 ||
+      bytes_.size() - pos_ < size_t(controlLen) + size_t(audioLen)) {
+    error_ = "Truncated session block";
+    return false;
+  }
+  controlPos_ = pos_;
+  controlEnd_ = pos_ + controlLen;
+  audioPos_ = controlEnd_;
+  audioEnd_ = audioPos_ + audioLen;
+  pos_ = audioEnd_;
+  blockFramesLeft_ = frames;
+  runLeft_ = 0;
+  return true;
+}
+
+bool SessionReader::next(SessionFrame *frame) {
+  if (!frame || !error_.empty()) {
+    return false;
+  }
+  if (blockFramesLeft_ == 0 && !beginBlock()) {
+    return false;
+  }
+  if (runLeft_ == 0) {
+    uint32_t mask = 0;
+    if (!readVarint(bytes_, &controlPos_, controlEnd_, &mask)) {
+      error_ = "Corrupt control run";
+      return false;
+    }
+    for (int i = 0; i < kSessionControlWordCount; ++i) {
+      if (mask & (1u << i)) {
+        uint32_t delta = 0;
+        if (!readVarint(bytes_, &controlPos_, controlEnd_, &delta)) {
+          error_ = "Corrupt control run";
+          return false;
+        }
+        control_[i] ^= delta;
+      }
+    }
+    if (!readVarint(bytes_, &controlPos_, controlEnd_, &runLeft_) || runLeft_ == 0) {
+      error_ = "Corrupt control run";
+      return false;
+    }
+  }
+  uint32_t dl = 0;
+  uint32_t dr = 0;
+  if (!readVarint(bytes_, &audioPos_, audioEnd_, &dl) || !readVarint(bytes_, &audioPos_, audioEnd_, &dr)) {
+    error_ = "Corrupt audio block";
+    return false;
+  }
+  audioL_ ^= dl;
+  audioR_ ^= dr;
+
+  unpackControl(control_, frame);
+  frame->input.inL = bitsFloat(audioL_);
+  frame->input.inR = bitsFloat(audioR_);
+  runLeft_--;
+  blockFramesLeft_--;
+  return true;
+}
+
+// SessionRecorder -----------------------------------------------------------
+
+SessionRecorder::~SessionRecorder() {
+  // The audio thread is gone by now, so flushing its side here is safe.
+  endSession();
+  joinWriter();
+  if (file_) {
+    std::fclose(file_);
+    file_ = nullptr;
+  }
+}
+
+bool SessionRecorder::start(const std::string &path, std::string *errorOut) {
+  if (recording_.load(std::memory_order_relaxed) || startRequested_.load(std::memory_order_relaxed)) {
+    setError(errorOut, "Session recording already active");
+    return false;
+  }
+  joinWriter();
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  if (!file) {
+    setError(errorOut, "Failed to open session file");
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    file_ = file;
+    path_ = path;
+    shutdown_ = false;
+  }
+  // Everything the audio thread touches is sized here, so encoding and handoff
+  // never allocate.
+  ring_.allocate(kRecorderRingBytes);
+  filling_.clear();
+  filling_.reserve(kRecorderMaxBlockBytes + 64);
+  droppedFrames_.store(0, std::memory_order_relaxed);
+  producerDone_.store(false, std::memory_order_relaxed);
+  stopRequested_.store(false, std::memory_order_relaxed);
+  writerThread_ = std::thread([this]() { writerLoop(); });
+  startRequested_.store(true, std::memory_order_release);
+  return true;
+}
+
+void SessionRecorder::requestStop() {
+  if (startRequested_.exchange(false, std::memory_order_acq_rel)) {
+    // Never started on the audio thread; nothing was encoded.
+    producerDone_.store(true, std::memory_order_release);
+    cv_.notify_one();
+    return;
+  }
+  stopRequested_.store(true, std::memory_order_release);
+}
+
+bool SessionRecorder::isRecording() const {
+  return recording_.load(std::memory_order_relaxed) || startRequested_.load(std::memory_order_relaxed);
+}
+
+std::string SessionRecorder::path() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return path_;
+}
+
+bool SessionRecorder::consumeStartRequest() {
+  return startRequested_.exchange(false, std::memory_order_acq_rel);
+}
+
+bool SessionRecorder::consumeStopRequest() {
+  return stopRequested_.exchange(false, std::memory_order_acq_rel);
+}
+
+void SessionRecorder::beginSession(const SessionHeader &header) {
+  encoder_.reset();
+  filling_.clear();
+  fillingFrames_ = 0;
+  overrun_ = false;
+  SessionEncoder::appendHeader(header, &filling_);
+  handoff();
+  sessionActive_ = true;
+  recording_.store(true, std::memory_order_relaxed);
+}
+
+void SessionRecorder::push(const SessionFrame &frame) {
+  if (!sessionActive_) {
+    return;
+  }
+  if (overrun_) {
+    droppedFrames_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  fillingFrames_++;
+  if (encoder_.push(frame, &filling_)) {
+    handoff();
+  }
+}
+
+void SessionRecorder::endSession() {
+  if (!sessionActive_) {
+    return;
+  }
+  encoder_.flush(&filling_);
+  handoff();
+  producerDone_.store(true, std::memory_order_release);
+  sessionActive_ = false;
+  recording_.store(false, std::memory_order_relaxed);
+}
+
+void SessionRecorder::handoff() {
+  if (filling_.empty()) {
+    return;
+  }
+  if (overrun_ || !ring_.push(filling_.data(), filling_.size())) {
+    overrun_ = true;
+    droppedFrames_.fetch_add(uint64_t(fillingFrames_), std::memory_order_relaxed);
+  }
+  filling_.clear();
+  fillingFrames_ = 0;
+}
+
+void SessionRecorder::writerLoop() {
+  std::vector<uint8_t> chunk(kRecorderWriteChunkBytes);
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    lock.unlock();
+    // Read before draining, so every block pushed before the stop is written.
+    bool done = producerDone_.load(std::memory_order_acquire);
+    size_t got = 0;
+    while ((got = ring_.pop(chunk.data(), chunk.size())) > 0) {
+      if (file_) {
+        std::fwrite(chunk.data(), 1, got, file_);
+      }
+    }
+    lock.lock();
+    if (done || shutdown_) {
+      break;
+    }
+    cv_.wait_for(lock, std::chrono::milliseconds(kRecorderWriterPollMs));
+  }
+  if (file_) {
+    std::fclose(file_);
+    file_ = nullptr;
+  }
+}
+
+void SessionRecorder::joinWriter() {
+  if (!writerThread_.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  cv_.notify_one();
+  writerThread_.join();
+}
+
+// Replay --------------------------------------------------------------------
+
+void applySessionFrame(TemporalDeckEngine &engine, const SessionFrame &frame, uint32_t *appliedSampleSeekRevision,
+                       uint32_t *appliedLiveSeekRevision) {
+  // Mirrors the engine setup order in TemporalDeck::process().
+  engine.scratchInterpolationMode = frame.scratchInterpolationMode;
+  engine.slipReturnMode = frame.slipReturnMode;
+  engine.externalGatePosMode = frame.externalGatePosMode;
+  engine.cartridgeCharacter = frame.cartridgeCharacter;
+  engine.cartridgeOversamplingMode = frame.cartridgeOversamplingMode;
+  engine.autoInterpolationCap = frame.autoInterpolationCap;
+  engine.sampleRate = frame.sampleRate;
+  engine.sampleModeEnabled = frame.sampleModeEnabled;
+  engine.sampleLoopEnabled = frame.sampleLoopEnabled;
+  engine.sampleSeekSnap = frame.sampleSeekSnap;
+  *appliedSampleSeekRevision = temporaldeck_transport::applyPendingSampleSeek(
+    engine, *appliedSampleSeekRevision, frame.sampleSeekRevision, frame.sampleSeekNormalized, frame.input.bufferKnob);
+  *appliedLiveSeekRevision = temporaldeck_transport::applyPendingLiveSeekArc(
+    engine, *appliedLiveSeekRevision, frame.liveSeekRevision, frame.liveSeekArcNormalized, frame.input.bufferKnob);
+}
+
+bool renderSession(SessionReader &reader, RenderedSession *out, std::string *errorOut,
+                   const TemporalDeckBuffer *startRing) {
+  if (!out) {
+    return false;
+  }
+  const SessionHeader &header = reader.header();
+  if (header.hasStartRing && !startRing) {
+    setError(errorOut, "Session starts from saved history; load its start ring");
+    return false;
+  }
+  TemporalDeckEngine engine;
+  engine.bufferDurationMode = header.bufferDurationMode;
+  engine.compactLongBuffers = header.compactLongBuffers;
+  engine.reset(header.sampleRate);
+  if (header.hasStartRing) {
+    // The module restarts transport at NOW on the ring it already had.
+    engine.buffer = *startRing;
+    engine.reset(header.sampleRate, false);
+    engine.readHead = engine.newestReadablePos();
+  }
+
+  out->sampleRate = header.sampleRate;
+  out->left.clear();
+  out->right.clear();
+
+  SessionFrame frame;
+  bool first = true;
+  uint32_t appliedSampleSeekRevision = 0;
+  uint32_t appliedLiveSeekRevision = 0;
+  while (reader.next(&frame)) {
+    if (first) {
+      // The module starts a session from a fresh engine, with its revision
+      // counters already at whatever the UI had published.
+      appliedSampleSeekRevision = frame.sampleSeekRevision;
+      appliedLiveSeekRevision = frame.liveSeekRevision;
+      first = false;
+    }
+    applySessionFrame(engine, frame, &appliedSampleSeekRevision, &appliedLiveSeekRevision);
+    TemporalDeckEngine::FrameResult result = engine.process(frame.input);
+    out->left.push_back(result.outL);
+    out->right.push_back(result.outR);
+  }
+  if (!reader.error().empty()) {
+    setError(errorOut, reader.error().c_str());
+    return false;
+  }
+  return true;
+}
+
+std::string sessionStartRingPath(const std::string &sessionPath) {
+  return sessionPath + ".tdlb";
+}
+
+bool loadSessionStartRing(const std::string &sessionPath, const SessionHeader &header, TemporalDeckBuffer *out,
+                          std::string *errorOut) {
+  if (!out || !header.hasStartRing) {
+    setError(errorOut, "Session has no start ring");
+    return false;
+  }
+  TemporalDeckBuffer saved;
+  temporaldeck::RingSnapshotInfo info;
+  if (!temporaldeck::readRingSnapshot(sessionStartRingPath(sessionPath), header.compactLongBuffers, &saved, &info,
+                                      errorOut)) {
+    return false;
+  }
+  if (info.sampleRate != header.sampleRate || info.bufferMode != header.bufferDurationMode) {
+    setError(errorOut, "Start ring does not match the session");
+    return false;
+  }
+  // Reads depend on absolute ring positions, so the history goes back exactly
+  // where it was, ending at the recorded write head.
+  out->resetForMode(header.sampleRate, header.bufferDurationMode, header.compactLongBuffers);
+  if (header.startRingWriteHead >= out->size || header.startRingFilled > out->size || info.frames > out->size) {
+    setError(errorOut, "Start ring does not match the session");
+    return false;
+  }
+  out->writeHead = out->wrapIndex(header.startRingWriteHead - info.frames);
+  for (int i = 0; i < info.frames; ++i) {
+    int idx = saved.wrapIndex(saved.writeHead - info.frames + i);
+    out->write(saved.leftSample(idx), saved.rightSample(idx));
+  }
+  out->clearHistoryBefore(info.frames);
+  out->filled = header.startRingFilled;
+  return true;
+}
+
+bool renderSessionFile(const std::string &sessionPath, RenderedSession *out, std::string *errorOut) {
+  SessionReader reader;
+  if (!reader.open(sessionPath, errorOut)) {
+    return false;
+  }
+  TemporalDeckBuffer startRing;
+  if (reader.header().hasStartRing && !loadSessionStartRing(sessionPath, reader.header(), &startRing, errorOut)) {
+    return false;
+  }
+  return renderSession(reader, out, errorOut, reader.header().hasStartRing ? &startRing : nullptr);
+}
+
+bool writeFloatWav(const std::string &path, const RenderedSession &render, std::string *errorOut) {
+  size_t frames = std::min(render.left.size(), render.right.size());
+  uint64_t dataBytes = uint64_t(frames) * 8ull;
+  if (dataBytes + 36ull > uint64_t(std::numeric_limits<uint32_t>::max())) {
+    setError(errorOut, "Render exceeds RIFF size limit");
+    return false;
+  }
+  std::vector<uint8_t> bytes;
+  bytes.reserve(size_t(dataBytes) + 44);
+  uint32_t sr = uint32_t(std::max(1l, std::lround(double(render.sampleRate))));
+  auto appendTag = [&](const char *tag) { bytes.insert(bytes.end(), tag, tag + 4); };
+  appendTag("RIFF");
+  appendLe32(&bytes, uint32_t(36ull + dataBytes));
+  appendTag("WAVE");
+  appendTag("fmt ");
+  appendLe32(&bytes, 16u);
+  bytes.push_back(3); // IEEE float
+  bytes.push_back(0);
+  bytes.push_back(2);
+  bytes.push_back(0);
+  appendLe32(&bytes, sr);
+  appendLe32(&bytes, sr * 8u);
+  bytes.push_back(8);
+  bytes.push_back(0);
+  bytes.push_back(32);
+  bytes.push_back(0);
+  appendTag("data");
+  appendLe32(&bytes, uint32_t(dataBytes));
+  for (size_t i = 0; i < frames; ++i) {
+    appendLe32(&bytes, floatBits(render.left[i]));
+    appendLe32(&bytes, floatBits(render.right[i]));
+  }
+
+  std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+  if (!out.good()) {
+    setError(errorOut, "Failed to open output WAV");
+    return false;
+  }
+  out.write(reinterpret_cast<const char *>(bytes.data()), std::streamsize(bytes.size()));
+  if (!out.good()) {
+    setError(errorOut, "Failed to write output WAV");
+    return false;
+  }
+  return true;
+}
+
+bool readFloatWav(const std::string &path, RenderedSession *out, std::string *errorOut) {
+  std::ifstream in(path.c_str(), std::ios::binary);
+  if (!out || !in.good()) {
+    setError(errorOut, "Failed to open WAV");
+    return false;
+  }
+  std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  if (bytes.size() < 12 || std::memcmp(bytes.data(), "RIFF", 4) != 0 || std::memcmp(bytes.data() + 8, "WAVE", 4) != 0) {
+    setError(errorOut, "Not a RIFF/WAVE file");
+    return false;
+  }
+  bool haveFormat = false;
+  size_t pos = 12;
+  while (pos + 8 <= bytes.size()) {
+    const uint8_t *chunk = bytes.data() + pos;
+    uint32_t size = readLe32(chunk + 4);
+    size_t body = pos + 8;
+    if (bytes.size() - body < size) {
+      break;
+    }
+    if (std::memcmp(chunk, "fmt ", 4) == 0 && size >= 16) {
+      uint16_t format = readLe16(bytes.data() + body);
+      uint16_t channels = readLe16(bytes.data() + body + 2);
+      uint16_t bits = readLe16(bytes.data() + body + 14);
+      if (format != 3 || channels != 2 || bits != 32) {
+        setError(errorOut, "Expected stereo 32-bit float WAV");
+        return false;
+      }
+      out->sampleRate = float(readLe32(bytes.data() + body + 4));
+      haveFormat = true;
+    } else if (std::memcmp(chunk, "data", 4) == 0 && haveFormat) {
+      size_t frames = size / 8;
+      out->left.resize(frames);
+      out->right.resize(frames);
+      for (size_t i = 0; i < frames; ++i) {
+        out->left[i] = bitsFloat(readLe32(bytes.data() + body + i * 8));
+        out->right[i] = bitsFloat(readLe32(bytes.data() + body + i * 8 + 4));
+      }
+      return true;
+    }
+    pos = body + size + (size & 1u);
+  }
+  setError(errorOut, "WAV is missing fmt/data chunks");
+  return false;
+}
+
+RenderDiff compareRenders(const RenderedSession &a, const RenderedSession &b) {
+  RenderDiff diff;
+  size_t frames = std::min(a.left.size(), b.left.size());
+  diff.lengthMismatch = a.left.size() != b.left.size();
+  for (size_t i = 0; i < frames; ++i) {
+    bool same = floatBits(a.left[i]) == floatBits(b.left[i]) && floatBits(a.right[i]) == floatBits(b.right[i]);
+    if (same) {
+      continue;
+    }
+    if (diff.firstMismatchFrame < 0) {
+      diff.firstMismatchFrame = (long long)i;
+    }
+    diff.mismatchedFrames++;
+    diff.maxAbsDiff = std::max(diff.maxAbsDiff, std::fabs(a.left[i] - b.left[i]));
+    diff.maxAbsDiff = std::max(diff.maxAbsDiff, std::fabs(a.right[i] - b.right[i]));
+  }
+  diff.identical = !diff.lengthMismatch && diff.mismatchedFrames == 0;
+  return diff;
+}
+
+} // namespace temporaldeck_session
@@ -0,0 +1,247 @@
+#pragma once
+
+#include "TemporalDeckEngine.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace temporaldeck_session {
+
+// Everything the module hands the engine for one audio frame: the FrameInput
+// itself, the mode fields written onto the engine just before process(), and
+// the UI seek revisions applied through temporaldeck_transport.
+struct SessionFrame {
+  temporaldeck::TemporalDeckEngine::FrameInput input;
+  float sampleRate = 44100.f;
+  int scratchInterpolationMode = temporaldeck::TemporalDeckEngine::SCRATCH_INTERP_LAGRANGE6;
+  int slipReturnMode = temporaldeck::TemporalDeckEngine::SLIP_RETURN_NORMAL;
+  int externalGatePosMode = temporaldeck::TemporalDeckEngine::EXTERNAL_GATE_POS_GLIDE;
+  int cartridgeCharacter = temporaldeck::TemporalDeckEngine::CARTRIDGE_CLEAN;
+  int cartridgeOversamplingMode = temporaldeck::TemporalDeckEngine::CARTRIDGE_OVERSAMPLING_OFF;
+  // The CPU governor's ceiling is timing-dependent, so it is recorded rather
+  // than re-derived on replay.
+  int autoInterpolationCap = temporaldeck::TemporalDeckEngine::INTERP_TIER_SINC;
+  bool sampleModeEnabled = false;
+  bool sampleLoopEnabled = false;
+  bool sampleSeekSnap = false;
+  uint32_t sampleSeekRevision = 0;
+  float sampleSeekNormalized = 0.f;
+  uint32_t liveSeekRevision = 0;
+  float liveSeekArcNormalized = 0.f;
+};
+
+struct SessionHeader {
+  float sampleRate = 44100.f;
+  int bufferDurationMode = temporaldeck::TemporalDeckEngine::BUFFER_DURATION_10S;
+  bool compactLongBuffers = false;
+  // Set when recording started on a deck with history. The ring is saved next
+  // to the session (see sessionStartRingPath()) and replay puts it back at the
+  // same ring position, so scratches into that history replay bit-exact.
+  bool hasStartRing = false;
+  int startRingWriteHead = 0;
+  int startRingFilled = 0;
+};
+
+// Control fields are packed into fixed 32-bit words so a frame can be diffed
+// against the previous one with a single change mask.
+static constexpr int kSessionControlWordCount = 18;
+static constexpr int kSessionBlockFrames = 4096;
+// History kept past the oldest lag the knob can reach when a take starts, for
+// interpolation and mip-level taps at that edge. Anything older is cleared.
+static constexpr int kSessionStartRingMarginFrames = 4096;
+
+// Delta/RLE encoder for the frame stream. Control words are stored as runs of
+// identical frames (mask of changed words + XOR deltas + run length); audio is
+// stored per frame as varint XOR deltas of the float bit patterns, which keeps
+// decoding bit-exact. Encoding never allocates once the staging buffers are
+// reserved, so it is safe to drive from the audio thread.
+struct SessionEncoder {
+  SessionEncoder();
+
+  void reset();
+  // Returns true when a full block has been appended to `out`.
+  bool push(const SessionFrame &frame, std::vector<uint8_t> *out);
+  void flush(std::vector<uint8_t> *out);
+
+  static void appendHeader(const SessionHeader &header, std::vector<uint8_t> *out);
+
+private:
+  void closeRun();
+
+  uint32_t prevControl_[kSessionControlWordCount];
+  uint32_t prevAudioL_ = 0;
+  uint32_t prevAudioR_ = 0;
+  bool haveControl_ = false;
+  uint32_t runLength_ = 0;
+  uint32_t runMask_ = 0;
+  uint32_t runDelta_[kSessionControlWordCount];
+  uint32_t blockFrames_ = 0;
+  std::vector<uint8_t> controlBytes_;
+  std::vector<uint8_t> audioBytes_;
+};
+
+struct SessionReader {
+  bool open(const std::string &path, std::string *errorOut = nullptr);
+  bool openMemory(std::vector<uint8_t> bytes, std::string *errorOut = nullptr);
+  const SessionHeader &header() const { return header_; }
+  // Returns false at end of stream or on a malformed block (see error()).
+  bool next(SessionFrame *frame);
+  const std::string &error() const { return error_; }
+
+private:
+  bool beginBlock();
+
+  std::vector<uint8_t> bytes_;
+  size_t pos_ = 0;
+  SessionHeader header_;
+  std::string error_;
+  uint32_t control_[kSessionControlWordCount] = {};
+  uint32_t audioL_ = 0;
+  uint32_t audioR_ = 0;
+  size_t controlPos_ = 0;
+  size_t controlEnd_ = 0;
+  size_t audioPos_ = 0;
+  size_t audioEnd_ = 0;
+  uint32_t blockFramesLeft_ = 0;
+  uint32_t runLeft_ = 0;
+};
+
+// Single-producer/single-consumer byte FIFO with a power-of-two capacity.
+// Writes are all or nothing, so an encoded block never lands half in the file.
+struct SessionByteRing {
+  std::vector<uint8_t> bytes;
+  uint64_t mask = 0;
+  std::atomic<uint64_t> writeIndex{0};
+  std::atomic<uint64_t> readIndex{0};
+
+  void allocate(size_t minBytes) {
+    uint64_t capacity = 1;
+    while (capacity < uint64_t(std::max<size_t>(minBytes, 1))) {
+      capacity <<= 1;
+    }
+    bytes.assign(size_t(capacity), 0);
+    mask = capacity - 1;
+    readIndex.store(writeIndex.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+
+  // Producer. False when `count` bytes do not fit; nothing is written.
+  bool push(const uint8_t *data, size_t count) {
+    uint64_t w = writeIndex.load(std::memory_order_relaxed);
+    uint64_t used = w - readIndex.load(std::memory_order_acquire);
+    if (bytes.empty() || uint64_t(count) > mask + 1 - used) {
+      return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      bytes[size_t((w + i) & mask)] = data[i];
+    }
+    writeIndex.store(w + count, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer.
+  size_t pop(uint8_t *out, size_t maxBytes) {
+    uint64_t r = readIndex.load(std::memory_order_relaxed);
+    uint64_t available = writeIndex.load(std::memory_order_acquire) - r;
+    size_t count = size_t(std::min<uint64_t>(available, uint64_t(maxBytes)));
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = bytes[size_t((r + i) & mask)];
+    }
+    readIndex.store(r + count, std::memory_order_release);
+    return count;
+  }
+};
+
+// Streams an encoded session to disk from the audio thread. start()/requestStop()
+// are called from the UI thread; beginSession()/push()/endSession() only from
+// the audio thread, which encodes into preallocated staging and copies each
+// finished block into a ring that a writer thread polls. A block that finds the
+// ring full ends the file there: later blocks would not decode without it, so
+// the rest of the session is dropped and counted instead.
+struct SessionRecorder {
+  SessionRecorder() = default;
+  ~SessionRecorder();
+
+  bool start(const std::string &path, std::string *errorOut = nullptr);
+  void requestStop();
+  bool isRecording() const;
+  std::string path() const;
+  // Frames encoded but not written because the writer fell behind.
+  uint64_t droppedFrames() const { return droppedFrames_.load(std::memory_order_relaxed); }
+
+  bool consumeStartRequest();
+  bool consumeStopRequest();
+  bool active() const { return sessionActive_; }
+  void beginSession(const SessionHeader &header);
+  void push(const SessionFrame &frame);
+  void endSession();
+
+private:
+  void handoff();
+  void writerLoop();
+  void joinWriter();
+
+  SessionEncoder encoder_;
+  // Audio thread only: the block being encoded and the frames it holds.
+  std::vector<uint8_t> filling_;
+  int fillingFrames_ = 0;
+  bool overrun_ = false;
+  SessionByteRing ring_;
+  std::FILE *file_ = nullptr;
+  std::string path_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::thread writerThread_;
+  bool shutdown_ = false;
+  std::atomic<bool> startRequested_{false};
+  std::atomic<bool> stopRequested_{false};
+  std::atomic<bool> producerDone_{false};
+  std::atomic<bool> recording_{false};
+  std::atomic<uint64_t> droppedFrames_{0};
+  bool sessionActive_ = false;
+};
+
+// Offline replay: runs a recorded session through a fresh engine exactly as
+// TemporalDeck::process() does and collects the stereo output.
+struct RenderedSession {
+  float sampleRate = 44100.f;
+  std::vector<float> left;
+  std::vector<float> right;
+};
+
+void applySessionFrame(temporaldeck::TemporalDeckEngine &engine, const SessionFrame &frame,
+                       uint32_t *appliedSampleSeekRevision, uint32_t *appliedLiveSeekRevision);
+// `startRing` is required when the header has one (see loadSessionStartRing()).
+bool renderSession(SessionReader &reader, RenderedSession *out, std::string *errorOut = nullptr,
+                   const temporaldeck::TemporalDeckBuffer *startRing = nullptr);
+
+// Live ring snapshot written beside a session that started with history.
+std::string sessionStartRingPath(const std::string &sessionPath);
+// Reads the start ring saved for `sessionPath` and lays it out at the ring
+// position recorded in `header`.
+bool loadSessionStartRing(const std::string &sessionPath, const SessionHeader &header,
+                          temporaldeck::TemporalDeckBuffer *out, std::string *errorOut = nullptr);
+// Opens `sessionPath`, loads its start ring when it has one, and renders it.
+bool renderSessionFile(const std::string &sessionPath, RenderedSession *out, std::string *errorOut = nullptr);
+
+// 32-bit float WAV so golden comparisons are bit-exact.
+bool writeFloatWav(const std::string &path, const RenderedSession &render, std::string *errorOut = nullptr);
+bool readFloatWav(const std::string &path, RenderedSession *out, std::string *errorOut = nullptr);
+
+struct RenderDiff {
+  bool identical = false;
+  bool lengthMismatch = false;
+  long long firstMismatchFrame = -1;
+  long long mismatchedFrames = 0;
+  float maxAbsDiff = 0.f;
+};
+
+RenderDiff compareRenders(const RenderedSession &a, const RenderedSession &b);
+
+} // namespace temporaldeck_session
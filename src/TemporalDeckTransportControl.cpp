@@ -91,15 +91,9 @@ uint32_t applyPendingSampleSeek(temporaldeck::TemporalDeckEngine &engine, uint32
   float seekNorm = std::max(0.f, std::min(pendingNormalized, 1.f));
   if (engine.sampleLoaded && engine.sampleFrames > 0) {
     double sampleEndPos = std::max(0.0, double(engine.sampleFrames - 1));
-    double sampleWindowEndPos = sampleEndPos * double(std::max(0.f, std::min(bufferKnob, 1.f)));
+    double sampleWindowEndPos = engine.sampleWindowEndFor(bufferKnob);
     // Arc seek maps to full sample time and then clamps to active window end.
-    double targetFrame = clampd(double(seekNorm) * sampleEndPos, 0.0, sampleWindowEndPos);
-    engine.samplePlayhead = targetFrame;
-    engine.readHead = targetFrame;
-    engine.scratchLagSamples = 0.0;
-    engine.scratchLagTargetSamples = 0.0;
-    engine.nowCatchActive = false;
-    engine.cancelSlipReturnState();
+    engine.seekSampleTo(double(seekNorm) * sampleEndPos, sampleWindowEndPos);
   }
 
   return pendingRevision;
@@ -2084,6 +2084,26 @@ static std::string lowercaseExtension(const std::string &path) {
   return ext;
 }
 
+// Recordings and exports keep a .flac extension and default to WAV otherwise.
+static std::string ensureRecordingExtension(std::string path) {
+  return lowercaseExtension(path) == ".flac" ? path : ensureWavExtension(path);
+}
+
+// Save dialog for recordings and exports; empty when cancelled.
+static std::string promptRecordingPath(const char *defaultName) {
+  std::string defaultDir = temporalDeckUserRootPath();
+  system::createDirectories(defaultDir);
+  osdialog_filters *filters = osdialog_filters_parse("WAV (32-bit float):wav,WAV;FLAC (24-bit):flac,FLAC");
+  char *pathC = osdialog_file(OSDIALOG_SAVE, defaultDir.c_str(), defaultName, filters);
+  osdialog_filters_free(filters);
+  if (!pathC) {
+    return "";
+  }
+  std::string path = ensureRecordingExtension(pathC);
+  std::free(pathC);
+  return path;
+}
+
 static bool isSupportedPlatterArtPath(const std::string &path) {
   std::string ext = lowercaseExtension(path);
   return ext == ".svg" || ext == ".png" || ext == ".jpg" || ext == ".jpeg";
@@ -3186,6 +3206,15 @@ struct TemporalDeckWidget : ModuleWidget {
     addParam(createParamCentered<LEDButton>(tonearmPivot, module, TemporalDeck::CARTRIDGE_CYCLE_PARAM));
   }
 
+  void step() override {
+    // Panel lights are derived here from the audio thread's latest snapshot.
+    TemporalDeck *module = dynamic_cast<TemporalDeck *>(this->module);
+    if (module) {
+      module->refreshPanelLights();
+    }
+    ModuleWidget::step();
+  }
+
   void appendContextMenu(Menu *menu) override {
     TemporalDeck *module = dynamic_cast<TemporalDeck *>(this->module);
     assert(menu);
@@ -3334,7 +3363,78 @@ struct TemporalDeckWidget : ModuleWidget {
             [=]() { return module->getScratchInterpolationMode() == i; },
             [=]() { module->setScratchInterpolationMode(i); }));
         }
+        submenu->addChild(new MenuSeparator());
+        submenu->addChild(createMenuLabel(
+          string::f("Now: %s", TemporalDeck::interpolationTierLabelFor(module->getActiveInterpolationTier()))));
+        submenu->addChild(createMenuLabel(string::f(
+          "Auto ceiling: %s (all decks %.0f%% CPU)",
+          TemporalDeck::interpolationTierLabelFor(module->getQualityGovernorTierCap()),
+          100.f * module->getQualityGovernorLoad())));
+        submenu->addChild(createSubmenuItem("Auto CPU budget (all decks)", "", [=](Menu *budgetMenu) {
+          for (int i = 0; i < TemporalDeck::QUALITY_BUDGET_COUNT; ++i) {
+            float budget = TemporalDeck::kQualityBudgetOptions[i];
+            budgetMenu->addChild(createCheckMenuItem(
+              string::f("%.0f%% of one core", 100.f * budget), "",
+              [=]() { return std::fabs(module->getQualityBudget() - budget) < 1e-3f; },
+              [=]() { module->setQualityBudget(budget); }));
+          }
+        }));
       }));
+      menu->addChild(createSubmenuItem("Performance", "", [=](Menu *submenu) {
+        submenu->addChild(createCheckMenuItem("Stage profiling", "", [=]() { return module->isProfilingEnabled(); },
+                                              [=]() { module->setProfilingEnabled(!module->isProfilingEnabled()); }));
+        TemporalDeck::PerformanceSnapshot perf = module->getPerformanceSnapshot();
+        submenu->addChild(createMenuLabel(string::f("Deck load: %.1f%% of one core", 100.f * perf.loadFraction)));
+        if (!perf.enabled) {
+          return;
+        }
+        double totalNs = 0.0;
+        for (int i = 0; i < TemporalDeck::PROFILE_STAGE_COUNT; ++i) {
+          totalNs += perf.stageNsPerFrame[i];
+        }
+        submenu->addChild(new MenuSeparator());
+        for (int i = 0; i < TemporalDeck::PROFILE_STAGE_COUNT; ++i) {
+          submenu->addChild(createMenuLabel(string::f("%s: %.0f ns/frame (%.0f%%)", TemporalDeck::profileStageLabelFor(i),
+                                                      perf.stageNsPerFrame[i],
+                                                      totalNs > 0.0 ? 100.0 * perf.stageNsPerFrame[i] / totalNs : 0.0)));
+        }
+        submenu->addChild(new MenuSeparator());
+        for (int i = 0; i < TemporalDeck::PROFILE_COUNTER_COUNT; ++i) {
+          submenu->addChild(createMenuLabel(string::f("%s: %llu", TemporalDeck::profileCounterLabelFor(i),
+                                                      (unsigned long long)perf.counters[i])));
+        }
+        submenu->addChild(new MenuSeparator());
+        submenu->addChild(createMenuItem("Reset counters", "", [=]() { module->resetProfiling(); }));
+        submenu->addChild(createMenuItem("Export JSON...", "", [=]() {
+          std::string defaultDir = temporalDeckUserRootPath();
+          system::createDirectories(defaultDir);
+          osdialog_filters *filters = osdialog_filters_parse("JSON:json,JSON");
+          char *pathC = osdialog_file(OSDIALOG_SAVE, defaultDir.c_str(), "temporaldeck_performance.json", filters);
+          osdialog_filters_free(filters);
+          if (!pathC) {
+            return;
+          }
+          std::string path = ensureJsonExtension(pathC);
+          std::free(pathC);
+          std::string error;
+          if (!module->exportPerformanceJson(path, &error)) {
+            osdialog_message(OSDIALOG_ERROR, OSDIALOG_OK, error.c_str());
+          }
+        }));
+      }));
+      menu->addChild(createSubmenuItem("Cartridge oversampling", "", [=](Menu *submenu) {
+        for (int i = 0; i < TemporalDeck::CARTRIDGE_OVERSAMPLING_COUNT; ++i) {
+          submenu->addChild(createCheckMenuItem(
+            TemporalDeck::cartridgeOversamplingLabelFor(i), "",
+            [=]() { return module->getCartridgeOversamplingMode() == i; },
+            [=]() { module->setCartridgeOversamplingMode(i); }));
+        }
+      }));
+      menu->addChild(createCheckMenuItem(
+        "Polyphonic read heads",
+        module->isPolyReadHeadsEnabled() ? string::f("%d active", module->getActiveReadHeadCount()) : "",
+        [=]() { return module->isPolyReadHeadsEnabled(); },
+        [=]() { module->setPolyReadHeadsEnabled(!module->isPolyReadHeadsEnabled()); }));
       menu->addChild(createSubmenuItem("Gate+Pos mode", "", [=](Menu *submenu) {
         for (int i = 0; i < TemporalDeck::EXTERNAL_GATE_POS_COUNT; ++i) {
           submenu->addChild(createCheckMenuItem(
@@ -3353,7 +3453,8 @@ struct TemporalDeckWidget : ModuleWidget {
             // 10-minute modes use 601s internal allocation (extra 1s headroom).
             float sr = std::max(module->getUiSampleRate(), 1.f);
             float channels = (mode == TemporalDeck::BUFFER_DURATION_10M_MONO) ? 1.f : 2.f;
-            double bytes = double(sr) * 601.0 * double(channels) * double(sizeof(float));
+            double bytesPerSample = module->isCompactLongBuffersEnabled() ? 2.0 : double(sizeof(float));
+            double bytes = double(sr) * 601.0 * double(channels) * bytesPerSample;
             double mib = bytes / (1024.0 * 1024.0);
             return string::f("%s (~%.0f MiB @ %.1fk)", label.c_str(), mib, sr / 1000.f);
           };
@@ -3362,6 +3463,13 @@ struct TemporalDeckWidget : ModuleWidget {
                                                   [=]() { return module->getBufferDurationMode() == i; },
                                                   [=]() { module->applyBufferDurationMode(i); }));
           }
+          submenu->addChild(new MenuSeparator());
+          submenu->addChild(createCheckMenuItem(
+            "Compact 10m buffers (16-bit float)", "", [=]() { return module->isCompactLongBuffersEnabled(); },
+            [=]() { module->setCompactLongBuffersEnabled(!module->isCompactLongBuffersEnabled()); }));
+          submenu->addChild(createCheckMenuItem(
+            "Save live buffer with patch", "", [=]() { return module->isSaveLiveBufferEnabled(); },
+            [=]() { module->setSaveLiveBufferEnabled(!module->isSaveLiveBufferEnabled()); }));
         }));
       }
       menu->addChild(createSubmenuItem("Slip return speed", "", [=](Menu *submenu) {
@@ -3383,6 +3491,24 @@ struct TemporalDeckWidget : ModuleWidget {
                                            [=]() {
                                              module->setPlatterTraceLoggingEnabled(!module->isPlatterTraceLoggingEnabled());
                                            }));
+        menu->addChild(createCheckMenuItem("Record engine session", "",
+                                           [=]() { return module->isSessionRecording(); },
+                                           [=]() {
+                                             if (module->isSessionRecording()) {
+                                               module->stopSessionRecording();
+                                               return;
+                                             }
+                                             std::string sessionDir =
+                                               system::join(temporalDeckUserRootPath(), "sessions");
+                                             system::createDirectories(sessionDir);
+                                             long long stampMs = (long long)std::llround(system::getUnixTime() * 1000.0);
+                                             std::string path = system::join(
+                                               sessionDir, "session_" + std::to_string(stampMs) + ".tdsession");
+                                             std::string error;
+                                             if (!module->startSessionRecording(path, &error)) {
+                                               osdialog_message(OSDIALOG_ERROR, OSDIALOG_OK, error.c_str());
+                                             }
+                                           }));
       }
       if (isDragonKingDebugEnabled()) {
         menu->addChild(createMenuItem("Export signed inventory.json...", "", [=]() {
@@ -3480,6 +3606,13 @@ struct TemporalDeckWidget : ModuleWidget {
       if (liveModeActive) {
         bool disableConvert = module->getUiAccessibleLagSamples() < 1.0;
         menu->addChild(createMenuItem("Convert live -> sample", "", [=]() { module->convertLiveToSample(); }, disableConvert));
+        menu->addChild(createMenuItem("Export capture window...", "WAV/FLAC", [=]() {
+          std::string path = promptRecordingPath("capture_window.wav");
+          std::string error;
+          if (!path.empty() && !module->exportCaptureWindow(path, &error)) {
+            osdialog_message(OSDIALOG_ERROR, OSDIALOG_OK, error.c_str());
+          }
+        }, disableConvert));
       }
       menu->addChild(createMenuItem("Load sample...", loadedSampleRight, [=]() {
         osdialog_filters *filters = osdialog_filters_parse("Audio:wav,WAV,flac,FLAC,mp3,MP3");
@@ -3516,6 +3649,9 @@ struct TemporalDeckWidget : ModuleWidget {
         }));
       }
       menu->addChild(createMenuItem("Clear sample", "", [=]() { module->clearLoadedSample(); }, !hasLoadedSample));
+      menu->addChild(createCheckMenuItem(
+        "Snap seeks to transients", "", [=]() { return module->isSampleSeekSnapEnabled(); },
+        [=]() { module->setSampleSeekSnapEnabled(!module->isSampleSeekSnapEnabled()); }));
       if (hasLoadedSample) {
         menu->addChild(createSubmenuItem("Sample info", "", [=](Menu *submenu) {
           submenu->addChild(createMenuLabel(sampleInfoName));
@@ -3526,6 +3662,24 @@ struct TemporalDeckWidget : ModuleWidget {
           }
         }));
       }
+
+      menu->addChild(new MenuSeparator());
+      menu->addChild(createMenuLabel("Recording"));
+      uint64_t droppedFrames = module->getOutputRecordingOverruns();
+      std::string recordRight = droppedFrames > 0 ? string::f("%llu dropped", (unsigned long long)droppedFrames) : "";
+      menu->addChild(createCheckMenuItem("Record output...", recordRight,
+                                         [=]() { return module->isOutputRecording(); },
+                                         [=]() {
+                                           if (module->isOutputRecording()) {
+                                             module->stopOutputRecording();
+                                             return;
+                                           }
+                                           std::string path = promptRecordingPath("temporaldeck_output.wav");
+                                           std::string error;
+                                           if (!path.empty() && !module->startOutputRecording(path, &error)) {
+                                             osdialog_message(OSDIALOG_ERROR, OSDIALOG_OK, error.c_str());
+                                           }
+                                         }));
     }
   }
 };
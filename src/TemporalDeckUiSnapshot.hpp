@@ -0,0 +1,107 @@
+#pragma once
+
+#include "TemporalDeckArcLights.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace temporaldeck_ui {
+
+// Everything the panel, platter and lights read from the audio thread, published
+// together once per block so the UI never sees lag from one frame next to the
+// sample state of another.
+struct UiSnapshot {
+  double lagSamples = 0.0;
+  double accessibleLagSamples = 0.0;
+  double samplePlayheadSeconds = 0.0;
+  double sampleDurationSeconds = 0.0;
+  double sampleProgress = 0.0;
+  float sampleRate = 44100.f;
+  float platterAngle = 0.f;
+  // Full arc span in samples for the current buffer mode.
+  float maxLagSamples = 1.f;
+  int sampleFrames = 0;
+  int readHeadCount = 1;
+  int interpolationTier = 0;
+  int slipReturnMode = 0;
+  bool freezeLatched = false;
+  bool reverseLatched = false;
+  bool slipLatched = false;
+  bool sampleModeEnabled = false;
+  bool sampleLoaded = false;
+  bool sampleTransportPlaying = false;
+};
+
+// Single-writer sequence lock. The writer bumps the sequence to odd, stores the
+// payload as relaxed atomic words and bumps it back to even; readers copy the
+// words and retry if the sequence moved underneath them. The writer never waits,
+// and the payload words being atomics keeps a torn copy well defined until the
+// reader discards it.
+template <typename T>
+class SeqlockCell {
+public:
+  static_assert(std::is_trivially_copyable<T>::value, "seqlock payloads are copied word by word");
+  static constexpr int kWords = int((sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+
+  SeqlockCell() {
+    publish(T());
+  }
+
+  // Only one thread (or threads serialized with it) may publish.
+  void publish(const T &value) {
+    uint64_t staged[kWords] = {};
+    std::memcpy(staged, &value, sizeof(T));
+    uint32_t seq = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int i = 0; i < kWords; ++i) {
+      words_[i].store(staged[i], std::memory_order_relaxed);
+    }
+    sequence_.store(seq + 2, std::memory_order_release);
+  }
+
+  // Copies a consistent payload into `out`, leaving it untouched if every
+  // attempt raced a publish. `sequenceOut` receives the version that was read.
+  bool read(T &out, uint32_t *sequenceOut = nullptr, int attempts = 64) const {
+    for (int attempt = 0; attempt < attempts; ++attempt) {
+      uint32_t before = sequence_.load(std::memory_order_acquire);
+      if (before & 1u) {
+        continue;
+      }
+      uint64_t staged[kWords];
+      for (int i = 0; i < kWords; ++i) {
+        staged[i] = words_[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence_.load(std::memory_order_relaxed) != before) {
+        continue;
+      }
+      std::memcpy(&out, staged, sizeof(T));
+      if (sequenceOut) {
+        *sequenceOut = before;
+      }
+      return true;
+    }
+    return false;
+  }
+
+  // Even, and advances by 2 per publish.
+  uint32_t sequence() const {
+    return sequence_.load(std::memory_order_acquire);
+  }
+
+private:
+  std::atomic<uint32_t> sequence_{0};
+  std::array<std::atomic<uint64_t>, kWords> words_;
+};
+
+inline ArcLightState arcLightStateFor(const UiSnapshot &snapshot) {
+  return computeArcLightState(snapshot.sampleFrames, snapshot.maxLagSamples, snapshot.sampleModeEnabled,
+                              snapshot.sampleLoaded, snapshot.lagSamples, snapshot.accessibleLagSamples,
+                              snapshot.sampleProgress);
+}
+
+} // namespace temporaldeck_ui
@@ -0,0 +1,195 @@
+#pragma once
+#include "plugin.hpp"
+#include "SegmentCurve.hpp"
+#include <array>
+#include <cstdio>
+
+
+// One rise+fall cycle preview shared by Proc and IntegralFlux. The curve is
+// stroked into a framebuffer that is only redrawn when the preview geometry
+// changes; the moving dot and the frequency label are drawn on top each frame.
+struct WavePreviewState {
+	float riseTime = 0.01f;
+	float fallTime = 0.01f;
+	float curveSigned = 0.f;
+	float dotXNorm = 0.f;
+	float dotYNorm = 0.f;
+	bool dotVisible = false;
+	bool interactiveRecent = false;
+	uint32_t version = 0;
+};
+
+struct WavePreviewCurve : Widget {
+	static constexpr int POINT_COUNT = 320;
+	static constexpr float WAVE_LINE_WIDTH = 1.4f;
+	static constexpr float WAVE_EDGE_PAD = 1.0f;
+	std::array<Vec, POINT_COUNT> points {};
+	bool pointsValid = false;
+
+	float drawPad() const {
+		return 0.5f * WAVE_LINE_WIDTH + WAVE_EDGE_PAD;
+	}
+
+	void rebuildPoints(float riseTime, float fallTime, float curveSigned) {
+		float w = std::max(box.size.x, 1.f);
+		float h = std::max(box.size.y, 1.f);
+		float left = drawPad();
+		float top = drawPad();
+		float right = std::max(left + 1.f, w - drawPad());
+		float bottom = std::max(top + 1.f, h - drawPad());
+		float drawW = right - left;
+		float drawH = bottom - top;
+		// The preview always shows exactly one full rise+fall cycle across widget width.
+		float totalTime = std::max(riseTime + fallTime, 1e-6f);
+		float riseRatio = riseTime / totalTime;
+		float peakX = left + riseRatio * drawW;
+		float riseWidth = std::max(peakX - left, 1e-4f);
+		float fallWidth = std::max(right - peakX, 1e-4f);
+		const segment_curve::SegmentLutPair& luts = segment_curve::sharedSegmentLuts(curveSigned);
+
+		for (int i = 0; i < POINT_COUNT; ++i) {
+			float xNorm = float(i) / float(POINT_COUNT - 1);
+			float x = left + xNorm * drawW;
+			float v = 0.f;
+			if (x <= peakX) {
+				v = segment_curve::sampleSegmentLut(luts.rise, (x - left) / riseWidth);
+			}
+			else {
+				v = segment_curve::sampleSegmentLut(luts.fall, (x - peakX) / fallWidth);
+			}
+			float y = -1.f + 2.f * v;
+			float py = top + (0.5f - 0.5f * y) * drawH;
+			py = clamp(py, top, bottom);
+			points[i] = Vec(x, py);
+		}
+
+		int peakIndex = int(std::round(riseRatio * float(POINT_COUNT - 1)));
+		peakIndex = std::max(0, std::min(POINT_COUNT - 1, peakIndex));
+		float peakPx = left + (float(peakIndex) / float(POINT_COUNT - 1)) * drawW;
+		points[peakIndex] = Vec(peakPx, top);
+		points.front() = Vec(left, bottom);
+		points.back() = Vec(right, bottom);
+		pointsValid = true;
+	}
+
+	// Keeps the dot glued to the rendered waveform by sampling the polyline
+	// instead of a separately published y.
+	Vec pointAt(float xNorm) const {
+		float w = std::max(box.size.x, 1.f);
+		float left = drawPad();
+		float right = std::max(left + 1.f, w - drawPad());
+		xNorm = clamp(xNorm, 0.f, 1.f);
+		float idx = xNorm * float(POINT_COUNT - 1);
+		int i0 = clamp(int(std::floor(idx)), 0, POINT_COUNT - 1);
+		int i1 = std::min(i0 + 1, POINT_COUNT - 1);
+		float f = idx - float(i0);
+		return Vec(left + xNorm * (right - left), points[i0].y + (points[i1].y - points[i0].y) * f);
+	}
+
+	void draw(const DrawArgs& args) override {
+		if (!pointsValid) {
+			return;
+		}
+		nvgBeginPath(args.vg);
+		nvgMoveTo(args.vg, points[0].x, points[0].y);
+		for (int i = 1; i < POINT_COUNT; ++i) {
+			nvgLineTo(args.vg, points[i].x, points[i].y);
+		}
+		nvgStrokeColor(args.vg, nvgRGBA(230, 230, 220, 255));
+		nvgStrokeWidth(args.vg, WAVE_LINE_WIDTH);
+		nvgLineCap(args.vg, NVG_BUTT);
+		nvgLineJoin(args.vg, NVG_ROUND);
+		nvgStroke(args.vg);
+	}
+};
+
+struct WavePreviewWidget : Widget {
+	static constexpr float DOT_RADIUS = 2.1f;
+	static constexpr float DOT_SHOW_MAX_HZ = 2.0f;
+	static constexpr float DOT_HIDE_MIN_HZ = 2.4f;
+	static constexpr float LABEL_FONT_SIZE = 11.5f;
+	widget::FramebufferWidget* framebuffer = nullptr;
+	WavePreviewCurve* curve = nullptr;
+	uint32_t lastVersion = 0;
+	float lastFreqHz = 100.f;
+	float dotXNorm = 0.f;
+	bool dotVisible = false;
+
+	WavePreviewWidget() {
+		framebuffer = new widget::FramebufferWidget();
+		curve = new WavePreviewCurve();
+		framebuffer->addChild(curve);
+		addChild(framebuffer);
+	}
+
+	// Fills `state` from the owning module; false when there is none (browser).
+	virtual bool readPreviewState(WavePreviewState& state) = 0;
+
+	void step() override {
+		bool resized = !framebuffer->box.size.equals(box.size);
+		if (resized) {
+			framebuffer->box.size = box.size;
+			curve->box.size = box.size;
+		}
+		Widget::step();
+		WavePreviewState state;
+		if (!readPreviewState(state)) {
+			if (!curve->pointsValid || resized) {
+				curve->rebuildPoints(0.01f, 0.01f, 0.f);
+				framebuffer->setDirty();
+			}
+			return;
+		}
+		dotXNorm = state.dotXNorm;
+		// Displayed frequency reflects the currently effective cycle period.
+		lastFreqHz = 1.f / std::max(state.riseTime + state.fallTime, 1e-6f);
+		if (lastFreqHz >= DOT_HIDE_MIN_HZ) {
+			dotVisible = false;
+		} else if (lastFreqHz <= DOT_SHOW_MAX_HZ) {
+			dotVisible = state.dotVisible;
+		}
+		if (!curve->pointsValid || resized || state.version != lastVersion) {
+			curve->rebuildPoints(state.riseTime, state.fallTime, state.curveSigned);
+			framebuffer->setDirty();
+			lastVersion = state.version;
+		}
+	}
+
+	void draw(const DrawArgs& args) override {
+		Widget::draw(args);
+
+		if (curve->pointsValid && dotVisible) {
+			Vec dot = curve->pointAt(dotXNorm);
+			nvgSave(args.vg);
+			nvgScissor(args.vg, 0.f, 0.f, box.size.x, box.size.y);
+			nvgBeginPath(args.vg);
+			nvgCircle(args.vg, dot.x, dot.y, DOT_RADIUS);
+			nvgFillColor(args.vg, nvgRGBA(255, 232, 72, 255));
+			nvgFill(args.vg);
+			nvgBeginPath(args.vg);
+			nvgCircle(args.vg, dot.x, dot.y, DOT_RADIUS + 0.55f);
+			nvgStrokeWidth(args.vg, 0.9f);
+			nvgStrokeColor(args.vg, nvgRGBA(0, 0, 0, 220));
+			nvgStroke(args.vg);
+			nvgResetScissor(args.vg);
+			nvgRestore(args.vg);
+		}
+
+		char freqText[32];
+		if (lastFreqHz < 1.f) {
+			std::snprintf(freqText, sizeof(freqText), "%4.0f mHz", lastFreqHz * 1000.f);
+		}
+		else if (lastFreqHz >= 1000.f) {
+			std::snprintf(freqText, sizeof(freqText), "%4.2f kHz", lastFreqHz / 1000.f);
+		}
+		else {
+			std::snprintf(freqText, sizeof(freqText), "%5.1f Hz", lastFreqHz);
+		}
+		nvgFontSize(args.vg, LABEL_FONT_SIZE);
+		nvgFontFaceId(args.vg, APP->window->uiFont->handle);
+		nvgFillColor(args.vg, nvgRGBA(255, 255, 255, 255));
+		nvgTextAlign(args.vg, NVG_ALIGN_CENTER | NVG_ALIGN_TOP);
+		// Keep label outside preview box to avoid occluding waveform.
+		nvgText(args.vg, box.size.x * 0.5f, box.size.y + 1.5f, freqText, nullptr);
+	}
+};
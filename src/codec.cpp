@@ -1,11 +1,11 @@
 #include "codec.hpp"
 
-#include "plugin.hpp"
-
 #include <algorithm>
 #include <cctype>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <limits>
 #include <string>
 #include <vector>
@@ -56,6 +56,34 @@ static float decodePcmSample(const uint8_t *src, int bitsPerSample, bool isFloat
   }
 }
 
+// Plain std I/O keeps the codec usable outside Rack (offline render library).
+static bool readWholeFile(const std::string &path, std::vector<uint8_t> *out) {
+  std::ifstream in(path.c_str(), std::ios::binary);
+  if (!in.good()) {
+    return false;
+  }
+  in.seekg(0, std::ios::end);
+  std::streamoff size = in.tellg();
+  if (size < 0) {
+    return false;
+  }
+  in.seekg(0, std::ios::beg);
+  out->resize(size_t(size));
+  if (size > 0) {
+    in.read(reinterpret_cast<char *>(out->data()), size);
+  }
+  return bool(in);
+}
+
+static std::string fileExtension(const std::string &path) {
+  size_t slash = path.find_last_of("/\\");
+  size_t dot = path.find_last_of('.');
+  if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+    return "";
+  }
+  return path.substr(dot);
+}
+
 static bool failWith(const std::string &message, std::string *errorOut) {
   if (errorOut) {
     *errorOut = message;
@@ -63,16 +91,61 @@ static bool failWith(const std::string &message, std::string *errorOut) {
   return false;
 }
 
+static bool seekFile(FILE *file, int64_t offset) {
+#if defined(_WIN32)
+  return _fseeki64(file, offset, SEEK_SET) == 0;
+#else
+  return fseeko(file, off_t(offset), SEEK_SET) == 0;
+#endif
+}
+
+struct WaveFormat {
+  int channels = 0;
+  uint32_t sampleRate = 0;
+  int blockAlign = 0;
+  int bitsPerSample = 0;
+  int bytesPerSample = 0;
+  bool isFloat = false;
+};
+
+static bool parseWaveFormat(const uint8_t *fmtChunk, size_t fmtSize, WaveFormat *format, std::string *errorOut) {
+  if (!fmtChunk || fmtSize < 16) {
+    return failWith("WAV file is missing fmt or data chunk", errorOut);
+  }
+  uint16_t formatTag = readLe16(fmtChunk + 0);
+  format->channels = readLe16(fmtChunk + 2);
+  format->sampleRate = readLe32(fmtChunk + 4);
+  format->blockAlign = readLe16(fmtChunk + 12);
+  format->bitsPerSample = readLe16(fmtChunk + 14);
+  format->isFloat = false;
+  if (formatTag == 3) {
+    format->isFloat = true;
+  } else if (formatTag != 1) {
+    return failWith("Only PCM and 32-bit float WAV files are supported", errorOut);
+  }
+
+  if (format->channels < 1 || format->channels > 2) {
+    return failWith("Only mono and stereo files are supported", errorOut);
+  }
+  if (format->sampleRate == 0 || format->blockAlign == 0 || format->bitsPerSample == 0) {
+    return failWith("WAV format chunk is invalid", errorOut);
+  }
+
+  format->bytesPerSample = (format->bitsPerSample + 7) / 8;
+  if (format->blockAlign < format->channels * format->bytesPerSample) {
+    return failWith("WAV block alignment is invalid", errorOut);
+  }
+  return true;
+}
+
 static bool decodeWaveFile(const std::string &path, DecodedSampleFile *out, std::string *errorOut) {
   if (!out) {
     return false;
   }
 
   std::vector<uint8_t> data;
-  try {
-    data = system::readFile(path);
-  } catch (const std::exception &e) {
-    return failWith(e.what(), errorOut);
+  if (!readWholeFile(path, &data)) {
+    return failWith("Could not read file " + path, errorOut);
   }
 
   if (data.size() < 44) {
@@ -105,33 +178,16 @@ static bool decodeWaveFile(const std::string &path, DecodedSampleFile *out, std:
     offset = payloadOffset + paddedChunkSize;
   }
 
-  if (!fmtChunk || fmtSize < 16 || !dataChunk || dataSize == 0) {
+  if (!dataChunk || dataSize == 0) {
     return failWith("WAV file is missing fmt or data chunk", errorOut);
   }
-
-  uint16_t formatTag = readLe16(fmtChunk + 0);
-  uint16_t channels = readLe16(fmtChunk + 2);
-  uint32_t sampleRate = readLe32(fmtChunk + 4);
-  uint16_t blockAlign = readLe16(fmtChunk + 12);
-  uint16_t bitsPerSample = readLe16(fmtChunk + 14);
-  bool isFloat = false;
-  if (formatTag == 3) {
-    isFloat = true;
-  } else if (formatTag != 1) {
-    return failWith("Only PCM and 32-bit float WAV files are supported", errorOut);
-  }
-
-  if (channels < 1 || channels > 2) {
-    return failWith("Only mono and stereo files are supported", errorOut);
-  }
-  if (sampleRate == 0 || blockAlign == 0 || bitsPerSample == 0) {
-    return failWith("WAV format chunk is invalid", errorOut);
-  }
-
-  int bytesPerSample = (bitsPerSample + 7) / 8;
-  if (blockAlign < channels * bytesPerSample) {
-    return failWith("WAV block alignment is invalid", errorOut);
+  WaveFormat format;
+  if (!parseWaveFormat(fmtChunk, fmtSize, &format, errorOut)) {
+    return false;
   }
+  int channels = format.channels;
+  int blockAlign = format.blockAlign;
+  int bytesPerSample = format.bytesPerSample;
   int frames = int(dataSize / blockAlign);
   if (frames <= 0) {
     return failWith("WAV file contains no sample frames", errorOut);
@@ -146,15 +202,15 @@ static bool decodeWaveFile(const std::string &path, DecodedSampleFile *out, std:
 
   for (int i = 0; i < frames; ++i) {
     const uint8_t *frame = dataChunk + size_t(i) * blockAlign;
-    out->left[i] = decodePcmSample(frame, bitsPerSample, isFloat);
+    out->left[i] = decodePcmSample(frame, format.bitsPerSample, format.isFloat);
     if (channels > 1) {
-      out->right[i] = decodePcmSample(frame + bytesPerSample, bitsPerSample, isFloat);
+      out->right[i] = decodePcmSample(frame + bytesPerSample, format.bitsPerSample, format.isFloat);
     }
   }
 
   out->channels = channels;
   out->frames = frames;
-  out->sampleRate = float(sampleRate);
+  out->sampleRate = float(format.sampleRate);
   out->truncated = false;
   return true;
 }
@@ -234,7 +290,7 @@ bool decodeSampleFile(const std::string &path, DecodedSampleFile *out, std::stri
   }
 
   *out = DecodedSampleFile();
-  std::string ext = system::getExtension(path);
+  std::string ext = fileExtension(path);
   std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)std::tolower(c); });
 
   if (ext == ".wav" || ext == ".wave") {
@@ -253,4 +309,240 @@ bool decodeSampleFile(const std::string &path, DecodedSampleFile *out, std::stri
   return failWith("Unsupported sample format (supported: WAV, FLAC, MP3)", errorOut);
 }
 
+struct SampleStreamReader::Impl {
+  enum Kind { NONE, WAVE, FLAC, MP3 };
+
+  Kind kind = NONE;
+  int channels = 0;
+  float sampleRate = 0.f;
+  int64_t frames = 0;
+  // Next frame the decoder will produce without seeking.
+  int64_t cursor = -1;
+
+  FILE *file = nullptr;
+  WaveFormat wave;
+  int64_t dataOffset = 0;
+  std::vector<uint8_t> raw;
+
+  drflac *flac = nullptr;
+  drmp3 mp3;
+  bool mp3Open = false;
+  std::vector<drmp3_seek_point> mp3SeekPoints;
+  std::vector<float> interleaved;
+
+  bool openWave(const std::string &path, std::string *errorOut) {
+    file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+      return failWith("Could not read file " + path, errorOut);
+    }
+    uint8_t header[12];
+    if (std::fread(header, 1, sizeof(header), file) != sizeof(header)) {
+      return failWith("File is too small to be a WAV file", errorOut);
+    }
+    if (std::memcmp(header, "RIFF", 4) != 0 || std::memcmp(header + 8, "WAVE", 4) != 0) {
+      return failWith("WAV file is missing RIFF/WAVE header", errorOut);
+    }
+
+    std::vector<uint8_t> fmtChunk;
+    int64_t dataSize = 0;
+    int64_t offset = 12;
+    uint8_t chunk[8];
+    while (dataSize == 0 || fmtChunk.empty()) {
+      if (!seekFile(file, offset) || std::fread(chunk, 1, sizeof(chunk), file) != sizeof(chunk)) {
+        break;
+      }
+      uint32_t chunkSize = readLe32(chunk + 4);
+      int64_t payloadOffset = offset + 8;
+      if (std::memcmp(chunk, "fmt ", 4) == 0) {
+        fmtChunk.resize(std::min<size_t>(chunkSize, 64));
+        if (std::fread(fmtChunk.data(), 1, fmtChunk.size(), file) != fmtChunk.size()) {
+          return failWith("WAV file has a truncated chunk", errorOut);
+        }
+      } else if (std::memcmp(chunk, "data", 4) == 0) {
+        dataOffset = payloadOffset;
+        dataSize = chunkSize;
+      }
+      offset = payloadOffset + ((int64_t(chunkSize) + 1) & ~int64_t(1));
+    }
+
+    if (dataSize == 0) {
+      return failWith("WAV file is missing fmt or data chunk", errorOut);
+    }
+    if (!parseWaveFormat(fmtChunk.empty() ? nullptr : fmtChunk.data(), fmtChunk.size(), &wave, errorOut)) {
+      return false;
+    }
+    channels = wave.channels;
+    sampleRate = float(wave.sampleRate);
+    frames = dataSize / wave.blockAlign;
+    if (frames <= 0) {
+      return failWith("WAV file contains no sample frames", errorOut);
+    }
+    kind = WAVE;
+    return true;
+  }
+
+  bool openFlac(const std::string &path, std::string *errorOut) {
+    flac = drflac_open_file(path.c_str(), nullptr);
+    if (!flac) {
+      return failWith("Failed to decode FLAC file", errorOut);
+    }
+    channels = int(flac->channels);
+    sampleRate = float(flac->sampleRate);
+    frames = int64_t(flac->totalPCMFrameCount);
+    kind = FLAC;
+    cursor = 0;
+    return true;
+  }
+
+  bool openMp3(const std::string &path, std::string *errorOut) {
+    if (!drmp3_init_file(&mp3, path.c_str(), nullptr)) {
+      return failWith("Failed to decode MP3 file", errorOut);
+    }
+    mp3Open = true;
+    channels = int(mp3.channels);
+    sampleRate = float(mp3.sampleRate);
+    frames = int64_t(drmp3_get_pcm_frame_count(&mp3));
+    // Roughly one seek point per second keeps a seek within a few MP3 frames
+    // of its target; the index is the only per-length cost of streaming.
+    drmp3_uint32 seekPointCount = drmp3_uint32(std::min<int64_t>(
+        std::max<int64_t>(frames / std::max<int64_t>(int64_t(sampleRate), 1), 1), 1 << 16));
+    mp3SeekPoints.resize(seekPointCount);
+    if (drmp3_calculate_seek_points(&mp3, &seekPointCount, mp3SeekPoints.data())) {
+      mp3SeekPoints.resize(seekPointCount);
+      drmp3_bind_seek_table(&mp3, seekPointCount, mp3SeekPoints.data());
+    } else {
+      mp3SeekPoints.clear();
+    }
+    kind = MP3;
+    cursor = -1;
+    return true;
+  }
+
+  int readWave(int64_t startFrame, int count, float *left, float *right) {
+    if (cursor != startFrame && !seekFile(file, dataOffset + startFrame * wave.blockAlign)) {
+      cursor = -1;
+      return 0;
+    }
+    raw.resize(size_t(count) * size_t(wave.blockAlign));
+    size_t got = std::fread(raw.data(), size_t(wave.blockAlign), size_t(count), file);
+    for (size_t i = 0; i < got; ++i) {
+      const uint8_t *frame = raw.data() + i * size_t(wave.blockAlign);
+      left[i] = decodePcmSample(frame, wave.bitsPerSample, wave.isFloat);
+      if (right) {
+        right[i] = channels > 1 ? decodePcmSample(frame + wave.bytesPerSample, wave.bitsPerSample, wave.isFloat)
+                                : left[i];
+      }
+    }
+    cursor = startFrame + int64_t(got);
+    return int(got);
+  }
+
+  int readDecoded(int64_t startFrame, int count, float *left, float *right) {
+    if (cursor != startFrame) {
+      bool seeked = kind == FLAC ? drflac_seek_to_pcm_frame(flac, drflac_uint64(startFrame)) != 0
+                                 : drmp3_seek_to_pcm_frame(&mp3, drmp3_uint64(startFrame)) != 0;
+      if (!seeked) {
+        cursor = -1;
+        return 0;
+      }
+    }
+    interleaved.resize(size_t(count) * size_t(channels));
+    uint64_t got = kind == FLAC ? uint64_t(drflac_read_pcm_frames_f32(flac, drflac_uint64(count), interleaved.data()))
+                                : uint64_t(drmp3_read_pcm_frames_f32(&mp3, drmp3_uint64(count), interleaved.data()));
+    for (uint64_t i = 0; i < got; ++i) {
+      const float *frame = interleaved.data() + size_t(i) * size_t(channels);
+      left[i] = clampAudio(frame[0]);
+      if (right) {
+        right[i] = channels > 1 ? clampAudio(frame[1]) : left[i];
+      }
+    }
+    cursor = startFrame + int64_t(got);
+    return int(got);
+  }
+
+  void close() {
+    if (file) {
+      std::fclose(file);
+      file = nullptr;
+    }
+    if (flac) {
+      drflac_close(flac);
+      flac = nullptr;
+    }
+    if (mp3Open) {
+      drmp3_uninit(&mp3);
+      mp3Open = false;
+    }
+    mp3SeekPoints.clear();
+    kind = NONE;
+    channels = 0;
+    sampleRate = 0.f;
+    frames = 0;
+    cursor = -1;
+  }
+};
+
+SampleStreamReader::SampleStreamReader() : impl_(new Impl()) {}
+
+SampleStreamReader::~SampleStreamReader() {
+  impl_->close();
+}
+
+bool SampleStreamReader::open(const std::string &path, std::string *errorOut) {
+  impl_->close();
+  std::string ext = fileExtension(path);
+  std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+
+  bool ok = false;
+  if (ext == ".wav" || ext == ".wave") {
+    ok = impl_->openWave(path, errorOut);
+  } else if (ext == ".flac") {
+    ok = impl_->openFlac(path, errorOut);
+  } else if (ext == ".mp3") {
+    ok = impl_->openMp3(path, errorOut);
+  } else {
+    ok = failWith("Unsupported sample format (supported: WAV, FLAC, MP3)", errorOut);
+  }
+  if (ok && (impl_->channels < 1 || impl_->channels > 2)) {
+    ok = failWith("Only mono and stereo files are supported", errorOut);
+  } else if (ok && (impl_->sampleRate <= 0.f || impl_->frames <= 0)) {
+    ok = failWith("Decoded file contains no sample frames", errorOut);
+  }
+  if (!ok) {
+    impl_->close();
+  }
+  return ok;
+}
+
+void SampleStreamReader::close() {
+  impl_->close();
+}
+
+bool SampleStreamReader::isOpen() const {
+  return impl_->kind != Impl::NONE;
+}
+
+int SampleStreamReader::channels() const {
+  return impl_->channels;
+}
+
+float SampleStreamReader::sampleRate() const {
+  return impl_->sampleRate;
+}
+
+int64_t SampleStreamReader::frames() const {
+  return impl_->frames;
+}
+
+int SampleStreamReader::read(int64_t startFrame, int count, float *left, float *right) {
+  if (!isOpen() || !left || startFrame < 0 || startFrame >= impl_->frames || count <= 0) {
+    return 0;
+  }
+  count = int(std::min<int64_t>(count, impl_->frames - startFrame));
+  if (impl_->kind == Impl::WAVE) {
+    return impl_->readWave(startFrame, count, left, right);
+  }
+  return impl_->readDecoded(startFrame, count, left, right);
+}
+
 } // namespace temporaldeck
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -16,4 +18,30 @@ struct DecodedSampleFile {
 
 bool decodeSampleFile(const std::string &path, DecodedSampleFile *out, std::string *errorOut = nullptr);
 
+// Random access to a sample file without decoding all of it. WAV reads go to
+// the data chunk offset directly, FLAC seeks through its seektable and MP3
+// through a seek-point index built once when the file is opened.
+class SampleStreamReader {
+public:
+  SampleStreamReader();
+  ~SampleStreamReader();
+
+  bool open(const std::string &path, std::string *errorOut = nullptr);
+  void close();
+  bool isOpen() const;
+
+  int channels() const;
+  float sampleRate() const;
+  int64_t frames() const;
+
+  // Reads up to `count` frames starting at `startFrame`, deinterleaved and
+  // clamped like decodeSampleFile(). `right` may be null for mono files.
+  // Returns the number of frames read. Contiguous reads skip the seek.
+  int read(int64_t startFrame, int count, float *left, float *right);
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
 } // namespace temporaldeck
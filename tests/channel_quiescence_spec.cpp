@@ -0,0 +1,168 @@
+#include "../src/ChannelQuiescence.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using channel_quiescence::ChannelQuiescence;
+using channel_quiescence::kControlPollDivider;
+using channel_quiescence::kSettleSamples;
+
+struct TestResult {
+  std::string name;
+  bool pass = false;
+  std::string detail;
+};
+
+constexpr float kEps = 1e-4f;
+
+// Feeds settled samples until the channel falls asleep; returns how many it took.
+int settleUntilAsleep(ChannelQuiescence &q, bool signalPatched, int limit) {
+  for (int i = 1; i <= limit; ++i) {
+    q.update(true, true, signalPatched);
+    if (q.quiescent) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+TestResult testSleepsOnlyAfterAFullSettledRun() {
+  ChannelQuiescence q;
+  q.update(false, true, false);
+  int run = settleUntilAsleep(q, false, 4 * kSettleSamples);
+  bool fullRun = run == kSettleSamples + 1;
+
+  ChannelQuiescence restarted;
+  restarted.update(false, true, false);
+  for (int i = 0; i < kSettleSamples - 1; ++i) {
+    restarted.update(true, true, false);
+  }
+  restarted.update(false, true, false);
+  bool restartedAwake = !restarted.quiescent;
+  int restartedRun = settleUntilAsleep(restarted, false, 4 * kSettleSamples);
+
+  ChannelQuiescence disabled;
+  for (int i = 0; i < 4 * kSettleSamples; ++i) {
+    disabled.update(true, false, false);
+  }
+  bool disabledAwake = !disabled.quiescent;
+
+  bool pass = fullRun && restartedAwake && restartedRun == kSettleSamples + 1 && disabledAwake;
+  return {"Sleeps only after a full settled run", pass,
+          "run=" + std::to_string(run) + " restartedRun=" + std::to_string(restartedRun) +
+            " disabledAwake=" + std::to_string(disabledAwake)};
+}
+
+TestResult testImmediateWakeReasons() {
+  auto neverMoved = []() { return false; };
+  int wrongResults = 0;
+
+  // Module-side checks: edges, gates, sleep disabled.
+  ChannelQuiescence edge;
+  settleUntilAsleep(edge, false, 4 * kSettleSamples);
+  wrongResults += edge.poll(true, false, 0.f, 0.f, kEps, neverMoved);
+  wrongResults += edge.quiescent || edge.settleSamplesLeft != kSettleSamples;
+
+  // Patching the signal input while asleep.
+  ChannelQuiescence patched;
+  settleUntilAsleep(patched, false, 4 * kSettleSamples);
+  wrongResults += patched.poll(false, true, 0.f, 0.f, kEps, neverMoved);
+
+  // Unpatching it.
+  ChannelQuiescence unpatched;
+  settleUntilAsleep(unpatched, true, 4 * kSettleSamples);
+  wrongResults += unpatched.poll(false, false, 0.f, 2.f, kEps, neverMoved);
+
+  // A patched signal drifting off the held output; small wobble stays asleep.
+  ChannelQuiescence drift;
+  settleUntilAsleep(drift, true, 4 * kSettleSamples);
+  wrongResults += !drift.poll(false, true, 2.f + 0.5f * kEps, 2.f, kEps, neverMoved);
+  wrongResults += drift.poll(false, true, 2.f + 2.f * kEps, 2.f, kEps, neverMoved);
+
+  // An unpatched signal input never wakes on its (absent) voltage.
+  ChannelQuiescence idle;
+  settleUntilAsleep(idle, false, 4 * kSettleSamples);
+  wrongResults += !idle.poll(false, false, 5.f, 0.f, kEps, neverMoved);
+
+  bool pass = wrongResults == 0;
+  return {"Edges, patch changes and signal drift wake at once", pass, "wrongResults=" + std::to_string(wrongResults)};
+}
+
+TestResult testControlsPolledAtDivider() {
+  ChannelQuiescence q;
+  settleUntilAsleep(q, false, 4 * kSettleSamples);
+  int calls = 0;
+  int polls = 4 * kControlPollDivider;
+  bool stayedAsleep = true;
+  for (int i = 0; i < polls; ++i) {
+    stayedAsleep &= q.poll(false, false, 0.f, 0.f, kEps, [&]() {
+      calls++;
+      return false;
+    });
+  }
+  bool dividedCalls = calls == polls / kControlPollDivider;
+
+  // Immediate wakes skip the control check entirely.
+  int callsOnImmediateWake = 0;
+  ChannelQuiescence immediate;
+  settleUntilAsleep(immediate, false, 4 * kSettleSamples);
+  for (int i = 0; i < kControlPollDivider; ++i) {
+    immediate.poll(true, false, 0.f, 0.f, kEps, [&]() {
+      callsOnImmediateWake++;
+      return false;
+    });
+  }
+
+  // A moved control wakes on the next divider tick and restarts the settle run.
+  ChannelQuiescence moved;
+  settleUntilAsleep(moved, false, 4 * kSettleSamples);
+  int wokeAfter = -1;
+  for (int i = 1; i <= 2 * kControlPollDivider; ++i) {
+    if (!moved.poll(false, false, 0.f, 0.f, kEps, []() { return true; })) {
+      wokeAfter = i;
+      break;
+    }
+  }
+  int resettleRun = settleUntilAsleep(moved, false, 4 * kSettleSamples);
+
+  bool pass = stayedAsleep && dividedCalls && callsOnImmediateWake == 0 && wokeAfter == kControlPollDivider &&
+              resettleRun == kSettleSamples + 1;
+  return {"Controls are polled at the divider and wake restarts settling", pass,
+          "calls=" + std::to_string(calls) + " callsOnImmediateWake=" + std::to_string(callsOnImmediateWake) +
+            " wokeAfter=" + std::to_string(wokeAfter) + " resettleRun=" + std::to_string(resettleRun)};
+}
+
+TestResult testSchmittThresholdsMatchRack() {
+  using channel_quiescence::schmittWouldChange;
+  bool lowSide = !schmittWouldChange(false, 0.99f) && schmittWouldChange(false, 1.f) && schmittWouldChange(false, 10.f);
+  bool highSide = !schmittWouldChange(true, 0.01f) && schmittWouldChange(true, 0.f) && schmittWouldChange(true, -5.f);
+  bool pass = lowSide && highSide;
+  return {"Schmitt thresholds match Rack's trigger", pass,
+          "lowSide=" + std::to_string(lowSide) + " highSide=" + std::to_string(highSide)};
+}
+
+} // namespace
+
+int main() {
+  std::vector<TestResult> tests;
+  tests.push_back(testSleepsOnlyAfterAFullSettledRun());
+  tests.push_back(testImmediateWakeReasons());
+  tests.push_back(testControlsPolledAtDivider());
+  tests.push_back(testSchmittThresholdsMatchRack());
+
+  int failed = 0;
+  std::cout << "Channel Quiescence Spec\n";
+  std::cout << "-----------------------\n";
+  for (const auto &t : tests) {
+    std::cout << (t.pass ? "[PASS] " : "[FAIL] ") << t.name << " :: " << t.detail << "\n";
+    if (!t.pass) {
+      failed++;
+    }
+  }
+  std::cout << "-----------------------\n";
+  std::cout << "Summary: " << (tests.size() - failed) << "/" << tests.size() << " passed\n";
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,171 @@
+#include "../src/ControlAcquisition.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using control_acquisition::ControlBank;
+using control_acquisition::ControlClock;
+using control_acquisition::ControlRamp;
+
+struct TestResult {
+  std::string name;
+  bool pass = false;
+  std::string detail;
+};
+
+uint32_t nextRandom(uint32_t &state) {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+TestResult testClockReadsEveryNthSample() {
+  ControlClock clock;
+  int audioRateReads = 0;
+  for (int i = 0; i < 64; ++i) {
+    audioRateReads += clock.tick();
+  }
+  clock.setDivider(8);
+  int firstRead = -1;
+  int reads = 0;
+  for (int i = 0; i < 64; ++i) {
+    if (clock.tick()) {
+      reads++;
+      if (firstRead < 0) {
+        firstRead = i;
+      }
+    }
+  }
+  clock.setDivider(0);
+  bool clampsToOne = clock.divider == 1 && clock.tick();
+  bool pass = audioRateReads == 64 && reads == 8 && firstRead == 7 && clampsToOne;
+  return {"Clock reads every Nth sample", pass,
+          "audioRateReads=" + std::to_string(audioRateReads) + " reads=" + std::to_string(reads) +
+            " firstRead=" + std::to_string(firstRead) + " clampsToOne=" + std::to_string(clampsToOne)};
+}
+
+TestResult testHysteresisFlagsOnlyRealMoves() {
+  ControlBank<3> bank;
+  bank.setThreshold(0, 1e-3f);
+  bank.setThreshold(1, 1e-3f);
+  bool firstReadingLatches = bank.awaitingReading() && bank.acquire(0, 2.f) && bank.acquire(1, 0.f) && bank.acquire(2, 0.5f);
+  bool allDirty = bank.dirty == 7u && !bank.awaitingReading();
+  bank.clearDirty();
+  // Jitter inside the band never reaches the DSP.
+  uint32_t rng = 0x9e3779b9u;
+  int jitterFlags = 0;
+  for (int i = 0; i < 10000; ++i) {
+    float noise = (float(nextRandom(rng) % 2001) - 1000.f) * 9e-7f;
+    jitterFlags += bank.acquire(0, 2.f + noise);
+  }
+  bool stillLatched = bank.value(0) == 2.f && !bank.anyDirty();
+  // A slow drift moves the latched value in band-sized steps, each flagged once.
+  int driftFlags = 0;
+  int probeMismatches = 0;
+  for (int i = 1; i <= 1000; ++i) {
+    float raw = float(i) * 1e-4f;
+    bool predicted = bank.wouldChange(1, raw);
+    bool moved = bank.acquire(1, raw);
+    probeMismatches += predicted != moved;
+    driftFlags += moved;
+  }
+  bool onlySlotOneDirty = bank.isDirty(1) && !bank.isDirty(0) && !bank.isDirty(2);
+  // A zero threshold flags any change; invalidate() forces the next reading through.
+  bank.clearDirty();
+  bool exactSlot = !bank.acquire(2, 0.5f) && bank.acquire(2, 0.50001f);
+  bank.invalidate();
+  bool forced = bank.acquire(0, bank.value(0)) && bank.isDirty(0);
+  bool pass = firstReadingLatches && allDirty && jitterFlags == 0 && stillLatched && driftFlags >= 90 &&
+              driftFlags <= 100 && probeMismatches == 0 && onlySlotOneDirty && exactSlot && forced;
+  return {"Hysteresis flags only real moves", pass,
+          "jitterFlags=" + std::to_string(jitterFlags) + " driftFlags=" + std::to_string(driftFlags) +
+            " probeMismatches=" + std::to_string(probeMismatches) + " exactSlot=" + std::to_string(exactSlot) +
+            " forced=" + std::to_string(forced)};
+}
+
+TestResult testRampGlidesOntoTheTarget() {
+  ControlRamp ramp;
+  ramp.jump(0.25f);
+  ramp.glide(1.f, 16);
+  float maxStepError = 0.f;
+  float previous = ramp.value;
+  int steps = 0;
+  while (ramp.gliding()) {
+    float v = ramp.advance();
+    maxStepError = std::fmax(maxStepError, std::fabs((v - previous) - 0.75f / 16.f));
+    previous = v;
+    steps++;
+  }
+  bool landsExactly = ramp.value == 1.f && ramp.advance() == 1.f;
+  ramp.glide(0.f, 1);
+  bool shortGlideJumps = ramp.value == 0.f && !ramp.gliding();
+  bool pass = steps == 16 && maxStepError < 1e-6f && landsExactly && shortGlideJumps;
+  return {"Ramp glides onto the target", pass,
+          "steps=" + std::to_string(steps) + " maxStepError=" + std::to_string(maxStepError) +
+            " landsExactly=" + std::to_string(landsExactly) + " shortGlideJumps=" + std::to_string(shortGlideJumps)};
+}
+
+TestResult testControlRateReadingSkipsIdleRecomputes() {
+  // The pattern Proc and Integral Flux run per channel: read a knob and a noisy CV on timing
+  // ticks and recompute the stage time only when one of them moved.
+  const int div = 16;
+  const int samples = 48000;
+  ControlClock clock;
+  clock.setDivider(div);
+  ControlBank<2> bank;
+  bank.setThreshold(0, 1e-4f);
+  bank.setThreshold(1, 1e-3f);
+  uint32_t rng = 0x1234567u;
+  int reads = 0;
+  int recomputes = 0;
+  int recomputesWhileStill = 0;
+  for (int i = 0; i < samples; ++i) {
+    // The knob turns for the first quarter second and then rests; the CV only carries noise.
+    float knob = i < samples / 4 ? float(i) / float(samples) : 0.25f;
+    float cv = 1.f + (float(nextRandom(rng) % 2001) - 1000.f) * 4e-7f;
+    if (!clock.tick() && !bank.awaitingReading()) {
+      continue;
+    }
+    reads++;
+    bank.acquire(0, knob);
+    bank.acquire(1, cv);
+    if (bank.anyDirty()) {
+      bank.clearDirty();
+      recomputes++;
+      recomputesWhileStill += i >= samples / 4 + div;
+    }
+  }
+  bool pass = reads == samples / div + 1 && recomputes <= samples / 4 / div + 1 && recomputesWhileStill == 0;
+  return {"Control-rate reading skips idle recomputes", pass,
+          "reads=" + std::to_string(reads) + " recomputes=" + std::to_string(recomputes) +
+            " recomputesWhileStill=" + std::to_string(recomputesWhileStill)};
+}
+
+} // namespace
+
+int main() {
+  std::vector<TestResult> tests;
+  tests.push_back(testClockReadsEveryNthSample());
+  tests.push_back(testHysteresisFlagsOnlyRealMoves());
+  tests.push_back(testRampGlidesOntoTheTarget());
+  tests.push_back(testControlRateReadingSkipsIdleRecomputes());
+
+  int failed = 0;
+  std::cout << "Control Acquisition Spec\n";
+  std::cout << "------------------------\n";
+  for (const auto &t : tests) {
+    std::cout << (t.pass ? "[PASS] " : "[FAIL] ") << t.name << " :: " << t.detail << "\n";
+    if (!t.pass) {
+      failed++;
+    }
+  }
+  std::cout << "------------------------\n";
+  std::cout << "Summary: " << (tests.size() - failed) << "/" << tests.size() << " passed\n";
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,193 @@
+#include "../src/SegmentCurve.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using segment_curve::SegmentLut;
+using segment_curve::SegmentLutPair;
+using segment_curve::WarpCurve;
+
+struct TestResult {
+  std::string name;
+  bool pass = false;
+  std::string detail;
+};
+
+TestResult testSharedLutMatchesDirectBuild() {
+  int mismatches = 0;
+  bool monotonic = true;
+  const float curves[] = {-1.f, -0.37f, 0.f, 0.004f, 0.5f, 1.f};
+  for (float curve : curves) {
+    const SegmentLutPair &shared = segment_curve::sharedSegmentLuts(curve);
+    float quantized = segment_curve::curveForKey(segment_curve::curveKey(curve));
+    SegmentLut rise;
+    SegmentLut fall;
+    segment_curve::buildSegmentLut(rise, quantized, true);
+    segment_curve::buildSegmentLut(fall, quantized, false);
+    mismatches += std::memcmp(rise.data(), shared.rise.data(), sizeof(float) * rise.size()) != 0;
+    mismatches += std::memcmp(fall.data(), shared.fall.data(), sizeof(float) * fall.size()) != 0;
+    for (int i = 1; i < segment_curve::LUT_SIZE; ++i) {
+      monotonic = monotonic && shared.rise[i] >= shared.rise[i - 1] && shared.fall[i] <= shared.fall[i - 1];
+    }
+  }
+  bool linearExact = segment_curve::curveForKey(segment_curve::curveKey(0.001f)) == 0.f;
+  bool pass = mismatches == 0 && monotonic && linearExact;
+  return {"Shared LUTs match a direct build of the quantized curve", pass,
+          "mismatches=" + std::to_string(mismatches) + " monotonic=" + std::to_string(monotonic)};
+}
+
+TestResult testNearbyCurvesShareOneEntry() {
+  const SegmentLutPair *a = &segment_curve::sharedSegmentLuts(0.25f);
+  const SegmentLutPair *b = &segment_curve::sharedSegmentLuts(0.25f + 0.3f / segment_curve::CURVE_STEPS);
+  const SegmentLutPair *c = &segment_curve::sharedSegmentLuts(0.25f + 1.f / segment_curve::CURVE_STEPS);
+
+  // A cache hit should cost far less than the two RK2 passes it replaces.
+  auto start = std::chrono::steady_clock::now();
+  SegmentLut scratch;
+  for (int i = 0; i < 20; ++i) {
+    segment_curve::buildSegmentLut(scratch, 0.25f, (i & 1) != 0);
+  }
+  double buildNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / 10.0;
+  start = std::chrono::steady_clock::now();
+  float sink = 0.f;
+  for (int i = 0; i < 1000; ++i) {
+    sink += segment_curve::sharedSegmentLuts(0.25f).rise[i & 511];
+  }
+  double hitNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / 1000.0;
+  bool pass = a == b && a != c && hitNs * 20.0 < buildNs && sink > 0.f;
+  return {"Nearby curves share one cache entry", pass,
+          "buildNs=" + std::to_string(buildNs) + " hitNs=" + std::to_string(hitNs)};
+}
+
+TestResult testConcurrentLookupsAgree() {
+  const int threadCount = 4;
+  const SegmentLutPair *seen[threadCount] = {};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t) {
+    threads.emplace_back([t, &seen]() { seen[t] = &segment_curve::sharedSegmentLuts(-0.8125f); });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  bool agree = true;
+  for (int t = 1; t < threadCount; ++t) {
+    agree = agree && seen[t] == seen[0];
+  }
+  return {"Concurrent lookups agree on one entry", agree && seen[0] != nullptr, "agree=" + std::to_string(agree)};
+}
+
+// Reference: RK4 on dx/dp = slopeWarp(x) * scale in double precision, fine enough to be exact at float resolution.
+double integrateLevel(float curveSigned, double scale, double p, int steps) {
+  double x = 0.0;
+  double h = p / double(steps);
+  auto slope = [&](double xi) { return double(segment_curve::slopeWarp(float(xi), curveSigned)) * scale; };
+  for (int i = 0; i < steps; ++i) {
+    double k1 = slope(x);
+    double k2 = slope(x + 0.5 * h * k1);
+    double k3 = slope(x + 0.5 * h * k2);
+    double k4 = slope(x + h * k3);
+    x += h * (k1 + 2.0 * k2 + 2.0 * k3 + k4) / 6.0;
+  }
+  return x;
+}
+
+TestResult testClosedFormMatchesIntegratedCurve() {
+  const float curves[] = {-1.f, -0.5f, -0.01f, 0.f, 0.01f, 0.5f, 1.f};
+  double maxLevelError = 0.0;
+  double maxScaleError = 0.0;
+  double maxRoundTrip = 0.0;
+  for (float curve : curves) {
+    WarpCurve warp = segment_curve::makeWarpCurve(curve);
+    // Exact scale is the integral of 1 / slopeWarp over the segment.
+    double integral = 0.0;
+    const int n = 100000;
+    for (int i = 0; i < n; ++i) {
+      integral += 1.0 / double(segment_curve::slopeWarp((float(i) + 0.5f) / float(n), curve)) / double(n);
+    }
+    maxScaleError = std::fmax(maxScaleError, std::fabs(double(warp.scale) - integral) / integral);
+    for (int i = 0; i <= 20; ++i) {
+      float p = float(i) / 20.f;
+      double reference = integrateLevel(curve, double(warp.scale), double(p), 4000);
+      float level = segment_curve::warpLevel(warp, p);
+      maxLevelError = std::fmax(maxLevelError, std::fabs(double(level) - std::fmin(reference, 1.0)));
+      maxRoundTrip = std::fmax(maxRoundTrip, std::fabs(double(segment_curve::warpTravel(warp, level)) - double(p)));
+    }
+  }
+  bool pass = maxLevelError < 2e-4 && maxScaleError < 1e-4 && maxRoundTrip < 1e-4;
+  return {"Closed form matches the integrated slopeWarp curve", pass,
+          "maxLevelError=" + std::to_string(maxLevelError) + " maxScaleError=" + std::to_string(maxScaleError) +
+            " maxRoundTrip=" + std::to_string(maxRoundTrip)};
+}
+
+TestResult testLargeStepsLandOnTheSameCurve() {
+  // Stepping from the current level by travel is exact, so block size does not change where a
+  // segment lands or when it ends, and the end crossing is known to within the sample.
+  const float curves[] = {-0.8f, 0.8f};
+  double maxDrift = 0.0;
+  double maxCrossingError = 0.0;
+  for (float curve : curves) {
+    WarpCurve warp = segment_curve::makeWarpCurve(curve);
+    const int blocks[] = {1, 7, 64, 333};
+    for (int block : blocks) {
+      const int samples = 1000;
+      const float dp = 1.f / 834.5f;
+      float x = 0.f;
+      int crossedAt = -1;
+      float crossingFraction = 0.f;
+      for (int i = 0; i < samples && crossedAt < 0; i += block) {
+        float step = dp * float(block);
+        float travel = segment_curve::warpTravel(warp, x) + step;
+        x = segment_curve::warpLevel(warp, travel);
+        if (travel >= 1.f) {
+          crossedAt = i;
+          crossingFraction = (1.f - (travel - step)) / step;
+        }
+        else if (i + block <= samples) {
+          double expected = double(segment_curve::warpLevel(warp, dp * float(i + block)));
+          maxDrift = std::fmax(maxDrift, std::fabs(double(x) - expected));
+        }
+      }
+      if (crossedAt >= 0) {
+        double crossingTime = (double(crossedAt) + double(crossingFraction) * double(block)) * double(dp);
+        maxCrossingError = std::fmax(maxCrossingError, std::fabs(crossingTime - 1.0));
+      }
+      else {
+        maxCrossingError = 1.0;
+      }
+    }
+  }
+  bool pass = maxDrift < 1e-4 && maxCrossingError < 1e-4;
+  return {"Large steps land on the same curve and crossing", pass,
+          "maxDrift=" + std::to_string(maxDrift) + " maxCrossingError=" + std::to_string(maxCrossingError)};
+}
+
+} // namespace
+
+int main() {
+  std::vector<TestResult> tests;
+  tests.push_back(testSharedLutMatchesDirectBuild());
+  tests.push_back(testNearbyCurvesShareOneEntry());
+  tests.push_back(testConcurrentLookupsAgree());
+  tests.push_back(testClosedFormMatchesIntegratedCurve());
+  tests.push_back(testLargeStepsLandOnTheSameCurve());
+
+  int failed = 0;
+  std::cout << "Segment Curve Spec\n";
+  std::cout << "------------------\n";
+  for (const auto &t : tests) {
+    std::cout << (t.pass ? "[PASS] " : "[FAIL] ") << t.name << " :: " << t.detail << "\n";
+    if (!t.pass) {
+      failed++;
+    }
+  }
+  std::cout << "------------------\n";
+  std::cout << "Summary: " << (tests.size() - failed) << "/" << tests.size() << " passed\n";
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,218 @@
+#include "../src/SegmentOscillator.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using segment_curve::WarpCurve;
+using segment_oscillator::Frame;
+using segment_oscillator::SegmentOscillator;
+
+struct TestResult {
+  std::string name;
+  bool pass = false;
+  std::string detail;
+};
+
+double naiveLevel(const WarpCurve &curve, double phase, double riseShare) {
+  return phase < riseShare ? segment_curve::warpLevel(curve, float(phase / riseShare))
+                           : segment_curve::warpLevel(curve, float((1.0 - phase) / (1.0 - riseShare)));
+}
+
+TestResult testCycleTracksTheClosedFormCurve() {
+  // Away from corners each frame is the closed-form level two samples late, and every
+  // peak/trough crossing lands where the phase says it should.
+  const float shapes[] = {-0.7f, 0.f, 0.7f};
+  double maxLevelError = 0.0;
+  double maxCrossingError = 0.0;
+  int troughs = 0;
+  for (float shape : shapes) {
+    WarpCurve curve = segment_curve::makeWarpCurve(shape);
+    const double riseShare = 0.3;
+    const double step = 441.3 / 48000.0;
+    SegmentOscillator osc;
+    osc.reset(0.f, 0.f);
+    double phase = 0.0;
+    double lastPeak[segment_oscillator::LATENCY] = {};
+    double lastTrough[segment_oscillator::LATENCY] = {};
+    std::vector<double> expected;
+    expected.assign(segment_oscillator::LATENCY, 0.0);
+    for (int i = 0; i < 4800; ++i) {
+      double start = phase;
+      phase += step;
+      double peakFraction = 0.0;
+      double troughFraction = 0.0;
+      if (start < riseShare && phase >= riseShare) {
+        peakFraction = 1.0 - (phase - riseShare) / step;
+      }
+      if (phase >= 1.0) {
+        troughFraction = 1.0 - (phase - 1.0) / step;
+        phase -= 1.0;
+      }
+      expected.push_back(naiveLevel(curve, phase, riseShare));
+      Frame frame = osc.process(curve, float(riseShare), float(step));
+      bool nearCorner = std::fabs(frame.phase - riseShare) < 3.0 * step || frame.phase < 3.0 * step || frame.phase > 1.0 - 3.0 * step;
+      if (!nearCorner) {
+        maxLevelError = std::fmax(maxLevelError, std::fabs(double(frame.level) - expected[size_t(i)]));
+      }
+      // Frames come out late, so they carry the crossings from LATENCY samples back.
+      maxCrossingError = std::fmax(maxCrossingError, std::fabs(frame.peakFraction - lastPeak[0]));
+      maxCrossingError = std::fmax(maxCrossingError, std::fabs(frame.troughFraction - lastTrough[0]));
+      lastPeak[0] = lastPeak[1];
+      lastTrough[0] = lastTrough[1];
+      lastPeak[1] = peakFraction;
+      lastTrough[1] = troughFraction;
+      troughs += frame.troughFraction > 0.f;
+    }
+  }
+  // 4800 samples at 441.3 Hz is 44.13 cycles per shape.
+  bool pass = maxLevelError < 1e-3 && maxCrossingError < 1e-3 && troughs == 3 * 44;
+  return {"Cycle tracks the closed-form curve and crossings", pass,
+          "maxLevelError=" + std::to_string(maxLevelError) + " maxCrossingError=" + std::to_string(maxCrossingError) +
+            " troughs=" + std::to_string(troughs)};
+}
+
+// Energy away from the true harmonics, relative to the total, for an audio-rate cycle.
+double aliasRatio(bool corrected, float shape, double freq) {
+  const int n = 4096;
+  const double sampleRate = 48000.0;
+  const float riseShare = 0.5f;
+  WarpCurve curve = segment_curve::makeWarpCurve(shape);
+  SegmentOscillator osc;
+  osc.reset(0.f, 0.f);
+  std::vector<double> signal(n);
+  double phase = 0.0;
+  double step = freq / sampleRate;
+  for (int i = 0; i < n + 64; ++i) {
+    double level = 0.0;
+    if (corrected) {
+      level = osc.process(curve, riseShare, float(step)).level;
+    }
+    else {
+      phase += step;
+      phase -= std::floor(phase);
+      level = naiveLevel(curve, phase, riseShare);
+    }
+    if (i >= 64) {
+      signal[size_t(i - 64)] = level;
+    }
+  }
+  double mean = 0.0;
+  for (double v : signal) {
+    mean += v / double(n);
+  }
+  double total = 0.0;
+  double alias = 0.0;
+  for (int k = 1; k < n / 2; ++k) {
+    double re = 0.0;
+    double im = 0.0;
+    for (int i = 0; i < n; ++i) {
+      double w = 0.42 - 0.5 * std::cos(2.0 * M_PI * i / (n - 1)) + 0.08 * std::cos(4.0 * M_PI * i / (n - 1));
+      double angle = -2.0 * M_PI * double(k) * double(i) / double(n);
+      re += (signal[size_t(i)] - mean) * w * std::cos(angle);
+      im += (signal[size_t(i)] - mean) * w * std::sin(angle);
+    }
+    double power = re * re + im * im;
+    double binFreq = double(k) * sampleRate / double(n);
+    double harmonic = std::round(binFreq / freq);
+    bool nearHarmonic = harmonic >= 1.0 && std::fabs(binFreq - harmonic * freq) <= 4.0 * sampleRate / double(n);
+    total += power;
+    alias += nearHarmonic ? 0.0 : power;
+  }
+  return alias / total;
+}
+
+TestResult testCornerCorrectionCutsAliasing() {
+  std::string detail;
+  bool pass = true;
+  const float shapes[] = {-0.6f, 0.f, 0.6f};
+  for (float shape : shapes) {
+    double naive = 10.0 * std::log10(aliasRatio(false, shape, 3456.7));
+    double corrected = 10.0 * std::log10(aliasRatio(true, shape, 3456.7));
+    pass = pass && corrected < naive - 10.0;
+    detail += "shape=" + std::to_string(shape) + " naiveDb=" + std::to_string(naive) +
+              " correctedDb=" + std::to_string(corrected) + " ";
+  }
+  return {"Corner correction cuts audio-rate aliasing", pass, detail};
+}
+
+TestResult testExtremeCurvesStayBoundedUpToTheCeiling() {
+  // Corrections on the steepest curves near Nyquist must not blow the level out of range. The
+  // first few frames are skipped: starting from rest is itself a corner nothing corrects.
+  float low = 0.f;
+  float high = 1.f;
+  const float shapes[] = {-1.f, -0.5f, 0.5f, 1.f};
+  const float rates[] = {1000.f, 5000.f, 12000.f, 20000.f};
+  const float riseShares[] = {0.05f, 0.5f, 0.95f};
+  for (float shape : shapes) {
+    WarpCurve curve = segment_curve::makeWarpCurve(shape);
+    for (float rate : rates) {
+      for (float riseShare : riseShares) {
+        SegmentOscillator osc;
+        osc.reset(0.f, 0.f);
+        for (int i = 0; i < 4800; ++i) {
+          float level = osc.process(curve, riseShare, rate / 48000.f).level;
+          if (i >= 8) {
+            low = std::fmin(low, level);
+            high = std::fmax(high, level);
+          }
+        }
+      }
+    }
+  }
+  bool pass = low > -0.25f && high < 1.25f;
+  return {"Extreme curves stay bounded up to the ceiling", pass,
+          "low=" + std::to_string(low) + " high=" + std::to_string(high)};
+}
+
+TestResult testSixteenVoicesFitTheAudioBudget() {
+  const int voices = 16;
+  const int frames = 48000;
+  WarpCurve curves[voices];
+  SegmentOscillator osc[voices];
+  for (int v = 0; v < voices; ++v) {
+    curves[v] = segment_curve::makeWarpCurve(float(v - 8) / 8.f);
+    osc[v].reset(float(v) / float(voices), 0.f);
+  }
+  float sink = 0.f;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < frames; ++i) {
+    for (int v = 0; v < voices; ++v) {
+      sink += osc[v].process(curves[v], 0.25f + 0.03f * float(v), (55.f + 110.f * float(v)) / 48000.f).level;
+    }
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  double nsPerVoice = seconds * 1e9 / double(frames * voices);
+  // One second of 16 voices at 48 kHz should take at most a quarter of a second, leaving the
+  // rest of the realtime budget to the module around it and to a busy machine.
+  bool pass = std::isfinite(sink) && seconds < 0.25;
+  return {"Sixteen voices fit the audio budget", pass,
+          "nsPerVoiceSample=" + std::to_string(nsPerVoice) + " cpuShare=" + std::to_string(seconds)};
+}
+
+} // namespace
+
+int main() {
+  std::vector<TestResult> tests;
+  tests.push_back(testCycleTracksTheClosedFormCurve());
+  tests.push_back(testCornerCorrectionCutsAliasing());
+  tests.push_back(testExtremeCurvesStayBoundedUpToTheCeiling());
+  tests.push_back(testSixteenVoicesFitTheAudioBudget());
+
+  int failed = 0;
+  std::cout << "Segment Oscillator Spec\n";
+  std::cout << "-----------------------\n";
+  for (const auto &t : tests) {
+    std::cout << (t.pass ? "[PASS] " : "[FAIL] ") << t.name << " :: " << t.detail << "\n";
+    if (!t.pass) {
+      failed++;
+    }
+  }
+  std::cout << "-----------------------\n";
+  std::cout << "Summary: " << (tests.size() - failed) << "/" << tests.size() << " passed\n";
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+#include "../src/TemporalDeckBufferSnapshot.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using temporaldeck::RingSnapshotInfo;
+using temporaldeck::TemporalDeckBuffer;
+using temporaldeck::TemporalDeckEngine;
+
+struct TestResult {
+  std::string name;
+  bool pass = false;
+  std::string detail;
+};
+
+std::string tempPath(const char *name) {
+  return std::string("build/tests/") + name;
+}
+
+long fileSize(const std::string &path) {
+  std::ifstream in(path.c_str(), std::ios::binary | std::ios::ate);
+  return in.good() ? long(in.tellg()) : -1;
+}
+
+// Fills a ring past one wrap with a noisy two-tone signal.
+void fillRing(TemporalDeckBuffer *ring, int frames) {
+  uint32_t rng = 0x1234567u;
+  for (int i = 0; i < frames; ++i) {
+    rng = rng * 1664525u + 1013904223u;
+    float noise = (float(rng >> 8) / float(1u << 24) - 0.5f) * 1e-3f;
+    float t = float(i) / ring->sampleRate;
+    ring->write(5.f * std::sin(2.f * 3.14159265f * 110.f * t) + noise,
+                3.f * std::sin(2.f * 3.14159265f * 330.f * t) - noise);
+  }
+}
+
+int countMismatches(const TemporalDeckBuffer &a, const TemporalDeckBuffer &b, int frames) {
+  int mismatches = 0;
+  for (int back = 1; back <= frames; ++back) {
+    int ia = a.wrapIndex(a.writeHead - back);
+    int ib = b.wrapIndex(b.writeHead - back);
+    float la = a.leftSample(ia);
+    float lb = b.leftSample(ib);
+    float ra = a.rightSample(ia);
+    float rb = b.rightSample(ib);
+    if (std::memcmp(&la, &lb, sizeof(float)) != 0 || std::memcmp(&ra, &rb, sizeof(float)) != 0) {
+      mismatches++;
+    }
+  }
+  return mismatches;
+}
+
+TestResult testStereoSnapshotRoundTripIsBitExact() {
+  TemporalDeckBuffer ring;
+  ring.resetForMode(48000.f, TemporalDeckEngine::BUFFER_DURATION_10S, false);
+  fillRing(&ring, ring.size + 48000);
+  const int frames = ring.size - 48000;
+  std::string path = tempPath("snapshot_stereo.tdlb");
+  std::string error;
+  bool wrote = temporaldeck::writeRingSnapshot(path, ring, ring.writeHead, frames,
+                                               TemporalDeckEngine::BUFFER_DURATION_10S, nullptr, &error);
+  TemporalDeckBuffer restored;
+  RingSnapshotInfo info;
+  bool read = wrote && temporaldeck::readRingSnapshot(path, false, &restored, &info, &error);
+  int mismatches = read ? countMismatches(ring, restored, frames) : -1;
+  double ratio = double(fileSize(path)) / (double(frames) * 8.0);
+  bool pass = read && info.frames == frames && restored.filled == frames && restored.mipMapped &&
+              mismatches == 0 && ratio < 0.8;
+  return {"Stereo snapshot round trip is bit-exact and compressed", pass,
+          "mismatches=" + std::to_string(mismatches) + " ratio=" + std::to_string(ratio) + " error=" + error};
+}
+
+TestResult testCompactMonoSnapshotRoundTrip() {
+  TemporalDeckBuffer ring;
+  ring.resetForMode(8000.f, TemporalDeckEngine::BUFFER_DURATION_10MIN_MONO, true);
+  fillRing(&ring, 8000 * 30);
+  const int frames = ring.filled;
+  std::string path = tempPath("snapshot_mono.tdlb");
+  std::string error;
+  bool wrote = temporaldeck::writeRingSnapshot(path, ring, ring.writeHead, frames,
+                                               TemporalDeckEngine::BUFFER_DURATION_10MIN_MONO, nullptr, &error);
+  TemporalDeckBuffer restored;
+  RingSnapshotInfo info;
+  bool read = wrote && temporaldeck::readRingSnapshot(path, true, &restored, &info, &error);
+  int mismatches = read ? countMismatches(ring, restored, frames) : -1;
+  bool pass = read && info.monoStorage && restored.halfStorage && restored.filled == frames && mismatches == 0;
+  return {"Compact mono snapshot round trip is bit-exact", pass,
+          "mismatches=" + std::to_string(mismatches) + " filled=" + std::to_string(restored.filled) + " error=" + error};
+}
+
+TestResult testAbandonedAndTruncatedSnapshots() {
+  TemporalDeckBuffer ring;
+  ring.resetForMode(48000.f, TemporalDeckEngine::BUFFER_DURATION_10S, false);
+  fillRing(&ring, 96000);
+  std::string path = tempPath("snapshot_abandon.tdlb");
+  std::remove(path.c_str());
+  std::string abandonError;
+  bool abandoned = !temporaldeck::writeRingSnapshot(path, ring, ring.writeHead, 96000,
+                                                    TemporalDeckEngine::BUFFER_DURATION_10S,
+                                                    [](int done) { return done < 10000; }, &abandonError);
+  bool noFileLeft = fileSize(path) < 0 && fileSize(path + ".tmp") < 0;
+
+  temporaldeck::writeRingSnapshot(path, ring, ring.writeHead, 96000, TemporalDeckEngine::BUFFER_DURATION_10S,
+                                  nullptr);
+  std::vector<char> bytes(size_t(std::max(0l, fileSize(path))));
+  {
+    std::ifstream in(path.c_str(), std::ios::binary);
+    in.read(bytes.data(), std::streamsize(bytes.size()));
+  }
+  {
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), std::streamsize(bytes.size() / 2));
+  }
+  TemporalDeckBuffer restored;
+  std::string truncatedError;
+  bool rejected = !temporaldeck::readRingSnapshot(path, false, &restored, nullptr, &truncatedError);
+  bool pass = abandoned && noFileLeft && rejected && truncatedError == "Truncated snapshot";
+  return {"Abandoned writes leave nothing; truncated snapshots are rejected", pass,
+          "abandonError='" + abandonError + "' truncatedError='" + truncatedError + "'"};
+}
+
+} // namespace
+
+int main() {
+  std::vector<TestResult> tests;
+  tests.push_back(testStereoSnapshotRoundTripIsBitExact());
+  tests.push_back(testCompactMonoSnapshotRoundTrip());
+  tests.push_back(testAbandonedAndTruncatedSnapshots());
+
+  int failed = 0;
+  std::cout << "TemporalDeck Buffer Snapshot Spec\n";
+  std::cout << "---------------------------------\n";
+  for (const auto &t : tests) {
+    std::cout << (t.pass ? "[PASS] " : "[FAIL] ") << t.name << " :: " << t.detail << "\n";
+    if (!t.pass) {
+      failed++;
+    }
+  }
+  std::cout << "---------------------------------\n";
+  std::cout << "Summary: " << (tests.size() - failed) << "/" << tests.size() << " passed\n";
+  return failed == 0 ? 0 : 1;
+}
@@ -1,10 +1,20 @@
 #include "../src/TemporalDeckEngine.hpp"
 
+#include <chrono>
 #include <cmath>
+#include <cstring>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 namespace {
 
 using Engine = temporaldeck::TemporalDeckEngine;
@@ -13,6 +23,8 @@ struct TestResult {
   std::string name;
   bool pass = false;
   std::string detail;
+  // Set when the host cannot measure what the test is about; neither passes nor fails.
+  bool skipped = false;
 };
 
 Engine::FrameInput makeDefaultInput(float sampleRate) {
@@ -147,6 +159,55 @@ TestResult testSampleLoopWraps() {
             ", autoFreeze=" + (sawAutoFreeze ? "true" : "false")};
 }
 
+TestResult testFixedPointHeadIsDriftFreeOverAnHour() {
+  using temporaldeck::TemporalDeckPosition;
+  const int ringFrames = 601 * 48000;
+  const int64_t steps = int64_t(3600) * 48000;
+  const double speed = 1.37;
+  const int64_t stepRaw = TemporalDeckPosition::rawFrom(speed);
+  TemporalDeckPosition head(1234.5);
+  const int64_t startRaw = head.raw;
+  double doubleHead = 1234.5;
+  for (int64_t i = 0; i < steps; ++i) {
+    head.raw += stepRaw;
+    head.wrap(ringFrames);
+    doubleHead = temporaldeck::TemporalDeckBuffer::wrapPositionIn(doubleHead + speed, ringFrames);
+  }
+  // The fixed-point head lands exactly where one multiply puts it.
+  int64_t expected = (startRaw + steps * stepRaw) % TemporalDeckPosition::span(ringFrames);
+  double doubleDrift = std::fabs(doubleHead - double(head));
+  bool pass = head.raw == expected && head.index() >= 0 && head.index() < ringFrames;
+  return {"Fixed-point head is drift-free over an hour", pass,
+          "raw=" + std::to_string(head.raw) + " expected=" + std::to_string(expected) +
+            " doubleDrift=" + std::to_string(doubleDrift)};
+}
+
+TestResult testLiveLagIsBitStableAcrossRingWraps() {
+  const float sr = 8000.f;
+  Engine engine;
+  engine.reset(sr);
+  auto in = makeDefaultInput(sr);
+  for (int i = 0; i < 20000; ++i) {
+    in.inL = std::sin(0.01f * float(i));
+    engine.process(in);
+  }
+  // A lag with no exact binary form, held through several ring wraps.
+  engine.readHead = engine.buffer.wrapPosition(engine.newestReadablePos() - 3000.1);
+  temporaldeck::TemporalDeckPosition newest(engine.newestReadablePos());
+  const int64_t startLag = newest.distanceBackTo(engine.readHead, engine.buffer.size);
+  const int frames = engine.buffer.size * 3;
+  int changed = 0;
+  for (int i = 0; i < frames; ++i) {
+    in.inL = std::sin(0.01f * float(i));
+    engine.process(in);
+    newest = temporaldeck::TemporalDeckPosition(engine.newestReadablePos());
+    changed += newest.distanceBackTo(engine.readHead, engine.buffer.size) != startLag ? 1 : 0;
+  }
+  bool pass = changed == 0;
+  return {"Live lag is bit-stable across ring wraps", pass,
+          "frames=" + std::to_string(frames) + " changed=" + std::to_string(changed)};
+}
+
 TestResult testLiveFreezeForwardTouchSnapAppliesToReadHead() {
   const float sr = 48000.f;
   Engine engine;
@@ -254,29 +315,1043 @@ TestResult testLiveTouchUiLikeAlternatingScratchRegressionGuard() {
             " maxAbsGap=" + std::to_string(maxAbsGap)};
 }
 
-TestResult testConvertLiveWindowToSampleCapturesRedLimitToNow() {
-  const float sr = 1000.f;
+// Straight per-channel scalar form of the cartridge voicing (pre lane-packing),
+// used as the reference for the stereo stage.
+struct ScalarCartridgeReference {
+  float rumble[2] = {0.f, 0.f};
+  float body[2] = {0.f, 0.f};
+  float air[2] = {0.f, 0.f};
+
+  std::pair<float, float> process(const Engine &e, std::pair<float, float> in, float motionAmount) {
+    const Engine::CartridgeParams &p = e.cachedCartridgeParams;
+    float lpMotionMix = std::min(std::max(motionAmount * p.motionDulling, 0.f), 1.f);
+    float lpCoeff = e.cachedLpCoeffBase + (e.cachedLpCoeffMotion - e.cachedLpCoeffBase) * lpMotionMix;
+    auto channel = [&](int c, float x) {
+      rumble[c] += e.cachedHpCoeff * (x - rumble[c]);
+      float hp = x - rumble[c];
+      body[c] += e.cachedBodyCoeff * (hp - body[c]);
+      air[c] += lpCoeff * (hp - air[c]);
+      float voiced = air[c] * e.cachedAirMixGain + body[c] * e.cachedBodyMixGain;
+      if (e.cachedDriveEnabled) {
+        float sat = Engine::fastTanh(voiced * p.drive) / e.cachedDriveNorm;
+        voiced = voiced + (sat - voiced) * e.cachedSaturationMix;
+      }
+      return voiced;
+    };
+    float l = channel(0, in.first) * e.cachedTiltLeftGain;
+    float r = channel(1, in.second) * e.cachedTiltRightGain;
+    float mixedL = l * (1.f - e.cachedCrossfeed) + r * e.cachedCrossfeed;
+    float mixedR = r * (1.f - e.cachedCrossfeed) + l * e.cachedCrossfeed;
+    return {mixedL * e.cachedMakeupGain, mixedR * e.cachedMakeupGain};
+  }
+};
+
+TestResult testStereoCartridgeStageMatchesScalarReference() {
+  const float sr = 48000.f;
+  const int modes[] = {Engine::CARTRIDGE_M44_7, Engine::CARTRIDGE_CONCORDE_SCRATCH, Engine::CARTRIDGE_680_HP,
+                       Engine::CARTRIDGE_QBERT};
+  float maxErr = 0.f;
+  for (int mode : modes) {
+    Engine engine;
+    engine.reset(sr);
+    engine.cartridgeCharacter = mode;
+    engine.refreshCartridgeCache();
+    ScalarCartridgeReference ref;
+    for (int i = 0; i < 20000; ++i) {
+      std::pair<float, float> x{4.f * std::sin(float(i) * 0.031f), 3.f * std::sin(float(i) * 0.047f + 1.f)};
+      // Motion steps in coarse increments so the lazy coefficient path must track it.
+      float motion = float((i / 2000) % 5) * 0.25f;
+      std::pair<float, float> got = engine.applyCartridgeCharacter(x, motion, true);
+      std::pair<float, float> want = ref.process(engine, x, motion);
+      maxErr = std::max(maxErr, std::max(std::fabs(got.first - want.first), std::fabs(got.second - want.second)));
+    }
+  }
+  bool pass = maxErr <= 1e-5f;
+  return {"Stereo cartridge stage matches scalar reference", pass, "maxErr=" + std::to_string(maxErr)};
+}
+
+// Hann-windowed single-bin magnitude (Goertzel) of x at freqHz.
+double toneMagnitude(const std::vector<float> &x, double freqHz, double sampleRate) {
+  const double w = 2.0 * M_PI * freqHz / sampleRate;
+  const double coeff = 2.0 * std::cos(w);
+  const size_t n = x.size();
+  double s1 = 0.0;
+  double s2 = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    double hann = 0.5 - 0.5 * std::cos(2.0 * M_PI * double(i) / double(n - 1));
+    double s0 = double(x[i]) * hann + coeff * s1 - s2;
+    s2 = s1;
+    s1 = s0;
+  }
+  return std::sqrt(std::max(0.0, s1 * s1 + s2 * s2 - coeff * s1 * s2)) / double(n);
+}
+
+TestResult testHalfbandRoundTripIsDelayedIdentity() {
+  const float sr = 48000.f;
+  const int latency = 2 * temporaldeck::kHalfbandOddTaps - 1;
+  temporaldeck::HalfbandStereoStage stage;
+  std::vector<float> in;
+  std::vector<float> out;
+  float dcOut = 0.f;
+  for (int i = 0; i < 4096; ++i) {
+    // Left carries a 1 kHz tone, right a DC level.
+    float x[2] = {std::sin(2.f * float(M_PI) * 1000.f * float(i) / sr), 0.5f};
+    float a0[2];
+    float a1[2];
+    float y[2];
+    stage.upsample(x, a0, a1);
+    stage.downsample(a0, a1, y);
+    in.push_back(x[0]);
+    out.push_back(y[0]);
+    dcOut = y[1];
+  }
+  float maxErr = 0.f;
+  for (int i = 256; i < 4096; ++i) {
+    maxErr = std::max(maxErr, std::fabs(out[i] - in[i - latency]));
+  }
+  bool pass = maxErr < 2e-3f && std::fabs(dcOut - 0.5f) < 1e-5f;
+  return {"Halfband round trip is a delayed identity in band", pass,
+          "latency=" + std::to_string(latency) + " maxErr=" + std::to_string(maxErr) + " dc=" + std::to_string(dcOut)};
+}
+
+TestResult testOversampledDriveReducesAliasing() {
+  const float sr = 48000.f;
+  const double toneHz = 7000.0;
+  // Odd harmonics 5..11 of 7 kHz sit above Nyquist and fold onto these bins.
+  const double aliasHz[] = {13000.0, 1000.0, 15000.0, 19000.0};
+  auto aliasEnergy = [&](int oversampling, double *fundamental) {
+    Engine engine;
+    engine.reset(sr);
+    engine.cartridgeCharacter = Engine::CARTRIDGE_QBERT;
+    engine.cartridgeOversamplingMode = oversampling;
+    std::vector<float> y;
+    for (int i = 0; i < 16384 + 2048; ++i) {
+      float x = 4.5f * float(std::sin(2.0 * M_PI * toneHz * double(i) / double(sr)));
+      std::pair<float, float> out = engine.applyCartridgeCharacter({x, x}, 0.f, true);
+      if (i >= 2048) {
+        y.push_back(out.first);
+      }
+    }
+    double sum = 0.0;
+    for (double f : aliasHz) {
+      double m = toneMagnitude(y, f, sr);
+      sum += m * m;
+    }
+    *fundamental = toneMagnitude(y, toneHz, sr);
+    return sum;
+  };
+  double fundOff = 0.0;
+  double fund2x = 0.0;
+  double fund4x = 0.0;
+  double off = aliasEnergy(Engine::CARTRIDGE_OVERSAMPLING_OFF, &fundOff);
+  double os2 = aliasEnergy(Engine::CARTRIDGE_OVERSAMPLING_2X, &fund2x);
+  double os4 = aliasEnergy(Engine::CARTRIDGE_OVERSAMPLING_4X, &fund4x);
+  auto db = [](double ratio) { return 10.0 * std::log10(std::max(ratio, 1e-30)); };
+  double gain2x = db(off / os2);
+  double gain4x = db(off / os4);
+  double fundDrift = 20.0 * std::log10(fund4x / fundOff);
+  bool pass = gain2x > 10.0 && gain4x > 40.0 && std::fabs(fundDrift) < 1.0;
+  return {"Oversampled drive reduces aliasing", pass,
+          "alias2x=-" + std::to_string(gain2x) + "dB alias4x=-" + std::to_string(gain4x) +
+            "dB fundamentalDrift=" + std::to_string(fundDrift) + "dB"};
+}
+
+TestResult testOversampledDryBlendStaysAligned() {
+  // Playback (non-scratch) blends the dry input back in; with the wet path
+  // delayed by the oversampler an unaligned dry would comb-filter. A slow tone
+  // should come out at the same level with and without oversampling.
+  const float sr = 48000.f;
+  auto level = [&](int oversampling, double freqHz) {
+    Engine engine;
+    engine.reset(sr);
+    engine.cartridgeCharacter = Engine::CARTRIDGE_M44_7;
+    engine.cartridgeOversamplingMode = oversampling;
+    std::vector<float> y;
+    for (int i = 0; i < 8192 + 2048; ++i) {
+      float x = 0.5f * float(std::sin(2.0 * M_PI * freqHz * double(i) / double(sr)));
+      std::pair<float, float> out = engine.applyCartridgeCharacter({x, x}, 0.f, false);
+      if (i >= 2048) {
+        y.push_back(out.first);
+      }
+    }
+    return toneMagnitude(y, freqHz, sr);
+  };
+  double worstDb = 0.0;
+  for (double f : {500.0, 1600.0, 3200.0, 6000.0}) {
+    for (int mode : {Engine::CARTRIDGE_OVERSAMPLING_2X, Engine::CARTRIDGE_OVERSAMPLING_4X}) {
+      double d = 20.0 * std::log10(level(mode, f) / level(Engine::CARTRIDGE_OVERSAMPLING_OFF, f));
+      worstDb = std::max(worstDb, std::fabs(d));
+    }
+  }
+  bool pass = worstDb < 0.25;
+  return {"Oversampled dry blend stays phase-aligned", pass, "worstLevelDelta=" + std::to_string(worstDb) + "dB"};
+}
+
+TestResult testLofiHissSpectrumIsWhite() {
+  const float sr = 48000.f;
   Engine engine;
   engine.reset(sr);
-  engine.sampleModeEnabled = false;
-  engine.sampleLoaded = false;
+  std::vector<float> left;
+  std::vector<float> right;
+  while (left.size() < (1u << 18)) {
+    engine.lofiBlock.fillHiss();
+    left.insert(left.end(), engine.lofiBlock.hiss[0], engine.lofiBlock.hiss[0] + Engine::kLofiBlockFrames);
+    right.insert(right.end(), engine.lofiBlock.hiss[1], engine.lofiBlock.hiss[1] + Engine::kLofiBlockFrames);
+  }
+  double mean = 0.0;
+  double var = 0.0;
+  double cross = 0.0;
+  for (size_t i = 0; i < left.size(); ++i) {
+    mean += left[i];
+    var += double(left[i]) * left[i];
+    cross += double(left[i]) * right[i];
+  }
+  mean /= double(left.size());
+  var /= double(left.size());
+  double crossCorr = cross / double(left.size()) / var;
+  // Average bin power over four octave-ish bands; white noise keeps them level.
+  const double bandStartsHz[] = {200.0, 2000.0, 8000.0, 16000.0};
+  double bandPower[4] = {0.0, 0.0, 0.0, 0.0};
+  for (int b = 0; b < 4; ++b) {
+    for (int k = 0; k < 32; ++k) {
+      double ml = toneMagnitude(left, bandStartsHz[b] + 61.0 * k, sr);
+      double mr = toneMagnitude(right, bandStartsHz[b] + 61.0 * k, sr);
+      bandPower[b] += ml * ml + mr * mr;
+    }
+  }
+  double spreadDb = 0.0;
+  for (int b = 1; b < 4; ++b) {
+    spreadDb = std::max(spreadDb, std::fabs(10.0 * std::log10(bandPower[b] / bandPower[0])));
+  }
+  bool pass = std::fabs(mean) < 0.01 && std::fabs(var - 1.0 / 3.0) < 0.01 && std::fabs(crossCorr) < 0.02 &&
+              spreadDb < 1.5;
+  return {"LOFI hiss is white, uniform and decorrelated", pass,
+          "mean=" + std::to_string(mean) + " var=" + std::to_string(var) + " lrCorr=" + std::to_string(crossCorr) +
+            " bandSpread=" + std::to_string(spreadDb) + "dB"};
+}
+
+TestResult testLofiCrackleDensityMatchesRate() {
+  // Pops follow the per-sample probability the LOFI voicing has always used
+  // (0.00009 + 0.0002 * motion); count them via envelope jumps.
+  const float sr = 48000.f;
+  const int frames = int(sr) * 30;
+  std::string detail;
+  bool pass = true;
+  for (float motion : {0.f, 1.f}) {
+    Engine engine;
+    engine.reset(sr);
+    engine.cartridgeCharacter = Engine::CARTRIDGE_LOFI;
+    int events = 0;
+    double sumSq = 0.0;
+    for (int i = 0; i < frames; ++i) {
+      float before = engine.lofiCrackleEnv * 0.87f;
+      std::pair<float, float> y = engine.applyCartridgeCharacter({0.f, 0.f}, motion, true);
+      if (engine.lofiCrackleEnv > before + 1e-7f) {
+        events++;
+      }
+      sumSq += double(y.first) * y.first;
+    }
+    double expected = double(frames) * (0.00009 + 0.00020 * motion);
+    double sigma = std::sqrt(expected);
+    double rms = std::sqrt(sumSq / frames);
+    double hissRms = (0.0024 + 0.0018 * motion) / std::sqrt(3.0);
+    bool ok = std::fabs(double(events) - expected) < 4.0 * sigma && rms > hissRms && rms < 3.0 * hissRms;
+    pass = pass && ok;
+    detail += (detail.empty() ? "" : " ") + std::string("motion=") + std::to_string(int(motion)) +
+              " events=" + std::to_string(events) + "/" + std::to_string(int(expected)) +
+              " rms=" + std::to_string(rms);
+  }
+  return {"LOFI crackle density matches scheduled rate", pass, detail};
+}
+
+TestResult testHalfFloatConversionRoundTrip() {
+  // Every finite half must survive half -> float -> half unchanged.
+  int roundTripMismatches = 0;
+  for (uint32_t h = 0; h < 0x10000u; ++h) {
+    if ((h & 0x7C00u) == 0x7C00u) {
+      continue; // Inf/NaN are never stored.
+    }
+    if (temporaldeck::floatToHalf(temporaldeck::halfToFloat(uint16_t(h))) != uint16_t(h)) {
+      roundTripMismatches++;
+    }
+  }
+  // Normal-range values stay within half an ulp (2^-11 relative).
+  float maxRelErr = 0.f;
+  uint32_t rng = 0x1234567u;
+  for (int i = 0; i < 200000; ++i) {
+    rng = rng * 1664525u + 1013904223u;
+    float x = (float(rng >> 8) / float(1 << 24) * 2.f - 1.f) * 12.f;
+    if (std::fabs(x) < 1e-3f) {
+      continue;
+    }
+    float y = temporaldeck::halfToFloat(temporaldeck::floatToHalf(x));
+    maxRelErr = std::max(maxRelErr, std::fabs(y - x) / std::fabs(x));
+  }
+  bool saturates = temporaldeck::halfToFloat(temporaldeck::floatToHalf(1e9f)) == 65504.f &&
+                   temporaldeck::halfToFloat(temporaldeck::floatToHalf(-1e9f)) == -65504.f;
+  bool pass = roundTripMismatches == 0 && maxRelErr <= 1.f / 2048.f && saturates;
+  return {"Half float conversion round trip", pass,
+          "mismatches=" + std::to_string(roundTripMismatches) + " maxRelErr=" + std::to_string(maxRelErr)};
+}
+
+TestResult testCompactBufferNoiseFloor() {
+  // Same program through float and half storage; the difference is the
+  // quantization noise the interpolators see.
+  const float sr = 48000.f;
+  temporaldeck::TemporalDeckBuffer full;
+  temporaldeck::TemporalDeckBuffer compact;
+  full.reset(sr, 2.f, false, false);
+  compact.reset(sr, 2.f, false, true);
+  const int frames = int(sr * 1.5f);
+  for (int i = 0; i < frames; ++i) {
+    float t = float(i) / sr;
+    // Loud left, -50 dB right: binary16 noise tracks the signal level.
+    float l = 5.f * std::sin(2.f * float(M_PI) * 997.f * t) + 2.f * std::sin(2.f * float(M_PI) * 6121.f * t);
+    float r = 0.0158f * std::sin(2.f * float(M_PI) * 211.f * t);
+    full.write(l, r);
+    compact.write(l, r);
+  }
+  double worstSnrDb = 1e9;
+  std::string detail;
+  for (int kernel = 0; kernel < 3; ++kernel) {
+    double sigL = 0.0;
+    double errL = 0.0;
+    double sigR = 0.0;
+    double errR = 0.0;
+    for (double pos = 100.0; pos < double(frames - 100); pos += 0.731) {
+      std::pair<float, float> a;
+      std::pair<float, float> b;
+      if (kernel == 0) {
+        a = full.readCubic(pos);
+        b = compact.readCubic(pos);
+      } else if (kernel == 1) {
+        a = full.readHighQuality(pos);
+        b = compact.readHighQuality(pos);
+      } else {
+        a = full.readSinc(pos);
+        b = compact.readSinc(pos);
+      }
+      sigL += double(a.first) * a.first;
+      errL += double(a.first - b.first) * (a.first - b.first);
+      sigR += double(a.second) * a.second;
+      errR += double(a.second - b.second) * (a.second - b.second);
+    }
+    double snrL = 10.0 * std::log10(sigL / std::max(errL, 1e-30));
+    double snrR = 10.0 * std::log10(sigR / std::max(errR, 1e-30));
+    worstSnrDb = std::min(worstSnrDb, std::min(snrL, snrR));
+    detail += (kernel == 0 ? "cubic" : (kernel == 1 ? " lagrange6" : " sinc")) + std::string("=") +
+              std::to_string(int(std::min(snrL, snrR))) + "dB";
+  }
+
+  // Engine level: 10-minute stereo mode allocates half the bytes.
+  Engine compactEngine;
+  compactEngine.bufferDurationMode = Engine::BUFFER_DURATION_10MIN_STEREO;
+  compactEngine.compactLongBuffers = true;
+  compactEngine.reset(8000.f);
+  Engine floatEngine;
+  floatEngine.bufferDurationMode = Engine::BUFFER_DURATION_10MIN_STEREO;
+  floatEngine.reset(8000.f);
+  size_t compactBytes = compactEngine.buffer.leftHalf.capacity() * sizeof(uint16_t) +
+                        compactEngine.buffer.rightHalf.capacity() * sizeof(uint16_t) +
+                        compactEngine.buffer.left.capacity() * sizeof(float);
+  size_t floatBytes = floatEngine.buffer.left.capacity() * sizeof(float) +
+                      floatEngine.buffer.right.capacity() * sizeof(float);
+  double engineSig = 0.0;
+  double engineErr = 0.0;
+  auto in = makeDefaultInput(8000.f);
+  in.rateKnob = 0.3f; // slower than 1x, so reads land between samples
+  for (int i = 0; i < 16000; ++i) {
+    in.inL = 3.f * std::sin(float(i) * 0.07f);
+    in.inR = 2.f * std::sin(float(i) * 0.031f);
+    Engine::FrameResult a = floatEngine.process(in);
+    Engine::FrameResult b = compactEngine.process(in);
+    engineSig += double(a.outL) * a.outL;
+    engineErr += double(a.outL - b.outL) * (a.outL - b.outL);
+  }
+  double engineSnrDb = 10.0 * std::log10(engineSig / std::max(engineErr, 1e-30));
+  bool halved = compactEngine.buffer.halfStorage && compactBytes * 2 == floatBytes;
+  bool shortModesStayFloat = true;
+  {
+    Engine shortEngine;
+    shortEngine.compactLongBuffers = true;
+    shortEngine.reset(8000.f);
+    shortModesStayFloat = !shortEngine.buffer.halfStorage;
+  }
+  bool pass = worstSnrDb > 65.0 && engineSnrDb > 60.0 && halved && shortModesStayFloat;
+  return {"Compact buffer noise floor and footprint", pass,
+          detail + " engine=" + std::to_string(int(engineSnrDb)) + "dB bytes=" + std::to_string(compactBytes) + "/" +
+            std::to_string(floatBytes)};
+}
+
+TestResult testLiveMipRingsMatchWorkerBuild() {
+  // Streaming levels maintained by write() must equal the zero-phase build
+  // the sample worker runs, index for index, once the decimators catch up.
+  const float sr = 48000.f;
+  temporaldeck::TemporalDeckBuffer ring;
+  ring.reset(sr, 2.f, false, false, true);
+  const int frames = 40000;
+  uint32_t rng = 0x1234567u;
+  for (int i = 0; i < frames; ++i) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    ring.write(float(int32_t(rng)) * 4.6566e-10f, std::sin(float(i) * 0.05f));
+  }
+  temporaldeck::TemporalDeckMipLevels offline;
+  temporaldeck::buildMipLevels(ring.left, ring.right, frames, &offline);
+  double worst = 0.0;
+  bool sizesOk = ring.size % 8 == 0;
+  for (int k = 0; k < temporaldeck::kMipLevels; ++k) {
+    sizesOk = sizesOk && int(ring.mips.left[k].size()) == ring.size >> (k + 1);
+    int settled = (frames >> (k + 1)) - 16;
+    for (int j = 16; j < settled; ++j) {
+      worst = std::max(worst, double(std::fabs(ring.mips.left[k][j] - offline.left[k][j])));
+      worst = std::max(worst, double(std::fabs(ring.mips.right[k][j] - offline.right[k][j])));
+    }
+  }
+  bool pass = sizesOk && worst < 1e-5;
+  return {"Live mip rings match worker-built levels", pass,
+          "size=" + std::to_string(ring.size) + " worstDiff=" + std::to_string(worst)};
+}
 
-  for (int i = 0; i < 10; ++i) {
-    engine.buffer.write(float(i), float(100 + i));
-  }
-
-  bool converted = engine.convertLiveWindowToSample(0.00045f, true);
-  bool sizeOk = engine.sampleFrames == 5;
-  bool endpointsOk = sizeOk && std::fabs(engine.buffer.left[0] - 5.f) <= 1e-6f &&
-                     std::fabs(engine.buffer.left[engine.sampleFrames - 1] - 9.f) <= 1e-6f;
-  bool rightOk = sizeOk && !engine.buffer.monoStorage && std::fabs(engine.buffer.right[0] - 105.f) <= 1e-6f &&
-                 std::fabs(engine.buffer.right[engine.sampleFrames - 1] - 109.f) <= 1e-6f;
-  bool pass = converted && sizeOk && endpointsOk && rightOk && engine.sampleModeEnabled && engine.sampleLoaded &&
-              engine.sampleTransportPlaying;
-  return {"Convert live -> sample captures red-limit window", pass,
-          "converted=" + std::to_string(int(converted)) + " frames=" + std::to_string(engine.sampleFrames) +
-            " firstL=" + std::to_string(engine.buffer.left[0]) +
-            " lastL=" + std::to_string(engine.buffer.left[std::max(0, engine.sampleFrames - 1)])};
+TestResult testMipReadsSuppressFastScratchAliasing() {
+  // 0.2 fs tone plus a 300 Hz tone, read at 3x and 4x. Above 1x everything
+  // the 0.2 fs tone puts out is aliasing; the 300 Hz tone must survive.
+  const float sr = 48000.f;
+  const double highHz = 9600.0;
+  const double lowHz = 300.0;
+  const int n = 8192;
+  Engine live;
+  live.reset(sr);
+  const int frames = int(sr * 3.f);
+  std::vector<float> program(frames);
+  for (int i = 0; i < frames; ++i) {
+    float t = float(i) / sr;
+    program[i] = std::sin(2.f * float(M_PI) * float(highHz) * t) + std::sin(2.f * float(M_PI) * float(lowHz) * t);
+    live.buffer.write(program[i], program[i]);
+  }
+  Engine sample;
+  sample.reset(sr);
+  temporaldeck::TemporalDeckMipLevels mips;
+  temporaldeck::buildMipLevels(program, program, frames, &mips);
+  sample.installPreparedSample(std::vector<float>(program), std::vector<float>(program), frames, false, false, false,
+                               std::move(mips));
+
+  std::string detail;
+  double worstSuppressionDb = 1e9;
+  double worstLowDeltaDb = 0.0;
+  const double speeds[2] = {3.0, 4.0};
+  for (int s = 0; s < 2; ++s) {
+    double speed = speeds[s];
+    double aliasHz = std::fabs(sr - speed * highHz);
+    for (int source = 0; source < 2; ++source) {
+      std::vector<float> base(n);
+      std::vector<float> mip(n);
+      double start = 1000.3;
+      for (int i = 0; i < n; ++i) {
+        double pos = start + speed * double(i);
+        if (source == 0) {
+          base[i] = live.readLiveInterpolatedAt(pos, Engine::INTERP_TIER_SINC, 1.0).first;
+          mip[i] = live.readLiveInterpolatedAt(pos, Engine::INTERP_TIER_SINC, speed).first;
+        } else {
+          base[i] = sample.readSampleBounded(pos, Engine::INTERP_TIER_SINC, double(frames - 1), 1.0).first;
+          mip[i] = sample.readSampleBounded(pos, Engine::INTERP_TIER_SINC, double(frames - 1), speed).first;
+        }
+      }
+      double suppressionDb = 20.0 * std::log10(toneMagnitude(base, aliasHz, sr) /
+                                               std::max(toneMagnitude(mip, aliasHz, sr), 1e-12));
+      double lowDeltaDb = 20.0 * std::log10(toneMagnitude(mip, lowHz * speed, sr) /
+                                            std::max(toneMagnitude(base, lowHz * speed, sr), 1e-12));
+      worstSuppressionDb = std::min(worstSuppressionDb, suppressionDb);
+      worstLowDeltaDb = std::max(worstLowDeltaDb, std::fabs(lowDeltaDb));
+      detail += std::string(detail.empty() ? "" : " ") + (source == 0 ? "live@" : "sample@") +
+                std::to_string(int(speed)) + "x=" + std::to_string(int(suppressionDb)) + "dB";
+    }
+  }
+
+  // Same kernel count at any speed: time one sinc read per frame at 1x and 4x.
+  double ns[2] = {0.0, 0.0};
+  float acc = 0.f;
+  for (int s = 0; s < 2; ++s) {
+    double speed = s == 0 ? 1.0 : 4.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < (1 << 16); ++i) {
+      double pos = 1000.3 + std::fmod(speed * double(i), double(frames - 4000));
+      acc += live.readLiveInterpolatedAt(pos, Engine::INTERP_TIER_SINC, speed).first;
+    }
+    ns[s] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (1 << 16);
+  }
+  bool pass = worstSuppressionDb > 30.0 && worstLowDeltaDb < 0.5 && std::isfinite(acc);
+  return {"Mip reads suppress fast-scratch aliasing", pass,
+          detail + " lowDelta=" + std::to_string(worstLowDeltaDb).substr(0, 5) + "dB ns@1x=" +
+            std::to_string(ns[0]).substr(0, 5) + " ns@4x=" + std::to_string(ns[1]).substr(0, 5)};
+}
+
+TestResult testAutoInterpolationFollowsMotionAndCap() {
+  const float sr = 48000.f;
+  Engine engine;
+  engine.reset(sr);
+  engine.scratchInterpolationMode = Engine::SCRATCH_INTERP_AUTO;
+  bool stationaryLinear = engine.autoInterpolationTierFor(0.0, true) == Engine::INTERP_TIER_LINEAR;
+  bool slowScratchSinc = engine.autoInterpolationTierFor(0.4, true) == Engine::INTERP_TIER_SINC;
+  bool fastScratchLagrange = engine.autoInterpolationTierFor(-5.0, true) == Engine::INTERP_TIER_LAGRANGE6;
+  bool unityCatchCubic = engine.autoInterpolationTierFor(1.005, false) == Engine::INTERP_TIER_CUBIC;
+  engine.autoInterpolationCap = Engine::INTERP_TIER_CUBIC;
+  bool capped = engine.autoInterpolationTierFor(0.4, true) == Engine::INTERP_TIER_CUBIC;
+  engine.autoInterpolationCap = Engine::INTERP_TIER_SINC;
+
+  // Held slow scratch through process(): the reported tier settles on sinc
+  // within one decision block.
+  auto in = makeDefaultInput(sr);
+  for (int i = 0; i < 4800; ++i) {
+    in.inL = std::sin(float(i) * 0.01f);
+    in.inR = in.inL;
+    engine.process(in);
+  }
+  int transportTier = engine.activeInterpolationTier;
+  in.platterTouched = true;
+  in.platterMotionActive = true;
+  in.platterGestureRevision = 1;
+  float lagTarget = 2400.f;
+  for (int i = 0; i < 2 * Engine::kAutoInterpBlockFrames + 256; ++i) {
+    lagTarget += 0.6f; // 0.4x backwards relative to the advancing write head
+    in.platterLagTarget = lagTarget;
+    in.platterGestureVelocity = -0.4f * sr;
+    in.platterGestureRevision++;
+    engine.process(in);
+  }
+  int scratchTier = engine.activeInterpolationTier;
+  bool pass = stationaryLinear && slowScratchSinc && fastScratchLagrange && unityCatchCubic && capped &&
+              transportTier == Engine::INTERP_TIER_CUBIC && scratchTier == Engine::INTERP_TIER_SINC;
+  return {"Auto interpolation follows motion and the CPU cap", pass,
+          "transportTier=" + std::to_string(transportTier) + " scratchTier=" + std::to_string(scratchTier) +
+            " speed=" + std::to_string(engine.mipReadSpeed)};
+}
+
+TestResult testTapHeadsShareOwnerBuffer() {
+  const float sr = 48000.f;
+  Engine reference;
+  Engine owner;
+  Engine sameTap(owner.buffer);
+  Engine slowTap(owner.buffer);
+  reference.reset(sr);
+  owner.reset(sr);
+  sameTap.restartTapOn(owner);
+  slowTap.restartTapOn(owner);
+  auto in = makeDefaultInput(sr);
+  auto slowIn = in;
+  slowIn.rateKnob = 0.25f;
+  float slowSpeed = Engine::baseSpeedFromKnob(slowIn.rateKnob);
+  const int frames = 9600;
+  double maxOwnerDiff = 0.0;
+  double maxSameTapDiff = 0.0;
+  Engine::FrameResult slow;
+  for (int i = 0; i < frames; ++i) {
+    in.inL = std::sin(float(i) * 0.013f);
+    in.inR = std::cos(float(i) * 0.007f);
+    slowIn.inL = in.inL;
+    slowIn.inR = in.inR;
+    auto ref = reference.process(in);
+    auto own = owner.process(in);
+    sameTap.followOwner(owner);
+    auto same = sameTap.process(in);
+    slowTap.followOwner(owner);
+    slow = slowTap.process(slowIn);
+    maxOwnerDiff = std::max(maxOwnerDiff, double(std::fabs(ref.outL - own.outL) + std::fabs(ref.outR - own.outR)));
+    maxSameTapDiff = std::max(maxSameTapDiff, double(std::fabs(own.outL - same.outL)));
+  }
+  // A tap runs after the owner's write, so it may sit one frame nearer NOW.
+  double expectedSlowLag = double(frames) * (1.0 - double(slowSpeed));
+  bool noTapStorage = sameTap.ownedBuffer.size == 0 && slowTap.ownedBuffer.size == 0 &&
+                      sameTap.ownedBuffer.left.empty() && slowTap.ownedBuffer.left.empty();
+  bool slowLagOk = std::fabs(slow.lag - expectedSlowLag) < 0.02 * expectedSlowLag;
+
+  // A streamed sample leaves a one-frame placeholder in the shared buffer, so
+  // the tap must read through the owner's stream, both on restart and when
+  // the stream is swapped under it.
+  const int pageFrames = temporaldeck::kStreamPageFrames;
+  auto makeStream = [&](float value) {
+    std::shared_ptr<temporaldeck::TemporalDeckPageCache> pages = std::make_shared<temporaldeck::TemporalDeckPageCache>();
+    pages->allocate(pageFrames * 4, false);
+    for (int page = 0; page < 2; ++page) {
+      temporaldeck::TemporalDeckPageCache::Slot &slot = pages->slotFor(page);
+      std::fill(slot.left.begin(), slot.left.end(), value);
+      std::fill(slot.right.begin(), slot.right.end(), value);
+      slot.page.store(page);
+    }
+    return pages;
+  };
+  owner.sampleModeEnabled = true;
+  owner.installStreamedSample(makeStream(0.5f), true, false);
+  sameTap.restartTapOn(owner);
+  auto sampleIn = makeDefaultInput(sr);
+  sampleIn.inL = 0.f;
+  sampleIn.inR = 0.f;
+  bool restartShares = sameTap.sampleStream == owner.sampleStream && sameTap.sampleFrames == pageFrames * 4;
+  float tapLevel = 0.f;
+  for (int i = 0; i < 2000; ++i) {
+    owner.process(sampleIn);
+    sameTap.followOwner(owner);
+    tapLevel = sameTap.process(sampleIn).outL;
+  }
+  owner.installStreamedSample(makeStream(0.25f), true, false);
+  owner.process(sampleIn);
+  sameTap.followOwner(owner);
+  bool swapFollowed = sameTap.sampleStream == owner.sampleStream;
+  float swappedLevel = 0.f;
+  for (int i = 0; i < 2000; ++i) {
+    owner.process(sampleIn);
+    sameTap.followOwner(owner);
+    swappedLevel = sameTap.process(sampleIn).outL;
+  }
+  bool streamOk = restartShares && swapFollowed && tapLevel > 0.f && swappedLevel > 0.f && swappedLevel < tapLevel;
+
+  bool pass = noTapStorage && maxOwnerDiff == 0.0 && maxSameTapDiff < 0.05 && slowLagOk && streamOk;
+  return {"Tap read heads share the owner's ring without disturbing it", pass,
+          "ownerDiff=" + std::to_string(maxOwnerDiff) + " sameTapDiff=" + std::to_string(maxSameTapDiff) +
+            " slowLag=" + std::to_string(slow.lag) + " expected=" + std::to_string(expectedSlowLag) +
+            " streamTap=" + std::to_string(tapLevel) + "/" + std::to_string(swappedLevel) +
+            " swapFollowed=" + std::to_string(swapFollowed)};
+}
+
+TestResult testAdoptResampledRingKeepsHistory() {
+  Engine engine;
+  engine.reset(48000.f);
+  auto in = makeDefaultInput(48000.f);
+  for (int i = 0; i < 4800; ++i) {
+    in.inL = 1.f;
+    in.inR = 1.f;
+    engine.process(in);
+  }
+  int oldSize = engine.buffer.size;
+  temporaldeck::TemporalDeckBuffer ring;
+  ring.resetForMode(96000.f, engine.bufferDurationMode, false);
+  for (int i = 0; i < 9600; ++i) {
+    ring.write(0.5f, 0.5f);
+  }
+  engine.adoptResampledRing(&ring);
+  bool swapped = ring.size == oldSize && engine.buffer.sampleRate == 96000.f && engine.sampleRate == 96000.f &&
+                 engine.buffer.filled == 9600;
+  bool atNow = engine.readHead == engine.newestReadablePos();
+
+  // Pull the head back into the adopted history and check it is what was there.
+  in = makeDefaultInput(96000.f);
+  in.inL = 0.f;
+  in.inR = 0.f;
+  in.platterTouched = true;
+  in.platterMotionActive = true;
+  Engine::FrameResult frame;
+  for (int i = 0; i < 4000; ++i) {
+    in.platterLagTarget = 6000.f + float(i);
+    in.platterGestureRevision++;
+    frame = engine.process(in);
+  }
+  bool historyAudible = std::fabs(frame.outL - 0.5f) < 0.05f;
+  bool pass = swapped && atNow && historyAudible;
+  return {"Adopted resampled ring keeps history", pass,
+          "swapped=" + std::to_string(int(swapped)) + " atNow=" + std::to_string(int(atNow)) +
+            " out=" + std::to_string(frame.outL) + " lag=" + std::to_string(frame.lag)};
+}
+
+TestResult testProfilingCountsStagesAndEvents() {
+  Engine engine;
+  engine.reset(48000.f);
+  engine.profilingEnabled = true;
+  auto in = makeDefaultInput(48000.f);
+  in.inL = 0.5f;
+  in.inR = 0.5f;
+  // Fill a little history, scratch back to the oldest audio with slip held,
+  // then release.
+  const int frames = 16000;
+  for (int i = 0; i < frames; ++i) {
+    bool touching = i >= 2400 && i < 12400;
+    in.slipButton = true;
+    in.platterTouched = touching;
+    in.platterMotionActive = touching;
+    if (touching) {
+      // Past the oldest frame: the head settles against the ring's start.
+      in.platterLagTarget = 1e6f;
+      in.platterGestureRevision++;
+    }
+    engine.process(in);
+  }
+  const Engine::Profile &profile = engine.profile;
+  uint64_t reads = 0;
+  for (int tier = 0; tier < Engine::INTERP_TIER_COUNT; ++tier) {
+    reads += profile.counters[Engine::PROFILE_READS_LINEAR + tier];
+  }
+  bool stagesTimed = true;
+  for (int stage = 0; stage < Engine::PROFILE_STAGE_COUNT; ++stage) {
+    stagesTimed = stagesTimed && profile.stageNs[stage] > 0.0;
+  }
+  bool counted = profile.counters[Engine::PROFILE_FRAMES] == uint64_t(frames) && reads == uint64_t(frames) &&
+                 profile.counters[Engine::PROFILE_TIMED_FRAMES] == uint64_t(frames / Engine::kProfileIntervalFrames);
+  // Reads next to the ring's first frame gather across the wrap.
+  bool gathered = profile.counters[Engine::PROFILE_EDGE_GATHERS] > 0;
+  bool slipCounted = profile.counters[Engine::PROFILE_SLIP_RETURNS] >= 1;
+
+  Engine quiet;
+  quiet.reset(48000.f);
+  for (int i = 0; i < 256; ++i) {
+    quiet.process(makeDefaultInput(48000.f));
+  }
+  bool idleWhenOff = quiet.profile.counters[Engine::PROFILE_FRAMES] == 0 && quiet.profile.stageNs[0] == 0.0;
+  bool pass = stagesTimed && counted && gathered && slipCounted && idleWhenOff;
+  return {"Profiling counts stages and events", pass,
+          "timed=" + std::to_string(profile.counters[Engine::PROFILE_TIMED_FRAMES]) +
+            " reads=" + std::to_string(reads) + " gathers=" + std::to_string(profile.counters[Engine::PROFILE_EDGE_GATHERS]) +
+            " slipReturns=" + std::to_string(profile.counters[Engine::PROFILE_SLIP_RETURNS]) +
+            " readNs=" + std::to_string(profile.stageNs[Engine::PROFILE_STAGE_READ] /
+                                        double(std::max<uint64_t>(1, profile.counters[Engine::PROFILE_TIMED_FRAMES])))};
+}
+
+// Seeks snap onto the indexed onset and crossfade from the old position, so
+// leaving a waveform peak does not step the output.
+TestResult testSnappedSampleSeekLandsWithoutClick() {
+  const float sr = 48000.f;
+  const int frames = int(sr * 2.f);
+  const int hit = 60000;
+  std::vector<float> left(frames);
+  for (int i = 0; i < frames; ++i) {
+    float t = float(i) / sr;
+    left[i] = 4.f * std::sin(2.f * float(M_PI) * 100.f * t) * (i < hit - 4800 ? 1.f : 0.f);
+    if (i >= hit) {
+      float th = float(i - hit) / sr;
+      left[i] += 4.f * std::exp(-th / 0.05f) * std::sin(2.f * float(M_PI) * 440.f * th);
+    }
+  }
+  auto run = [&](bool fade, int *landedOut) {
+    Engine engine;
+    engine.reset(sr);
+    engine.installSample(left, left, frames, true, false);
+    engine.sampleModeEnabled = true;
+    engine.sampleTransportPlaying = true;
+    engine.sampleSeekSnap = true;
+    auto in = makeDefaultInput(sr);
+    // Park at a crest of the 100 Hz tone (every 480 frames from 120).
+    engine.samplePlayhead = engine.readHead = 120.0 + 480.0 * 20.0;
+    float prev = engine.process(in).outL;
+    engine.seekSampleTo(double(hit + 1500), engine.sampleWindowEndFor(in.bufferKnob));
+    *landedOut = int(engine.samplePlayhead);
+    if (!fade) {
+      engine.seekFadeRemaining = 0;
+    }
+    float maxStep = 0.f;
+    for (int i = 0; i < 512; ++i) {
+      float out = engine.process(in).outL;
+      maxStep = std::max(maxStep, std::fabs(out - prev));
+      prev = out;
+    }
+    return maxStep;
+  };
+  int landed = -1;
+  int landedHard = -1;
+  float fadedStep = run(true, &landed);
+  float hardStep = run(false, &landedHard);
+  // 440 Hz at 4 V moves at most ~0.23 V per frame.
+  bool snapped = std::abs(landed - hit) <= 8;
+  bool pass = snapped && fadedStep < 0.4f && hardStep > 2.f;
+  return {"Snapped sample seek lands without a click", pass,
+          "landed=" + std::to_string(landed) + " fadedStep=" + std::to_string(fadedStep) +
+            " hardStep=" + std::to_string(hardStep)};
+}
+
+// Interior reads skip the wrap/clamp gather; both paths must agree bit for
+// bit. lastIndex = -1 forces the gather for the reference.
+TestResult testInteriorReadsSkipEdgeGather() {
+  using Buffer = temporaldeck::TemporalDeckBuffer;
+  const int frames = 1 << 16;
+  std::vector<float> left(frames);
+  std::vector<float> right(frames);
+  for (int i = 0; i < frames; ++i) {
+    left[i] = std::sin(0.0123f * float(i)) + 0.3f * std::sin(0.731f * float(i));
+    right[i] = std::cos(0.0071f * float(i));
+  }
+  Buffer::FloatFrames view = {left.data(), right.data(), frames};
+  Engine::SampleIndex loop = {frames - 1, true, nullptr};
+  Engine::SampleIndex clamped = {frames - 1, false, nullptr};
+  const double probes[] = {0.37, 2.5, 6.81, 500.25, double(frames) - 7.3, double(frames) - 1.6, double(frames) - 0.2};
+  int mismatches = 0;
+  for (int tier = 0; tier < Engine::INTERP_TIER_COUNT; ++tier) {
+    for (double pos : probes) {
+      for (int m = 0; m < 2; ++m) {
+        const Engine::SampleIndex &map = m == 0 ? loop : clamped;
+        std::pair<float, float> fast = Buffer::readTierAt(view, pos, tier, frames - 1, map);
+        std::pair<float, float> ref = Buffer::readTierAt(view, pos, tier, -1, map);
+        mismatches += (fast.first != ref.first || fast.second != ref.second) ? 1 : 0;
+      }
+    }
+  }
+
+  // Timings are informational only: the two paths are close enough that
+  // machine noise decides the order, so only bit-exactness gates.
+  const int reads = 1 << 18;
+  std::string detail = "mismatches=" + std::to_string(mismatches);
+  float acc = 0.f;
+  const int timedTiers[] = {Engine::INTERP_TIER_CUBIC, Engine::INTERP_TIER_LAGRANGE6, Engine::INTERP_TIER_SINC};
+  const char *tierNames[] = {"linear", "cubic", "lagrange6", "sinc"};
+  for (int tier : timedTiers) {
+    double ns[2] = {0.0, 0.0};
+    for (int path = 0; path < 2; ++path) {
+      int lastIndex = path == 0 ? frames - 1 : -1;
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < reads; ++i) {
+        double pos = 1000.3 + std::fmod(0.731 * double(i), double(frames - 2000));
+        acc += Buffer::readTierAt(view, pos, tier, lastIndex, loop).first;
+      }
+      ns[path] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / reads;
+    }
+    detail += std::string(" ") + tierNames[tier] + "=" +
+              std::to_string(ns[0]).substr(0, 5) + "ns vs gather " + std::to_string(ns[1]).substr(0, 5) + "ns";
+  }
+  return {"Interior reads skip the edge gather", mismatches == 0 && std::isfinite(acc), detail};
+}
+
+TestResult testCartridgeStageBenchmark() {
+  const float sr = 48000.f;
+  const int frames = 1 << 20;
+  std::string detail;
+  bool finite = true;
+  // Every cartridge at 1x, then M44 with the 2x and 4x drive oversampler.
+  for (int run = 0; run < Engine::CARTRIDGE_COUNT + 2; ++run) {
+    int mode = run < Engine::CARTRIDGE_COUNT ? run : int(Engine::CARTRIDGE_M44_7);
+    int oversampling = run < Engine::CARTRIDGE_COUNT ? 0 : run - Engine::CARTRIDGE_COUNT + 1;
+    Engine engine;
+    engine.reset(sr);
+    engine.cartridgeCharacter = mode;
+    engine.cartridgeOversamplingMode = oversampling;
+    float acc = 0.f;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+      std::pair<float, float> x{float((i * 37) % 200) * 0.02f - 2.f, float((i * 53) % 180) * 0.02f - 1.8f};
+      float motion = float((i >> 12) & 3) * 0.3f;
+      std::pair<float, float> y = engine.applyCartridgeCharacter(x, motion, (i & 1) != 0);
+      acc += y.first + y.second;
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / frames;
+    finite = finite && std::isfinite(acc);
+    std::string label = std::to_string(mode) + (oversampling > 0 ? "@" + std::to_string(1 << oversampling) + "x" : "");
+    detail += (run == 0 ? "" : " ") + label + "=" + std::to_string(ns).substr(0, 5) + "ns";
+  }
+  return {"Cartridge stage benchmark (ns/frame per mode)", finite, detail};
+}
+
+#ifdef __linux__
+constexpr int kCacheL1D = PERF_COUNT_HW_CACHE_L1D;
+constexpr int kCacheLastLevel = PERF_COUNT_HW_CACHE_LL;
+#else
+constexpr int kCacheL1D = 0;
+constexpr int kCacheLastLevel = 0;
+#endif
+
+// Hardware cache read-miss counter for this thread. Reads -1 where the
+// platform or a sandbox does not expose one.
+struct CacheMissCounter {
+  int fd = -1;
+
+  explicit CacheMissCounter(int cache) {
+#ifdef __linux__
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = uint64_t(cache) | (uint64_t(PERF_COUNT_HW_CACHE_OP_READ) << 8) |
+                  (uint64_t(PERF_COUNT_HW_CACHE_RESULT_MISS) << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd = int(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+    (void)cache;
+#endif
+  }
+
+  ~CacheMissCounter() {
+#ifdef __linux__
+    if (fd >= 0) {
+      close(fd);
+    }
+#endif
+  }
+
+  void start() {
+#ifdef __linux__
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  long long stop() {
+#ifdef __linux__
+    long long count = -1;
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+      if (read(fd, &count, sizeof(count)) != ssize_t(sizeof(count))) {
+        count = -1;
+      }
+    }
+    return count;
+#else
+    return -1;
+#endif
+  }
+};
+
+// Byte ranges of the per-frame engine fields before the hot-to-cold reorder,
+// taken with offsetof on x86-64 (the engine was then 5624 bytes). They give the
+// benchmark its baseline: the same fields, spread as they used to be.
+struct HotRange {
+  size_t offset;
+  size_t bytes;
+};
+const HotRange kInterleavedHotRanges[] = {{2620, 28}, {2736, 1},   {2760, 65},  {2940, 1},
+                                          {2952, 184}, {4956, 16}, {5384, 236}};
+constexpr size_t kInterleavedEngineBytes = 5624;
+
+struct HotStateRun {
+  int lines = 0;
+  int words = 0;
+  double ns = 0.0;
+  long long l1Misses = -1;
+  long long llcMisses = -1;
+};
+
+// Steps `decks` objects of `objectBytes` frame by frame, updating every word
+// in `ranges` once per frame, and reports the fastest of a few passes.
+HotStateRun runHotStateLayout(const HotRange *ranges, int rangeCount, size_t objectBytes, int decks, int frames) {
+  HotStateRun run;
+  std::vector<bool> touched(objectBytes / 64 + 1, false);
+  std::vector<std::pair<int, int>> words;
+  for (int r = 0; r < rangeCount; ++r) {
+    words.emplace_back(int(ranges[r].offset / 4), int((ranges[r].offset + ranges[r].bytes + 3) / 4));
+    run.words += words.back().second - words.back().first;
+    for (size_t b = ranges[r].offset; b < ranges[r].offset + ranges[r].bytes; ++b) {
+      touched[b / 64] = true;
+    }
+  }
+  for (bool line : touched) {
+    run.lines += line ? 1 : 0;
+  }
+  std::vector<std::unique_ptr<float[]>> states;
+  for (int d = 0; d < decks; ++d) {
+    states.emplace_back(new float[objectBytes / 4 + 1]());
+  }
+  float acc = 0.f;
+  auto step = [&](int i) {
+    float x = std::sin(0.01f * float(i));
+    for (auto &state : states) {
+      float *s = state.get();
+      for (const auto &w : words) {
+        for (int k = w.first; k < w.second; ++k) {
+          s[k] = s[k] * 0.999f + x;
+        }
+      }
+      acc += s[words.front().first];
+    }
+  };
+  for (int i = 0; i < 400; ++i) {
+    step(i);
+  }
+  run.ns = 1e30;
+  for (int pass = 0; pass < 3; ++pass) {
+    CacheMissCounter l1(kCacheL1D);
+    CacheMissCounter llc(kCacheLastLevel);
+    l1.start();
+    llc.start();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+      step(i);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                (double(frames) * decks);
+    long long l1Misses = l1.stop();
+    long long llcMisses = llc.stop();
+    if (ns < run.ns) {
+      run.ns = ns;
+      run.l1Misses = l1Misses;
+      run.llcMisses = llcMisses;
+    }
+  }
+  if (!std::isfinite(acc)) {
+    run.ns = -1.0;
+  }
+  return run;
+}
+
+TestResult testMultiDeckHotStateBenchmark() {
+  // Many decks stepped frame by frame, as Rack runs them, so each engine's
+  // per-frame state has to come back into cache on every frame.
+  const float sr = 8000.f;
+  const int decks = 64;
+  const int frames = 4000;
+  std::vector<std::unique_ptr<Engine>> engines;
+  for (int d = 0; d < decks; ++d) {
+    engines.emplace_back(new Engine());
+    engines.back()->reset(sr);
+    engines.back()->cartridgeCharacter = d % Engine::CARTRIDGE_COUNT;
+  }
+  // The hot block runs from the first field after the ring reference up to
+  // the owned ring.
+  const Engine &probe = *engines.front();
+  const char *base = reinterpret_cast<const char *>(&probe);
+  size_t hotStart = size_t(reinterpret_cast<const char *>(&probe.readHead) - base);
+  size_t hotBytes = size_t(reinterpret_cast<const char *>(&probe.ownedBuffer) - base);
+  int hotLines = int((hotBytes + 63) / 64);
+
+  auto in = makeDefaultInput(sr);
+  for (int i = 0; i < 400; ++i) {
+    for (auto &engine : engines) {
+      engine->process(in);
+    }
+  }
+  float acc = 0.f;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < frames; ++i) {
+    in.inL = std::sin(0.01f * float(i));
+    in.inR = in.inL;
+    for (auto &engine : engines) {
+      acc += engine->process(in).outL;
+    }
+  }
+  double engineNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                    (double(frames) * decks);
+
+  // The same per-frame fields in the old interleaved order and in the packed
+  // block, measured in this run.
+  const HotRange packedRanges[] = {{hotStart, hotBytes - hotStart}};
+  const int layoutFrames = 20000;
+  HotStateRun interleaved = runHotStateLayout(kInterleavedHotRanges, int(sizeof(kInterleavedHotRanges) / sizeof(HotRange)),
+                                              kInterleavedEngineBytes, decks, layoutFrames);
+  HotStateRun packed = runHotStateLayout(packedRanges, 1, sizeof(Engine), decks, layoutFrames);
+
+  auto perDeckFrame = [&](long long misses) {
+    return std::to_string(double(misses) / (double(layoutFrames) * decks)).substr(0, 5);
+  };
+  std::string detail = "decks=" + std::to_string(decks) + " hotBytes=" + std::to_string(hotBytes) +
+                       " hotLines=" + std::to_string(hotLines) + " engine ns/frame/deck=" +
+                       std::to_string(engineNs).substr(0, 6) + " lines interleaved=" +
+                       std::to_string(interleaved.lines) + " packed=" + std::to_string(packed.lines) + " words interleaved=" +
+                       std::to_string(interleaved.words) + " packed=" + std::to_string(packed.words) +
+                       " ns/frame/deck interleaved=" + std::to_string(interleaved.ns).substr(0, 5) +
+                       " packed=" + std::to_string(packed.ns).substr(0, 5) + " (" +
+                       std::to_string(100.0 * (packed.ns - interleaved.ns) / interleaved.ns).substr(0, 5) + "%)";
+  bool layoutOk = std::isfinite(acc) && engineNs > 0.0 && interleaved.ns > 0.0 && packed.ns > 0.0 &&
+                  hotLines <= 9 && packed.lines < interleaved.lines;
+  bool countersAvailable = interleaved.l1Misses >= 0 && packed.l1Misses >= 0 && interleaved.llcMisses >= 0 &&
+                           packed.llcMisses >= 0;
+  TestResult result{"Multi-deck hot state benchmark", layoutOk, detail};
+  if (!countersAvailable) {
+    // Without miss counts the benchmark cannot show the reduction it exists for.
+    result.skipped = layoutOk;
+    result.detail += " cache counters unavailable";
+    return result;
+  }
+  result.detail += " L1D misses/frame/deck interleaved=" + perDeckFrame(interleaved.l1Misses) +
+                   " packed=" + perDeckFrame(packed.l1Misses) + " LLC misses/frame/deck interleaved=" +
+                   perDeckFrame(interleaved.llcMisses) + " packed=" + perDeckFrame(packed.llcMisses);
+  return result;
 }
 
 } // namespace
@@ -289,18 +1364,44 @@ int main() {
   tests.push_back(testSampleLoopWraps());
   tests.push_back(testLiveFreezeForwardTouchSnapAppliesToReadHead());
   tests.push_back(testLiveTouchUiLikeAlternatingScratchRegressionGuard());
-  tests.push_back(testConvertLiveWindowToSampleCapturesRedLimitToNow());
+  tests.push_back(testStereoCartridgeStageMatchesScalarReference());
+  tests.push_back(testHalfbandRoundTripIsDelayedIdentity());
+  tests.push_back(testOversampledDriveReducesAliasing());
+  tests.push_back(testOversampledDryBlendStaysAligned());
+  tests.push_back(testLofiHissSpectrumIsWhite());
+  tests.push_back(testLofiCrackleDensityMatchesRate());
+  tests.push_back(testHalfFloatConversionRoundTrip());
+  tests.push_back(testCompactBufferNoiseFloor());
+  tests.push_back(testLiveMipRingsMatchWorkerBuild());
+  tests.push_back(testMipReadsSuppressFastScratchAliasing());
+  tests.push_back(testAutoInterpolationFollowsMotionAndCap());
+  tests.push_back(testTapHeadsShareOwnerBuffer());
+  tests.push_back(testAdoptResampledRingKeepsHistory());
+  tests.push_back(testInteriorReadsSkipEdgeGather());
+  tests.push_back(testSnappedSampleSeekLandsWithoutClick());
+  tests.push_back(testProfilingCountsStagesAndEvents());
+  tests.push_back(testCartridgeStageBenchmark());
+  tests.push_back(testFixedPointHeadIsDriftFreeOverAnHour());
+  tests.push_back(testLiveLagIsBitStableAcrossRingWraps());
+  tests.push_back(testMultiDeckHotStateBenchmark());
 
   int failed = 0;
+  int skipped = 0;
   std::cout << "TemporalDeck Engine Spec\n";
   std::cout << "------------------------\n";
   for (const auto &t : tests) {
-    std::cout << (t.pass ? "[PASS] " : "[FAIL] ") << t.name << " :: " << t.detail << "\n";
-    if (!t.pass) {
+    std::cout << (t.skipped ? "[SKIP] " : t.pass ? "[PASS] " : "[FAIL] ") << t.name << " :: " << t.detail << "\n";
+    if (t.skipped) {
+      skipped++;
+    } else if (!t.pass) {
       failed++;
     }
   }
   std::cout << "------------------------\n";
-  std::cout << "Summary: " << (tests.size() - failed) << "/" << tests.size() << " passed\n";
+  std::cout << "Summary: " << (tests.size() - failed - skipped) << "/" << tests.size() << " passed";
+  if (skipped > 0) {
+    std::cout << ", " << skipped << " skipped";
+  }
+  std::cout << "\n";
   return failed == 0 ? 0 : 1;
 }
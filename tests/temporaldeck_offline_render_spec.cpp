@@ -0,0 +1,152 @@
+#include "../tools/temporaldeck_offline_render.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Engine = temporaldeck::TemporalDeckEngine;
+using temporaldeck_offline::AutomationEvent;
+using temporaldeck_offline::AutomationScript;
+using temporaldeck_session::RenderedSession;
+
+struct TestResult {
+  std::string name;
+  bool pass = false;
+  std::string detail;
+};
+
+temporaldeck::PreparedSampleData makeToneSample(float sampleRate, int frames) {
+  temporaldeck::PreparedSampleData sample;
+  sample.left.resize(frames);
+  sample.right.resize(frames);
+  for (int i = 0; i < frames; ++i) {
+    float t = float(i) / sampleRate;
+    sample.left[i] = 4.f * std::sin(2.f * float(M_PI) * 110.f * t);
+    sample.right[i] = 4.f * std::sin(2.f * float(M_PI) * 165.f * t);
+  }
+  sample.frames = frames;
+  sample.sampleRate = sampleRate;
+  sample.bufferMode = Engine::BUFFER_DURATION_10S;
+  sample.valid = true;
+  return sample;
+}
+
+const char *kScratchScript = "# warm up, then a baby scratch with slip\n"
+                             "0.00 cartridge m44\n"
+                             "0.20 slip on\n"
+                             "0.25 scratch -1.5\n"
+                             "0.35 scratch 2.0   # push forward\n"
+                             "0.45 release\n"
+                             "0.60 cartridge lofi\n"
+                             "0.80 end\n";
+
+TestResult testParseAutomationScript() {
+  AutomationScript script;
+  std::string error;
+  bool ok = temporaldeck_offline::parseAutomationScript("1.0 release\n0.5 scratch -2\n\n# c\n0.5 interp sinc\n", &script,
+                                                        &error);
+  bool orderOk = ok && script.events.size() == 3 && script.events[0].type == AutomationEvent::SCRATCH &&
+                 script.events[1].type == AutomationEvent::INTERPOLATION &&
+                 script.events[1].mode == Engine::SCRATCH_INTERP_SINC &&
+                 script.events[2].type == AutomationEvent::RELEASE;
+  std::string badError;
+  bool rejectsBad = !temporaldeck_offline::parseAutomationScript("0 mix 0.5\n0.1 cartridge shure\n", &script, &badError);
+  bool pass = orderOk && rejectsBad && badError.find("line 2") != std::string::npos;
+  return {"Automation script parse and validation", pass, "error='" + error + "' badError='" + badError + "'"};
+}
+
+TestResult testScriptedRenderIsDeterministic() {
+  const float sr = 48000.f;
+  AutomationScript script;
+  temporaldeck_offline::parseAutomationScript(kScratchScript, &script);
+  temporaldeck_offline::RenderOptions options;
+  RenderedSession a;
+  RenderedSession b;
+  RenderedSession plain;
+  bool ok = temporaldeck_offline::renderPreparedSample(makeToneSample(sr, int(sr)), script, options, &a) &&
+            temporaldeck_offline::renderPreparedSample(makeToneSample(sr, int(sr)), script, options, &b) &&
+            temporaldeck_offline::renderPreparedSample(makeToneSample(sr, int(sr)), AutomationScript(), options, &plain);
+  temporaldeck_session::RenderDiff same = temporaldeck_session::compareRenders(a, b);
+  plain.left.resize(a.left.size());
+  plain.right.resize(a.right.size());
+  temporaldeck_session::RenderDiff automated = temporaldeck_session::compareRenders(a, plain);
+  bool lengthOk = a.left.size() == size_t(0.8f * sr);
+  bool pass = ok && same.identical && lengthOk && automated.mismatchedFrames > 0;
+  return {"Scripted render is deterministic", pass,
+          "frames=" + std::to_string(a.left.size()) + " automatedDiffFrames=" + std::to_string(automated.mismatchedFrames)};
+}
+
+TestResult testParallelBatchMatchesSerial() {
+  const float sr = 44100.f;
+  AutomationScript script;
+  temporaldeck_offline::parseAutomationScript(kScratchScript, &script);
+  temporaldeck_offline::RenderOptions options;
+  options.sampleRate = sr;
+
+  std::vector<temporaldeck_offline::RenderJob> serialJobs;
+  std::vector<temporaldeck_offline::RenderJob> parallelJobs;
+  for (int i = 0; i < 4; ++i) {
+    RenderedSession source;
+    source.sampleRate = sr;
+    for (int n = 0; n < int(sr); ++n) {
+      source.left.push_back(0.5f * std::sin(float(n) * 0.01f * float(i + 1)));
+      source.right.push_back(0.5f * std::cos(float(n) * 0.013f * float(i + 1)));
+    }
+    std::string input = "build/tests/offline_render_in_" + std::to_string(i) + ".wav";
+    temporaldeck_session::writeFloatWav(input, source);
+    serialJobs.push_back({input, "build/tests/offline_render_serial_" + std::to_string(i) + ".wav"});
+    parallelJobs.push_back({input, "build/tests/offline_render_parallel_" + std::to_string(i) + ".wav"});
+  }
+
+  auto serial = temporaldeck_offline::renderBatch(serialJobs, script, options, 1);
+  auto start = std::chrono::steady_clock::now();
+  auto parallel = temporaldeck_offline::renderBatch(parallelJobs, script, options, 4);
+  double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  bool allOk = true;
+  bool allSame = true;
+  long long frames = 0;
+  std::string error;
+  for (size_t i = 0; i < serialJobs.size(); ++i) {
+    allOk = allOk && serial[i].ok && parallel[i].ok;
+    if (!serial[i].ok) {
+      error = serial[i].error;
+    }
+    RenderedSession a;
+    RenderedSession b;
+    bool read = temporaldeck_session::readFloatWav(serialJobs[i].outputPath, &a) &&
+                temporaldeck_session::readFloatWav(parallelJobs[i].outputPath, &b);
+    allSame = allSame && read && temporaldeck_session::compareRenders(a, b).identical;
+    frames += parallel[i].frames;
+  }
+  double realtimeFactor = wall > 0.0 ? (double(frames) / double(sr)) / wall : 0.0;
+  bool pass = allOk && allSame && realtimeFactor > 1.0;
+  return {"Parallel batch matches serial and beats realtime", pass,
+          "same=" + std::to_string(int(allSame)) + " realtimeFactor=" + std::to_string(realtimeFactor) + " error=" + error};
+}
+
+} // namespace
+
+int main() {
+  std::vector<TestResult> tests;
+  tests.push_back(testParseAutomationScript());
+  tests.push_back(testScriptedRenderIsDeterministic());
+  tests.push_back(testParallelBatchMatchesSerial());
+
+  int failed = 0;
+  std::cout << "TemporalDeck Offline Render Spec\n";
+  std::cout << "--------------------------------\n";
+  for (const auto &t : tests) {
+    std::cout << (t.pass ? "[PASS] " : "[FAIL] ") << t.name << " :: " << t.detail << "\n";
+    if (!t.pass) {
+      failed++;
+    }
+  }
+  std::cout << "--------------------------------\n";
+  std::cout << "Summary: " << (tests.size() - failed) << "/" << tests.size() << " passed\n";
+  return failed == 0 ? 0 : 1;
+}
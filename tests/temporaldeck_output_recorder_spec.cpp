@@ -0,0 +1,201 @@
+#include "../src/TemporalDeckOutputRecorder.hpp"
+#include "../src/TemporalDeckSamplePrep.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using temporaldeck::AudioFileWriter;
+using temporaldeck::DecodedSampleFile;
+using temporaldeck::OutputRecorder;
+using temporaldeck::StereoFrameRing;
+using temporaldeck::TemporalDeckBuffer;
+
+struct TestResult {
+  std::string name;
+  bool pass = false;
+  std::string detail;
+};
+
+std::string tempPath(const char *name) {
+  return std::string("build/tests/") + name;
+}
+
+// Tone, noise and silent stretches, so every FLAC subframe type gets used.
+float testSignal(int i, int c) {
+  if ((i / 3000) % 4 == 3) {
+    return 0.f;
+  }
+  uint32_t h = uint32_t(i) * 2654435761u ^ uint32_t(c + 1) * 40503u;
+  float noise = float(h >> 8) / float(1u << 24) - 0.5f;
+  return 0.7f * std::sin(0.021f * float(i) * float(c + 1)) + 0.05f * noise;
+}
+
+bool waitUntilIdle(const OutputRecorder &recorder) {
+  for (int attempt = 0; attempt < 400 && recorder.isRecording(); ++attempt) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  return !recorder.isRecording();
+}
+
+float maxErrorAgainstSignal(const DecodedSampleFile &decoded) {
+  float maxError = 0.f;
+  for (int i = 0; i < decoded.frames; ++i) {
+    maxError = std::fmax(maxError, std::fabs(decoded.left[i] - testSignal(i, 0)));
+    maxError = std::fmax(maxError, std::fabs(decoded.right[i] - testSignal(i, 1)));
+  }
+  return maxError;
+}
+
+TestResult testWriterRoundTripsWavAndFlac() {
+  const int frames = AudioFileWriter::kFlacBlockFrames * 3 + 777;
+  std::vector<float> left(frames);
+  std::vector<float> right(frames);
+  for (int i = 0; i < frames; ++i) {
+    left[i] = testSignal(i, 0);
+    right[i] = testSignal(i, 1);
+  }
+  std::string detail;
+  bool pass = true;
+  const char *names[] = {"recorder_roundtrip.wav", "recorder_roundtrip.flac"};
+  const float tolerance[] = {0.f, 1.f / 8388607.f};
+  for (int f = 0; f < 2; ++f) {
+    std::string path = tempPath(names[f]);
+    AudioFileWriter writer;
+    bool ok = writer.open(path, temporaldeck::audioFileFormatForPath(path), 48000.f);
+    // Uneven chunks, so FLAC blocks straddle write calls.
+    for (int at = 0; at < frames && ok; at += 1000) {
+      int count = std::min(1000, frames - at);
+      ok = writer.write(left.data() + at, right.data() + at, count);
+    }
+    ok = ok && writer.close();
+    DecodedSampleFile decoded;
+    ok = ok && temporaldeck::decodeSampleFile(path, &decoded) && decoded.frames == frames && decoded.channels == 2 &&
+         decoded.sampleRate == 48000.f;
+    float maxError = ok ? maxErrorAgainstSignal(decoded) : 1.f;
+    pass = pass && ok && maxError <= tolerance[f] * 1.01f;
+    detail += std::string(names[f]) + " ok=" + std::to_string(ok) + " maxError=" + std::to_string(maxError) + " ";
+  }
+  return {"Writer round-trips float WAV and 24-bit FLAC", pass, detail};
+}
+
+TestResult testRingCountsDroppedFramesWhenFull() {
+  StereoFrameRing ring;
+  ring.allocate(100); // rounds up to 128
+  int accepted = 0;
+  for (int i = 0; i < 200; ++i) {
+    accepted += ring.push(float(i), -float(i)) ? 1 : 0;
+  }
+  std::vector<float> left(64);
+  std::vector<float> right(64);
+  int first = ring.pop(left.data(), right.data(), 64);
+  bool ordered = first == 64 && left[0] == 0.f && left[63] == 63.f && right[63] == -63.f;
+  bool roomAgain = ring.push(500.f, -500.f);
+  int rest = ring.pop(left.data(), right.data(), 64) + ring.pop(left.data(), right.data(), 64);
+  bool pass = accepted == 128 && ordered && roomAgain && rest == 65 && left[0] == 500.f;
+  return {"Ring keeps order and refuses frames when full", pass,
+          "accepted=" + std::to_string(accepted) + " first=" + std::to_string(first) + " rest=" + std::to_string(rest)};
+}
+
+TestResult testRecorderCapturesPushedFramesUntilStopped() {
+  std::string path = tempPath("recorder_session.flac");
+  OutputRecorder recorder;
+  std::string error;
+  const float rate = 8000.f;
+  bool started = recorder.start(path, rate, &error);
+  bool refusesSecond = !recorder.start(path, rate);
+  // Audio-thread side: push in blocks, as a process() loop would.
+  const int frames = 20000;
+  for (int i = 0; i < frames; ++i) {
+    recorder.push(testSignal(i, 0) * temporaldeck::kSampleFileVoltageScale,
+                  testSignal(i, 1) * temporaldeck::kSampleFileVoltageScale);
+    if (i % 256 == 255) {
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+  }
+  recorder.requestStop();
+  // The stop lands on the next audio frame; frames after it are not recorded.
+  recorder.push(0.f, 0.f);
+  recorder.push(0.f, 0.f);
+  bool idle = waitUntilIdle(recorder);
+  DecodedSampleFile decoded;
+  bool decodedOk = idle && temporaldeck::decodeSampleFile(path, &decoded);
+  float maxError = decodedOk ? maxErrorAgainstSignal(decoded) : 1.f;
+  bool pass = started && refusesSecond && idle && decodedOk && decoded.frames == frames && recorder.overruns() == 0 &&
+              recorder.framesWritten() == frames && maxError < 2e-7f && recorder.lastError().empty();
+  return {"Recorder captures pushed frames until stopped", pass,
+          "started=" + std::to_string(started) + " error=" + error + " frames=" + std::to_string(decoded.frames) +
+            " overruns=" + std::to_string(recorder.overruns()) + " maxError=" + std::to_string(maxError)};
+}
+
+TestResult testStopBeforeFirstFrameLeavesEmptyFile() {
+  std::string path = tempPath("recorder_empty.wav");
+  OutputRecorder recorder;
+  bool started = recorder.start(path, 44100.f);
+  recorder.requestStop();
+  bool idle = waitUntilIdle(recorder);
+  // A late frame must not reopen the finished session.
+  recorder.push(1.f, 1.f);
+  DecodedSampleFile decoded;
+  bool readable = temporaldeck::decodeSampleFile(path, &decoded) || decoded.frames == 0;
+  bool pass = started && idle && recorder.framesWritten() == 0 && readable && !recorder.isRecording();
+  return {"Stopping before the first frame leaves an empty file", pass,
+          "idle=" + std::to_string(idle) + " written=" + std::to_string(recorder.framesWritten())};
+}
+
+TestResult testExportWritesWindowOldestFirst() {
+  TemporalDeckBuffer ring;
+  ring.reset(1000.f, 4.f);
+  for (int i = 0; i < 5000; ++i) {
+    ring.write(float(i % 100) * 0.01f, -float(i % 100) * 0.01f);
+  }
+  std::string path = tempPath("recorder_export.wav");
+  int window = 1500;
+  bool ok = temporaldeck::exportRingWindow(path, ring, ring.writeHead, window, nullptr);
+  DecodedSampleFile decoded;
+  ok = ok && temporaldeck::decodeSampleFile(path, &decoded) && decoded.frames == window;
+  float maxError = 0.f;
+  for (int i = 0; ok && i < window; ++i) {
+    int written = 5000 - window + i;
+    float expected = float(written % 100) * 0.01f / temporaldeck::kSampleFileVoltageScale;
+    maxError = std::fmax(maxError, std::fabs(decoded.left[i] - expected));
+    maxError = std::fmax(maxError, std::fabs(decoded.right[i] + expected));
+  }
+  bool abandoned = !temporaldeck::exportRingWindow(tempPath("recorder_abandoned.wav"), ring, ring.writeHead, window,
+                                                   [](int) { return false; });
+  DecodedSampleFile missing;
+  bool removed = !temporaldeck::decodeSampleFile(tempPath("recorder_abandoned.wav"), &missing);
+  bool pass = ok && maxError < 1e-6f && abandoned && removed;
+  return {"Export writes the capture window oldest first", pass,
+          "ok=" + std::to_string(ok) + " maxError=" + std::to_string(maxError) + " removed=" + std::to_string(removed)};
+}
+
+} // namespace
+
+int main() {
+  std::vector<TestResult> tests;
+  tests.push_back(testWriterRoundTripsWavAndFlac());
+  tests.push_back(testRingCountsDroppedFramesWhenFull());
+  tests.push_back(testRecorderCapturesPushedFramesUntilStopped());
+  tests.push_back(testStopBeforeFirstFrameLeavesEmptyFile());
+  tests.push_back(testExportWritesWindowOldestFirst());
+
+  int failed = 0;
+  std::cout << "TemporalDeck Output Recorder Spec\n";
+  std::cout << "---------------------------------\n";
+  for (const auto &t : tests) {
+    std::cout << (t.pass ? "[PASS] " : "[FAIL] ") << t.name << " :: " << t.detail << "\n";
+    if (!t.pass) {
+      failed++;
+    }
+  }
+  std::cout << "---------------------------------\n";
+  std::cout << "Summary: " << (tests.size() - failed) << "/" << tests.size() << " passed\n";
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+#include "../src/TemporalDeckQualityGovernor.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using temporaldeck::TemporalDeckQualityGovernor;
+
+struct TestResult {
+  std::string name;
+  bool pass = false;
+  std::string detail;
+};
+
+TestResult testOverBudgetStepsDownOneTierPerHold() {
+  TemporalDeckQualityGovernor governor;
+  governor.setBudget(0.25f);
+  int a = governor.acquireSlot();
+  int b = governor.acquireSlot();
+  std::vector<int> caps;
+  for (int i = 0; i < 4 * (TemporalDeckQualityGovernor::kHoldPublishes + 1); ++i) {
+    governor.publishLoad(i % 2 == 0 ? a : b, 0.15f);
+    caps.push_back(governor.tierCap());
+  }
+  // Two decks at 15% each exceed a 25% budget once both have published: one
+  // step, hold, next step...
+  bool firstStepImmediate = caps[0] == TemporalDeckQualityGovernor::kTierCount - 1 &&
+                            caps[1] == TemporalDeckQualityGovernor::kTierCount - 2;
+  bool heldAfterStep = caps[1 + TemporalDeckQualityGovernor::kHoldPublishes] == caps[1];
+  bool flooredAtLinear = caps.back() == 0;
+  bool aggregateOk = governor.aggregateLoad() > 0.29f && governor.aggregateLoad() < 0.31f;
+  bool pass = a >= 0 && b >= 0 && a != b && firstStepImmediate && heldAfterStep && flooredAtLinear && aggregateOk;
+  return {"Over budget steps every deck down one tier per hold window", pass,
+          "firstCap=" + std::to_string(caps[1]) + " lastCap=" + std::to_string(caps.back()) +
+            " aggregate=" + std::to_string(governor.aggregateLoad())};
+}
+
+TestResult testRecoveryNeedsHeadroom() {
+  TemporalDeckQualityGovernor governor;
+  governor.setBudget(0.5f);
+  int slot = governor.acquireSlot();
+  for (int i = 0; i < 40; ++i) {
+    governor.publishLoad(slot, 0.8f);
+  }
+  int floored = governor.tierCap();
+  // Below budget but above the recover ratio: stays put.
+  for (int i = 0; i < 40; ++i) {
+    governor.publishLoad(slot, 0.4f);
+  }
+  int inBand = governor.tierCap();
+  for (int i = 0; i < 40; ++i) {
+    governor.publishLoad(slot, 0.1f);
+  }
+  int recovered = governor.tierCap();
+  bool pass = floored == 0 && inBand == 0 && recovered == TemporalDeckQualityGovernor::kTierCount - 1;
+  return {"Ceiling recovers only with headroom below the budget", pass,
+          "floored=" + std::to_string(floored) + " inBand=" + std::to_string(inBand) +
+            " recovered=" + std::to_string(recovered)};
+}
+
+TestResult testReleasedSlotsLeaveTheAggregate() {
+  TemporalDeckQualityGovernor governor;
+  int a = governor.acquireSlot();
+  int b = governor.acquireSlot();
+  governor.publishLoad(a, 0.2f);
+  governor.publishLoad(b, 0.3f);
+  float both = governor.aggregateLoad();
+  governor.releaseSlot(b);
+  governor.publishLoad(a, 0.2f);
+  float one = governor.aggregateLoad();
+  int reused = governor.acquireSlot();
+  int taken = 0;
+  while (governor.acquireSlot() >= 0) {
+    taken++;
+  }
+  bool pass = both > 0.49f && both < 0.51f && one > 0.19f && one < 0.21f && reused == b &&
+              taken == TemporalDeckQualityGovernor::kMaxDecks - 2;
+  return {"Released slots leave the aggregate and are reused", pass,
+          "both=" + std::to_string(both) + " one=" + std::to_string(one) + " extraSlots=" + std::to_string(taken)};
+}
+
+} // namespace
+
+int main() {
+  std::vector<TestResult> tests;
+  tests.push_back(testOverBudgetStepsDownOneTierPerHold());
+  tests.push_back(testRecoveryNeedsHeadroom());
+  tests.push_back(testReleasedSlotsLeaveTheAggregate());
+
+  int failed = 0;
+  std::cout << "TemporalDeck Quality Governor Spec\n";
+  std::cout << "----------------------------------\n";
+  for (const auto &t : tests) {
+    std::cout << (t.pass ? "[PASS] " : "[FAIL] ") << t.name << " :: " << t.detail << "\n";
+    if (!t.pass) {
+      failed++;
+    }
+  }
+  std::cout << "----------------------------------\n";
+  std::cout << "Summary: " << (tests.size() - failed) << "/" << tests.size() << " passed\n";
+  return failed == 0 ? 0 : 1;
+}
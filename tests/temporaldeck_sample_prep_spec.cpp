@@ -1,6 +1,8 @@
 #include "../src/TemporalDeckSamplePrep.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -92,6 +94,135 @@ TestResult testInvalidInputClearsPreparedOutput() {
           "ok=" + std::to_string(int(ok)) + " frames=" + std::to_string(prepared.frames)};
 }
 
+TestResult testLiveHistoryResamplesAcrossRateChange() {
+  const float fromRate = 48000.f;
+  const float toRate = 96000.f;
+  const int mode = TemporalDeckEngine::BUFFER_DURATION_10S;
+  temporaldeck::TemporalDeckBuffer source;
+  source.resetForMode(fromRate, mode, false);
+  // Wrap the ring once so the history straddles the end of storage.
+  const int written = source.size + 12345;
+  const double hz = 220.0;
+  for (int i = 0; i < written; ++i) {
+    float v = float(std::sin(2.0 * M_PI * hz * double(i) / fromRate));
+    source.write(v, -v);
+  }
+  const int frames = source.filled - 1000;
+
+  temporaldeck::TemporalDeckBuffer out;
+  out.resetForMode(toRate, mode, false);
+  bool ok = temporaldeck::resampleLiveHistory(source, source.writeHead, frames, &out, nullptr);
+
+  // The newest output frame lands on the newest source frame.
+  float maxErr = 0.f;
+  int checked = 0;
+  for (int back = 0; back < out.filled; back += 997) {
+    int idx = out.wrapIndex(out.writeHead - 1 - back);
+    double t = (double(written - 1) * 2.0 - double(back)) / double(toRate);
+    float expected = float(std::sin(2.0 * M_PI * hz * t));
+    maxErr = std::max(maxErr, std::fabs(out.left[idx] - expected));
+    maxErr = std::max(maxErr, std::fabs(out.right[idx] + expected));
+    checked++;
+  }
+
+  temporaldeck::TemporalDeckBuffer aborted;
+  aborted.resetForMode(toRate, mode, false);
+  bool stopped = !temporaldeck::resampleLiveHistory(source, source.writeHead, frames, &aborted,
+                                                    [](int consumed) { return consumed < 20000; });
+
+  int expectedFrames = frames * 2;
+  bool pass = ok && stopped && out.filled == expectedFrames && maxErr < 2e-3f && checked > 100 &&
+              aborted.filled < out.filled;
+  return {"Live history resamples across a rate change", pass,
+          "filled=" + std::to_string(out.filled) + " expected=" + std::to_string(expectedFrames) +
+            " maxErr=" + std::to_string(maxErr) + " abortedFilled=" + std::to_string(aborted.filled)};
+}
+
+TestResult testLiveWindowConvertsToSampleRedLimitToNow() {
+  const float sr = 1000.f;
+  TemporalDeckEngine engine;
+  engine.reset(sr);
+  for (int i = 0; i < 10; ++i) {
+    engine.buffer.write(float(i), float(100 + i));
+  }
+
+  // The module sizes the window from the red limit and converts it on the worker.
+  int frames = int(std::floor(std::max(0.0, engine.accessibleLag(0.00045f)))) + 1;
+  bool pollsStopped = false;
+  PreparedSampleData stopped;
+  bool stoppedRejected = !temporaldeck::prepareLiveWindowSample(
+    engine.buffer, engine.buffer.writeHead, frames, engine.bufferDurationMode, true,
+    [&](int) {
+      pollsStopped = true;
+      return false;
+    },
+    &stopped) && pollsStopped && !stopped.valid;
+  PreparedSampleData prepared;
+  bool converted = temporaldeck::prepareLiveWindowSample(engine.buffer, engine.buffer.writeHead, frames,
+                                                         engine.bufferDurationMode, true, nullptr, &prepared);
+  engine.installPreparedSample(std::move(prepared.left), std::move(prepared.right), prepared.frames,
+                               prepared.autoPlayOnLoad, prepared.truncated, prepared.monoStorage,
+                               std::move(prepared.mips), std::move(prepared.onsets));
+  engine.sampleModeEnabled = true;
+
+  bool sizeOk = engine.sampleFrames == 5;
+  bool endpointsOk = sizeOk && nearlyEqual(engine.buffer.left[0], 5.f, 1e-6f) &&
+                     nearlyEqual(engine.buffer.left[engine.sampleFrames - 1], 9.f, 1e-6f);
+  bool rightOk = sizeOk && !engine.buffer.monoStorage && nearlyEqual(engine.buffer.right[0], 105.f, 1e-6f) &&
+                 nearlyEqual(engine.buffer.right[engine.sampleFrames - 1], 109.f, 1e-6f);
+  bool pass = converted && stoppedRejected && sizeOk && endpointsOk && rightOk && engine.sampleLoaded &&
+              engine.sampleTransportPlaying;
+  return {"Live window converts to a red-limit-to-NOW sample", pass,
+          "converted=" + std::to_string(int(converted)) + " stoppedRejected=" + std::to_string(stoppedRejected) +
+            " frames=" + std::to_string(engine.sampleFrames) + " firstL=" + std::to_string(engine.buffer.left[0]) +
+            " lastL=" + std::to_string(engine.buffer.left[std::max(0, engine.sampleFrames - 1)])};
+}
+
+TestResult testOnsetIndexFindsBurstsOnZeroCrossings() {
+  const float sr = 48000.f;
+  const int bursts[] = {14400, 43200, 74400, 115200, 148800};
+  DecodedSampleFile decoded;
+  decoded.channels = 1;
+  decoded.frames = int(sr * 4.f);
+  decoded.sampleRate = sr;
+  decoded.left.assign(decoded.frames, 0.f);
+  uint32_t rng = 0x2468aceu;
+  for (int i = 0; i < decoded.frames; ++i) {
+    rng = rng * 1664525u + 1013904223u;
+    decoded.left[i] = (float(rng >> 8) / float(1u << 24) - 0.5f) * 2e-4f;
+  }
+  // Decaying 440 Hz hits that start on a rising zero crossing.
+  for (int start : bursts) {
+    for (int i = 0; i < int(0.2f * sr) && start + i < decoded.frames; ++i) {
+      float t = float(i) / sr;
+      decoded.left[start + i] += 0.8f * std::exp(-t / 0.05f) * std::sin(2.f * 3.14159265f * 440.f * t);
+    }
+  }
+
+  PreparedSampleData prepared;
+  bool ok = temporaldeck::buildPreparedSample(decoded, sr, TemporalDeckEngine::BUFFER_DURATION_10S, true, &prepared);
+  const temporaldeck::TemporalDeckOnsetIndex &index = prepared.onsets;
+  int maxError = 0;
+  bool countMatches = index.onsets.size() == sizeof(bursts) / sizeof(bursts[0]);
+  for (size_t i = 0; countMatches && i < index.onsets.size(); ++i) {
+    maxError = std::max(maxError, std::abs(index.onsets[i] - bursts[i]));
+  }
+  int blocks = (prepared.frames + temporaldeck::kOnsetBlockFrames - 1) / temporaldeck::kOnsetBlockFrames;
+  // Just after a hit snaps back onto it; between hits lands on a zero crossing.
+  int snappedNear = index.snapFrame(bursts[2] + 2000, int(0.25f * sr));
+  int between = index.snapFrame(bursts[2] + 4000 + 37, 100);
+  const std::vector<float> &l = prepared.left;
+  bool betweenOnCrossing = between > 0 && between + 1 < prepared.frames &&
+                           ((l[between - 1] >= 0.f) != (l[between] >= 0.f) ||
+                            (l[between] >= 0.f) != (l[between + 1] >= 0.f)) &&
+                           std::abs(between - (bursts[2] + 4037)) < 2 * temporaldeck::kOnsetBlockFrames;
+  bool pass = ok && countMatches && maxError <= 8 && int(index.blockRms.size()) == blocks &&
+              snappedNear == index.onsets[2] && betweenOnCrossing;
+  return {"Onset index finds bursts and snaps seeks", pass,
+          "onsets=" + std::to_string(index.onsets.size()) + " maxError=" + std::to_string(maxError) +
+            " snappedNear=" + std::to_string(snappedNear) + " between=" + std::to_string(between)};
+}
+
 } // namespace
 
 int main() {
@@ -100,6 +231,9 @@ int main() {
   tests.push_back(testBuildPreparedSampleMonoFoldDown());
   tests.push_back(testBuildPreparedSampleTruncatesToBufferLimit());
   tests.push_back(testInvalidInputClearsPreparedOutput());
+  tests.push_back(testLiveHistoryResamplesAcrossRateChange());
+  tests.push_back(testLiveWindowConvertsToSampleRedLimitToNow());
+  tests.push_back(testOnsetIndexFindsBurstsOnZeroCrossings());
 
   int failed = 0;
   std::cout << "TemporalDeck Sample Prep Spec\n";
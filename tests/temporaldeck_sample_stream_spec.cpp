@@ -0,0 +1,226 @@
+#include "../src/TemporalDeckSampleStream.hpp"
+#include "../src/TemporalDeckSamplePrep.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using temporaldeck::DecodedSampleFile;
+using temporaldeck::PreparedSampleData;
+using temporaldeck::TemporalDeckEngine;
+using temporaldeck::TemporalDeckPageCache;
+using temporaldeck::TemporalDeckSampleStream;
+
+struct TestResult {
+  std::string name;
+  bool pass = false;
+  std::string detail;
+};
+
+std::string tempPath(const char *name) {
+  return std::string("build/tests/") + name;
+}
+
+void putLe(std::ofstream &out, uint32_t value, int bytes) {
+  for (int i = 0; i < bytes; ++i) {
+    out.put(char((value >> (8 * i)) & 0xFFu));
+  }
+}
+
+// 16-bit PCM with a LIST chunk ahead of the data, so readers must walk chunks.
+void writeTestWav(const std::string &path, int channels, int sampleRate, int frames,
+                  const std::function<float(int, int)> &sampleAt) {
+  std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+  uint32_t dataBytes = uint32_t(frames) * uint32_t(channels) * 2u;
+  out.write("RIFF", 4);
+  putLe(out, 4u + 24u + 12u + 8u + dataBytes, 4);
+  out.write("WAVE", 4);
+  out.write("fmt ", 4);
+  putLe(out, 16, 4);
+  putLe(out, 1, 2);
+  putLe(out, uint32_t(channels), 2);
+  putLe(out, uint32_t(sampleRate), 4);
+  putLe(out, uint32_t(sampleRate * channels * 2), 4);
+  putLe(out, uint32_t(channels * 2), 2);
+  putLe(out, 16, 2);
+  out.write("LIST", 4);
+  putLe(out, 4, 4);
+  out.write("INFO", 4);
+  out.write("data", 4);
+  putLe(out, dataBytes, 4);
+  std::vector<char> block;
+  block.reserve(size_t(channels) * 2u * 4096u);
+  for (int i = 0; i < frames; ++i) {
+    for (int c = 0; c < channels; ++c) {
+      int v = int(std::lround(std::fmax(-1.f, std::fmin(1.f, sampleAt(i, c))) * 32767.f));
+      uint16_t u = uint16_t(int16_t(v));
+      block.push_back(char(u & 0xFFu));
+      block.push_back(char(u >> 8));
+    }
+    if (block.size() >= size_t(channels) * 2u * 4096u) {
+      out.write(block.data(), std::streamsize(block.size()));
+      block.clear();
+    }
+  }
+  out.write(block.data(), std::streamsize(block.size()));
+}
+
+float testTone(int i, int c) {
+  return 0.6f * std::sin(0.013f * float(i) * float(c + 1)) + 0.2f * std::sin(0.0007f * float(i));
+}
+
+bool waitForPages(const TemporalDeckPageCache &pages, int firstPage, int lastPage) {
+  for (int attempt = 0; attempt < 400; ++attempt) {
+    bool all = true;
+    for (int p = firstPage; p <= lastPage && all; ++p) {
+      all = pages.isResident(p);
+    }
+    if (all) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  return false;
+}
+
+TestResult testStreamedPagesMatchDecodedSample() {
+  std::string path = tempPath("stream_match.wav");
+  writeTestWav(path, 2, 8000, 8000 * 6, testTone);
+  DecodedSampleFile decoded;
+  bool decodedOk = temporaldeck::decodeSampleFile(path, &decoded);
+  float maxError = 0.f;
+  bool ok = decodedOk;
+  for (int mono = 0; mono <= 1 && ok; ++mono) {
+    int mode = mono ? TemporalDeckEngine::BUFFER_DURATION_10MIN_MONO : TemporalDeckEngine::BUFFER_DURATION_10MIN_STEREO;
+    PreparedSampleData prepared;
+    TemporalDeckSampleStream stream;
+    ok = temporaldeck::buildPreparedSample(decoded, 11025.f, mode, true, &prepared) && stream.open(path) &&
+         stream.start(11025.f, mono != 0) && stream.frames() == prepared.frames &&
+         waitForPages(*stream.pages(), 0, stream.pages()->pageCount() - 1);
+    if (!ok) {
+      break;
+    }
+    for (int i = 0; i < prepared.frames && ok; ++i) {
+      // Adapters track the few pages of one kernel read; use one per frame.
+      TemporalDeckPageCache::Frames frames(*stream.pages());
+      maxError = std::fmax(maxError, std::fabs(frames.leftAt(i) - prepared.left[i]));
+      if (!mono) {
+        maxError = std::fmax(maxError, std::fabs(frames.rightAt(i) - prepared.right[i]));
+      }
+      ok = frames.valid();
+    }
+  }
+  bool pass = ok && maxError < 1e-6f;
+  return {"Streamed pages match the decoded and resampled file", pass,
+          "ok=" + std::to_string(ok) + " maxError=" + std::to_string(maxError)};
+}
+
+TestResult testLongFileStreamsInFixedMemoryAroundTheHead() {
+  std::string shortPath = tempPath("stream_short.wav");
+  std::string longPath = tempPath("stream_long.wav");
+  const int rate = 1000;
+  writeTestWav(shortPath, 1, rate, rate * 30, testTone);
+  writeTestWav(longPath, 1, rate, rate * 700, testTone);
+
+  TemporalDeckSampleStream shortStream;
+  TemporalDeckSampleStream longStream;
+  bool opened = shortStream.open(shortPath) && longStream.open(longPath);
+  bool started = opened && shortStream.start(4000.f, true) && longStream.start(4000.f, true);
+  bool sameMemory = started && shortStream.pageBytes() == longStream.pageBytes();
+  bool isLong = longStream.sourceSeconds() > temporaldeck_modes::usableBufferSecondsForMode(
+                                               TemporalDeckEngine::BUFFER_DURATION_10MIN_STEREO);
+
+  // Jump near the end and play backwards: the head page and the pages behind
+  // it in the direction of travel come in.
+  const TemporalDeckPageCache &pages = *longStream.pages();
+  int headFrame = 4000 * 650;
+  int headPage = headFrame >> temporaldeck::kStreamPageShift;
+  longStream.pages()->publishHead(double(headFrame), -1.0);
+  bool windowLoaded = started && waitForPages(pages, headPage - temporaldeck::kStreamPagesAhead, headPage);
+
+  // Every fourth output frame lands exactly on a source frame.
+  temporaldeck::SampleStreamReader reader;
+  reader.open(longPath);
+  std::vector<float> source(64);
+  int sourceStart = headFrame / 4 - 32;
+  reader.read(sourceStart, 64, source.data(), nullptr);
+  TemporalDeckPageCache::Frames frames(pages);
+  float maxError = 0.f;
+  for (int k = 0; k < 64; ++k) {
+    float expected = source[k] * temporaldeck::kSampleFileVoltageScale;
+    maxError = std::fmax(maxError, std::fabs(frames.leftAt((sourceStart + k) * 4) - expected));
+  }
+  int resident = 0;
+  for (int p = 0; p < pages.pageCount(); ++p) {
+    resident += pages.isResident(p) ? 1 : 0;
+  }
+  bool pass = sameMemory && isLong && windowLoaded && frames.valid() && maxError < 1e-6f &&
+              resident <= temporaldeck::kStreamSlotCount && pages.pageCount() > temporaldeck::kStreamSlotCount;
+  return {"Long files stream in fixed memory around the head", pass,
+          "pageBytes=" + std::to_string(longStream.pageBytes()) + " windowLoaded=" + std::to_string(windowLoaded) +
+            " resident=" + std::to_string(resident) + "/" + std::to_string(pages.pageCount()) +
+            " maxError=" + std::to_string(maxError)};
+}
+
+TestResult testEngineReadsSilenceForMissingPages() {
+  std::shared_ptr<TemporalDeckPageCache> pages = std::make_shared<TemporalDeckPageCache>();
+  const int pageFrames = temporaldeck::kStreamPageFrames;
+  pages->allocate(pageFrames * 3, false);
+  auto fill = [&](int page, float value) {
+    TemporalDeckPageCache::Slot &slot = pages->slotFor(page);
+    std::fill(slot.left.begin(), slot.left.end(), value);
+    std::fill(slot.right.begin(), slot.right.end(), -value);
+    slot.page.store(page);
+  };
+  fill(0, 2.f);
+
+  TemporalDeckEngine engine;
+  engine.reset(48000.f);
+  engine.installStreamedSample(pages, true, false);
+  double newest = double(engine.sampleFrames - 1);
+  const int tier = TemporalDeckEngine::INTERP_TIER_CUBIC;
+  std::pair<float, float> resident = engine.readSampleBounded(100.25, tier, newest);
+  std::pair<float, float> missing = engine.readSampleBounded(double(pageFrames) + 100.25, tier, newest);
+  // Taps straddling into a missing page count as a miss too.
+  std::pair<float, float> straddle = engine.readSampleBounded(double(pageFrames) - 1.5, tier, newest);
+  uint64_t misses = pages->misses.load();
+  fill(1, 3.f);
+  std::pair<float, float> loaded = engine.readSampleBounded(double(pageFrames) + 100.25, tier, newest);
+
+  bool pass = engine.sampleLoaded && engine.sampleFrames == pageFrames * 3 && std::fabs(resident.first - 2.f) < 1e-5f &&
+              std::fabs(resident.second + 2.f) < 1e-5f && missing.first == 0.f && missing.second == 0.f &&
+              straddle.first == 0.f && misses == 2 && std::fabs(loaded.first - 3.f) < 1e-5f;
+  return {"Engine reads silence for pages not yet resident", pass,
+          "resident=" + std::to_string(resident.first) + " missing=" + std::to_string(missing.first) +
+            " misses=" + std::to_string(misses) + " loaded=" + std::to_string(loaded.first)};
+}
+
+} // namespace
+
+int main() {
+  std::vector<TestResult> tests;
+  tests.push_back(testStreamedPagesMatchDecodedSample());
+  tests.push_back(testLongFileStreamsInFixedMemoryAroundTheHead());
+  tests.push_back(testEngineReadsSilenceForMissingPages());
+
+  int failed = 0;
+  std::cout << "TemporalDeck Sample Stream Spec\n";
+  std::cout << "-------------------------------\n";
+  for (const auto &t : tests) {
+    std::cout << (t.pass ? "[PASS] " : "[FAIL] ") << t.name << " :: " << t.detail << "\n";
+    if (!t.pass) {
+      failed++;
+    }
+  }
+  std::cout << "-------------------------------\n";
+  std::cout << "Summary: " << (tests.size() - failed) << "/" << tests.size() << " passed\n";
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,419 @@
+#include "../src/TemporalDeckBufferSnapshot.hpp"
+#include "../src/TemporalDeckSessionRecord.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Engine = temporaldeck::TemporalDeckEngine;
+using temporaldeck::usableBufferSecondsForMode;
+using temporaldeck_session::RenderDiff;
+using temporaldeck_session::RenderedSession;
+using temporaldeck_session::SessionEncoder;
+using temporaldeck_session::SessionFrame;
+using temporaldeck_session::SessionHeader;
+using temporaldeck_session::SessionReader;
+using temporaldeck_session::SessionRecorder;
+
+struct TestResult {
+  std::string name;
+  bool pass = false;
+  std::string detail;
+};
+
+SessionFrame makeDefaultFrame(float sampleRate) {
+  SessionFrame frame;
+  frame.sampleRate = sampleRate;
+  frame.input.dt = 1.f / sampleRate;
+  frame.input.bufferKnob = 1.f;
+  frame.input.rateKnob = 0.5f;
+  frame.input.mixKnob = 1.f;
+  return frame;
+}
+
+// A short performance: sine input, a platter drag backwards and release,
+// a freeze press, a cartridge change and an arc-light seek.
+std::vector<SessionFrame> buildScriptedSession(float sampleRate, int frames) {
+  std::vector<SessionFrame> out;
+  out.reserve(frames);
+  SessionFrame frame = makeDefaultFrame(sampleRate);
+  uint32_t gestureRevision = 0;
+  for (int i = 0; i < frames; ++i) {
+    float t = float(i) / sampleRate;
+    frame.input.inL = 4.f * std::sin(2.f * float(M_PI) * 220.f * t);
+    frame.input.inR = 4.f * std::sin(2.f * float(M_PI) * 330.f * t);
+    bool touched = i >= frames / 4 && i < frames / 2;
+    if (touched && (i % 64) == 0) {
+      gestureRevision++;
+    }
+    frame.input.platterTouched = touched;
+    frame.input.platterMotionActive = touched;
+    frame.input.platterGestureRevision = gestureRevision;
+    frame.input.platterLagTarget = touched ? float(i - frames / 4) * 0.5f : 0.f;
+    frame.input.platterGestureVelocity = touched ? -0.5f * sampleRate : 0.f;
+    frame.input.freezeButton = i >= (frames * 5) / 8 && i < (frames * 6) / 8;
+    frame.cartridgeCharacter = i >= (frames * 3) / 4 ? Engine::CARTRIDGE_LOFI : Engine::CARTRIDGE_CLEAN;
+    if (i == (frames * 7) / 8) {
+      frame.liveSeekRevision++;
+      frame.liveSeekArcNormalized = 0.3f;
+    }
+    out.push_back(frame);
+  }
+  return out;
+}
+
+std::vector<uint8_t> encodeSession(const SessionHeader &header, const std::vector<SessionFrame> &frames) {
+  std::vector<uint8_t> bytes;
+  SessionEncoder::appendHeader(header, &bytes);
+  SessionEncoder encoder;
+  for (const SessionFrame &frame : frames) {
+    encoder.push(frame, &bytes);
+  }
+  encoder.flush(&bytes);
+  return bytes;
+}
+
+bool sameBits(float a, float b) {
+  return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+bool framesEqual(const SessionFrame &a, const SessionFrame &b) {
+  const Engine::FrameInput &x = a.input;
+  const Engine::FrameInput &y = b.input;
+  return sameBits(x.dt, y.dt) && sameBits(x.inL, y.inL) && sameBits(x.inR, y.inR) &&
+         sameBits(x.bufferKnob, y.bufferKnob) && sameBits(x.rateKnob, y.rateKnob) && sameBits(x.mixKnob, y.mixKnob) &&
+         sameBits(x.feedbackKnob, y.feedbackKnob) && x.freezeButton == y.freezeButton &&
+         x.reverseButton == y.reverseButton && x.slipButton == y.slipButton && x.quickSlipTrigger == y.quickSlipTrigger &&
+         x.freezeGate == y.freezeGate && x.scratchGate == y.scratchGate &&
+         x.scratchGateConnected == y.scratchGateConnected && x.positionConnected == y.positionConnected &&
+         sameBits(x.positionCv, y.positionCv) && sameBits(x.rateCv, y.rateCv) && x.rateCvConnected == y.rateCvConnected &&
+         x.platterTouched == y.platterTouched && x.wheelScratchHeld == y.wheelScratchHeld &&
+         x.platterMotionActive == y.platterMotionActive && x.platterGestureRevision == y.platterGestureRevision &&
+         sameBits(x.platterLagTarget, y.platterLagTarget) && sameBits(x.platterGestureVelocity, y.platterGestureVelocity) &&
+         sameBits(x.wheelDelta, y.wheelDelta) && sameBits(a.sampleRate, b.sampleRate) &&
+         a.scratchInterpolationMode == b.scratchInterpolationMode && a.slipReturnMode == b.slipReturnMode &&
+         a.externalGatePosMode == b.externalGatePosMode && a.cartridgeCharacter == b.cartridgeCharacter &&
+         a.sampleModeEnabled == b.sampleModeEnabled && a.sampleLoopEnabled == b.sampleLoopEnabled &&
+         a.sampleSeekRevision == b.sampleSeekRevision && sameBits(a.sampleSeekNormalized, b.sampleSeekNormalized) &&
+         a.liveSeekRevision == b.liveSeekRevision && sameBits(a.liveSeekArcNormalized, b.liveSeekArcNormalized);
+}
+
+TestResult testEncodeDecodeRoundTripIsBitExact() {
+  const float sr = 48000.f;
+  SessionHeader header;
+  header.sampleRate = sr;
+  header.bufferDurationMode = Engine::BUFFER_DURATION_20S;
+  std::vector<SessionFrame> frames = buildScriptedSession(sr, 3 * temporaldeck_session::kSessionBlockFrames + 123);
+  frames[10].input.wheelDelta = -0.f; // sign of zero must survive
+  frames[11].input.rateCv = std::nanf("");
+
+  SessionReader reader;
+  std::string error;
+  bool opened = reader.openMemory(encodeSession(header, frames), &error);
+  size_t decoded = 0;
+  size_t firstMismatch = frames.size();
+  SessionFrame frame;
+  while (opened && reader.next(&frame)) {
+    if (decoded < frames.size() && !framesEqual(frame, frames[decoded]) && firstMismatch == frames.size()) {
+      firstMismatch = decoded;
+    }
+    decoded++;
+  }
+  bool headerOk = opened && reader.header().sampleRate == sr &&
+                  reader.header().bufferDurationMode == Engine::BUFFER_DURATION_20S;
+  bool pass = headerOk && decoded == frames.size() && firstMismatch == frames.size() && reader.error().empty();
+  return {"Session encode/decode round trip is bit-exact", pass,
+          "decoded=" + std::to_string(decoded) + "/" + std::to_string(frames.size()) +
+            " firstMismatch=" + std::to_string(firstMismatch) + " error=" + reader.error() + error};
+}
+
+TestResult testStaticControlsCompressToRuns() {
+  const float sr = 48000.f;
+  const int frames = int(sr) * 60;
+  SessionHeader header;
+  header.sampleRate = sr;
+  SessionEncoder encoder;
+  std::vector<uint8_t> bytes;
+  SessionEncoder::appendHeader(header, &bytes);
+  SessionFrame frame = makeDefaultFrame(sr);
+  for (int i = 0; i < frames; ++i) {
+    // Slow knob move every 10 ms, otherwise idle controls and silent input.
+    if ((i % 480) == 0) {
+      frame.input.mixKnob = 0.5f + 0.5f * std::sin(float(i) * 1e-5f);
+    }
+    encoder.push(frame, &bytes);
+  }
+  encoder.flush(&bytes);
+  double rawBytes = double(frames) * double(sizeof(SessionFrame));
+  double bytesPerFrame = double(bytes.size()) / double(frames);
+  // Two 1-byte audio deltas per frame dominate; control runs stay negligible.
+  bool pass = bytesPerFrame < 2.1 && double(bytes.size()) < rawBytes / 50.0;
+  return {"Static controls compress to runs", pass,
+          "bytes=" + std::to_string(bytes.size()) + " bytesPerFrame=" + std::to_string(bytesPerFrame) +
+            " raw=" + std::to_string((long long)rawBytes)};
+}
+
+TestResult testReplayMatchesLiveProcessing() {
+  const float sr = 44100.f;
+  SessionHeader header;
+  header.sampleRate = sr;
+  header.bufferDurationMode = Engine::BUFFER_DURATION_10S;
+  std::vector<SessionFrame> frames = buildScriptedSession(sr, int(sr) * 2);
+
+  // Reference: drive an engine directly the way the module does.
+  Engine engine;
+  engine.bufferDurationMode = header.bufferDurationMode;
+  engine.reset(sr);
+  RenderedSession live;
+  live.sampleRate = sr;
+  uint32_t appliedSampleSeek = 0;
+  uint32_t appliedLiveSeek = 0;
+  for (const SessionFrame &frame : frames) {
+    temporaldeck_session::applySessionFrame(engine, frame, &appliedSampleSeek, &appliedLiveSeek);
+    Engine::FrameResult result = engine.process(frame.input);
+    live.left.push_back(result.outL);
+    live.right.push_back(result.outR);
+  }
+
+  SessionReader reader;
+  RenderedSession replay;
+  std::string error;
+  bool ok = reader.openMemory(encodeSession(header, frames), &error) &&
+            temporaldeck_session::renderSession(reader, &replay, &error);
+  RenderDiff diff = temporaldeck_session::compareRenders(live, replay);
+  bool nonSilent = false;
+  for (float v : replay.left) {
+    nonSilent = nonSilent || std::fabs(v) > 0.1f;
+  }
+  bool pass = ok && diff.identical && nonSilent;
+  return {"Replay matches live processing bit-exact", pass,
+          "frames=" + std::to_string(replay.left.size()) + " mismatched=" + std::to_string(diff.mismatchedFrames) +
+            " first=" + std::to_string(diff.firstMismatchFrame) + " error=" + error};
+}
+
+TestResult testFloatWavRoundTripAndDiff() {
+  RenderedSession render;
+  render.sampleRate = 48000.f;
+  for (int i = 0; i < 1000; ++i) {
+    render.left.push_back(std::sin(float(i) * 0.01f));
+    render.right.push_back(-std::cos(float(i) * 0.02f) * 1e-7f);
+  }
+  const std::string path = "build/tests/temporaldeck_session_roundtrip.wav";
+  std::string error;
+  RenderedSession loaded;
+  bool ok = temporaldeck_session::writeFloatWav(path, render, &error) &&
+            temporaldeck_session::readFloatWav(path, &loaded, &error);
+  RenderDiff same = temporaldeck_session::compareRenders(render, loaded);
+  loaded.right[500] = std::nextafter(loaded.right[500], 1.f);
+  RenderDiff changed = temporaldeck_session::compareRenders(render, loaded);
+  bool pass = ok && same.identical && !changed.identical && changed.firstMismatchFrame == 500 &&
+              changed.mismatchedFrames == 1;
+  return {"Float WAV round trip and golden diff", pass,
+          "same=" + std::to_string(int(same.identical)) + " changedFirst=" + std::to_string(changed.firstMismatchFrame) +
+            " error=" + error};
+}
+
+TestResult testTruncatedSessionReportsError() {
+  const float sr = 48000.f;
+  SessionHeader header;
+  header.sampleRate = sr;
+  std::vector<uint8_t> bytes = encodeSession(header, buildScriptedSession(sr, 5000));
+  bytes.resize(bytes.size() - 7);
+  SessionReader reader;
+  bool opened = reader.openMemory(bytes);
+  SessionFrame frame;
+  int decoded = 0;
+  while (reader.next(&frame)) {
+    decoded++;
+  }
+  SessionReader garbage;
+  bool garbageRejected = !garbage.openMemory(std::vector<uint8_t>(64, 0x5A));
+  bool pass = opened && !reader.error().empty() && decoded < 5000 && garbageRejected;
+  return {"Truncated session reports error", pass,
+          "decoded=" + std::to_string(decoded) + " error=" + reader.error()};
+}
+
+TestResult testRecorderStreamsThroughBoundedRing() {
+  // Ring pushes are all or nothing, so a block that does not fit leaves no partial bytes.
+  temporaldeck_session::SessionByteRing ring;
+  ring.allocate(100);
+  std::vector<uint8_t> block(100);
+  for (size_t i = 0; i < block.size(); ++i) {
+    block[i] = uint8_t(i);
+  }
+  bool firstFits = ring.push(block.data(), 100);
+  bool fullRejected = !ring.push(block.data(), 40) && ring.writeIndex.load() == 100;
+  uint8_t out[256];
+  size_t drained = ring.pop(out, 60);
+  bool wrappedFits = ring.push(block.data(), 40);
+  drained += ring.pop(out + drained, sizeof(out) - drained);
+  bool ordered = drained == 140;
+  for (size_t i = 0; ordered && i < 140; ++i) {
+    ordered = out[i] == uint8_t(i < 100 ? i : i - 100);
+  }
+
+  // The recorder hands blocks to its writer through that ring and the file decodes bit-exact.
+  const float sr = 48000.f;
+  const std::string path = "build/tests/temporaldeck_session_recorder.tdsession";
+  SessionHeader header;
+  header.sampleRate = sr;
+  std::vector<SessionFrame> frames = buildScriptedSession(sr, 5 * temporaldeck_session::kSessionBlockFrames + 77);
+  std::string error;
+  bool started = false;
+  uint64_t dropped = 0;
+  {
+    SessionRecorder recorder;
+    started = recorder.start(path, &error) && recorder.consumeStartRequest();
+    recorder.beginSession(header);
+    for (const SessionFrame &frame : frames) {
+      recorder.push(frame);
+    }
+    recorder.endSession();
+    dropped = recorder.droppedFrames();
+  }
+  SessionReader reader;
+  bool opened = reader.open(path, &error);
+  size_t decoded = 0;
+  size_t firstMismatch = frames.size();
+  SessionFrame frame;
+  while (opened && reader.next(&frame)) {
+    if (decoded < frames.size() && !framesEqual(frame, frames[decoded]) && firstMismatch == frames.size()) {
+      firstMismatch = decoded;
+    }
+    decoded++;
+  }
+  std::remove(path.c_str());
+  bool ringOk = firstFits && fullRejected && wrappedFits && ordered;
+  bool pass = ringOk && started && opened && dropped == 0 && decoded == frames.size() && firstMismatch == frames.size();
+  return {"Recorder streams through a bounded ring", pass,
+          "ringOk=" + std::to_string(ringOk) + " decoded=" + std::to_string(decoded) + "/" +
+            std::to_string(frames.size()) + " dropped=" + std::to_string(dropped) + " error=" + error};
+}
+
+TestResult testReplayRestoresStartHistory() {
+  const float sr = 44100.f;
+  const int mode = Engine::BUFFER_DURATION_10S;
+  const std::string sessionPath = "build/tests/temporaldeck_session_history.tdsession";
+  const std::string ringPath = temporaldeck_session::sessionStartRingPath(sessionPath);
+
+  // The performer has been playing for longer than the ring holds, so the
+  // write head has wrapped before the take starts.
+  Engine engine;
+  engine.bufferDurationMode = mode;
+  engine.reset(sr);
+  SessionFrame preRoll = makeDefaultFrame(sr);
+  const int preRollFrames = int(sr * 12.f);
+  for (int i = 0; i < preRollFrames; ++i) {
+    float t = float(i) / sr;
+    preRoll.input.inL = 3.f * std::sin(2.f * float(M_PI) * 97.f * t);
+    preRoll.input.inR = 3.f * std::sin(2.f * float(M_PI) * 131.f * t);
+    engine.process(preRoll.input);
+  }
+
+  // What the module does on record start: transport back to NOW, unreachable
+  // history cleared, the rest kept and saved.
+  engine.reset(sr, false);
+  engine.readHead = engine.newestReadablePos();
+  engine.buffer.clearHistoryBefore(int(usableBufferSecondsForMode(mode) * sr) +
+                                   temporaldeck_session::kSessionStartRingMarginFrames);
+  SessionHeader header;
+  header.sampleRate = sr;
+  header.bufferDurationMode = mode;
+  header.hasStartRing = true;
+  header.startRingWriteHead = engine.buffer.writeHead;
+  header.startRingFilled = engine.buffer.filled;
+  int ringFrames = engine.buffer.filled;
+  std::string error;
+  bool saved = temporaldeck::writeRingSnapshot(ringPath, engine.buffer, engine.buffer.writeHead, ringFrames, mode,
+                                               [](int) { return true; }, &error);
+
+  // Drag several seconds back, past the start of the take into the saved history.
+  std::vector<SessionFrame> frames = buildScriptedSession(sr, int(sr) * 2);
+  for (SessionFrame &frame : frames) {
+    frame.input.platterLagTarget *= 16.f;
+  }
+  RenderedSession live;
+  live.sampleRate = sr;
+  uint32_t appliedSampleSeek = 0;
+  uint32_t appliedLiveSeek = 0;
+  for (const SessionFrame &frame : frames) {
+    temporaldeck_session::applySessionFrame(engine, frame, &appliedSampleSeek, &appliedLiveSeek);
+    Engine::FrameResult result = engine.process(frame.input);
+    live.left.push_back(result.outL);
+    live.right.push_back(result.outR);
+  }
+
+  std::vector<uint8_t> bytes = encodeSession(header, frames);
+  SessionReader reader;
+  RenderedSession replay;
+  temporaldeck::TemporalDeckBuffer startRing;
+  bool ok = saved && reader.openMemory(bytes, &error) &&
+            temporaldeck_session::loadSessionStartRing(sessionPath, reader.header(), &startRing, &error) &&
+            temporaldeck_session::renderSession(reader, &replay, &error, &startRing);
+  RenderDiff diff = temporaldeck_session::compareRenders(live, replay);
+
+  // The render CLI's path: the session file finds its start ring by name.
+  RenderedSession fromFile;
+  std::FILE *file = std::fopen(sessionPath.c_str(), "wb");
+  bool written = file && std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+  if (file) {
+    std::fclose(file);
+  }
+  bool fileOk = written && temporaldeck_session::renderSessionFile(sessionPath, &fromFile, &error) &&
+                temporaldeck_session::compareRenders(live, fromFile).identical;
+  std::remove(sessionPath.c_str());
+
+  // Without its start ring the session refuses to render rather than replaying silence.
+  SessionReader bare;
+  RenderedSession refused;
+  std::string refusedError;
+  bool refusesBare = bare.openMemory(bytes, &refusedError) &&
+                     !temporaldeck_session::renderSession(bare, &refused, &refusedError) && !refusedError.empty();
+
+  // And the history matters: a fresh ring renders the drag differently.
+  SessionHeader freshHeader = header;
+  freshHeader.hasStartRing = false;
+  SessionReader fresh;
+  RenderedSession freshRender;
+  bool freshOk = fresh.openMemory(encodeSession(freshHeader, frames), &refusedError) &&
+                 temporaldeck_session::renderSession(fresh, &freshRender, &refusedError);
+  bool historyUsed = freshOk && !temporaldeck_session::compareRenders(live, freshRender).identical;
+  std::remove(ringPath.c_str());
+
+  bool pass = ok && diff.identical && fileOk && refusesBare && historyUsed;
+  return {"Replay restores the history a session started from", pass,
+          "ringFrames=" + std::to_string(ringFrames) + " mismatched=" + std::to_string(diff.mismatchedFrames) +
+            " first=" + std::to_string(diff.firstMismatchFrame) + " fileOk=" + std::to_string(fileOk) + " refusesBare=" + std::to_string(refusesBare) +
+            " historyUsed=" + std::to_string(historyUsed) + " error=" + error};
+}
+
+} // namespace
+
+int main() {
+  std::vector<TestResult> tests;
+  tests.push_back(testEncodeDecodeRoundTripIsBitExact());
+  tests.push_back(testStaticControlsCompressToRuns());
+  tests.push_back(testReplayMatchesLiveProcessing());
+  tests.push_back(testFloatWavRoundTripAndDiff());
+  tests.push_back(testTruncatedSessionReportsError());
+  tests.push_back(testRecorderStreamsThroughBoundedRing());
+  tests.push_back(testReplayRestoresStartHistory());
+
+  int failed = 0;
+  std::cout << "TemporalDeck Session Record/Replay Spec\n";
+  std::cout << "---------------------------------------\n";
+  for (const auto &t : tests) {
+    std::cout << (t.pass ? "[PASS] " : "[FAIL] ") << t.name << " :: " << t.detail << "\n";
+    if (!t.pass) {
+      failed++;
+    }
+  }
+  std::cout << "---------------------------------------\n";
+  std::cout << "Summary: " << (tests.size() - failed) << "/" << tests.size() << " passed\n";
+  return failed == 0 ? 0 : 1;
+}
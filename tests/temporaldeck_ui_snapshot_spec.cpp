@@ -0,0 +1,218 @@
+#include "../src/TemporalDeckUiSnapshot.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using temporaldeck_ui::ArcLightState;
+using temporaldeck_ui::SeqlockCell;
+using temporaldeck_ui::UiSnapshot;
+
+struct TestResult {
+  std::string name;
+  bool pass = false;
+  std::string detail;
+};
+
+// Every field carries the same counter, so any mix of two publishes is visible.
+UiSnapshot stampedSnapshot(int stamp) {
+  UiSnapshot s;
+  s.lagSamples = double(stamp);
+  s.accessibleLagSamples = double(stamp);
+  s.samplePlayheadSeconds = double(stamp);
+  s.sampleDurationSeconds = double(stamp);
+  s.sampleProgress = double(stamp);
+  s.sampleRate = float(stamp);
+  s.platterAngle = float(stamp);
+  s.maxLagSamples = float(stamp);
+  s.sampleFrames = stamp;
+  s.readHeadCount = stamp;
+  s.interpolationTier = stamp;
+  s.slipReturnMode = stamp;
+  s.freezeLatched = stamp & 1;
+  s.reverseLatched = stamp & 1;
+  s.slipLatched = stamp & 1;
+  s.sampleModeEnabled = stamp & 1;
+  s.sampleLoaded = stamp & 1;
+  s.sampleTransportPlaying = stamp & 1;
+  return s;
+}
+
+bool isStamped(const UiSnapshot &s) {
+  int stamp = s.sampleFrames;
+  bool odd = stamp & 1;
+  return s.lagSamples == double(stamp) && s.accessibleLagSamples == double(stamp) &&
+         s.samplePlayheadSeconds == double(stamp) && s.sampleDurationSeconds == double(stamp) &&
+         s.sampleProgress == double(stamp) && s.sampleRate == float(stamp) && s.platterAngle == float(stamp) &&
+         s.maxLagSamples == float(stamp) && s.readHeadCount == stamp && s.interpolationTier == stamp &&
+         s.slipReturnMode == stamp && s.freezeLatched == odd && s.reverseLatched == odd && s.slipLatched == odd &&
+         s.sampleModeEnabled == odd && s.sampleLoaded == odd && s.sampleTransportPlaying == odd;
+}
+
+TestResult testPublishRoundTripsAndAdvancesSequence() {
+  SeqlockCell<UiSnapshot> cell;
+  UiSnapshot initial;
+  uint32_t firstSequence = 0;
+  bool defaultsPublished = cell.read(initial, &firstSequence) && initial.sampleRate == 44100.f &&
+                           initial.readHeadCount == 1 && initial.maxLagSamples == 1.f;
+  cell.publish(stampedSnapshot(37));
+  UiSnapshot out;
+  uint32_t secondSequence = 0;
+  bool roundTrip = cell.read(out, &secondSequence) && isStamped(out) && out.sampleFrames == 37;
+  bool advanced = secondSequence == firstSequence + 2 && cell.sequence() == secondSequence && (secondSequence & 1u) == 0u;
+  bool pass = defaultsPublished && roundTrip && advanced;
+  return {"Publish round-trips and advances the sequence", pass,
+          "defaults=" + std::to_string(defaultsPublished) + " roundTrip=" + std::to_string(roundTrip) +
+            " sequence=" + std::to_string(firstSequence) + "->" + std::to_string(secondSequence)};
+}
+
+TestResult testConcurrentReaderNeverSeesATornSnapshot() {
+  SeqlockCell<UiSnapshot> cell;
+  cell.publish(stampedSnapshot(0));
+  std::atomic<bool> done{false};
+  const int publishes = 10000;
+  std::thread writer([&]() {
+    for (int i = 1; i <= publishes; ++i) {
+      cell.publish(stampedSnapshot(i));
+      // Leave gaps between publishes like audio blocks do, so reads land both inside and between them.
+      if ((i & 7) == 0) {
+        std::this_thread::yield();
+      }
+    }
+    done.store(true, std::memory_order_release);
+  });
+  long long reads = 0;
+  long long failedReads = 0;
+  int torn = 0;
+  int backwards = 0;
+  int lastStamp = 0;
+  while (!done.load(std::memory_order_acquire) || reads == 0) {
+    UiSnapshot out;
+    if (!cell.read(out)) {
+      failedReads++;
+      continue;
+    }
+    reads++;
+    torn += !isStamped(out);
+    backwards += out.sampleFrames < lastStamp;
+    lastStamp = out.sampleFrames;
+  }
+  writer.join();
+  UiSnapshot last;
+  bool settled = cell.read(last) && last.sampleFrames == publishes;
+  bool pass = reads >= 100 && torn == 0 && backwards == 0 && settled;
+  return {"Concurrent reader never sees a torn snapshot", pass,
+          "reads=" + std::to_string(reads) + " failedReads=" + std::to_string(failedReads) +
+            " torn=" + std::to_string(torn) + " backwards=" + std::to_string(backwards) +
+            " settled=" + std::to_string(settled)};
+}
+
+TestResult testArcLightsDeriveFromTheSnapshot() {
+  // The UI thread must light the arc exactly as the audio thread used to.
+  struct Case {
+    int sampleFrames;
+    float maxLag;
+    bool sampleMode;
+    bool sampleLoaded;
+    double lag;
+    double accessibleLag;
+    double progress;
+  };
+  const Case cases[] = {{0, 48000.f * 8.f, false, false, 12000.0, 96000.0, 0.0},
+                        {0, 48000.f * 8.f, false, false, 380000.0, 383000.0, 0.0},
+                        {96000, 48000.f * 8.f, true, true, 0.0, 96000.0, 0.37},
+                        {96000, 48000.f * 8.f, true, false, 0.0, 0.0, 0.0}};
+  int mismatches = 0;
+  for (const Case &c : cases) {
+    UiSnapshot s;
+    s.sampleFrames = c.sampleFrames;
+    s.maxLagSamples = c.maxLag;
+    s.sampleModeEnabled = c.sampleMode;
+    s.sampleLoaded = c.sampleLoaded;
+    s.lagSamples = c.lag;
+    s.accessibleLagSamples = c.accessibleLag;
+    s.sampleProgress = c.progress;
+    ArcLightState derived = temporaldeck_ui::arcLightStateFor(s);
+    ArcLightState direct = temporaldeck_ui::computeArcLightState(c.sampleFrames, c.maxLag, c.sampleMode, c.sampleLoaded,
+                                                                 c.lag, c.accessibleLag, c.progress);
+    for (int i = 0; i < temporaldeck_ui::kTemporalDeckArcLightCount; ++i) {
+      mismatches += derived.yellow[i] != direct.yellow[i] || derived.red[i] != direct.red[i];
+    }
+  }
+  bool pass = mismatches == 0;
+  return {"Arc lights derive from the snapshot", pass, "mismatches=" + std::to_string(mismatches)};
+}
+
+TestResult testBlockPublishIsCheaperThanPerSampleStores() {
+  // The old path stored eleven relaxed atomics every sample; the snapshot is one sequence-locked
+  // copy every 32 frames.
+  const int frames = 48000 * 20;
+  const int block = 32;
+  std::atomic<double> lag{0.0}, accessibleLag{0.0}, playhead{0.0}, duration{0.0}, progress{0.0};
+  std::atomic<float> rate{0.f}, angle{0.f};
+  std::atomic<bool> freeze{false}, mode{false}, loaded{false}, playing{false};
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < frames; ++i) {
+    double v = double(i);
+    lag.store(v, std::memory_order_relaxed);
+    accessibleLag.store(v, std::memory_order_relaxed);
+    playhead.store(v, std::memory_order_relaxed);
+    duration.store(v, std::memory_order_relaxed);
+    progress.store(v, std::memory_order_relaxed);
+    rate.store(float(i), std::memory_order_relaxed);
+    angle.store(float(i), std::memory_order_relaxed);
+    freeze.store(i & 1, std::memory_order_relaxed);
+    mode.store(i & 2, std::memory_order_relaxed);
+    loaded.store(i & 4, std::memory_order_relaxed);
+    playing.store(i & 8, std::memory_order_relaxed);
+  }
+  double perSampleSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  SeqlockCell<UiSnapshot> cell;
+  int countdown = 0;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < frames; ++i) {
+    if (--countdown <= 0) {
+      countdown = block;
+      cell.publish(stampedSnapshot(i));
+    }
+  }
+  double blockSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  UiSnapshot last;
+  bool published = cell.read(last) && isStamped(last) && last.sampleFrames == frames - block;
+  double nsPerFrameOld = perSampleSeconds * 1e9 / double(frames);
+  double nsPerFrameNew = blockSeconds * 1e9 / double(frames);
+  bool pass = published && blockSeconds < perSampleSeconds;
+  return {"Block publish is cheaper than per-sample stores", pass,
+          "nsPerFramePerSample=" + std::to_string(nsPerFrameOld) + " nsPerFrameBlock=" + std::to_string(nsPerFrameNew) +
+            " published=" + std::to_string(published)};
+}
+
+} // namespace
+
+int main() {
+  std::vector<TestResult> tests;
+  tests.push_back(testPublishRoundTripsAndAdvancesSequence());
+  tests.push_back(testConcurrentReaderNeverSeesATornSnapshot());
+  tests.push_back(testArcLightsDeriveFromTheSnapshot());
+  tests.push_back(testBlockPublishIsCheaperThanPerSampleStores());
+
+  int failed = 0;
+  std::cout << "TemporalDeck UI Snapshot Spec\n";
+  std::cout << "-----------------------------\n";
+  for (const auto &t : tests) {
+    std::cout << (t.pass ? "[PASS] " : "[FAIL] ") << t.name << " :: " << t.detail << "\n";
+    if (!t.pass) {
+      failed++;
+    }
+  }
+  std::cout << "-----------------------------\n";
+  std::cout << "Summary: " << (tests.size() - failed) << "/" << tests.size() << " passed\n";
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,379 @@
+#include "temporaldeck_offline_render.hpp"
+
+#include "../src/TemporalDeckTest.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+namespace temporaldeck_offline {
+
+using temporaldeck::TemporalDeckEngine;
+
+namespace {
+
+// Platter gestures are published at roughly UI mouse rate rather than per
+// sample, matching how the module sees them.
+static constexpr int kPlatterTickSamples = 64;
+
+struct NamedMode {
+  const char *name;
+  int mode;
+};
+
+static const NamedMode kCartridgeNames[] = {
+  {"clean", TemporalDeckEngine::CARTRIDGE_CLEAN},
+  {"m44", TemporalDeckEngine::CARTRIDGE_M44_7},
+  {"concorde", TemporalDeckEngine::CARTRIDGE_CONCORDE_SCRATCH},
+  {"680hp", TemporalDeckEngine::CARTRIDGE_680_HP},
+  {"qbert", TemporalDeckEngine::CARTRIDGE_QBERT},
+  {"lofi", TemporalDeckEngine::CARTRIDGE_LOFI},
+};
+
+static const NamedMode kInterpolationNames[] = {
+  {"cubic", TemporalDeckEngine::SCRATCH_INTERP_CUBIC},
+  {"lagrange6", TemporalDeckEngine::SCRATCH_INTERP_LAGRANGE6},
+  {"sinc", TemporalDeckEngine::SCRATCH_INTERP_SINC},
+  {"auto", TemporalDeckEngine::SCRATCH_INTERP_AUTO},
+};
+
+static const NamedMode kOversamplingNames[] = {
+  {"off", TemporalDeckEngine::CARTRIDGE_OVERSAMPLING_OFF},
+  {"2x", TemporalDeckEngine::CARTRIDGE_OVERSAMPLING_2X},
+  {"4x", TemporalDeckEngine::CARTRIDGE_OVERSAMPLING_4X},
+};
+
+static const NamedMode kSlipReturnNames[] = {
+  {"slow", TemporalDeckEngine::SLIP_RETURN_SLOW},
+  {"normal", TemporalDeckEngine::SLIP_RETURN_NORMAL},
+  {"instant", TemporalDeckEngine::SLIP_RETURN_INSTANT},
+};
+
+template <size_t N>
+bool lookupMode(const NamedMode (&table)[N], const std::string &name, int *modeOut) {
+  for (const NamedMode &entry : table) {
+    if (name == entry.name) {
+      *modeOut = entry.mode;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool parseOnOff(const std::string &token, float *out) {
+  if (token == "on" || token == "1") {
+    *out = 1.f;
+    return true;
+  }
+  if (token == "off" || token == "0") {
+    *out = 0.f;
+    return true;
+  }
+  return false;
+}
+
+bool parseFloat(const std::string &token, float *out) {
+  try {
+    size_t idx = 0;
+    float v = std::stof(token, &idx);
+    if (idx != token.size() || !std::isfinite(v)) {
+      return false;
+    }
+    *out = v;
+    return true;
+  } catch (...) {
+    return false;
+  }
+}
+
+bool failLine(int lineNo, const std::string &message, std::string *errorOut) {
+  if (errorOut) {
+    *errorOut = "line " + std::to_string(lineNo) + ": " + message;
+  }
+  return false;
+}
+
+} // namespace
+
+bool parseAutomationScript(const std::string &text, AutomationScript *out, std::string *errorOut) {
+  if (!out) {
+    return false;
+  }
+  out->events.clear();
+  std::istringstream lines(text);
+  std::string line;
+  int lineNo = 0;
+  while (std::getline(lines, line)) {
+    lineNo++;
+    size_t hash = line.find('#');
+    if (hash != std::string::npos) {
+      line.erase(hash);
+    }
+    std::istringstream tokens(line);
+    std::string timeToken;
+    std::string command;
+    std::string value;
+    if (!(tokens >> timeToken)) {
+      continue;
+    }
+    if (!(tokens >> command)) {
+      return failLine(lineNo, "missing command", errorOut);
+    }
+    tokens >> value;
+
+    AutomationEvent event;
+    float time = 0.f;
+    if (!parseFloat(timeToken, &time) || time < 0.f) {
+      return failLine(lineNo, "bad time '" + timeToken + "'", errorOut);
+    }
+    event.timeSec = time;
+
+    bool ok = true;
+    if (command == "buffer" || command == "rate" || command == "mix" || command == "feedback") {
+      event.type = command == "buffer"   ? AutomationEvent::BUFFER_KNOB
+                   : command == "rate"   ? AutomationEvent::RATE_KNOB
+                   : command == "mix"    ? AutomationEvent::MIX_KNOB
+                                         : AutomationEvent::FEEDBACK_KNOB;
+      ok = parseFloat(value, &event.value) && event.value >= 0.f && event.value <= 1.f;
+    } else if (command == "freeze" || command == "reverse" || command == "slip" || command == "loop") {
+      event.type = command == "freeze"    ? AutomationEvent::FREEZE
+                   : command == "reverse" ? AutomationEvent::REVERSE
+                   : command == "slip"    ? AutomationEvent::SLIP
+                                          : AutomationEvent::LOOP;
+      ok = parseOnOff(value, &event.value);
+    } else if (command == "scratch") {
+      event.type = AutomationEvent::SCRATCH;
+      ok = parseFloat(value, &event.value);
+    } else if (command == "release") {
+      event.type = AutomationEvent::RELEASE;
+    } else if (command == "quickslip") {
+      event.type = AutomationEvent::QUICK_SLIP;
+    } else if (command == "cartridge") {
+      event.type = AutomationEvent::CARTRIDGE;
+      ok = lookupMode(kCartridgeNames, value, &event.mode);
+    } else if (command == "interp") {
+      event.type = AutomationEvent::INTERPOLATION;
+      ok = lookupMode(kInterpolationNames, value, &event.mode);
+    } else if (command == "oversampling") {
+      event.type = AutomationEvent::OVERSAMPLING;
+      ok = lookupMode(kOversamplingNames, value, &event.mode);
+    } else if (command == "slipreturn") {
+      event.type = AutomationEvent::SLIP_RETURN;
+      ok = lookupMode(kSlipReturnNames, value, &event.mode);
+    } else if (command == "end") {
+      event.type = AutomationEvent::END;
+    } else {
+      return failLine(lineNo, "unknown command '" + command + "'", errorOut);
+    }
+    if (!ok) {
+      return failLine(lineNo, "bad value '" + value + "' for " + command, errorOut);
+    }
+    out->events.push_back(event);
+  }
+  std::stable_sort(out->events.begin(), out->events.end(),
+                   [](const AutomationEvent &a, const AutomationEvent &b) { return a.timeSec < b.timeSec; });
+  return true;
+}
+
+bool loadAutomationScript(const std::string &path, AutomationScript *out, std::string *errorOut) {
+  std::ifstream in(path.c_str());
+  if (!in.good()) {
+    if (errorOut) {
+      *errorOut = "Failed to open automation script " + path;
+    }
+    return false;
+  }
+  std::stringstream text;
+  text << in.rdbuf();
+  return parseAutomationScript(text.str(), out, errorOut);
+}
+
+bool renderPreparedSample(temporaldeck::PreparedSampleData sample, const AutomationScript &script,
+                          const RenderOptions &options, temporaldeck_session::RenderedSession *out) {
+  if (!out || !sample.valid || sample.frames <= 0) {
+    return false;
+  }
+  const float sr = sample.sampleRate;
+  TemporalDeckEngine engine;
+  engine.bufferDurationMode = sample.bufferMode;
+  engine.reset(sr, false);
+  engine.sampleModeEnabled = true;
+  if (sample.mips.empty() && !temporaldeck::isLongBufferMode(sample.bufferMode)) {
+    temporaldeck::buildMipLevels(sample.left, sample.right, sample.frames, &sample.mips);
+  }
+  engine.installPreparedSample(std::move(sample.left), std::move(sample.right), sample.frames, true, sample.truncated,
+                               sample.monoStorage, std::move(sample.mips), std::move(sample.onsets));
+
+  double seconds = options.seconds > 0.0 ? options.seconds : double(engine.sampleFrames) / double(sr);
+  for (const AutomationEvent &event : script.events) {
+    if (event.type == AutomationEvent::END) {
+      seconds = event.timeSec;
+      break;
+    }
+  }
+  const long long totalFrames = std::max(0LL, (long long)std::llround(seconds * double(sr)));
+
+  out->sampleRate = sr;
+  out->left.clear();
+  out->right.clear();
+  out->left.reserve(size_t(totalFrames));
+  out->right.reserve(size_t(totalFrames));
+
+  TemporalDeckEngine::FrameInput in;
+  in.dt = 1.f / sr;
+  in.bufferKnob = 1.f;
+  in.rateKnob = 0.5f;
+  in.mixKnob = 1.f;
+  bool scratching = false;
+  float scratchSpeed = 0.f;
+  double localLag = 0.0;
+  double engineLag = 0.0;
+  size_t nextEvent = 0;
+  const float invScale = 1.f / temporaldeck::kSampleFileVoltageScale;
+
+  for (long long frame = 0; frame < totalFrames; ++frame) {
+    double t = double(frame) / double(sr);
+    in.quickSlipTrigger = false;
+    while (nextEvent < script.events.size() && script.events[nextEvent].timeSec <= t) {
+      const AutomationEvent &event = script.events[nextEvent++];
+      switch (event.type) {
+      case AutomationEvent::BUFFER_KNOB:
+        in.bufferKnob = event.value;
+        break;
+      case AutomationEvent::RATE_KNOB:
+        in.rateKnob = event.value;
+        break;
+      case AutomationEvent::MIX_KNOB:
+        in.mixKnob = event.value;
+        break;
+      case AutomationEvent::FEEDBACK_KNOB:
+        in.feedbackKnob = event.value;
+        break;
+      case AutomationEvent::FREEZE:
+        in.freezeButton = event.value > 0.5f;
+        break;
+      case AutomationEvent::REVERSE:
+        in.reverseButton = event.value > 0.5f;
+        break;
+      case AutomationEvent::SLIP:
+        in.slipButton = event.value > 0.5f;
+        break;
+      case AutomationEvent::LOOP:
+        engine.sampleLoopEnabled = event.value > 0.5f;
+        break;
+      case AutomationEvent::SCRATCH:
+        if (!scratching) {
+          localLag = engineLag;
+        }
+        scratching = true;
+        scratchSpeed = event.value;
+        break;
+      case AutomationEvent::RELEASE:
+        scratching = false;
+        break;
+      case AutomationEvent::QUICK_SLIP:
+        in.quickSlipTrigger = true;
+        break;
+      case AutomationEvent::CARTRIDGE:
+        engine.cartridgeCharacter = event.mode;
+        break;
+      case AutomationEvent::INTERPOLATION:
+        engine.scratchInterpolationMode = event.mode;
+        break;
+      case AutomationEvent::OVERSAMPLING:
+        engine.cartridgeOversamplingMode = event.mode;
+        break;
+      case AutomationEvent::SLIP_RETURN:
+        engine.slipReturnMode = event.mode;
+        break;
+      default:
+        break;
+      }
+    }
+
+    if (scratching) {
+      if ((frame % kPlatterTickSamples) == 0) {
+        // Same rebase rule the platter widget uses, so held motion tracks the
+        // engine instead of drifting away from it.
+        float lagDelta = scratchSpeed * float(kPlatterTickSamples);
+        localLag = platter_interaction::rebaseLagTarget(float(localLag), float(engineLag), lagDelta);
+        localLag = std::max(0.0, std::min(localLag - double(lagDelta), double(std::max(engine.sampleFrames - 1, 0))));
+        in.platterGestureRevision++;
+        in.platterLagTarget = float(localLag);
+        in.platterGestureVelocity = lagDelta / (float(kPlatterTickSamples) * in.dt);
+      }
+      in.platterTouched = true;
+      in.platterMotionActive = scratchSpeed != 0.f;
+    } else {
+      in.platterTouched = false;
+      in.platterMotionActive = false;
+      in.platterGestureVelocity = 0.f;
+    }
+
+    TemporalDeckEngine::FrameResult result = engine.process(in);
+    engineLag = result.lag;
+    out->left.push_back(result.outL * invScale);
+    out->right.push_back(result.outR * invScale);
+  }
+  return true;
+}
+
+RenderJobResult renderFile(const RenderJob &job, const AutomationScript &script, const RenderOptions &options) {
+  RenderJobResult result;
+  auto start = std::chrono::steady_clock::now();
+
+  temporaldeck::DecodedSampleFile decoded;
+  if (!temporaldeck::decodeSampleFile(job.inputPath, &decoded, &result.error)) {
+    return result;
+  }
+  temporaldeck::PreparedSampleData prepared;
+  int bufferMode = temporaldeck::chooseSampleBufferMode(decoded);
+  if (!temporaldeck::buildPreparedSample(decoded, options.sampleRate, bufferMode, true, &prepared)) {
+    result.error = "Sample preparation failed";
+    return result;
+  }
+  temporaldeck_session::RenderedSession render;
+  if (!renderPreparedSample(std::move(prepared), script, options, &render)) {
+    result.error = "Render failed";
+    return result;
+  }
+  if (!temporaldeck_session::writeFloatWav(job.outputPath, render, &result.error)) {
+    return result;
+  }
+  result.ok = true;
+  result.frames = (long long)render.left.size();
+  result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return result;
+}
+
+std::vector<RenderJobResult> renderBatch(const std::vector<RenderJob> &jobs, const AutomationScript &script,
+                                         const RenderOptions &options, int threads) {
+  std::vector<RenderJobResult> results(jobs.size());
+  if (threads <= 0) {
+    threads = int(std::max(1u, std::thread::hardware_concurrency()));
+  }
+  threads = std::max(1, std::min(threads, int(jobs.size())));
+
+  std::atomic<size_t> nextJob{0};
+  auto worker = [&]() {
+    for (size_t i = nextJob.fetch_add(1); i < jobs.size(); i = nextJob.fetch_add(1)) {
+      results[i] = renderFile(jobs[i], script, options);
+    }
+  };
+  std::vector<std::thread> pool;
+  for (int i = 1; i < threads; ++i) {
+    pool.emplace_back(worker);
+  }
+  worker();
+  for (std::thread &t : pool) {
+    t.join();
+  }
+  return results;
+}
+
+} // namespace temporaldeck_offline
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "../src/TemporalDeckSamplePrep.hpp"
+#include "../src/TemporalDeckSessionRecord.hpp"
+
+#include <string>
+#include <vector>
+
+namespace temporaldeck_offline {
+
+// Timed control changes applied to a sample-mode deck. Script syntax, one
+// event per line ("#" starts a comment):
+//
+//   <seconds> <command> [value]
+//
+//   buffer|rate|mix|feedback <0..1>     knob positions
+//   freeze|reverse|slip|loop <on|off>   latched transport toggles
+//   scratch <speed>                     hold the platter moving at speed x playback (negative = backwards)
+//   release                             let go of the platter
+//   quickslip                           one-shot quick slip return
+//   cartridge <clean|m44|concorde|680hp|qbert|lofi>
+//   interp <cubic|lagrange6|sinc|auto>
+//   oversampling <off|2x|4x>            cartridge drive oversampling
+//   slipreturn <slow|normal|instant>
+//   end                                 stop rendering at this time
+struct AutomationEvent {
+  enum Type {
+    BUFFER_KNOB,
+    RATE_KNOB,
+    MIX_KNOB,
+    FEEDBACK_KNOB,
+    FREEZE,
+    REVERSE,
+    SLIP,
+    LOOP,
+    SCRATCH,
+    RELEASE,
+    QUICK_SLIP,
+    CARTRIDGE,
+    INTERPOLATION,
+    OVERSAMPLING,
+    SLIP_RETURN,
+    END,
+  };
+  double timeSec = 0.0;
+  int type = BUFFER_KNOB;
+  float value = 0.f;
+  int mode = 0;
+};
+
+struct AutomationScript {
+  // Sorted by time; events at the same time keep script order.
+  std::vector<AutomationEvent> events;
+};
+
+bool parseAutomationScript(const std::string &text, AutomationScript *out, std::string *errorOut = nullptr);
+bool loadAutomationScript(const std::string &path, AutomationScript *out, std::string *errorOut = nullptr);
+
+struct RenderOptions {
+  float sampleRate = 48000.f;
+  // Render length when the script has no "end"; <= 0 uses the sample length.
+  double seconds = 0.0;
+};
+
+// Runs an installed sample through the automation at full CPU speed. Output is
+// normalized back from deck voltages to +/-1.
+bool renderPreparedSample(temporaldeck::PreparedSampleData sample, const AutomationScript &script,
+                          const RenderOptions &options, temporaldeck_session::RenderedSession *out);
+
+struct RenderJob {
+  std::string inputPath;
+  std::string outputPath;
+};
+
+struct RenderJobResult {
+  bool ok = false;
+  std::string error;
+  long long frames = 0;
+  double wallSeconds = 0.0;
+};
+
+RenderJobResult renderFile(const RenderJob &job, const AutomationScript &script, const RenderOptions &options);
+
+// Renders jobs on up to `threads` worker threads (<= 0 uses all cores). Each
+// job owns its own engine, so results are identical to a serial run.
+std::vector<RenderJobResult> renderBatch(const std::vector<RenderJob> &jobs, const AutomationScript &script,
+                                         const RenderOptions &options, int threads);
+
+} // namespace temporaldeck_offline
@@ -0,0 +1,145 @@
+#include "temporaldeck_offline_render.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+void printUsage() {
+  std::cerr << "Usage:\n";
+  std::cerr << "  temporaldeck_render [--script <automation.txt>] [--out-dir <dir>] [--sample-rate <hz>]\n";
+  std::cerr << "                      [--seconds <s>] [-j <threads>] <input files...>\n";
+  std::cerr << "  temporaldeck_render --session <session.tdsession> [--out-dir <dir>] [--golden <golden.wav>]\n";
+  std::cerr << "\n";
+  std::cerr << "Renders each input (WAV/FLAC/MP3) through a sample-mode TemporalDeck engine driven by the\n";
+  std::cerr << "automation script and writes <out-dir>/<name>.render.wav (stereo 32-bit float).\n";
+  std::cerr << "--session replays a recorded engine session instead; with --golden the render must match\n";
+  std::cerr << "the golden file bit for bit.\n";
+}
+
+std::string outputPathFor(const std::string &input, const std::string &outDir) {
+  size_t slash = input.find_last_of("/\\");
+  std::string name = slash == std::string::npos ? input : input.substr(slash + 1);
+  size_t dot = name.find_last_of('.');
+  if (dot != std::string::npos && dot > 0) {
+    name.erase(dot);
+  }
+  if (outDir.empty()) {
+    std::string dir = slash == std::string::npos ? std::string() : input.substr(0, slash + 1);
+    return dir + name + ".render.wav";
+  }
+  return outDir + "/" + name + ".render.wav";
+}
+
+int renderSessionMode(const std::string &sessionPath, const std::string &outPath, const std::string &goldenPath) {
+  std::string error;
+  temporaldeck_session::RenderedSession render;
+  if (!temporaldeck_session::renderSessionFile(sessionPath, &render, &error)) {
+    std::cerr << "Replay failed: " << error << "\n";
+    return EXIT_FAILURE;
+  }
+  if (!temporaldeck_session::writeFloatWav(outPath, render, &error)) {
+    std::cerr << "Write failed: " << error << "\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "Rendered " << render.left.size() << " frames @ " << render.sampleRate << " Hz -> " << outPath << "\n";
+  if (goldenPath.empty()) {
+    return EXIT_SUCCESS;
+  }
+
+  temporaldeck_session::RenderedSession golden;
+  if (!temporaldeck_session::readFloatWav(goldenPath, &golden, &error)) {
+    std::cerr << "Golden read failed: " << error << "\n";
+    return EXIT_FAILURE;
+  }
+  temporaldeck_session::RenderDiff diff = temporaldeck_session::compareRenders(render, golden);
+  if (diff.identical) {
+    std::cout << "[PASS] bit-exact against " << goldenPath << "\n";
+    return EXIT_SUCCESS;
+  }
+  std::cout << "[FAIL] differs from " << goldenPath << " :: lengths " << render.left.size() << "/" << golden.left.size()
+            << " mismatched=" << diff.mismatchedFrames << " first=" << diff.firstMismatchFrame
+            << " maxAbsDiff=" << diff.maxAbsDiff << "\n";
+  return EXIT_FAILURE;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::string scriptPath;
+  std::string outDir;
+  std::string sessionPath;
+  std::string goldenPath;
+  temporaldeck_offline::RenderOptions options;
+  int threads = 0;
+  std::vector<std::string> inputs;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--script" && hasValue) {
+      scriptPath = argv[++i];
+    } else if (arg == "--out-dir" && hasValue) {
+      outDir = argv[++i];
+    } else if (arg == "--session" && hasValue) {
+      sessionPath = argv[++i];
+    } else if (arg == "--golden" && hasValue) {
+      goldenPath = argv[++i];
+    } else if (arg == "--sample-rate" && hasValue) {
+      options.sampleRate = float(std::atof(argv[++i]));
+    } else if (arg == "--seconds" && hasValue) {
+      options.seconds = std::atof(argv[++i]);
+    } else if (arg == "-j" && hasValue) {
+      threads = std::atoi(argv[++i]);
+    } else if (arg == "-h" || arg == "--help") {
+      printUsage();
+      return EXIT_SUCCESS;
+    } else if (!arg.empty() && arg[0] == '-') {
+      printUsage();
+      return EXIT_FAILURE;
+    } else {
+      inputs.push_back(arg);
+    }
+  }
+  if (!sessionPath.empty() && inputs.empty()) {
+    return renderSessionMode(sessionPath, outputPathFor(sessionPath, outDir), goldenPath);
+  }
+  if (inputs.empty() || !(options.sampleRate > 0.f)) {
+    printUsage();
+    return EXIT_FAILURE;
+  }
+
+  temporaldeck_offline::AutomationScript script;
+  std::string error;
+  if (!scriptPath.empty() && !temporaldeck_offline::loadAutomationScript(scriptPath, &script, &error)) {
+    std::cerr << "Script error: " << error << "\n";
+    return EXIT_FAILURE;
+  }
+
+  std::vector<temporaldeck_offline::RenderJob> jobs;
+  for (const std::string &input : inputs) {
+    temporaldeck_offline::RenderJob job;
+    job.inputPath = input;
+    job.outputPath = outputPathFor(input, outDir);
+    jobs.push_back(job);
+  }
+
+  std::vector<temporaldeck_offline::RenderJobResult> results =
+    temporaldeck_offline::renderBatch(jobs, script, options, threads);
+  int failed = 0;
+  for (size_t i = 0; i < jobs.size(); ++i) {
+    const temporaldeck_offline::RenderJobResult &r = results[i];
+    if (!r.ok) {
+      std::cout << "[FAIL] " << jobs[i].inputPath << " :: " << r.error << "\n";
+      failed++;
+      continue;
+    }
+    double audioSeconds = double(r.frames) / double(options.sampleRate);
+    double speed = r.wallSeconds > 0.0 ? audioSeconds / r.wallSeconds : 0.0;
+    std::cout << "[OK] " << jobs[i].inputPath << " -> " << jobs[i].outputPath << " :: " << audioSeconds << " s in "
+              << r.wallSeconds << " s (" << speed << "x realtime)\n";
+  }
+  return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}